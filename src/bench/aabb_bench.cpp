@@ -0,0 +1,78 @@
+#include "bench_common.h"
+
+namespace
+{
+    // Broad-phase scale: one query against every sprite
+    constexpr size_t COUNT = 200000;
+
+    struct Boxes
+    {
+        std::vector<jg::AABB2f> aos;
+        std::vector<float> minX, minY, maxX, maxY;
+    };
+
+    Boxes MakeBoxes()
+    {
+        Boxes boxes;
+        for (size_t i = 0; i < COUNT; ++i)
+        {
+            const auto x = bench::Value(i) * 500.0f;
+            const auto y = bench::Value(i + 7919) * 500.0f;
+            boxes.aos.push_back(jg::AABB2f{ jg::Vec2f{ x, y }, jg::Vec2f{ x + 8.0f, y + 8.0f } });
+            boxes.minX.push_back(x);
+            boxes.minY.push_back(y);
+            boxes.maxX.push_back(x + 8.0f);
+            boxes.maxY.push_back(y + 8.0f);
+        }
+        return boxes;
+    }
+
+    const jg::AABB2f QUERY{ jg::Vec2f{ -200.0f, -150.0f }, jg::Vec2f{ 200.0f, 150.0f } };
+}
+
+static void BM_OverlapScalar(benchmark::State& state)
+{
+    const auto boxes = MakeBoxes();
+    std::vector<jg::u64> mask((COUNT + 63) / 64);
+    for (auto _ : state)
+    {
+        for (auto& w : mask)
+            w = 0;
+        for (size_t i = 0; i < COUNT; ++i)
+            mask[i / 64] |= static_cast<jg::u64>(jg::Intersects(QUERY, boxes.aos[i])) << (i % 64);
+        benchmark::DoNotOptimize(mask.data());
+        benchmark::ClobberMemory();
+    }
+    bench::ReportPerOp(state, COUNT);
+}
+BENCHMARK(BM_OverlapScalar);
+
+static void BM_OverlapMask(benchmark::State& state)
+{
+    const auto boxes = MakeBoxes();
+    const jg::AABB2fSoA soa{ boxes.minX, boxes.minY, boxes.maxX, boxes.maxY };
+    std::vector<jg::u64> mask((COUNT + 63) / 64);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(jg::OverlapMask(QUERY, soa, mask));
+        benchmark::ClobberMemory();
+    }
+    bench::ReportPerOp(state, COUNT);
+}
+BENCHMARK(BM_OverlapMask);
+
+static void BM_AABBTransform(benchmark::State& state)
+{
+    const auto boxes = MakeBoxes();
+    const auto mat = jg::Mat3f::Translation2D(3.0f, -1.0f) * jg::Mat3f::Rotation2D(0.6f);
+    std::vector<jg::AABB2f> out(bench::BATCH);
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < bench::BATCH; ++i)
+            out[i] = jg::Transform(mat, boxes.aos[i]);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    bench::ReportPerOp(state);
+}
+BENCHMARK(BM_AABBTransform);
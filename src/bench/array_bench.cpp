@@ -0,0 +1,85 @@
+#include "bench_common.h"
+
+#include <utility>
+
+namespace
+{
+    // p += v * dt over this many Vec3f
+    constexpr size_t COUNT = bench::BATCH * 16;
+    constexpr float DT = 1.0f / 60.0f;
+}
+
+static void BM_IntegrateStdVector(benchmark::State& state)
+{
+    auto p = bench::MakeVecs<3>(COUNT, 0);
+    const auto v = bench::MakeVecs<3>(COUNT, 1);
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < COUNT; ++i)
+            p[i] = p[i] + v[i] * DT;
+        benchmark::DoNotOptimize(p.data());
+        benchmark::ClobberMemory();
+    }
+    bench::ReportPerOp(state, COUNT);
+}
+BENCHMARK(BM_IntegrateStdVector);
+
+static void BM_IntegrateAoS(benchmark::State& state)
+{
+    jg::VecArray<float, 3, jg::Layout::AoS, 32> p, v;
+    for (const auto& e : bench::MakeVecs<3>(COUNT, 0))
+        p.push_back(e);
+    for (const auto& e : bench::MakeVecs<3>(COUNT, 1))
+        v.push_back(e);
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < COUNT; ++i)
+            p[i] = p[i] + v[i] * DT;
+        benchmark::DoNotOptimize(p.data());
+        benchmark::ClobberMemory();
+    }
+    bench::ReportPerOp(state, COUNT);
+}
+BENCHMARK(BM_IntegrateAoS);
+
+static void BM_IntegrateSoA(benchmark::State& state)
+{
+    jg::VecArray<float, 3, jg::Layout::SoA, 32> p, v;
+    for (const auto& e : bench::MakeVecs<3>(COUNT, 0))
+        p.push_back(e);
+    for (const auto& e : bench::MakeVecs<3>(COUNT, 1))
+        v.push_back(e);
+    for (auto _ : state)
+    {
+        // Streams are aligned and padded, so the loop runs full width to PaddedSize
+        for (size_t k = 0; k < 3; ++k)
+        {
+            auto* pk = p.ComponentData(k);
+            const auto* vk = std::as_const(v).ComponentData(k);
+            for (size_t i = 0; i < p.PaddedSize(); ++i)
+                pk[i] += vk[i] * DT;
+        }
+        benchmark::DoNotOptimize(p.Component(0).data());
+        benchmark::ClobberMemory();
+    }
+    bench::ReportPerOp(state, COUNT);
+}
+BENCHMARK(BM_IntegrateSoA);
+
+static void BM_IntegrateSoAProxy(benchmark::State& state)
+{
+    jg::VecArray<float, 3, jg::Layout::SoA, 32> p, v;
+    for (const auto& e : bench::MakeVecs<3>(COUNT, 0))
+        p.push_back(e);
+    for (const auto& e : bench::MakeVecs<3>(COUNT, 1))
+        v.push_back(e);
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < COUNT; ++i)
+            p[i] = p.Get(i) + v.Get(i) * DT;
+        benchmark::DoNotOptimize(p.Component(0).data());
+        benchmark::ClobberMemory();
+    }
+    bench::ReportPerOp(state, COUNT);
+}
+BENCHMARK(BM_IntegrateSoAProxy);
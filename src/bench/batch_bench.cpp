@@ -0,0 +1,39 @@
+#include "bench_common.h"
+
+namespace
+{
+    const auto TRANSFORM = jg::Mat3f::Translation2D(4.0f, -2.0f) * jg::Mat3f::Rotation2D(0.3f);
+}
+
+static void BM_TransformPointsPerVec(benchmark::State& state)
+{
+    const auto count = static_cast<size_t>(state.range(0));
+    std::vector<jg::Vec3f> points(count, jg::Vec3f{ 1.0f, 2.0f, 1.0f });
+    std::vector<jg::Vec3f> out(count);
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < count; ++i)
+            out[i] = TRANSFORM * points[i];
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    bench::ReportPerOp(state, count);
+}
+BENCHMARK(BM_TransformPointsPerVec)->Arg(1 << 10)->Arg(1 << 20);
+
+static void BM_TransformPoints2D(benchmark::State& state)
+{
+    const auto count = static_cast<size_t>(state.range(0));
+    std::vector<float> xs(count, 1.0f), ys(count, 2.0f), outX(count), outY(count);
+
+    for (auto _ : state)
+    {
+        jg::TransformPoints2D(TRANSFORM, xs, ys, outX, outY);
+        benchmark::DoNotOptimize(outX.data());
+        benchmark::DoNotOptimize(outY.data());
+        benchmark::ClobberMemory();
+    }
+    bench::ReportPerOp(state, count);
+}
+BENCHMARK(BM_TransformPoints2D)->Arg(1 << 10)->Arg(1 << 20);
@@ -0,0 +1,52 @@
+#ifndef J_BENCH_COMMON_H
+#define J_BENCH_COMMON_H
+
+#include "benchmark/benchmark.h"
+
+#include <vector>
+
+#include "jangine.h"
+
+namespace bench
+{
+    // Operations run per benchmark iteration; small enough to stay in L1
+    constexpr size_t BATCH = 256;
+
+    // Reports items/s and time/op for a loop doing `ops` operations per iteration
+    inline void ReportPerOp(benchmark::State& state, size_t ops = BATCH)
+    {
+        const auto total = state.iterations() * static_cast<benchmark::IterationCount>(ops);
+        state.SetItemsProcessed(total);
+        state.counters["time/op"] = benchmark::Counter(static_cast<double>(total),
+            benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+    }
+
+    // Deterministic, well-conditioned values in [-2, 2)
+    inline float Value(size_t seed)
+    {
+        return static_cast<float>((seed * 2654435761u) % 4096u) / 1024.0f - 2.0f;
+    }
+
+    template <size_t N>
+    std::vector<jg::Vec<float, N>> MakeVecs(size_t count, size_t seed = 0)
+    {
+        std::vector<jg::Vec<float, N>> vecs(count, jg::Vec<float, N>{ 0.0f });
+        for (size_t i = 0; i < count; ++i)
+            for (size_t j = 0; j < N; ++j)
+                vecs[i][j] = Value(seed + i * N + j) + (j == 0 ? 3.0f : 0.0f);
+        return vecs;
+    }
+
+    // Diagonally dominant so every matrix is invertible
+    template <size_t N>
+    std::vector<jg::Mat<float, N, N>> MakeMats(size_t count, size_t seed = 0)
+    {
+        std::vector<jg::Mat<float, N, N>> mats(count);
+        for (size_t i = 0; i < count; ++i)
+            for (size_t j = 0; j < N * N; ++j)
+                mats[i].data[j] = Value(seed + i * N * N + j) + (j % (N + 1) == 0 ? 8.0f : 0.0f);
+        return mats;
+    }
+}
+
+#endif // J_BENCH_COMMON_H
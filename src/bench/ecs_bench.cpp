@@ -0,0 +1,99 @@
+#include "benchmark/benchmark.h"
+
+#include <vector>
+
+#include "jangine.h"
+
+namespace
+{
+    using jg::ecs::Position;
+    using jg::ecs::Velocity;
+
+    constexpr size_t ENTITY_COUNT = 1 << 20;
+    constexpr float DT = 1.0f / 60.0f;
+
+    using Health = jg::ecs::Component<struct BenchHealthTag, float>;
+
+    // Every fourth entity also has Health, so the query spans two archetypes
+    void Populate(jg::ecs::World& world)
+    {
+        for (size_t i = 0; i < ENTITY_COUNT; ++i)
+        {
+            const auto f = static_cast<float>(i % 1024);
+            const auto e = world.Create<Position, Velocity>(jg::Vec2f{ f, -f }, jg::Vec2f{ 0.5f, 0.25f });
+            if (i % 4 == 0)
+                world.Add<Health>(e, 1.0f);
+        }
+    }
+
+    // Two Vec2f read and one written per entity
+    void ReportBandwidth(benchmark::State& state)
+    {
+        state.SetItemsProcessed(state.iterations() * static_cast<benchmark::IterationCount>(ENTITY_COUNT));
+        state.SetBytesProcessed(state.iterations() * static_cast<benchmark::IterationCount>(ENTITY_COUNT * 3 * sizeof(jg::Vec2f)));
+    }
+}
+
+// Baseline: two plain arrays, no ECS
+static void BM_IntegrateRawArrays(benchmark::State& state)
+{
+    std::vector<jg::Vec2f> positions(ENTITY_COUNT, jg::Vec2f{ 1.0f });
+    const std::vector<jg::Vec2f> velocities(ENTITY_COUNT, jg::Vec2f{ 0.5f, 0.25f });
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < ENTITY_COUNT; ++i)
+            positions[i] = positions[i] + velocities[i] * DT;
+        benchmark::DoNotOptimize(positions.data());
+        benchmark::ClobberMemory();
+    }
+    ReportBandwidth(state);
+}
+BENCHMARK(BM_IntegrateRawArrays)->Unit(benchmark::kMillisecond);
+
+static void BM_EcsIntegrateChunks(benchmark::State& state)
+{
+    jg::ecs::World world;
+    Populate(world);
+    for (auto _ : state)
+    {
+        world.ForEachChunk<Position, const Velocity>([](jg::Span<jg::Vec2f> p, jg::Span<const jg::Vec2f> v) {
+            for (size_t i = 0; i < p.size(); ++i)
+                p[i] = p[i] + v[i] * DT;
+        });
+        benchmark::ClobberMemory();
+    }
+    ReportBandwidth(state);
+}
+BENCHMARK(BM_EcsIntegrateChunks)->Unit(benchmark::kMillisecond);
+
+static void BM_EcsIntegrateForEach(benchmark::State& state)
+{
+    jg::ecs::World world;
+    Populate(world);
+    for (auto _ : state)
+    {
+        world.ForEach<Position, const Velocity>([](jg::Vec2f& p, const jg::Vec2f& v) { p = p + v * DT; });
+        benchmark::ClobberMemory();
+    }
+    ReportBandwidth(state);
+}
+BENCHMARK(BM_EcsIntegrateForEach)->Unit(benchmark::kMillisecond);
+
+// Add then remove a component on every 16th entity: two archetype moves each
+static void BM_EcsAddRemove(benchmark::State& state)
+{
+    jg::ecs::World world;
+    std::vector<jg::ecs::Entity> entities;
+    entities.reserve(ENTITY_COUNT / 16);
+    for (size_t i = 0; i < ENTITY_COUNT / 16; ++i)
+        entities.push_back(world.Create<Position, Velocity>(jg::Vec2f{ 0.0f }, jg::Vec2f{ 1.0f }));
+    for (auto _ : state)
+    {
+        for (const auto e : entities)
+            world.Add<jg::ecs::Transform>(e, jg::Mat3f::Identity());
+        for (const auto e : entities)
+            world.Remove<jg::ecs::Transform>(e);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<benchmark::IterationCount>(2 * entities.size()));
+}
+BENCHMARK(BM_EcsAddRemove)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,75 @@
+#include "bench_common.h"
+
+#include "math/jexpr.h"
+
+namespace expr = jg::expr;
+
+// out = out * 0.5 + a * 0.25 - b + c * 2, eagerly: one temporary per operator.
+// Reading the previous out keeps the compiler from hoisting the chain out of the timed loop.
+template <typename C>
+static void RunEager(benchmark::State& state, const std::vector<C>& a, const std::vector<C>& b, const std::vector<C>& c)
+{
+    auto out = a;
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < bench::BATCH; ++i)
+            out[i] = out[i] * 0.5f + a[i] * 0.25f - b[i] + c[i] * 2.0f;
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    bench::ReportPerOp(state);
+}
+
+// Same expression fused into a single pass per element
+template <typename C>
+static void RunFused(benchmark::State& state, const std::vector<C>& a, const std::vector<C>& b, const std::vector<C>& c)
+{
+    auto out = a;
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < bench::BATCH; ++i)
+            expr::Assign(out[i], expr::Lazy(out[i]) * 0.5f + expr::Lazy(a[i]) * 0.25f - b[i] + expr::Lazy(c[i]) * 2.0f);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    bench::ReportPerOp(state);
+}
+
+template <size_t N>
+static void BM_VecExprEager(benchmark::State& state)
+{
+    RunEager(state, bench::MakeVecs<N>(bench::BATCH, 1), bench::MakeVecs<N>(bench::BATCH, 2), bench::MakeVecs<N>(bench::BATCH, 3));
+}
+
+template <size_t N>
+static void BM_VecExprFused(benchmark::State& state)
+{
+    RunFused(state, bench::MakeVecs<N>(bench::BATCH, 1), bench::MakeVecs<N>(bench::BATCH, 2), bench::MakeVecs<N>(bench::BATCH, 3));
+}
+
+template <size_t N>
+static void BM_MatExprEager(benchmark::State& state)
+{
+    RunEager(state, bench::MakeMats<N>(bench::BATCH, 1), bench::MakeMats<N>(bench::BATCH, 2), bench::MakeMats<N>(bench::BATCH, 3));
+}
+
+template <size_t N>
+static void BM_MatExprFused(benchmark::State& state)
+{
+    RunFused(state, bench::MakeMats<N>(bench::BATCH, 1), bench::MakeMats<N>(bench::BATCH, 2), bench::MakeMats<N>(bench::BATCH, 3));
+}
+
+BENCHMARK_TEMPLATE(BM_VecExprEager, 2);
+BENCHMARK_TEMPLATE(BM_VecExprFused, 2);
+BENCHMARK_TEMPLATE(BM_VecExprEager, 3);
+BENCHMARK_TEMPLATE(BM_VecExprFused, 3);
+BENCHMARK_TEMPLATE(BM_VecExprEager, 4);
+BENCHMARK_TEMPLATE(BM_VecExprFused, 4);
+BENCHMARK_TEMPLATE(BM_VecExprEager, 8);
+BENCHMARK_TEMPLATE(BM_VecExprFused, 8);
+BENCHMARK_TEMPLATE(BM_VecExprEager, 16);
+BENCHMARK_TEMPLATE(BM_VecExprFused, 16);
+BENCHMARK_TEMPLATE(BM_MatExprEager, 3);
+BENCHMARK_TEMPLATE(BM_MatExprFused, 3);
+BENCHMARK_TEMPLATE(BM_MatExprEager, 4);
+BENCHMARK_TEMPLATE(BM_MatExprFused, 4);
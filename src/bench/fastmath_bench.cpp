@@ -0,0 +1,143 @@
+#include "bench_common.h"
+
+#include <cmath>
+
+namespace
+{
+    std::vector<float> MakeAngles()
+    {
+        std::vector<float> angles(bench::BATCH);
+        for (size_t i = 0; i < bench::BATCH; ++i)
+            angles[i] = bench::Value(i) * 4.0f;
+        return angles;
+    }
+}
+
+static void BM_NormalizePrecise(benchmark::State& state)
+{
+    const auto v = bench::MakeVecs<2>(bench::BATCH);
+    auto out = v;
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < bench::BATCH; ++i)
+            out[i] = jg::Normalize(v[i]);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    bench::ReportPerOp(state);
+}
+BENCHMARK(BM_NormalizePrecise);
+
+static void BM_NormalizeFast(benchmark::State& state)
+{
+    const auto v = bench::MakeVecs<2>(bench::BATCH);
+    auto out = v;
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < bench::BATCH; ++i)
+            out[i] = jg::fast::NormalizeFast(v[i]);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    bench::ReportPerOp(state);
+}
+BENCHMARK(BM_NormalizeFast);
+
+static void BM_SinCosPrecise(benchmark::State& state)
+{
+    const auto angles = MakeAngles();
+    std::vector<float> sines(bench::BATCH), cosines(bench::BATCH);
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < bench::BATCH; ++i)
+        {
+            sines[i] = std::sin(angles[i]);
+            cosines[i] = std::cos(angles[i]);
+        }
+        benchmark::DoNotOptimize(sines.data());
+        benchmark::DoNotOptimize(cosines.data());
+        benchmark::ClobberMemory();
+    }
+    bench::ReportPerOp(state);
+}
+BENCHMARK(BM_SinCosPrecise);
+
+static void BM_SinCosFast(benchmark::State& state)
+{
+    const auto angles = MakeAngles();
+    std::vector<float> sines(bench::BATCH), cosines(bench::BATCH);
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < bench::BATCH; ++i)
+        {
+            const auto sc = jg::fast::SinCos(angles[i]);
+            sines[i] = sc.sin;
+            cosines[i] = sc.cos;
+        }
+        benchmark::DoNotOptimize(sines.data());
+        benchmark::DoNotOptimize(cosines.data());
+        benchmark::ClobberMemory();
+    }
+    bench::ReportPerOp(state);
+}
+BENCHMARK(BM_SinCosFast);
+
+static void BM_Atan2Precise(benchmark::State& state)
+{
+    const auto angles = MakeAngles();
+    std::vector<float> out(bench::BATCH);
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < bench::BATCH; ++i)
+            out[i] = std::atan2(angles[i], angles[bench::BATCH - 1 - i]);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    bench::ReportPerOp(state);
+}
+BENCHMARK(BM_Atan2Precise);
+
+static void BM_Atan2Fast(benchmark::State& state)
+{
+    const auto angles = MakeAngles();
+    std::vector<float> out(bench::BATCH);
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < bench::BATCH; ++i)
+            out[i] = jg::fast::Atan2(angles[i], angles[bench::BATCH - 1 - i]);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    bench::ReportPerOp(state);
+}
+BENCHMARK(BM_Atan2Fast);
+
+static void BM_ExpPrecise(benchmark::State& state)
+{
+    const auto angles = MakeAngles();
+    std::vector<float> out(bench::BATCH);
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < bench::BATCH; ++i)
+            out[i] = std::exp(angles[i]);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    bench::ReportPerOp(state);
+}
+BENCHMARK(BM_ExpPrecise);
+
+static void BM_ExpFast(benchmark::State& state)
+{
+    const auto angles = MakeAngles();
+    std::vector<float> out(bench::BATCH);
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < bench::BATCH; ++i)
+            out[i] = jg::fast::Exp(angles[i]);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    bench::ReportPerOp(state);
+}
+BENCHMARK(BM_ExpFast);
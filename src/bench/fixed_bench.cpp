@@ -0,0 +1,98 @@
+#include "bench_common.h"
+
+namespace
+{
+    // The lockstep budget: one 60 Hz step of 50k bodies must fit in 16.6 ms
+    constexpr size_t BODY_COUNT = 50000;
+
+    // Same step as the golden hash test, for either scalar type
+    template <typename T>
+    struct Bodies
+    {
+        std::vector<jg::Vec<T, 2>> position;
+        std::vector<jg::Vec<T, 2>> velocity;
+        std::vector<T> angle;
+        std::vector<T> spin;
+
+        Bodies()
+        {
+            for (size_t i = 0; i < BODY_COUNT; ++i)
+            {
+                position.push_back(jg::Vec<T, 2>{ static_cast<T>(bench::Value(i) * 200.0f), static_cast<T>(bench::Value(i + 1) * 200.0f) });
+                velocity.push_back(jg::Vec<T, 2>{ static_cast<T>(bench::Value(i + 2) * 5.0f), static_cast<T>(bench::Value(i + 3) * 5.0f) });
+                angle.push_back(static_cast<T>(bench::Value(i + 4)));
+                spin.push_back(static_cast<T>(bench::Value(i + 5)));
+            }
+        }
+
+        void Step()
+        {
+            const auto dt = static_cast<T>(1.0 / 60.0);
+            const auto gravity = static_cast<T>(-9.81);
+            const auto thrust = static_cast<T>(12.0);
+            const auto maxSpeed = static_cast<T>(80.0);
+            const auto bounds = static_cast<T>(500.0);
+            const auto restitution = static_cast<T>(0.75);
+
+            for (size_t i = 0; i < BODY_COUNT; ++i)
+            {
+                angle[i] += spin[i] * dt;
+                const jg::Vec<T, 2> heading{ jg::Cos(angle[i]), jg::Sin(angle[i]) };
+                auto v = velocity[i] + heading * (thrust * dt);
+                v.y += gravity * dt;
+
+                const auto speed = jg::Length(v);
+                if (speed > maxSpeed)
+                    v = v * (maxSpeed / speed);
+
+                auto p = position[i] + v * dt;
+                for (size_t k = 0; k < 2; ++k)
+                {
+                    if (p[k] > bounds || p[k] < -bounds)
+                    {
+                        p[k] = p[k] > bounds ? bounds : -bounds;
+                        v[k] = -v[k] * restitution;
+                    }
+                }
+                position[i] = p;
+                velocity[i] = v;
+            }
+        }
+    };
+
+    template <typename T>
+    void StepBodies(benchmark::State& state)
+    {
+        Bodies<T> bodies;
+        for (auto _ : state)
+        {
+            bodies.Step();
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<benchmark::IterationCount>(BODY_COUNT));
+    }
+}
+
+static void BM_LockstepStepFixed(benchmark::State& state) { StepBodies<jg::fixed>(state); }
+BENCHMARK(BM_LockstepStepFixed)->Unit(benchmark::kMillisecond);
+
+// Baseline: the same step on f32 with libm trig, which is not reproducible across machines
+static void BM_LockstepStepF32(benchmark::State& state) { StepBodies<jg::f32>(state); }
+BENCHMARK(BM_LockstepStepF32)->Unit(benchmark::kMillisecond);
+
+static void BM_FixedSinCos(benchmark::State& state)
+{
+    std::vector<jg::fixed> angles(bench::BATCH);
+    for (size_t i = 0; i < bench::BATCH; ++i)
+        angles[i] = jg::fixed{ bench::Value(i) * 8.0f };
+    for (auto _ : state)
+    {
+        for (const auto a : angles)
+        {
+            benchmark::DoNotOptimize(jg::Sin(a));
+            benchmark::DoNotOptimize(jg::Cos(a));
+        }
+    }
+    bench::ReportPerOp(state);
+}
+BENCHMARK(BM_FixedSinCos);
@@ -0,0 +1,71 @@
+#include "benchmark/benchmark.h"
+
+#include <vector>
+
+#include "jangine.h"
+
+namespace
+{
+    // Roughly a large scene's worth of transforms
+    constexpr size_t TRANSFORM_COUNT = 1 << 18;
+
+    struct TransformSet
+    {
+        std::vector<jg::Mat3f> parents, locals, worlds;
+
+        TransformSet() : worlds(TRANSFORM_COUNT)
+        {
+            for (size_t i = 0; i < TRANSFORM_COUNT; ++i)
+            {
+                const auto f = static_cast<float>(i % 1024);
+                parents.push_back(jg::Mat3f::Translation2D(f, -f) * jg::Mat3f::Rotation2D(0.001f * f));
+                locals.push_back(jg::Mat3f::Rotation2D(-0.002f * f) * jg::Mat3f::Scale2D(1.0f + 0.001f * f, 1.0f));
+            }
+        }
+    };
+}
+
+static void BM_ComposeTransformsSerial(benchmark::State& state)
+{
+    TransformSet set;
+    for (auto _ : state)
+    {
+        jg::ComposeTransforms(jg::Span<const jg::Mat3f>{ set.parents }, jg::Span<const jg::Mat3f>{ set.locals },
+                              jg::Span<jg::Mat3f>{ set.worlds });
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * TRANSFORM_COUNT);
+}
+BENCHMARK(BM_ComposeTransformsSerial)->Unit(benchmark::kMicrosecond);
+
+// Thread count scaling; counts above the core count show the oversubscription cost
+static void BM_ComposeTransformsParallel(benchmark::State& state)
+{
+    TransformSet set;
+    jg::jobs::ThreadPool pool{ static_cast<size_t>(state.range(0)) };
+    for (auto _ : state)
+    {
+        jg::jobs::ComposeTransforms(pool, jg::Span<const jg::Mat3f>{ set.parents }, jg::Span<const jg::Mat3f>{ set.locals },
+                                    jg::Span<jg::Mat3f>{ set.worlds });
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * TRANSFORM_COUNT);
+}
+BENCHMARK(BM_ComposeTransformsParallel)->RangeMultiplier(2)->Range(1, 16)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+// Scheduling overhead: many tiny tasks
+static void BM_ParallelForOverhead(benchmark::State& state)
+{
+    jg::jobs::ThreadPool pool{ static_cast<size_t>(state.range(0)) };
+    std::vector<float> values(4096, 1.0f);
+    for (auto _ : state)
+    {
+        jg::jobs::ParallelFor(pool, 0, values.size(), 64, [&](size_t first, size_t last) {
+            for (auto i = first; i < last; ++i)
+                values[i] *= 1.0001f;
+        });
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * values.size() / 64);
+}
+BENCHMARK(BM_ParallelForOverhead)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
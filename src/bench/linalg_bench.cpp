@@ -0,0 +1,91 @@
+#include "bench_common.h"
+
+namespace
+{
+    // Symmetric positive definite, like the effective mass matrix of a contact constraint
+    template <size_t N>
+    std::vector<jg::Mat<float, N, N>> MakeSpdMats(size_t count)
+    {
+        auto mats = bench::MakeMats<N>(count, 3);
+        for (auto& m : mats)
+            m = jg::Transpose(m) * m;
+        return mats;
+    }
+}
+
+// Baseline: form the inverse, then multiply
+template <size_t N>
+static void BM_SolveByInverse(benchmark::State& state)
+{
+    const auto a = MakeSpdMats<N>(bench::BATCH);
+    const auto b = bench::MakeVecs<N>(bench::BATCH, 1);
+    auto out = b;
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < bench::BATCH; ++i)
+            out[i] = jg::Inverse(a[i]) * b[i];
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    bench::ReportPerOp(state);
+}
+BENCHMARK_TEMPLATE(BM_SolveByInverse, 6);
+BENCHMARK_TEMPLATE(BM_SolveByInverse, 12);
+
+template <size_t N>
+static void BM_SolveLU(benchmark::State& state)
+{
+    const auto a = MakeSpdMats<N>(bench::BATCH);
+    const auto b = bench::MakeVecs<N>(bench::BATCH, 1);
+    auto out = b;
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < bench::BATCH; ++i)
+            out[i] = jg::Solve(*jg::DecomposeLU(a[i]), b[i]);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    bench::ReportPerOp(state);
+}
+BENCHMARK_TEMPLATE(BM_SolveLU, 6);
+BENCHMARK_TEMPLATE(BM_SolveLU, 12);
+
+template <size_t N>
+static void BM_SolveCholesky(benchmark::State& state)
+{
+    const auto a = MakeSpdMats<N>(bench::BATCH);
+    const auto b = bench::MakeVecs<N>(bench::BATCH, 1);
+    auto out = b;
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < bench::BATCH; ++i)
+            out[i] = jg::Solve(*jg::DecomposeCholesky(a[i]), b[i]);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    bench::ReportPerOp(state);
+}
+BENCHMARK_TEMPLATE(BM_SolveCholesky, 6);
+BENCHMARK_TEMPLATE(BM_SolveCholesky, 12);
+
+template <size_t N>
+static void BM_SolveQR(benchmark::State& state)
+{
+    const auto a = MakeSpdMats<N>(bench::BATCH);
+    const auto b = bench::MakeVecs<N>(bench::BATCH, 1);
+    auto out = b;
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < bench::BATCH; ++i)
+            out[i] = jg::Solve(*jg::DecomposeQR(a[i]), b[i]);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    bench::ReportPerOp(state);
+}
+BENCHMARK_TEMPLATE(BM_SolveQR, 6);
+BENCHMARK_TEMPLATE(BM_SolveQR, 12);
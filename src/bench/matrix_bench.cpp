@@ -0,0 +1,209 @@
+#include "bench_common.h"
+
+template <size_t N>
+static void BM_MatMul(benchmark::State& state)
+{
+    const auto a = bench::MakeMats<N>(bench::BATCH, 1);
+    const auto b = bench::MakeMats<N>(bench::BATCH, 2);
+    auto out = a;
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < bench::BATCH; ++i)
+            out[i] = a[i] * b[i];
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    bench::ReportPerOp(state);
+}
+BENCHMARK_TEMPLATE(BM_MatMul, 3);
+BENCHMARK_TEMPLATE(BM_MatMul, 4);
+BENCHMARK_TEMPLATE(BM_MatMul, 6);
+BENCHMARK_TEMPLATE(BM_MatMul, 8);
+BENCHMARK_TEMPLATE(BM_MatMul, 12);
+BENCHMARK_TEMPLATE(BM_MatMul, 16);
+
+// The triple loop the generic operator* used before the blocked kernel, as a baseline
+template <size_t N>
+static void BM_MatMulNaive(benchmark::State& state)
+{
+    const auto a = bench::MakeMats<N>(bench::BATCH, 1);
+    const auto b = bench::MakeMats<N>(bench::BATCH, 2);
+    auto out = a;
+
+    for (auto _ : state)
+    {
+        for (size_t m = 0; m < bench::BATCH; ++m)
+        {
+            jg::Mat<float, N, N> ret;
+            for (size_t i = 0; i < N; ++i)
+                for (size_t j = 0; j < N; ++j)
+                    for (size_t k = 0; k < N; ++k)
+                        ret.data[i * N + j] += a[m].data[k * N + j] * b[m].data[i * N + k];
+            out[m] = ret;
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    bench::ReportPerOp(state);
+}
+BENCHMARK_TEMPLATE(BM_MatMulNaive, 3);
+BENCHMARK_TEMPLATE(BM_MatMulNaive, 4);
+BENCHMARK_TEMPLATE(BM_MatMulNaive, 6);
+BENCHMARK_TEMPLATE(BM_MatMulNaive, 8);
+BENCHMARK_TEMPLATE(BM_MatMulNaive, 12);
+BENCHMARK_TEMPLATE(BM_MatMulNaive, 16);
+
+template <size_t N>
+static void BM_MatVec(benchmark::State& state)
+{
+    const auto m = bench::MakeMats<N>(1)[0];
+    const auto v = bench::MakeVecs<N>(bench::BATCH);
+    auto out = v;
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < bench::BATCH; ++i)
+            out[i] = m * v[i];
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    bench::ReportPerOp(state);
+}
+BENCHMARK_TEMPLATE(BM_MatVec, 3);
+BENCHMARK_TEMPLATE(BM_MatVec, 4);
+
+template <size_t N>
+static void BM_Transpose(benchmark::State& state)
+{
+    const auto a = bench::MakeMats<N>(bench::BATCH);
+    auto out = a;
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < bench::BATCH; ++i)
+            out[i] = jg::Transpose(a[i]);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    bench::ReportPerOp(state);
+}
+BENCHMARK_TEMPLATE(BM_Transpose, 3);
+BENCHMARK_TEMPLATE(BM_Transpose, 4);
+
+template <size_t N>
+static void BM_Determinant(benchmark::State& state)
+{
+    const auto a = bench::MakeMats<N>(bench::BATCH);
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < bench::BATCH; ++i)
+        {
+            auto det = jg::Determinant(a[i]);
+            benchmark::DoNotOptimize(det);
+        }
+    }
+    bench::ReportPerOp(state);
+}
+BENCHMARK_TEMPLATE(BM_Determinant, 3);
+BENCHMARK_TEMPLATE(BM_Determinant, 4);
+
+template <size_t N>
+static void BM_Inverse(benchmark::State& state)
+{
+    const auto a = bench::MakeMats<N>(bench::BATCH);
+    auto out = a;
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < bench::BATCH; ++i)
+            out[i] = jg::Inverse(a[i]);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    bench::ReportPerOp(state);
+}
+BENCHMARK_TEMPLATE(BM_Inverse, 3);
+BENCHMARK_TEMPLATE(BM_Inverse, 4);
+
+static void BM_AffineInverse4(benchmark::State& state)
+{
+    auto a = bench::MakeMats<4>(bench::BATCH);
+    for (auto& m : a)
+    {
+        m.m30 = m.m31 = m.m32 = 0.0f;
+        m.m33 = 1.0f;
+    }
+    auto out = a;
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < bench::BATCH; ++i)
+            out[i] = jg::AffineInverse(a[i]);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    bench::ReportPerOp(state);
+}
+BENCHMARK(BM_AffineInverse4);
+
+static void BM_Mat3Compose2D(benchmark::State& state)
+{
+    std::vector<jg::Mat3f> a(bench::BATCH), b(bench::BATCH);
+    for (size_t i = 0; i < bench::BATCH; ++i)
+    {
+        a[i] = jg::Mat3f::Translation2D(bench::Value(i), bench::Value(i + 1)) * jg::Mat3f::Rotation2D(bench::Value(i + 2));
+        b[i] = jg::Mat3f::Scale2D(bench::Value(i + 3), bench::Value(i + 4));
+    }
+    auto out = a;
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < bench::BATCH; ++i)
+            out[i] = a[i] * b[i];
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    bench::ReportPerOp(state);
+}
+BENCHMARK(BM_Mat3Compose2D);
+
+static void BM_Affine2Compose(benchmark::State& state)
+{
+    std::vector<jg::Affine2f> a(bench::BATCH), b(bench::BATCH);
+    for (size_t i = 0; i < bench::BATCH; ++i)
+    {
+        a[i] = jg::Affine2f::Translation(bench::Value(i), bench::Value(i + 1)) * jg::Affine2f::Rotation(bench::Value(i + 2));
+        b[i] = jg::Affine2f::Scale(bench::Value(i + 3), bench::Value(i + 4));
+    }
+    auto out = a;
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < bench::BATCH; ++i)
+            out[i] = a[i] * b[i];
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    bench::ReportPerOp(state);
+}
+BENCHMARK(BM_Affine2Compose);
+
+static void BM_Affine2Inverse(benchmark::State& state)
+{
+    std::vector<jg::Affine2f> a(bench::BATCH);
+    for (size_t i = 0; i < bench::BATCH; ++i)
+        a[i] = jg::Affine2f::Translation(bench::Value(i), bench::Value(i + 1)) * jg::Affine2f::Rotation(bench::Value(i + 2));
+    auto out = a;
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < bench::BATCH; ++i)
+            out[i] = jg::Inverse(a[i]);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    bench::ReportPerOp(state);
+}
+BENCHMARK(BM_Affine2Inverse);
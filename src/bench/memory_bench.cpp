@@ -0,0 +1,84 @@
+#include "benchmark/benchmark.h"
+
+#include <cstdlib>
+#include <list>
+#include <vector>
+
+#include "jangine.h"
+
+namespace
+{
+    // A frame's worth of scratch buffers of varying size, e.g. per-layer culling lists
+    constexpr size_t BUFFERS_PER_FRAME = 64;
+
+    size_t BufferSize(size_t i) { return 64 + (i * 2654435761u) % 4096; }
+
+    void Touch(jg::Vec2f* p, size_t count)
+    {
+        for (size_t i = 0; i < count; i += 16)
+            p[i] = jg::Vec2f{ 1.0f };
+        benchmark::DoNotOptimize(p);
+    }
+}
+
+static void BM_FrameScratchMalloc(benchmark::State& state)
+{
+    std::vector<jg::Vec2f*> buffers(BUFFERS_PER_FRAME);
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < BUFFERS_PER_FRAME; ++i)
+        {
+            buffers[i] = static_cast<jg::Vec2f*>(std::malloc(BufferSize(i) * sizeof(jg::Vec2f)));
+            Touch(buffers[i], BufferSize(i));
+        }
+        for (auto* p : buffers)
+            std::free(p);
+    }
+    state.SetItemsProcessed(state.iterations() * BUFFERS_PER_FRAME);
+}
+BENCHMARK(BM_FrameScratchMalloc);
+
+static void BM_FrameScratchArena(benchmark::State& state)
+{
+    jg::memory::FrameArena frame{ 4u << 20 };
+    for (auto _ : state)
+    {
+        frame.BeginFrame();
+        for (size_t i = 0; i < BUFFERS_PER_FRAME; ++i)
+        {
+            const auto buffer = frame.AllocateArray<jg::Vec2f>(BufferSize(i));
+            Touch(buffer.data(), buffer.size());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * BUFFERS_PER_FRAME);
+    state.counters["peak_bytes"] = static_cast<double>(frame.PeakFrameUsed());
+}
+BENCHMARK(BM_FrameScratchArena);
+
+template <typename List>
+static void ChurnList(List& nodes)
+{
+    for (auto i = 0; i < 256; ++i)
+        nodes.push_back(jg::Vec3f{ static_cast<float>(i) });
+    while (!nodes.empty())
+        nodes.pop_front();
+}
+
+static void BM_NodeChurnNew(benchmark::State& state)
+{
+    std::list<jg::Vec3f> nodes;
+    for (auto _ : state)
+        ChurnList(nodes);
+    state.SetItemsProcessed(state.iterations() * 256);
+}
+BENCHMARK(BM_NodeChurnNew);
+
+static void BM_NodeChurnPool(benchmark::State& state)
+{
+    jg::memory::Pool pool{ 32, 256 };
+    std::list<jg::Vec3f, jg::memory::PoolAllocator<jg::Vec3f>> nodes{ jg::memory::PoolAllocator<jg::Vec3f>{ pool } };
+    for (auto _ : state)
+        ChurnList(nodes);
+    state.SetItemsProcessed(state.iterations() * 256);
+}
+BENCHMARK(BM_NodeChurnPool);
@@ -0,0 +1,107 @@
+#include "bench_common.h"
+
+namespace
+{
+    // A vertex stream too large for L2, so the cost is mostly memory traffic
+    constexpr size_t VERTEX_COUNT = 1 << 18;
+
+    std::vector<jg::Vec3f> MakeVertices()
+    {
+        std::vector<jg::Vec3f> v(VERTEX_COUNT);
+        for (size_t i = 0; i < VERTEX_COUNT; ++i)
+            v[i] = jg::Vec3f{ bench::Value(i * 3), bench::Value(i * 3 + 1), bench::Value(i * 3 + 2) };
+        return v;
+    }
+
+    void ReportVertices(benchmark::State& state, size_t bytesPerVertex)
+    {
+        state.SetItemsProcessed(state.iterations() * static_cast<benchmark::IterationCount>(VERTEX_COUNT));
+        state.SetBytesProcessed(state.iterations() * static_cast<benchmark::IterationCount>(VERTEX_COUNT * bytesPerVertex));
+    }
+}
+
+// Baseline: summing full f32 positions, to compare against reading packed ones
+static void BM_SumVec3f(benchmark::State& state)
+{
+    const auto v = MakeVertices();
+    for (auto _ : state)
+    {
+        jg::Vec3f sum{ 0.0f };
+        for (const auto& p : v)
+            sum = sum + p;
+        benchmark::DoNotOptimize(sum);
+    }
+    ReportVertices(state, sizeof(jg::Vec3f));
+}
+BENCHMARK(BM_SumVec3f);
+
+static void BM_PackHalf(benchmark::State& state)
+{
+    const auto v = MakeVertices();
+    std::vector<jg::Vec3h> packed(VERTEX_COUNT);
+    for (auto _ : state)
+    {
+        jg::PackHalf(jg::Span<const jg::Vec3f>{ v }, jg::Span<jg::Vec3h>{ packed });
+        benchmark::ClobberMemory();
+    }
+    ReportVertices(state, sizeof(jg::Vec3f) + sizeof(jg::Vec3h));
+}
+BENCHMARK(BM_PackHalf);
+
+static void BM_UnpackHalf(benchmark::State& state)
+{
+    const auto v = MakeVertices();
+    std::vector<jg::Vec3h> packed(VERTEX_COUNT);
+    jg::PackHalf(jg::Span<const jg::Vec3f>{ v }, jg::Span<jg::Vec3h>{ packed });
+    std::vector<jg::Vec3f> out(VERTEX_COUNT);
+    for (auto _ : state)
+    {
+        jg::UnpackHalf(jg::Span<const jg::Vec3h>{ packed }, jg::Span<jg::Vec3f>{ out });
+        benchmark::ClobberMemory();
+    }
+    ReportVertices(state, sizeof(jg::Vec3f) + sizeof(jg::Vec3h));
+}
+BENCHMARK(BM_UnpackHalf);
+
+// Element-wise f16 conversion, for comparison with the bulk kernel
+static void BM_PackHalfScalar(benchmark::State& state)
+{
+    const auto v = MakeVertices();
+    std::vector<jg::Vec3h> packed(VERTEX_COUNT);
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < VERTEX_COUNT; ++i)
+            packed[i] = jg::Vec3h{ jg::f16{ v[i].x }, jg::f16{ v[i].y }, jg::f16{ v[i].z } };
+        benchmark::ClobberMemory();
+    }
+    ReportVertices(state, sizeof(jg::Vec3f) + sizeof(jg::Vec3h));
+}
+BENCHMARK(BM_PackHalfScalar);
+
+static void BM_PackFixed(benchmark::State& state)
+{
+    const auto v = MakeVertices();
+    std::vector<jg::Vec3fx> packed(VERTEX_COUNT);
+    for (auto _ : state)
+    {
+        jg::PackFixed(jg::Span<const jg::Vec3f>{ v }, jg::Span<jg::Vec3fx>{ packed });
+        benchmark::ClobberMemory();
+    }
+    ReportVertices(state, sizeof(jg::Vec3f) + sizeof(jg::Vec3fx));
+}
+BENCHMARK(BM_PackFixed);
+
+static void BM_UnpackFixed(benchmark::State& state)
+{
+    const auto v = MakeVertices();
+    std::vector<jg::Vec3fx> packed(VERTEX_COUNT);
+    jg::PackFixed(jg::Span<const jg::Vec3f>{ v }, jg::Span<jg::Vec3fx>{ packed });
+    std::vector<jg::Vec3f> out(VERTEX_COUNT);
+    for (auto _ : state)
+    {
+        jg::UnpackFixed(jg::Span<const jg::Vec3fx>{ packed }, jg::Span<jg::Vec3f>{ out });
+        benchmark::ClobberMemory();
+    }
+    ReportVertices(state, sizeof(jg::Vec3f) + sizeof(jg::Vec3fx));
+}
+BENCHMARK(BM_UnpackFixed);
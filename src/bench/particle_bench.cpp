@@ -0,0 +1,83 @@
+#include "benchmark/benchmark.h"
+
+#include "jangine.h"
+
+namespace
+{
+    constexpr float DT = 1.0f / 60.0f;
+
+    // Lifetimes of 1 to 10 seconds, so a few per thousand expire each frame and get re-emitted
+    void Emit(jg::ParticleSystem& particles, size_t seed)
+    {
+        const auto h = static_cast<jg::u32>(seed * 2654435761u);
+        particles.Emit(jg::Vec2f{ static_cast<float>(h % 1920), static_cast<float>((h >> 11) % 1080) },
+                       jg::Vec2f{ static_cast<float>(h % 200) - 100.0f, static_cast<float>((h >> 8) % 200) - 100.0f },
+                       1.0f + static_cast<float>(h % 1000) * 0.009f);
+    }
+
+    void Setup(jg::ParticleSystem& particles, jg::Integrator integrator)
+    {
+        particles.SetIntegrator(integrator);
+        particles.SetGravity(jg::Vec2f{ 0.0f, 98.0f });
+        particles.SetDrag(0.2f);
+        particles.AddForceField(jg::ForceField{ jg::Vec2f{ 960.0f, 540.0f }, 400.0f, 500.0f });
+        particles.AddForceField(jg::ForceField{ jg::Vec2f{ 300.0f, 800.0f }, -300.0f, 200.0f });
+        while (particles.size() < particles.Capacity())
+            Emit(particles, particles.size());
+    }
+
+    // range(0): particles, range(1): threads, 0 for the serial Update
+    void RunFrames(benchmark::State& state, jg::Integrator integrator)
+    {
+        const auto count = static_cast<size_t>(state.range(0));
+        const auto threads = static_cast<size_t>(state.range(1));
+        jg::ParticleSystem particles{ count };
+        Setup(particles, integrator);
+        jg::jobs::ThreadPool pool{ threads > 0 ? threads : 1 };
+        size_t seed = count;
+        for (auto _ : state)
+        {
+            if (threads > 0)
+                particles.Update(pool, DT);
+            else
+                particles.Update(DT);
+            while (particles.size() < count)
+                Emit(particles, seed++);
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<benchmark::IterationCount>(count));
+    }
+}
+
+static void BM_ParticlesEuler(benchmark::State& state) { RunFrames(state, jg::Integrator::Euler); }
+BENCHMARK(BM_ParticlesEuler)->ArgsProduct({ { 1 << 20, 10'000'000 }, { 0, 2, 4, 8 } })->UseRealTime()->Unit(benchmark::kMillisecond);
+
+static void BM_ParticlesVerlet(benchmark::State& state) { RunFrames(state, jg::Integrator::Verlet); }
+BENCHMARK(BM_ParticlesVerlet)->ArgsProduct({ { 1 << 20, 10'000'000 }, { 0, 8 } })->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// The same integration through Vec2f operators on an array of structures, for comparison
+static void BM_ParticlesVec2fBaseline(benchmark::State& state)
+{
+    struct Particle
+    {
+        jg::Vec2f position;
+        jg::Vec2f velocity;
+        float age;
+        float lifetime;
+    };
+    std::vector<Particle> particles(static_cast<size_t>(state.range(0)),
+                                    Particle{ jg::Vec2f{ 1.0f }, jg::Vec2f{ 2.0f }, 0.0f, 1e9f });
+    const jg::Vec2f gravity{ 0.0f, 98.0f };
+    for (auto _ : state)
+    {
+        for (auto& p : particles)
+        {
+            p.velocity = p.velocity + (gravity - p.velocity * 0.2f) * DT;
+            p.position = p.position + p.velocity * DT;
+            p.age += DT;
+        }
+        benchmark::DoNotOptimize(particles.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ParticlesVec2fBaseline)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,78 @@
+#include "benchmark/benchmark.h"
+
+#include <algorithm>
+
+#include "jangine.h"
+
+namespace
+{
+    constexpr float DT = 1.0f / 60.0f;
+
+    jg::physics::BodyDef StaticBox(float x, float y, float halfWidth, float halfHeight)
+    {
+        jg::physics::BodyDef def;
+        def.shape = jg::physics::MakeBox(halfWidth, halfHeight);
+        def.position = jg::Vec2f{ x, y };
+        def.density = 0.0f;
+        return def;
+    }
+
+    // A mix of boxes, circles and hexagons, dropped into `bins` walled bins side by side
+    void Fill(jg::physics::World& world, size_t bodies, size_t bins)
+    {
+        const auto perBin = bodies / bins;
+        const auto columns = std::max(size_t{ 10 }, perBin / 100);
+        const auto binWidth = static_cast<float>(columns) + 1.0f;
+        world.CreateBody(StaticBox(0.5f * binWidth * static_cast<float>(bins), -1.0f, 0.5f * binWidth * static_cast<float>(bins) + 1.0f, 1.0f));
+        for (size_t b = 0; b <= bins; ++b)
+            world.CreateBody(StaticBox(binWidth * static_cast<float>(b), 50.0f, 0.25f, 50.0f));
+
+        jg::Vec2f hexagon[6];
+        for (int k = 0; k < 6; ++k)
+            hexagon[k] = jg::Vec2f{ 0.4f * jg::Cos(static_cast<float>(k) * jg::PI / 3.0f), 0.4f * jg::Sin(static_cast<float>(k) * jg::PI / 3.0f) };
+        const auto hex = jg::physics::MakePolygon(jg::Span<const jg::Vec2f>{ hexagon, 6 });
+
+        for (size_t i = 0; i < perBin * bins; ++i)
+        {
+            const auto bin = i / perBin;
+            const auto slot = i % perBin;
+            const auto h = static_cast<jg::u32>(i * 2654435761u);
+            jg::physics::BodyDef def;
+            def.position = jg::Vec2f{ binWidth * static_cast<float>(bin) + 1.0f + static_cast<float>(slot % columns) + static_cast<float>(h % 16) * 0.01f,
+                                      0.6f + static_cast<float>(slot / columns) * 1.05f };
+            def.angle = static_cast<float>(h % 31) * 0.1f;
+            switch (h % 3)
+            {
+            case 0: def.shape = jg::physics::MakeBox(0.4f, 0.3f + static_cast<float>(h % 4) * 0.05f); break;
+            case 1: def.shape = jg::physics::MakeCircle(0.35f + static_cast<float>(h % 4) * 0.03f); break;
+            default: def.shape = hex; break;
+            }
+            world.CreateBody(def);
+        }
+    }
+
+    // range(0): bodies, range(1): bins, range(2): threads, 0 for the serial Step.
+    // Starts from piles that have had five seconds to settle
+    void BM_PhysicsStep(benchmark::State& state)
+    {
+        jg::physics::World world;
+        Fill(world, static_cast<size_t>(state.range(0)), static_cast<size_t>(state.range(1)));
+        const auto threads = static_cast<size_t>(state.range(2));
+        jg::jobs::ThreadPool pool{ threads > 0 ? threads : 1 };
+        for (int n = 0; n < 300; ++n)
+            world.Step(pool, DT);
+
+        for (auto _ : state)
+        {
+            if (threads > 0)
+                world.Step(pool, DT);
+            else
+                world.Step(DT);
+        }
+        state.counters["contacts"] = static_cast<double>(world.Contacts().size());
+        state.counters["islands"] = static_cast<double>(world.IslandCount());
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+}
+
+BENCHMARK(BM_PhysicsStep)->ArgsProduct({ { 10'000 }, { 1, 100 }, { 0, 2, 4, 8 } })->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,56 @@
+#include "benchmark/benchmark.h"
+
+#include <vector>
+
+#include "jangine.h"
+
+namespace
+{
+    constexpr jg::u32 WIDTH = 1920;
+    constexpr jg::u32 HEIGHT = 1080;
+    constexpr size_t SPRITE_COUNT = 100000;
+
+    // 100k sprites of 8 to 40 pixels spread over a 1080p frame, batched as in a real frame
+    std::vector<jg::SpriteVertex> MakeFrame(bool translucent)
+    {
+        std::vector<jg::Sprite> sprites(SPRITE_COUNT);
+        for (size_t i = 0; i < SPRITE_COUNT; ++i)
+        {
+            auto& s = sprites[i];
+            const auto h = static_cast<jg::u32>(i * 2654435761u);
+            const auto size = 8.0f + static_cast<float>(h % 33);
+            s.transform = jg::Mat3f::Rotation2D(0.01f * static_cast<float>(i % 628)) * jg::Mat3f::Scale2D(size, size);
+            s.position = jg::Vec2f{ static_cast<float>((h >> 6) % WIDTH), static_cast<float>((h >> 17) % HEIGHT) };
+            s.color = jg::Vec4f{ static_cast<float>(h & 0xFF) / 255.0f, 0.5f, 0.25f, translucent ? 0.5f : 1.0f };
+            s.texture = h % 16;
+            s.layer = static_cast<jg::u32>(i % 4);
+        }
+        std::vector<jg::SpriteVertex> vertices(SPRITE_COUNT * jg::SpriteBatcher::VERTICES_PER_SPRITE);
+        jg::SpriteBatcher batcher;
+        batcher.Build(jg::Span<const jg::Sprite>{ sprites }, jg::Span<jg::SpriteVertex>{ vertices });
+        return vertices;
+    }
+
+    void RenderFrame(benchmark::State& state, bool translucent)
+    {
+        const auto vertices = MakeFrame(translucent);
+        jg::jobs::ThreadPool pool{ static_cast<size_t>(state.range(0)) };
+        jg::Framebuffer fb{ WIDTH, HEIGHT };
+        jg::TileRasterizer rasterizer;
+        for (auto _ : state)
+        {
+            fb.Clear(0xFF000000u);
+            rasterizer.DrawQuads(jg::Mat3f::Identity(), jg::Span<const jg::SpriteVertex>{ vertices });
+            rasterizer.Render(pool, fb);
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<benchmark::IterationCount>(SPRITE_COUNT));
+    }
+}
+
+// Full frame: queue, set up, bin and rasterize 200k triangles, over 1 to 8 threads
+static void BM_RasterizeSpritesOpaque(benchmark::State& state) { RenderFrame(state, false); }
+BENCHMARK(BM_RasterizeSpritesOpaque)->RangeMultiplier(2)->Range(1, 8)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+static void BM_RasterizeSpritesBlended(benchmark::State& state) { RenderFrame(state, true); }
+BENCHMARK(BM_RasterizeSpritesBlended)->RangeMultiplier(2)->Range(1, 8)->UseRealTime()->Unit(benchmark::kMillisecond);
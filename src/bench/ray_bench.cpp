@@ -0,0 +1,218 @@
+#include "bench_common.h"
+
+#include <array>
+#include <bitset>
+
+namespace
+{
+    // A frame's worth of line-of-sight rays
+    constexpr size_t RAYS = 4096;
+
+    // Rays run from a shooter to its target
+    constexpr float MAX_T = 1.0f;
+
+    const jg::AABB2f BOX{ jg::Vec2f{ -0.5f, -0.75f }, jg::Vec2f{ 0.75f, 0.5f } };
+    const jg::Vec2f CENTER{ 0.25f, -0.25f };
+    constexpr float RADIUS = 0.6f;
+    const jg::Vec2f SEGMENT_A{ -1.0f, 0.5f };
+    const jg::Vec2f SEGMENT_B{ 0.5f, -1.0f };
+    const std::array<jg::Vec2f, 6> HEXAGON{
+        jg::Vec2f{ -0.5f, -0.25f }, jg::Vec2f{ -0.25f, -0.5f }, jg::Vec2f{ 0.25f, -0.5f },
+        jg::Vec2f{ 0.5f, -0.25f }, jg::Vec2f{ 0.25f, 0.5f }, jg::Vec2f{ -0.25f, 0.5f }
+    };
+
+    // Many of these hit each shape
+    std::vector<jg::Ray2f> MakeRays()
+    {
+        std::vector<jg::Ray2f> rays;
+        for (size_t i = 0; i < RAYS; ++i)
+        {
+            const auto origin = jg::Vec2f{ bench::Value(i) * 2.0f, bench::Value(i + 7919) * 2.0f };
+            const auto target = jg::Vec2f{ bench::Value(i + 104729) * 0.5f, bench::Value(i + 1299709) * 0.5f };
+            rays.push_back(jg::Ray2f{ origin, target - origin });
+        }
+        return rays;
+    }
+
+    template <size_t W>
+    std::vector<jg::RayPacket<W>> MakePackets(const std::vector<jg::Ray2f>& rays)
+    {
+        std::vector<jg::RayPacket<W>> packets(rays.size() / W);
+        for (size_t i = 0; i < rays.size(); ++i)
+            packets[i / W].Set(i % W, rays[i], MAX_T);
+        return packets;
+    }
+
+    template <typename Fn>
+    void RunScalar(benchmark::State& state, Fn fn)
+    {
+        const auto rays = MakeRays();
+        std::vector<float> t(RAYS);
+        for (auto _ : state)
+        {
+            size_t hits = 0;
+            for (size_t i = 0; i < RAYS; ++i)
+                hits += fn(rays[i], t[i]);
+            benchmark::DoNotOptimize(hits);
+            benchmark::DoNotOptimize(t.data());
+            benchmark::ClobberMemory();
+        }
+        bench::ReportPerOp(state, RAYS);
+    }
+
+    template <size_t W, typename Fn>
+    void RunPacket(benchmark::State& state, Fn fn)
+    {
+        const auto packets = MakePackets<W>(MakeRays());
+        std::vector<std::array<float, W>> t(packets.size());
+        for (auto _ : state)
+        {
+            size_t hits = 0;
+            for (size_t i = 0; i < packets.size(); ++i)
+                hits += std::bitset<W>(fn(packets[i], t[i])).count();
+            benchmark::DoNotOptimize(hits);
+            benchmark::DoNotOptimize(t.data());
+            benchmark::ClobberMemory();
+        }
+        bench::ReportPerOp(state, RAYS);
+    }
+
+    const auto HEXAGON_SPAN = jg::Span<const jg::Vec2f>{ HEXAGON.data(), HEXAGON.size() };
+}
+
+static void BM_RayBoxScalar(benchmark::State& state)
+{
+    RunScalar(state, [](const jg::Ray2f& ray, float& t) { return jg::Intersect(ray, BOX, MAX_T, t); });
+}
+BENCHMARK(BM_RayBoxScalar);
+
+template <size_t W>
+static void BM_RayBoxPacket(benchmark::State& state)
+{
+    RunPacket<W>(state, [](const jg::RayPacket<W>& rays, std::array<float, W>& t) { return jg::Intersect(rays, BOX, t); });
+}
+BENCHMARK_TEMPLATE(BM_RayBoxPacket, 4);
+BENCHMARK_TEMPLATE(BM_RayBoxPacket, 8);
+
+static void BM_RayCircleScalar(benchmark::State& state)
+{
+    RunScalar(state, [](const jg::Ray2f& ray, float& t) { return jg::IntersectCircle(ray, CENTER, RADIUS, MAX_T, t); });
+}
+BENCHMARK(BM_RayCircleScalar);
+
+template <size_t W>
+static void BM_RayCirclePacket(benchmark::State& state)
+{
+    RunPacket<W>(state, [](const jg::RayPacket<W>& rays, std::array<float, W>& t) { return jg::IntersectCircle(rays, CENTER, RADIUS, t); });
+}
+BENCHMARK_TEMPLATE(BM_RayCirclePacket, 4);
+BENCHMARK_TEMPLATE(BM_RayCirclePacket, 8);
+
+static void BM_RaySegmentScalar(benchmark::State& state)
+{
+    RunScalar(state, [](const jg::Ray2f& ray, float& t) { return jg::IntersectSegment(ray, SEGMENT_A, SEGMENT_B, MAX_T, t); });
+}
+BENCHMARK(BM_RaySegmentScalar);
+
+template <size_t W>
+static void BM_RaySegmentPacket(benchmark::State& state)
+{
+    RunPacket<W>(state, [](const jg::RayPacket<W>& rays, std::array<float, W>& t) { return jg::IntersectSegment(rays, SEGMENT_A, SEGMENT_B, t); });
+}
+BENCHMARK_TEMPLATE(BM_RaySegmentPacket, 4);
+BENCHMARK_TEMPLATE(BM_RaySegmentPacket, 8);
+
+static void BM_RayPolygonScalar(benchmark::State& state)
+{
+    RunScalar(state, [](const jg::Ray2f& ray, float& t) { return jg::IntersectConvexPolygon(ray, HEXAGON_SPAN, MAX_T, t); });
+}
+BENCHMARK(BM_RayPolygonScalar);
+
+template <size_t W>
+static void BM_RayPolygonPacket(benchmark::State& state)
+{
+    RunPacket<W>(state, [](const jg::RayPacket<W>& rays, std::array<float, W>& t) { return jg::IntersectConvexPolygon(rays, HEXAGON_SPAN, t); });
+}
+BENCHMARK_TEMPLATE(BM_RayPolygonPacket, 4);
+BENCHMARK_TEMPLATE(BM_RayPolygonPacket, 8);
+
+namespace
+{
+    // Walls scattered across the rays' paths; a ray is done at the first one that blocks it
+    std::vector<std::array<jg::Vec2f, 2>> MakeWalls()
+    {
+        std::vector<std::array<jg::Vec2f, 2>> walls;
+        for (size_t i = 0; i < 64; ++i)
+        {
+            const auto a = jg::Vec2f{ bench::Value(i * 4) * 1.5f, bench::Value(i * 4 + 1) * 1.5f };
+            const auto d = jg::Vec2f{ bench::Value(i * 4 + 2) * 0.2f, bench::Value(i * 4 + 3) * 0.2f };
+            walls.push_back({ a, a + d });
+        }
+        return walls;
+    }
+
+    // Each shooter checks 8 targets around it, so neighbouring rays are blocked by the same walls
+    std::vector<jg::Ray2f> MakeSightLines()
+    {
+        std::vector<jg::Ray2f> rays;
+        for (size_t i = 0; i < RAYS; ++i)
+        {
+            const auto shooter = i / 8;
+            const auto origin = jg::Vec2f{ bench::Value(shooter) * 2.0f, bench::Value(shooter + 7919) * 2.0f };
+            const auto target = origin * 0.25f + jg::Vec2f{ bench::Value(i + 104729) * 0.5f, bench::Value(i + 1299709) * 0.5f };
+            rays.push_back(jg::Ray2f{ origin, target - origin });
+        }
+        return rays;
+    }
+}
+
+static void BM_LineOfSightScalar(benchmark::State& state)
+{
+    const auto rays = MakeSightLines();
+    const auto walls = MakeWalls();
+    for (auto _ : state)
+    {
+        size_t visible = 0;
+        for (const auto& ray : rays)
+        {
+            bool blocked = false;
+            float t;
+            for (size_t w = 0; w < walls.size() && !blocked; ++w)
+                blocked = jg::IntersectSegment(ray, walls[w][0], walls[w][1], MAX_T, t);
+            visible += !blocked;
+        }
+        benchmark::DoNotOptimize(visible);
+    }
+    bench::ReportPerOp(state, RAYS);
+}
+BENCHMARK(BM_LineOfSightScalar);
+
+// Wall by wall over every packet, skipping packets whose lanes are all blocked
+template <size_t W>
+static void BM_LineOfSightPacket(benchmark::State& state)
+{
+    const auto packets = MakePackets<W>(MakeSightLines());
+    const auto walls = MakeWalls();
+    std::vector<jg::u32> live(packets.size());
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < packets.size(); ++i)
+            live[i] = packets[i].ActiveMask();
+        std::array<float, W> t;
+        for (const auto& wall : walls)
+        {
+            for (size_t i = 0; i < packets.size(); ++i)
+            {
+                if (live[i] != 0)
+                    live[i] &= ~jg::IntersectSegment(packets[i], wall[0], wall[1], t);
+            }
+        }
+        size_t visible = 0;
+        for (const auto mask : live)
+            visible += std::bitset<W>(mask).count();
+        benchmark::DoNotOptimize(visible);
+    }
+    bench::ReportPerOp(state, RAYS);
+}
+BENCHMARK_TEMPLATE(BM_LineOfSightPacket, 4);
+BENCHMARK_TEMPLATE(BM_LineOfSightPacket, 8);
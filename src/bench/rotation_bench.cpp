@@ -0,0 +1,121 @@
+#include "bench_common.h"
+
+namespace
+{
+    std::vector<jg::Quatf> MakeQuats(size_t count, size_t seed)
+    {
+        std::vector<jg::Quatf> quats;
+        const auto axes = bench::MakeVecs<3>(count, seed);
+        for (size_t i = 0; i < count; ++i)
+            quats.push_back(jg::Quatf::FromAxisAngle(jg::Normalize(axes[i]), bench::Value(seed + i) * 1.5f));
+        return quats;
+    }
+
+    std::vector<float> MakeWeights()
+    {
+        std::vector<float> t(bench::BATCH);
+        for (size_t i = 0; i < bench::BATCH; ++i)
+            t[i] = (bench::Value(i) + 2.0f) * 0.25f;
+        return t;
+    }
+}
+
+static void BM_QuatRotate(benchmark::State& state)
+{
+    const auto q = MakeQuats(bench::BATCH, 0);
+    const auto v = bench::MakeVecs<3>(bench::BATCH, 1);
+    auto out = v;
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < bench::BATCH; ++i)
+            out[i] = jg::Rotate(q[i], v[i]);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    bench::ReportPerOp(state);
+}
+BENCHMARK(BM_QuatRotate);
+
+static void BM_QuatToMat3Rotate(benchmark::State& state)
+{
+    const auto q = MakeQuats(bench::BATCH, 0);
+    const auto v = bench::MakeVecs<3>(bench::BATCH, 1);
+    auto out = v;
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < bench::BATCH; ++i)
+            out[i] = jg::ToMat3(q[i]) * v[i];
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    bench::ReportPerOp(state);
+}
+BENCHMARK(BM_QuatToMat3Rotate);
+
+static void BM_QuatNlerp(benchmark::State& state)
+{
+    const auto a = MakeQuats(bench::BATCH, 0);
+    const auto b = MakeQuats(bench::BATCH, 7);
+    const auto t = MakeWeights();
+    auto out = a;
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < bench::BATCH; ++i)
+            out[i] = jg::Nlerp(a[i], b[i], t[i]);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    bench::ReportPerOp(state);
+}
+BENCHMARK(BM_QuatNlerp);
+
+static void BM_QuatSlerp(benchmark::State& state)
+{
+    const auto a = MakeQuats(bench::BATCH, 0);
+    const auto b = MakeQuats(bench::BATCH, 7);
+    const auto t = MakeWeights();
+    auto out = a;
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < bench::BATCH; ++i)
+            out[i] = jg::Slerp(a[i], b[i], t[i]);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    bench::ReportPerOp(state);
+}
+BENCHMARK(BM_QuatSlerp);
+
+static void BM_QuatSlerpBatch(benchmark::State& state)
+{
+    const auto a = MakeQuats(bench::BATCH, 0);
+    const auto b = MakeQuats(bench::BATCH, 7);
+    const auto t = MakeWeights();
+    auto out = a;
+    for (auto _ : state)
+    {
+        jg::SlerpBatch(a, b, t, out);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    bench::ReportPerOp(state);
+}
+BENCHMARK(BM_QuatSlerpBatch);
+
+static void BM_Rotor2Rotate(benchmark::State& state)
+{
+    std::vector<jg::Rotor2f> r;
+    for (size_t i = 0; i < bench::BATCH; ++i)
+        r.push_back(jg::Rotor2f::FromAngle(bench::Value(i)));
+    const auto v = bench::MakeVecs<2>(bench::BATCH, 1);
+    auto out = v;
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < bench::BATCH; ++i)
+            out[i] = jg::Rotate(r[i], v[i]);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    bench::ReportPerOp(state);
+}
+BENCHMARK(BM_Rotor2Rotate);
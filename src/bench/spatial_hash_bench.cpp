@@ -0,0 +1,141 @@
+#include "benchmark/benchmark.h"
+
+#include <vector>
+
+#include "jangine.h"
+
+namespace
+{
+    // 100k moving entities in a 4096 x 4096 world
+    constexpr size_t ENTITIES = 100000;
+    constexpr float WORLD = 4096.0f;
+    constexpr float CELL = 32.0f;
+    constexpr size_t QUERIES = 64;
+
+    // Uniform in [0, 1); a full mix so consecutive seeds are uncorrelated
+    float Random(size_t seed)
+    {
+        auto z = static_cast<jg::u64>(seed) + 0x9e3779b97f4a7c15ull;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return static_cast<float>((z ^ (z >> 31)) >> 40) / 16777216.0f;
+    }
+
+    std::vector<jg::AABB2f> MakeEntities(float offset = 0.0f)
+    {
+        std::vector<jg::AABB2f> boxes;
+        for (size_t i = 0; i < ENTITIES; ++i)
+        {
+            const auto x = Random(i * 3) * WORLD + offset;
+            const auto y = Random(i * 3 + 1) * WORLD;
+            const auto size = 4.0f + Random(i * 3 + 2) * 12.0f;
+            boxes.push_back(jg::AABB2f{ jg::Vec2f{ x, y }, jg::Vec2f{ x + size, y + size } });
+        }
+        return boxes;
+    }
+
+    // Proximity query around an entity: a 64 x 64 neighbourhood
+    jg::AABB2f MakeQuery(size_t q)
+    {
+        const auto c = jg::Vec2f{ Random(q * 5 + 11) * WORLD, Random(q * 5 + 12) * WORLD };
+        return jg::AABB2f::FromCenterExtents(c, jg::Vec2f{ 32.0f });
+    }
+
+    jg::SpatialHashGrid MakeGrid(const std::vector<jg::AABB2f>& boxes)
+    {
+        jg::SpatialHashGrid grid{ CELL, 1 << 16 };
+        for (const auto& box : boxes)
+            grid.Insert(box);
+        return grid;
+    }
+}
+
+static void BM_RegionQueryBruteForce(benchmark::State& state)
+{
+    const auto boxes = MakeEntities();
+    size_t hits = 0;
+    for (auto _ : state)
+    {
+        for (size_t q = 0; q < QUERIES; ++q)
+        {
+            const auto region = MakeQuery(q);
+            for (const auto& box : boxes)
+                hits += jg::Intersects(box, region);
+        }
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetItemsProcessed(state.iterations() * QUERIES);
+}
+BENCHMARK(BM_RegionQueryBruteForce);
+
+static void BM_RegionQueryGrid(benchmark::State& state)
+{
+    const auto boxes = MakeEntities();
+    const auto grid = MakeGrid(boxes);
+    size_t hits = 0;
+    for (auto _ : state)
+    {
+        for (size_t q = 0; q < QUERIES; ++q)
+            grid.Query(MakeQuery(q), [&](jg::SpatialHashGrid::ProxyId) { ++hits; });
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetItemsProcessed(state.iterations() * QUERIES);
+}
+BENCHMARK(BM_RegionQueryGrid);
+
+static void BM_RaycastBruteForce(benchmark::State& state)
+{
+    const auto boxes = MakeEntities();
+    for (auto _ : state)
+    {
+        for (size_t q = 0; q < QUERIES; ++q)
+        {
+            const jg::Ray2f ray{ Center(MakeQuery(q)), jg::Vec2f{ Random(q) - 0.5f, Random(q + 99) - 0.5f } };
+            auto bestT = 512.0f;
+            for (const auto& box : boxes)
+            {
+                float t;
+                if (jg::Intersect(ray, box, bestT, t))
+                    bestT = t;
+            }
+            benchmark::DoNotOptimize(bestT);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * QUERIES);
+}
+BENCHMARK(BM_RaycastBruteForce);
+
+static void BM_RaycastGrid(benchmark::State& state)
+{
+    const auto boxes = MakeEntities();
+    const auto grid = MakeGrid(boxes);
+    for (auto _ : state)
+    {
+        for (size_t q = 0; q < QUERIES; ++q)
+        {
+            const jg::Ray2f ray{ Center(MakeQuery(q)), jg::Vec2f{ Random(q) - 0.5f, Random(q + 99) - 0.5f } };
+            float t;
+            benchmark::DoNotOptimize(grid.RaycastClosest(ray, 512.0f, t));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * QUERIES);
+}
+BENCHMARK(BM_RaycastGrid);
+
+// Every entity moves a little each frame
+static void BM_MoveAllGrid(benchmark::State& state)
+{
+    const auto boxes = MakeEntities();
+    const auto moved = MakeEntities(3.0f);
+    auto grid = MakeGrid(boxes);
+    auto flip = false;
+    for (auto _ : state)
+    {
+        const auto& target = flip ? boxes : moved;
+        for (size_t i = 0; i < ENTITIES; ++i)
+            grid.Move(static_cast<jg::SpatialHashGrid::ProxyId>(i), target[i]);
+        flip = !flip;
+    }
+    state.SetItemsProcessed(state.iterations() * ENTITIES);
+}
+BENCHMARK(BM_MoveAllGrid);
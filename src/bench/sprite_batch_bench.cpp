@@ -0,0 +1,81 @@
+#include "benchmark/benchmark.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "jangine.h"
+
+namespace
+{
+    constexpr size_t SPRITE_COUNT = 1 << 20;
+
+    // A typical frame: a handful of layers, a few dozen textures, submitted in scene order
+    std::vector<jg::Sprite> MakeSprites()
+    {
+        std::vector<jg::Sprite> sprites(SPRITE_COUNT);
+        for (size_t i = 0; i < SPRITE_COUNT; ++i)
+        {
+            auto& s = sprites[i];
+            const auto f = static_cast<float>(i);
+            s.transform = jg::Mat3f::Rotation2D(0.001f * f) * jg::Mat3f::Scale2D(16.0f, 16.0f);
+            s.position = jg::Vec2f{ static_cast<float>(i % 1920), static_cast<float>(i % 1080) };
+            s.color = jg::Vec4f{ 1.0f, 0.5f, 0.25f, 1.0f };
+            s.texture = static_cast<jg::u32>((i * 2654435761u) >> 7) % 32;
+            s.layer = static_cast<jg::u32>(i % 4);
+        }
+        return sprites;
+    }
+}
+
+// Sort, batch and write 1M quads (80 MB of vertices) into a preallocated buffer
+static void BM_SpriteBatchBuild(benchmark::State& state)
+{
+    const auto sprites = MakeSprites();
+    std::vector<jg::SpriteVertex> vertices(SPRITE_COUNT * jg::SpriteBatcher::VERTICES_PER_SPRITE);
+    jg::SpriteBatcher batcher;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(batcher.Build(jg::Span<const jg::Sprite>{ sprites }, jg::Span<jg::SpriteVertex>{ vertices }).size());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<benchmark::IterationCount>(SPRITE_COUNT));
+    state.SetBytesProcessed(state.iterations() * static_cast<benchmark::IterationCount>(vertices.size() * sizeof(jg::SpriteVertex)));
+}
+BENCHMARK(BM_SpriteBatchBuild)->Unit(benchmark::kMillisecond);
+
+// The sort on its own, against std::stable_sort of the same keys
+static void BM_SpriteKeyRadixSort(benchmark::State& state)
+{
+    const auto sprites = MakeSprites();
+    std::vector<jg::u64> keys(SPRITE_COUNT), keyScratch(SPRITE_COUNT);
+    std::vector<jg::u32> order(SPRITE_COUNT), orderScratch(SPRITE_COUNT);
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < SPRITE_COUNT; ++i)
+        {
+            keys[i] = static_cast<jg::u64>(sprites[i].layer) << 32 | sprites[i].texture;
+            order[i] = static_cast<jg::u32>(i);
+        }
+        jg::RadixSort(jg::Span<jg::u64>{ keys }, jg::Span<jg::u32>{ order }, jg::Span<jg::u64>{ keyScratch }, jg::Span<jg::u32>{ orderScratch });
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<benchmark::IterationCount>(SPRITE_COUNT));
+}
+BENCHMARK(BM_SpriteKeyRadixSort)->Unit(benchmark::kMillisecond);
+
+static void BM_SpriteKeyStableSort(benchmark::State& state)
+{
+    const auto sprites = MakeSprites();
+    std::vector<jg::u32> order(SPRITE_COUNT);
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < SPRITE_COUNT; ++i)
+            order[i] = static_cast<jg::u32>(i);
+        std::stable_sort(order.begin(), order.end(), [&sprites](jg::u32 a, jg::u32 b) {
+            return sprites[a].layer != sprites[b].layer ? sprites[a].layer < sprites[b].layer : sprites[a].texture < sprites[b].texture;
+        });
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<benchmark::IterationCount>(SPRITE_COUNT));
+}
+BENCHMARK(BM_SpriteKeyStableSort)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,61 @@
+#include "benchmark/benchmark.h"
+
+#include <vector>
+
+#include "jangine.h"
+
+namespace
+{
+    constexpr size_t NODE_COUNT = 1 << 15;
+
+    // Wide, shallow scene: a few hundred roots, each with a few levels of children
+    std::vector<jg::TransformHierarchy::NodeId> BuildScene(jg::TransformHierarchy& h)
+    {
+        std::vector<jg::TransformHierarchy::NodeId> nodes;
+        for (size_t i = 0; i < NODE_COUNT; ++i)
+        {
+            const auto parent = i % 128 == 0 ? jg::TransformHierarchy::INVALID_NODE : nodes[i - 1 - (i * 2654435761u) % (i % 128)];
+            const auto node = h.Create(parent);
+            h.SetLocal(node, jg::Vec2f{ 1.0f, 0.5f }, 0.001f * static_cast<float>(i % 1000), jg::Vec2f{ 1.0f });
+            nodes.push_back(node);
+        }
+        h.Update();
+        return nodes;
+    }
+}
+
+static void BM_TransformHierarchyAllDirty(benchmark::State& state)
+{
+    jg::TransformHierarchy h;
+    const auto nodes = BuildScene(h);
+    for (auto _ : state)
+    {
+        for (const auto node : nodes)
+            h.SetRotation(node, 0.5f);
+        benchmark::DoNotOptimize(h.Update());
+    }
+    state.SetItemsProcessed(state.iterations() * NODE_COUNT);
+}
+BENCHMARK(BM_TransformHierarchyAllDirty)->Unit(benchmark::kMicrosecond);
+
+// Percent of nodes moved per frame
+static void BM_TransformHierarchyPartial(benchmark::State& state)
+{
+    jg::TransformHierarchy h;
+    const auto nodes = BuildScene(h);
+    const auto moved = NODE_COUNT * static_cast<size_t>(state.range(0)) / 100;
+    size_t cursor = 0;
+    size_t updated = 0;
+    for (auto _ : state)
+    {
+        for (size_t k = 0; k < moved; ++k)
+        {
+            cursor = (cursor + 7919) % NODE_COUNT;
+            h.SetRotation(nodes[cursor], 0.5f);
+        }
+        updated += h.Update();
+    }
+    state.SetItemsProcessed(state.iterations() * NODE_COUNT);
+    state.counters["updated_per_frame"] = static_cast<double>(updated) / static_cast<double>(state.iterations());
+}
+BENCHMARK(BM_TransformHierarchyPartial)->Arg(1)->Arg(5)->Arg(25)->Unit(benchmark::kMicrosecond);
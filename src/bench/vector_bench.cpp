@@ -0,0 +1,162 @@
+#include "bench_common.h"
+
+namespace
+{
+    constexpr auto BATCH_SIZE = 1 << 20;
+
+    std::vector<jg::Vec4f> MakeBatch(float seed)
+    {
+        std::vector<jg::Vec4f> batch(BATCH_SIZE);
+        for (auto i = 0; i < BATCH_SIZE; ++i)
+        {
+            const auto f = static_cast<float>(i % 1024) * 0.01f + seed;
+            batch[i] = jg::Vec4f{ f, f + 1.0f, f - 2.0f, 0.5f * f + 1.0f };
+        }
+        return batch;
+    }
+}
+
+template <size_t N>
+static void BM_VecAdd(benchmark::State& state)
+{
+    const auto a = bench::MakeVecs<N>(bench::BATCH, 1);
+    const auto b = bench::MakeVecs<N>(bench::BATCH, 2);
+    auto out = a;
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < bench::BATCH; ++i)
+            out[i] = a[i] + b[i];
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    bench::ReportPerOp(state);
+}
+BENCHMARK_TEMPLATE(BM_VecAdd, 2);
+BENCHMARK_TEMPLATE(BM_VecAdd, 3);
+BENCHMARK_TEMPLATE(BM_VecAdd, 4);
+BENCHMARK_TEMPLATE(BM_VecAdd, 8);
+
+template <size_t N>
+static void BM_VecDot(benchmark::State& state)
+{
+    const auto a = bench::MakeVecs<N>(bench::BATCH, 1);
+    const auto b = bench::MakeVecs<N>(bench::BATCH, 2);
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < bench::BATCH; ++i)
+        {
+            auto d = jg::Dot(a[i], b[i]);
+            benchmark::DoNotOptimize(d);
+        }
+    }
+    bench::ReportPerOp(state);
+}
+BENCHMARK_TEMPLATE(BM_VecDot, 2);
+BENCHMARK_TEMPLATE(BM_VecDot, 3);
+BENCHMARK_TEMPLATE(BM_VecDot, 4);
+BENCHMARK_TEMPLATE(BM_VecDot, 8);
+
+template <size_t N>
+static void BM_VecNormalize(benchmark::State& state)
+{
+    const auto a = bench::MakeVecs<N>(bench::BATCH, 1);
+    auto out = a;
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < bench::BATCH; ++i)
+            out[i] = jg::Normalize(a[i]);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    bench::ReportPerOp(state);
+}
+BENCHMARK_TEMPLATE(BM_VecNormalize, 2);
+BENCHMARK_TEMPLATE(BM_VecNormalize, 3);
+BENCHMARK_TEMPLATE(BM_VecNormalize, 4);
+BENCHMARK_TEMPLATE(BM_VecNormalize, 8);
+
+static void BM_Vec4fBatchAdd(benchmark::State& state)
+{
+    const auto a = MakeBatch(1.0f);
+    const auto b = MakeBatch(2.0f);
+    std::vector<jg::Vec4f> out(BATCH_SIZE);
+
+    for (auto _ : state)
+    {
+        for (auto i = 0; i < BATCH_SIZE; ++i)
+            out[i] = a[i] + b[i];
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    bench::ReportPerOp(state, BATCH_SIZE);
+}
+BENCHMARK(BM_Vec4fBatchAdd);
+
+static void BM_Vec4fBatchMulAdd(benchmark::State& state)
+{
+    const auto a = MakeBatch(1.0f);
+    const auto b = MakeBatch(2.0f);
+    std::vector<jg::Vec4f> out(BATCH_SIZE);
+
+    for (auto _ : state)
+    {
+        for (auto i = 0; i < BATCH_SIZE; ++i)
+            out[i] = a[i] * 0.5f + b[i] - a[i];
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    bench::ReportPerOp(state, BATCH_SIZE);
+}
+BENCHMARK(BM_Vec4fBatchMulAdd);
+
+static void BM_Vec4fBatchDot(benchmark::State& state)
+{
+    const auto a = MakeBatch(1.0f);
+    const auto b = MakeBatch(2.0f);
+
+    for (auto _ : state)
+    {
+        auto sum = 0.0f;
+        for (auto i = 0; i < BATCH_SIZE; ++i)
+            sum += jg::Dot(a[i], b[i]);
+        benchmark::DoNotOptimize(sum);
+    }
+    bench::ReportPerOp(state, BATCH_SIZE);
+}
+BENCHMARK(BM_Vec4fBatchDot);
+
+static void BM_Vec4fBatchNormalize(benchmark::State& state)
+{
+    const auto a = MakeBatch(1.0f);
+    std::vector<jg::Vec4f> out(BATCH_SIZE);
+
+    for (auto _ : state)
+    {
+        for (auto i = 0; i < BATCH_SIZE; ++i)
+            out[i] = jg::Normalize(a[i]);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    bench::ReportPerOp(state, BATCH_SIZE);
+}
+BENCHMARK(BM_Vec4fBatchNormalize);
+
+static void BM_Mat4fBatchTransform(benchmark::State& state)
+{
+    const auto a = MakeBatch(1.0f);
+    std::vector<jg::Vec4f> out(BATCH_SIZE);
+    const auto m = bench::MakeMats<4>(1)[0];
+
+    for (auto _ : state)
+    {
+        for (auto i = 0; i < BATCH_SIZE; ++i)
+            out[i] = m * a[i];
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    bench::ReportPerOp(state, BATCH_SIZE);
+}
+BENCHMARK(BM_Mat4fBatchTransform);
@@ -0,0 +1,168 @@
+#ifndef J_ARCHETYPE_H
+#define J_ARCHETYPE_H
+
+#include <array> // std::array
+#include <cassert> // assert
+#include <cstring> // std::memcpy
+#include <vector> // std::vector
+
+#include "jtypes.h"
+#include "jspan.h"
+#include "memory/jaligned_allocator.h"
+#include "jcomponent.h"
+
+namespace jg
+{
+    namespace ecs
+    {
+        // Slot in the world's entity table plus that slot's generation, so stale handles are detected
+        struct Entity
+        {
+            u32 index = 0;
+            u32 generation = 0; // Never issued, so Entity{} is null
+        };
+
+        inline bool operator==(Entity lhs, Entity rhs) { return lhs.index == rhs.index && lhs.generation == rhs.generation; }
+        inline bool operator!=(Entity lhs, Entity rhs) { return !(lhs == rhs); }
+
+        /*
+         * Every entity with exactly one set of components. Each component is a
+         * column: a COLUMN_ALIGNMENT aligned array with one element per row, in
+         * the order of Entities(). Rows stay packed; removing one moves the last
+         * row into the hole.
+         */
+        class Archetype
+        {
+        public:
+            static constexpr u32 NO_ARCHETYPE = ~0u;
+
+            explicit Archetype(ComponentMask mask) : m_mask{ mask }
+            {
+                m_columnOf.fill(NO_COLUMN);
+                m_addTarget.fill(NO_ARCHETYPE);
+                m_removeTarget.fill(NO_ARCHETYPE);
+                for (ComponentId id = 0; id < MAX_COMPONENTS; ++id)
+                {
+                    if (!Has(id))
+                        continue;
+                    m_columnOf[id] = static_cast<u8>(m_columns.size());
+                    m_columns.push_back(Column{ id, GetComponentInfo(id).size, {} });
+                }
+            }
+
+            ComponentMask Mask() const { return m_mask; }
+            bool Has(ComponentId id) const { return (m_mask >> id) & 1u; }
+
+            size_t size() const { return m_entities.size(); }
+            bool empty() const { return m_entities.empty(); }
+            Span<const Entity> Entities() const { return Span<const Entity>{ m_entities.data(), m_entities.size() }; }
+
+            // The whole column of C; the archetype must have C
+            template <typename C>
+            Span<ComponentValue<C>> Components()
+            {
+                return Span<ComponentValue<C>>{ static_cast<ComponentValue<C>*>(ColumnData(ComponentIdOf<C>())), size() };
+            }
+
+            template <typename C>
+            Span<const ComponentValue<C>> Components() const
+            {
+                return Span<const ComponentValue<C>>{ static_cast<const ComponentValue<C>*>(ColumnData(ComponentIdOf<C>())), size() };
+            }
+
+            void* ColumnData(ComponentId id)
+            {
+                assert(Has(id));
+                return m_columns[m_columnOf[id]].bytes.data();
+            }
+
+            const void* ColumnData(ComponentId id) const
+            {
+                assert(Has(id));
+                return m_columns[m_columnOf[id]].bytes.data();
+            }
+
+            void* At(ComponentId id, size_t row)
+            {
+                assert(row < size());
+                const auto& column = m_columns[m_columnOf[id]];
+                return static_cast<u8*>(ColumnData(id)) + row * column.elementSize;
+            }
+
+            // Appends a row for entity; its components are uninitialized until written
+            u32 PushBack(Entity entity)
+            {
+                if (m_entities.size() == m_capacity)
+                    Grow();
+                m_entities.push_back(entity);
+                return static_cast<u32>(m_entities.size() - 1);
+            }
+
+            // Moves the last row into row and drops the last; returns the entity now at row,
+            // or the null entity if row was the last one
+            Entity SwapRemove(size_t row)
+            {
+                assert(row < size());
+                const auto last = m_entities.size() - 1;
+                auto moved = Entity{};
+                if (row != last)
+                {
+                    for (auto& column : m_columns)
+                    {
+                        auto* data = column.bytes.data();
+                        std::memcpy(data + row * column.elementSize, data + last * column.elementSize, column.elementSize);
+                    }
+                    moved = m_entities[last];
+                    m_entities[row] = moved;
+                }
+                m_entities.pop_back();
+                return moved;
+            }
+
+            // Copies every component both archetypes have from row to toRow of to
+            void CopyRow(size_t row, Archetype& to, size_t toRow) const
+            {
+                for (const auto& column : m_columns)
+                {
+                    if (!to.Has(column.id))
+                        continue;
+                    std::memcpy(to.At(column.id, toRow), column.bytes.data() + row * column.elementSize, column.elementSize);
+                }
+            }
+
+            // Cached archetype of this one plus or minus a component, or NO_ARCHETYPE
+            u32 AddTarget(ComponentId id) const { return m_addTarget[id]; }
+            u32 RemoveTarget(ComponentId id) const { return m_removeTarget[id]; }
+            void SetAddTarget(ComponentId id, u32 archetype) { m_addTarget[id] = archetype; }
+            void SetRemoveTarget(ComponentId id, u32 archetype) { m_removeTarget[id] = archetype; }
+
+        private:
+            static constexpr u8 NO_COLUMN = 0xFF;
+
+            struct Column
+            {
+                ComponentId id;
+                u32 elementSize;
+                std::vector<u8, memory::AlignedAllocator<u8, COLUMN_ALIGNMENT>> bytes;
+            };
+
+            void Grow()
+            {
+                m_capacity = m_capacity == 0 ? 16 : m_capacity * 2;
+                for (auto& column : m_columns)
+                    column.bytes.resize(m_capacity * column.elementSize);
+                m_entities.reserve(m_capacity);
+            }
+
+            ComponentMask m_mask;
+            std::vector<Column> m_columns; // By ascending component id
+            std::vector<Entity> m_entities; // Row -> entity
+            size_t m_capacity = 0;
+            std::array<u8, MAX_COMPONENTS> m_columnOf; // Component id -> column, or NO_COLUMN
+            std::array<u32, MAX_COMPONENTS> m_addTarget;
+            std::array<u32, MAX_COMPONENTS> m_removeTarget;
+        };
+    }
+}
+
+#endif // J_ARCHETYPE_H
@@ -0,0 +1,108 @@
+#ifndef J_COMPONENT_H
+#define J_COMPONENT_H
+
+#include <atomic> // std::atomic
+#include <cassert> // assert
+#include <cstddef> // size_t
+#include <type_traits> // std::is_trivially_copyable_v, std::remove_cv_t
+
+#include "jtypes.h"
+#include "math/jvec.h"
+#include "math/jmatrix.h"
+
+namespace jg
+{
+    namespace ecs
+    {
+        using ComponentId = u32;
+        using ComponentMask = u64; // Bit i is set when component i is present
+
+        static constexpr ComponentId MAX_COMPONENTS = 64;
+        static constexpr size_t COLUMN_ALIGNMENT = 64;
+
+        /*
+         * A component type is its own identity. Plain value types such as Mat3f
+         * can be used directly; Component<Tag, T> names a further component with
+         * the same data, so Position and Velocity are both Vec2f columns and
+         * queries hand out plain Vec2f spans. The data must be trivially
+         * copyable, since rows move between archetypes as raw bytes.
+         */
+        template <typename Tag, typename T>
+        struct Component
+        {
+            using Value = T;
+        };
+
+        template <typename C>
+        struct ComponentTraits { using Value = C; };
+        template <typename Tag, typename T>
+        struct ComponentTraits<Component<Tag, T>> { using Value = T; };
+        template <typename C>
+        struct ComponentTraits<const C> { using Value = const typename ComponentTraits<C>::Value; };
+
+        // The stored type, const for const C
+        template <typename C>
+        using ComponentValue = typename ComponentTraits<C>::Value;
+
+        struct ComponentInfo
+        {
+            u32 size = 0;
+            u32 align = 0;
+        };
+
+        namespace detail
+        {
+            // Entry i is filled before id i is handed out
+            inline ComponentInfo* ComponentInfos()
+            {
+                static ComponentInfo infos[MAX_COMPONENTS];
+                return infos;
+            }
+
+            inline std::atomic<ComponentId>& ComponentCount()
+            {
+                static std::atomic<ComponentId> count{ 0 };
+                return count;
+            }
+
+            template <typename C>
+            ComponentId RegisterComponent()
+            {
+                using Value = ComponentValue<C>;
+                static_assert(std::is_trivially_copyable_v<Value>, "Components move between archetypes as raw bytes");
+                static_assert(alignof(Value) <= COLUMN_ALIGNMENT, "Columns are only aligned to COLUMN_ALIGNMENT");
+
+                const auto id = ComponentCount()++;
+                assert(id < MAX_COMPONENTS && "Too many component types for a 64-bit mask");
+                ComponentInfos()[id] = ComponentInfo{ static_cast<u32>(sizeof(Value)), static_cast<u32>(alignof(Value)) };
+                return id;
+            }
+
+            template <typename C>
+            ComponentId ComponentIdOf()
+            {
+                static const auto id = RegisterComponent<C>();
+                return id;
+            }
+        }
+
+        // Assigned on first use, so ids differ between runs but never within one
+        template <typename C>
+        ComponentId ComponentIdOf() { return detail::ComponentIdOf<std::remove_cv_t<C>>(); }
+
+        template <typename... Cs>
+        ComponentMask MaskOf() { return (ComponentMask{ 0 } | ... | (ComponentMask{ 1 } << ComponentIdOf<Cs>())); }
+
+        inline const ComponentInfo& GetComponentInfo(ComponentId id)
+        {
+            assert(id < detail::ComponentCount().load(std::memory_order_relaxed));
+            return detail::ComponentInfos()[id];
+        }
+
+        using Position = Component<struct PositionTag, Vec2f>;
+        using Velocity = Component<struct VelocityTag, Vec2f>;
+        using Transform = Component<struct TransformTag, Mat3f>;
+    }
+}
+
+#endif // J_COMPONENT_H
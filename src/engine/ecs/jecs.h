@@ -0,0 +1,8 @@
+#ifndef J_ECS_H
+#define J_ECS_H
+
+#include "jcomponent.h"
+#include "jarchetype.h"
+#include "jworld.h"
+
+#endif // J_ECS_H
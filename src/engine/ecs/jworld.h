@@ -0,0 +1,274 @@
+#ifndef J_WORLD_H
+#define J_WORLD_H
+
+#include <cassert> // assert
+#include <cstring> // std::memcpy
+#include <unordered_map> // std::unordered_map
+#include <vector> // std::vector
+
+#include "jtypes.h"
+#include "jspan.h"
+#include "jcomponent.h"
+#include "jarchetype.h"
+
+namespace jg
+{
+    namespace ecs
+    {
+        /*
+         * Entities and their components, grouped into archetypes by component
+         * set. Creating and destroying entities and adding or removing a
+         * component are O(1) in the number of entities: a row is appended or
+         * swap-removed, and the archetype an entity moves to is cached per
+         * component after the first move.
+         *
+         * Queries visit every archetype that has all the requested components,
+         * one contiguous column per component. Use ForEachChunk to hand whole
+         * columns to batch kernels. Structural changes (Create, Destroy, Add,
+         * Remove) invalidate spans and references and must not happen inside
+         * a query.
+         */
+        class World
+        {
+        public:
+            World()
+            {
+                m_archetypes.emplace_back(ComponentMask{ 0 });
+                m_archetypeOf.emplace(ComponentMask{ 0 }, 0u);
+            }
+
+            // world.Create<Position, Velocity>(Vec2f{ 0.0f }, Vec2f{ 1.0f, 0.0f })
+            template <typename... Cs>
+            Entity Create(const ComponentValue<Cs>&... values)
+            {
+                const auto mask = MaskOf<Cs...>();
+                assert(CountBits(mask) == sizeof...(Cs) && "Duplicate component in Create");
+                const auto archetype = FindOrCreateArchetype(mask);
+                const auto entity = AllocateEntity();
+                auto& arch = m_archetypes[archetype];
+                const auto row = arch.PushBack(entity);
+                (Write<Cs>(arch, row, values), ...);
+                m_records[entity.index].archetype = archetype;
+                m_records[entity.index].row = row;
+                return entity;
+            }
+
+            void Destroy(Entity entity)
+            {
+                assert(IsAlive(entity));
+                auto& record = m_records[entity.index];
+                RemoveRow(record.archetype, record.row);
+                record.archetype = Archetype::NO_ARCHETYPE;
+                // Generation 0 is the null entity, so skip it on wrap-around
+                record.generation = record.generation + 1 == 0 ? 1 : record.generation + 1;
+                m_freeList.push_back(entity.index);
+                --m_count;
+            }
+
+            bool IsAlive(Entity entity) const
+            {
+                return entity.index < m_records.size() && m_records[entity.index].generation == entity.generation
+                    && m_records[entity.index].archetype != Archetype::NO_ARCHETYPE;
+            }
+
+            // The entity must not have C yet
+            template <typename C>
+            void Add(Entity entity, const ComponentValue<C>& value)
+            {
+                assert(IsAlive(entity) && !Has<C>(entity));
+                const auto id = ComponentIdOf<C>();
+                const auto from = m_records[entity.index].archetype;
+                auto to = m_archetypes[from].AddTarget(id);
+                if (to == Archetype::NO_ARCHETYPE)
+                {
+                    to = FindOrCreateArchetype(m_archetypes[from].Mask() | (ComponentMask{ 1 } << id));
+                    m_archetypes[from].SetAddTarget(id, to);
+                    m_archetypes[to].SetRemoveTarget(id, from);
+                }
+                Move(entity, to);
+                const auto& record = m_records[entity.index];
+                Write<C>(m_archetypes[record.archetype], record.row, value);
+            }
+
+            template <typename C>
+            void Remove(Entity entity)
+            {
+                assert(IsAlive(entity) && Has<C>(entity));
+                const auto id = ComponentIdOf<C>();
+                const auto from = m_records[entity.index].archetype;
+                auto to = m_archetypes[from].RemoveTarget(id);
+                if (to == Archetype::NO_ARCHETYPE)
+                {
+                    to = FindOrCreateArchetype(m_archetypes[from].Mask() & ~(ComponentMask{ 1 } << id));
+                    m_archetypes[from].SetRemoveTarget(id, to);
+                    m_archetypes[to].SetAddTarget(id, from);
+                }
+                Move(entity, to);
+            }
+
+            template <typename C>
+            bool Has(Entity entity) const
+            {
+                assert(IsAlive(entity));
+                return m_archetypes[m_records[entity.index].archetype].Has(ComponentIdOf<C>());
+            }
+
+            // nullptr if the entity does not have C
+            template <typename C>
+            ComponentValue<C>* TryGet(Entity entity)
+            {
+                assert(IsAlive(entity));
+                const auto& record = m_records[entity.index];
+                auto& arch = m_archetypes[record.archetype];
+                const auto id = ComponentIdOf<C>();
+                return arch.Has(id) ? static_cast<ComponentValue<C>*>(arch.At(id, record.row)) : nullptr;
+            }
+
+            template <typename C>
+            const ComponentValue<C>* TryGet(Entity entity) const { return const_cast<World*>(this)->TryGet<const C>(entity); }
+
+            template <typename C>
+            ComponentValue<C>& Get(Entity entity)
+            {
+                auto* value = TryGet<C>(entity);
+                assert(value != nullptr);
+                return *value;
+            }
+
+            template <typename C>
+            const ComponentValue<C>& Get(Entity entity) const
+            {
+                const auto* value = TryGet<C>(entity);
+                assert(value != nullptr);
+                return *value;
+            }
+
+            /*
+             * Calls fn(Span<ComponentValue<Cs>>...) once per non-empty archetype
+             * that has every Cs, with the archetype's columns in row order. Ask
+             * for const components to make their spans const.
+             */
+            template <typename... Cs, typename F>
+            void ForEachChunk(F&& fn)
+            {
+                const auto mask = MaskOf<Cs...>();
+                for (auto& arch : m_archetypes)
+                {
+                    if ((arch.Mask() & mask) != mask || arch.empty())
+                        continue;
+                    fn(arch.template Components<Cs>()...);
+                }
+            }
+
+            // Calls fn(ComponentValue<Cs>&...) for every entity that has every Cs
+            template <typename... Cs, typename F>
+            void ForEach(F&& fn)
+            {
+                static_assert(sizeof...(Cs) > 0, "ForEach needs at least one component");
+                const auto mask = MaskOf<Cs...>();
+                for (auto& arch : m_archetypes)
+                {
+                    if ((arch.Mask() & mask) != mask)
+                        continue;
+                    ForEachRow(arch.size(), fn, arch.template Components<Cs>().data()...);
+                }
+            }
+
+            // Number of entities that have every Cs
+            template <typename... Cs>
+            size_t Count() const
+            {
+                const auto mask = MaskOf<Cs...>();
+                size_t count = 0;
+                for (const auto& arch : m_archetypes)
+                    count += (arch.Mask() & mask) == mask ? arch.size() : 0;
+                return count;
+            }
+
+            Span<const Archetype> Archetypes() const { return Span<const Archetype>{ m_archetypes.data(), m_archetypes.size() }; }
+
+            size_t size() const { return m_count; }
+            bool empty() const { return m_count == 0; }
+
+        private:
+            struct Record
+            {
+                u32 archetype = Archetype::NO_ARCHETYPE;
+                u32 row = 0;
+                u32 generation = 1;
+            };
+
+            static size_t CountBits(ComponentMask mask)
+            {
+                size_t count = 0;
+                for (; mask != 0; mask &= mask - 1)
+                    ++count;
+                return count;
+            }
+
+            template <typename F, typename... Ts>
+            static void ForEachRow(size_t count, F& fn, Ts*... columns)
+            {
+                for (size_t i = 0; i < count; ++i)
+                    fn(columns[i]...);
+            }
+
+            template <typename C>
+            static void Write(Archetype& arch, size_t row, const ComponentValue<C>& value)
+            {
+                std::memcpy(arch.At(ComponentIdOf<C>(), row), &value, sizeof(value));
+            }
+
+            u32 FindOrCreateArchetype(ComponentMask mask)
+            {
+                const auto it = m_archetypeOf.find(mask);
+                if (it != m_archetypeOf.end())
+                    return it->second;
+                const auto index = static_cast<u32>(m_archetypes.size());
+                m_archetypes.emplace_back(mask);
+                m_archetypeOf.emplace(mask, index);
+                return index;
+            }
+
+            Entity AllocateEntity()
+            {
+                ++m_count;
+                if (!m_freeList.empty())
+                {
+                    const auto index = m_freeList.back();
+                    m_freeList.pop_back();
+                    return Entity{ index, m_records[index].generation };
+                }
+                m_records.emplace_back();
+                return Entity{ static_cast<u32>(m_records.size() - 1), m_records.back().generation };
+            }
+
+            void RemoveRow(u32 archetype, u32 row)
+            {
+                const auto moved = m_archetypes[archetype].SwapRemove(row);
+                if (moved != Entity{})
+                    m_records[moved.index].row = row;
+            }
+
+            // Components not in the target archetype are dropped; new ones are left for the caller
+            void Move(Entity entity, u32 to)
+            {
+                auto& record = m_records[entity.index];
+                auto& target = m_archetypes[to];
+                const auto row = target.PushBack(entity);
+                m_archetypes[record.archetype].CopyRow(record.row, target, row);
+                RemoveRow(record.archetype, record.row);
+                record.archetype = to;
+                record.row = row;
+            }
+
+            std::vector<Archetype> m_archetypes; // Index 0 has no components
+            std::unordered_map<ComponentMask, u32> m_archetypeOf;
+            std::vector<Record> m_records; // By entity index
+            std::vector<u32> m_freeList;
+            size_t m_count = 0;
+        };
+    }
+}
+
+#endif // J_WORLD_H
@@ -0,0 +1,249 @@
+#ifndef J_AABB_H
+#define J_AABB_H
+
+#include <cassert> // assert
+#include <limits> // std::numeric_limits
+
+#include "jtypes.h"
+#include "jspan.h"
+#include "math/jsimd.h"
+#include "math/jcmath.h"
+#include "math/jvec.h"
+#include "math/jmatrix.h"
+
+namespace jg
+{
+    // Axis-aligned box; a box with min > max on any axis is empty. Bounds are inclusive
+    template <typename T, size_t N>
+    struct AABB
+    {
+        Vec<T, N> min;
+        Vec<T, N> max;
+
+        // Identity for Merge
+        static constexpr AABB Empty()
+        {
+            return AABB{ Vec<T, N>{ std::numeric_limits<T>::max() }, Vec<T, N>{ std::numeric_limits<T>::lowest() } };
+        }
+        static constexpr AABB FromCenterExtents(const Vec<T, N>& center, const Vec<T, N>& extents)
+        {
+            return AABB{ center - extents, center + extents };
+        }
+        static constexpr AABB FromPoints(Span<const Vec<T, N>> points)
+        {
+            auto ret = Empty();
+            for (const auto& p : points)
+                ret = AABB{ Min(ret.min, p), Max(ret.max, p) };
+            return ret;
+        }
+
+        explicit constexpr AABB() : min{ T{} }, max{ T{} } {}
+        explicit constexpr AABB(const Vec<T, N>& nmin, const Vec<T, N>& nmax) : min{ nmin }, max{ nmax } {}
+    };
+
+    template <typename T, size_t N>
+    constexpr bool IsEmpty(const AABB<T, N>& box)
+    {
+        for (size_t i = 0; i < N; ++i)
+        {
+            if (box.min[i] > box.max[i])
+                return true;
+        }
+        return false;
+    }
+
+    template <typename T, size_t N>
+    constexpr Vec<T, N> Center(const AABB<T, N>& box) { return (box.min + box.max) * static_cast<T>(0.5); }
+
+    // Half the size on each axis
+    template <typename T, size_t N>
+    constexpr Vec<T, N> Extents(const AABB<T, N>& box) { return (box.max - box.min) * static_cast<T>(0.5); }
+
+    template <typename T, size_t N>
+    constexpr Vec<T, N> Size(const AABB<T, N>& box) { return box.max - box.min; }
+
+    template <typename T, size_t N>
+    constexpr AABB<T, N> Merge(const AABB<T, N>& lhs, const AABB<T, N>& rhs)
+    {
+        return AABB<T, N>{ Min(lhs.min, rhs.min), Max(lhs.max, rhs.max) };
+    }
+
+    template <typename T, size_t N>
+    constexpr AABB<T, N> Merge(const AABB<T, N>& box, const Vec<T, N>& point)
+    {
+        return AABB<T, N>{ Min(box.min, point), Max(box.max, point) };
+    }
+
+    template <typename T, size_t N>
+    constexpr bool Contains(const AABB<T, N>& box, const Vec<T, N>& point)
+    {
+        for (size_t i = 0; i < N; ++i)
+        {
+            if (point[i] < box.min[i] || point[i] > box.max[i])
+                return false;
+        }
+        return true;
+    }
+
+    template <typename T, size_t N>
+    constexpr bool Contains(const AABB<T, N>& box, const AABB<T, N>& inner)
+    {
+        for (size_t i = 0; i < N; ++i)
+        {
+            if (inner.min[i] < box.min[i] || inner.max[i] > box.max[i])
+                return false;
+        }
+        return true;
+    }
+
+    // Touching boxes intersect
+    template <typename T, size_t N>
+    constexpr bool Intersects(const AABB<T, N>& lhs, const AABB<T, N>& rhs)
+    {
+        for (size_t i = 0; i < N; ++i)
+        {
+            if (lhs.min[i] > rhs.max[i] || rhs.min[i] > lhs.max[i])
+                return false;
+        }
+        return true;
+    }
+
+    // Overlapping region; empty if the boxes do not intersect
+    template <typename T, size_t N>
+    constexpr AABB<T, N> Intersection(const AABB<T, N>& lhs, const AABB<T, N>& rhs)
+    {
+        return AABB<T, N>{ Max(lhs.min, rhs.min), Min(lhs.max, rhs.max) };
+    }
+
+    /*
+     * Tightest box around the transformed box (Arvo's method): the center is
+     * transformed as a point, the extents by the absolute linear part, so
+     * rotations grow the box only as much as the rotated corners need.
+     * The matrix is a 2D affine transform (bottom row 0, 0, 1). An empty box
+     * stays empty: its infinite extents would otherwise turn into NaN.
+     */
+    template <typename T>
+    constexpr AABB<T, 2> Transform(const Mat<T, 3, 3>& mat, const AABB<T, 2>& box)
+    {
+        if (IsEmpty(box))
+            return AABB<T, 2>::Empty();
+        const auto c = Center(box);
+        const auto e = Extents(box);
+        const Vec<T, 2> center{
+            mat.m00 * c.x + mat.m01 * c.y + mat.m02,
+            mat.m10 * c.x + mat.m11 * c.y + mat.m12
+        };
+        const Vec<T, 2> extents{
+            Abs(mat.m00) * e.x + Abs(mat.m01) * e.y,
+            Abs(mat.m10) * e.x + Abs(mat.m11) * e.y
+        };
+        return AABB<T, 2>::FromCenterExtents(center, extents);
+    }
+
+    // 3D version for affine Mat4 transforms (bottom row 0, 0, 0, 1)
+    template <typename T>
+    constexpr AABB<T, 3> Transform(const Mat<T, 4, 4>& mat, const AABB<T, 3>& box)
+    {
+        if (IsEmpty(box))
+            return AABB<T, 3>::Empty();
+        const auto c = Center(box);
+        const auto e = Extents(box);
+        const Vec<T, 3> center{
+            mat.m00 * c.x + mat.m01 * c.y + mat.m02 * c.z + mat.m03,
+            mat.m10 * c.x + mat.m11 * c.y + mat.m12 * c.z + mat.m13,
+            mat.m20 * c.x + mat.m21 * c.y + mat.m22 * c.z + mat.m23
+        };
+        const Vec<T, 3> extents{
+            Abs(mat.m00) * e.x + Abs(mat.m01) * e.y + Abs(mat.m02) * e.z,
+            Abs(mat.m10) * e.x + Abs(mat.m11) * e.y + Abs(mat.m12) * e.z,
+            Abs(mat.m20) * e.x + Abs(mat.m21) * e.y + Abs(mat.m22) * e.z
+        };
+        return AABB<T, 3>::FromCenterExtents(center, extents);
+    }
+
+    using AABB2f = AABB<f32, 2>;
+    using AABB3f = AABB<f32, 3>;
+
+    namespace detail
+    {
+        // Set bits in the low 4 bits of a movemask, via a nibble table rather than POPCNT
+        inline size_t PopCount4(u64 bits) { return (0x4332322132212110ull >> (bits * 4)) & 0xF; }
+    }
+
+    // Structure-of-arrays view over many 2D boxes, for the batch kernels
+    struct AABB2fSoA
+    {
+        Span<const f32> minX, minY, maxX, maxY;
+
+        size_t size() const { return minX.size(); }
+    };
+
+    /*
+     * Sets bit i of outMask (bit i % 64 of word i / 64) when boxes[i]
+     * intersects query, and returns the number of hits. outMask needs
+     * (boxes.size() + 63) / 64 words; bits past boxes.size() are cleared.
+     * Tests 8 boxes per step with AVX and 4 with SSE.
+     */
+    inline size_t OverlapMask(const AABB2f& query, const AABB2fSoA& boxes, Span<u64> outMask)
+    {
+        const auto count = boxes.size();
+        assert(boxes.minY.size() == count && boxes.maxX.size() == count && boxes.maxY.size() == count);
+        assert(outMask.size() >= (count + 63) / 64);
+
+        for (size_t w = 0; w < (count + 63) / 64; ++w)
+            outMask[w] = 0;
+
+        size_t i = 0;
+        size_t hits = 0;
+
+        // Overlap on every axis: box.min <= query.max && box.max >= query.min
+#if defined(JG_SIMD_AVX)
+        {
+            const auto qMinX = _mm256_set1_ps(query.min.x), qMinY = _mm256_set1_ps(query.min.y);
+            const auto qMaxX = _mm256_set1_ps(query.max.x), qMaxY = _mm256_set1_ps(query.max.y);
+            for (; i + 8 <= count; i += 8)
+            {
+                const auto x = _mm256_and_ps(
+                    _mm256_cmp_ps(_mm256_loadu_ps(boxes.minX.data() + i), qMaxX, _CMP_LE_OQ),
+                    _mm256_cmp_ps(_mm256_loadu_ps(boxes.maxX.data() + i), qMinX, _CMP_GE_OQ));
+                const auto y = _mm256_and_ps(
+                    _mm256_cmp_ps(_mm256_loadu_ps(boxes.minY.data() + i), qMaxY, _CMP_LE_OQ),
+                    _mm256_cmp_ps(_mm256_loadu_ps(boxes.maxY.data() + i), qMinY, _CMP_GE_OQ));
+                const auto bits = static_cast<u64>(_mm256_movemask_ps(_mm256_and_ps(x, y)));
+                outMask[i / 64] |= bits << (i % 64);
+                hits += detail::PopCount4(bits & 0xF) + detail::PopCount4(bits >> 4);
+            }
+        }
+#endif
+
+#if defined(JG_SIMD_SSE)
+        {
+            const auto qMinX = _mm_set1_ps(query.min.x), qMinY = _mm_set1_ps(query.min.y);
+            const auto qMaxX = _mm_set1_ps(query.max.x), qMaxY = _mm_set1_ps(query.max.y);
+            for (; i + 4 <= count; i += 4)
+            {
+                const auto x = _mm_and_ps(
+                    _mm_cmple_ps(_mm_loadu_ps(boxes.minX.data() + i), qMaxX),
+                    _mm_cmpge_ps(_mm_loadu_ps(boxes.maxX.data() + i), qMinX));
+                const auto y = _mm_and_ps(
+                    _mm_cmple_ps(_mm_loadu_ps(boxes.minY.data() + i), qMaxY),
+                    _mm_cmpge_ps(_mm_loadu_ps(boxes.maxY.data() + i), qMinY));
+                const auto bits = static_cast<u64>(_mm_movemask_ps(_mm_and_ps(x, y)));
+                outMask[i / 64] |= bits << (i % 64);
+                hits += detail::PopCount4(bits);
+            }
+        }
+#endif
+
+        for (; i < count; ++i)
+        {
+            const auto overlap = boxes.minX[i] <= query.max.x && boxes.maxX[i] >= query.min.x
+                              && boxes.minY[i] <= query.max.y && boxes.maxY[i] >= query.min.y;
+            outMask[i / 64] |= static_cast<u64>(overlap) << (i % 64);
+            hits += overlap;
+        }
+        return hits;
+    }
+}
+
+#endif // J_AABB_H
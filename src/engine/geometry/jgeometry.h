@@ -0,0 +1,9 @@
+#ifndef J_GEOMETRY_H
+#define J_GEOMETRY_H
+
+#include "jaabb.h"
+#include "jray.h"
+#include "jray_packet.h"
+#include "jspatial_hash.h"
+
+#endif // J_GEOMETRY_H
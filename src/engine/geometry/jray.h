@@ -0,0 +1,162 @@
+#ifndef J_RAY_H
+#define J_RAY_H
+
+#include "jtypes.h"
+#include "jspan.h"
+#include "math/jvec.h"
+#include "math/jcmath.h"
+#include "jaabb.h"
+
+namespace jg
+{
+    // Half-line origin + t * direction for t >= 0. direction need not be normalized; t is in its units
+    template <typename T, size_t N>
+    struct Ray
+    {
+        Vec<T, N> origin;
+        Vec<T, N> direction;
+
+        explicit constexpr Ray() : origin{ T{} }, direction{ T{} } {}
+        explicit constexpr Ray(const Vec<T, N>& o, const Vec<T, N>& d) : origin{ o }, direction{ d } {}
+    };
+
+    template <typename T, size_t N>
+    constexpr Vec<T, N> PointAt(const Ray<T, N>& ray, const T& t) { return ray.origin + ray.direction * t; }
+
+    namespace detail
+    {
+        // Slab test with a precomputed 1 / direction, so callers testing many boxes divide once
+        template <typename T, size_t N>
+        constexpr bool IntersectSlabs(const Vec<T, N>& origin, const Vec<T, N>& direction, const Vec<T, N>& invDir,
+                                      const AABB<T, N>& box, T maxT, T& outT)
+        {
+            auto tMin = T{};
+            auto tMax = maxT;
+            for (size_t i = 0; i < N; ++i)
+            {
+                // Parallel to this slab: inside it or a miss
+                if (direction[i] == T{})
+                {
+                    if (origin[i] < box.min[i] || origin[i] > box.max[i])
+                        return false;
+                    continue;
+                }
+                auto t0 = (box.min[i] - origin[i]) * invDir[i];
+                auto t1 = (box.max[i] - origin[i]) * invDir[i];
+                if (t0 > t1)
+                {
+                    const auto tmp = t0;
+                    t0 = t1;
+                    t1 = tmp;
+                }
+                tMin = t0 > tMin ? t0 : tMin;
+                tMax = t1 < tMax ? t1 : tMax;
+                if (tMin > tMax)
+                    return false;
+            }
+            outT = tMin;
+            return true;
+        }
+    }
+
+    /*
+     * First point of box hit by ray within [0, maxT]. On a hit stores its t in
+     * outT (0 when the origin is inside the box) and returns true.
+     */
+    template <typename T, size_t N>
+    constexpr bool Intersect(const Ray<T, N>& ray, const AABB<T, N>& box, T maxT, T& outT)
+    {
+        auto invDir = ray.direction;
+        for (size_t i = 0; i < N; ++i)
+            invDir[i] = ray.direction[i] == T{} ? T{} : static_cast<T>(1) / ray.direction[i];
+        return detail::IntersectSlabs(ray.origin, ray.direction, invDir, box, maxT, outT);
+    }
+
+    /*
+     * First point of the circle hit by ray within [0, maxT], 0 when the
+     * origin is inside. A circle of radius r moving along the ray first
+     * touches another circle where the ray hits one of the summed radius.
+     */
+    template <typename T>
+    constexpr bool IntersectCircle(const Ray<T, 2>& ray, const Vec<T, 2>& center, T radius, T maxT, T& outT)
+    {
+        // |m + t * d|^2 = r^2 with m = origin - center: a * t^2 + 2 * b * t + c = 0
+        const auto m = ray.origin - center;
+        const auto a = Dot(ray.direction, ray.direction);
+        const auto b = Dot(m, ray.direction);
+        const auto c = Dot(m, m) - radius * radius;
+        if (c <= T{})
+        {
+            outT = T{};
+            return maxT >= T{};
+        }
+        const auto disc = b * b - a * c;
+        if (b >= T{} || disc < T{})
+            return false;
+        const auto t = (-b - Sqrt(disc)) / a;
+        if (t > maxT)
+            return false;
+        outT = t;
+        return true;
+    }
+
+    // Crossing of ray and segment [a, b] within [0, maxT]. A ray parallel to the segment misses it, even when collinear
+    template <typename T>
+    constexpr bool IntersectSegment(const Ray<T, 2>& ray, const Vec<T, 2>& a, const Vec<T, 2>& b, T maxT, T& outT)
+    {
+        const auto e = b - a;
+        const auto denom = Cross(ray.direction, e);
+        if (denom == T{})
+            return false;
+        const auto m = a - ray.origin;
+        const auto t = Cross(m, e) / denom;
+        const auto u = Cross(m, ray.direction) / denom;
+        if (t < T{} || t > maxT || u < T{} || u > static_cast<T>(1))
+            return false;
+        outT = t;
+        return true;
+    }
+
+    /*
+     * First point of a convex polygon, vertices counter-clockwise, hit by
+     * ray within [0, maxT]; 0 when the origin is inside. Clips the ray
+     * against each edge's half-plane in turn (Cyrus-Beck).
+     */
+    template <typename T>
+    constexpr bool IntersectConvexPolygon(const Ray<T, 2>& ray, Span<const Vec<T, 2>> vertices, T maxT, T& outT)
+    {
+        if (maxT < T{})
+            return false;
+        auto tEnter = T{};
+        auto tExit = maxT;
+        for (size_t i = 0; i < vertices.size(); ++i)
+        {
+            const auto& v = vertices[i];
+            const auto& next = vertices[i + 1 < vertices.size() ? i + 1 : 0];
+            // Outward normal, unnormalized: t comes out the same
+            const auto n = Vec<T, 2>{ next.y - v.y, v.x - next.x };
+            const auto num = Dot(n, v - ray.origin);
+            const auto den = Dot(n, ray.direction);
+            if (den == T{})
+            {
+                if (num < T{})
+                    return false;
+                continue;
+            }
+            const auto t = num / den;
+            if (den < T{})
+                tEnter = t > tEnter ? t : tEnter;
+            else
+                tExit = t < tExit ? t : tExit;
+            if (tEnter > tExit)
+                return false;
+        }
+        outT = tEnter;
+        return true;
+    }
+
+    using Ray2f = Ray<f32, 2>;
+    using Ray3f = Ray<f32, 3>;
+}
+
+#endif // J_RAY_H
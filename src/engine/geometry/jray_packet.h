@@ -0,0 +1,342 @@
+#ifndef J_RAY_PACKET_H
+#define J_RAY_PACKET_H
+
+#include <array> // std::array
+#include <cassert> // assert
+#include <cmath> // std::sqrt
+#include <limits> // std::numeric_limits
+
+#include "jtypes.h"
+#include "jspan.h"
+#include "math/jsimd.h"
+#include "math/jvec.h"
+#include "jaabb.h"
+#include "jray.h"
+
+namespace jg
+{
+    /*
+     * W 2D rays in structure-of-arrays form, traced together: one SSE
+     * register per coordinate for 4 rays, one AVX register (or two SSE) for
+     * 8. With JG_NO_SIMD the same kernels run on plain arrays.
+     *
+     * A lane is live while its maxT is >= 0. The Intersect functions return
+     * a bit per live lane that hits, so tracing many shapes can stop as soon
+     * as every lane is done: for line of sight, clear the hits from a local
+     * mask of unblocked lanes (cheaper than Deactivate, which writes maxT);
+     * for closest hits, ClipTo the hits so later shapes must beat them.
+     */
+    template <size_t W>
+    struct RayPacket
+    {
+        static_assert(W == 4 || W == 8, "packets are 4 or 8 rays wide");
+        static constexpr u32 ALL_LANES = (1u << W) - 1;
+
+        alignas(32) std::array<f32, W> originX{};
+        alignas(32) std::array<f32, W> originY{};
+        alignas(32) std::array<f32, W> directionX{};
+        alignas(32) std::array<f32, W> directionY{};
+        alignas(32) std::array<f32, W> invDirectionX{}; // 0 where the direction is 0, as in Intersect(Ray, AABB)
+        alignas(32) std::array<f32, W> invDirectionY{};
+        alignas(32) std::array<f32, W> maxT; // Negative for lanes that are done
+
+        RayPacket() { maxT.fill(-1.0f); }
+
+        void Set(size_t lane, const Ray2f& ray, f32 laneMaxT)
+        {
+            assert(lane < W);
+            originX[lane] = ray.origin.x;
+            originY[lane] = ray.origin.y;
+            directionX[lane] = ray.direction.x;
+            directionY[lane] = ray.direction.y;
+            invDirectionX[lane] = ray.direction.x == 0.0f ? 0.0f : 1.0f / ray.direction.x;
+            invDirectionY[lane] = ray.direction.y == 0.0f ? 0.0f : 1.0f / ray.direction.y;
+            maxT[lane] = laneMaxT;
+        }
+
+        Ray2f Get(size_t lane) const
+        {
+            assert(lane < W);
+            return Ray2f{ Vec2f{ originX[lane], originY[lane] }, Vec2f{ directionX[lane], directionY[lane] } };
+        }
+
+        u32 ActiveMask() const
+        {
+            u32 mask = 0;
+            for (size_t i = 0; i < W; ++i)
+                mask |= static_cast<u32>(maxT[i] >= 0.0f) << i;
+            return mask;
+        }
+
+        void Deactivate(u32 lanes)
+        {
+            for (size_t i = 0; i < W; ++i)
+                maxT[i] = (lanes >> i) & 1 ? -1.0f : maxT[i];
+        }
+
+        // Shortens the hit lanes to their hit, so only closer hits count from now on
+        void ClipTo(u32 hits, const std::array<f32, W>& t)
+        {
+            for (size_t i = 0; i < W; ++i)
+                maxT[i] = (hits >> i) & 1 ? t[i] : maxT[i];
+        }
+    };
+
+    using RayPacket4 = RayPacket<4>;
+    using RayPacket8 = RayPacket<8>;
+
+    namespace detail
+    {
+        /*
+         * The operations the packet kernels use, on W lanes. V holds W f32
+         * and M a per-lane mask. The primary template loops over plain arrays
+         * with one u32 per lane, which compilers vectorize; SSE and AVX
+         * targets use registers instead.
+         */
+        template <size_t W>
+        struct PacketLanes
+        {
+            using V = std::array<f32, W>;
+            using M = std::array<u32, W>;
+
+            static V Load(const f32* p) { V v; for (size_t i = 0; i < W; ++i) v[i] = p[i]; return v; }
+            static void Store(f32* p, const V& v) { for (size_t i = 0; i < W; ++i) p[i] = v[i]; }
+            static V Set(f32 x) { V v; v.fill(x); return v; }
+            static V Add(const V& a, const V& b) { V v; for (size_t i = 0; i < W; ++i) v[i] = a[i] + b[i]; return v; }
+            static V Sub(const V& a, const V& b) { V v; for (size_t i = 0; i < W; ++i) v[i] = a[i] - b[i]; return v; }
+            static V Mul(const V& a, const V& b) { V v; for (size_t i = 0; i < W; ++i) v[i] = a[i] * b[i]; return v; }
+            static V Div(const V& a, const V& b) { V v; for (size_t i = 0; i < W; ++i) v[i] = a[i] / b[i]; return v; }
+            static V Min(const V& a, const V& b) { V v; for (size_t i = 0; i < W; ++i) v[i] = a[i] < b[i] ? a[i] : b[i]; return v; }
+            static V Max(const V& a, const V& b) { V v; for (size_t i = 0; i < W; ++i) v[i] = a[i] > b[i] ? a[i] : b[i]; return v; }
+            static V Sqrt(const V& a) { V v; for (size_t i = 0; i < W; ++i) v[i] = std::sqrt(a[i]); return v; }
+            static M Le(const V& a, const V& b) { M m; for (size_t i = 0; i < W; ++i) m[i] = a[i] <= b[i]; return m; }
+            static M Lt(const V& a, const V& b) { M m; for (size_t i = 0; i < W; ++i) m[i] = a[i] < b[i]; return m; }
+            static M Eq(const V& a, const V& b) { M m; for (size_t i = 0; i < W; ++i) m[i] = a[i] == b[i]; return m; }
+            static M And(const M& a, const M& b) { M m; for (size_t i = 0; i < W; ++i) m[i] = a[i] & b[i]; return m; }
+            static M Or(const M& a, const M& b) { M m; for (size_t i = 0; i < W; ++i) m[i] = a[i] | b[i]; return m; }
+            static M AndNot(const M& a, const M& b) { M m; for (size_t i = 0; i < W; ++i) m[i] = a[i] & ~b[i]; return m; }
+            static V Select(const M& m, const V& a, const V& b) { V v; for (size_t i = 0; i < W; ++i) v[i] = m[i] ? a[i] : b[i]; return v; }
+            static u32 Bits(const M& m) { u32 bits = 0; for (size_t i = 0; i < W; ++i) bits |= m[i] << i; return bits; }
+        };
+
+#if defined(JG_SIMD_SSE)
+        template <>
+        struct PacketLanes<4>
+        {
+            using V = __m128;
+            using M = __m128;
+
+            static V Load(const f32* p) { return _mm_load_ps(p); }
+            static void Store(f32* p, V v) { _mm_store_ps(p, v); }
+            static V Set(f32 x) { return _mm_set1_ps(x); }
+            static V Add(V a, V b) { return _mm_add_ps(a, b); }
+            static V Sub(V a, V b) { return _mm_sub_ps(a, b); }
+            static V Mul(V a, V b) { return _mm_mul_ps(a, b); }
+            static V Div(V a, V b) { return _mm_div_ps(a, b); }
+            static V Min(V a, V b) { return _mm_min_ps(a, b); }
+            static V Max(V a, V b) { return _mm_max_ps(a, b); }
+            static V Sqrt(V a) { return _mm_sqrt_ps(a); }
+            static M Le(V a, V b) { return _mm_cmple_ps(a, b); }
+            static M Lt(V a, V b) { return _mm_cmplt_ps(a, b); }
+            static M Eq(V a, V b) { return _mm_cmpeq_ps(a, b); }
+            static M And(M a, M b) { return _mm_and_ps(a, b); }
+            static M Or(M a, M b) { return _mm_or_ps(a, b); }
+            static M AndNot(M a, M b) { return _mm_andnot_ps(b, a); }
+            static V Select(M m, V a, V b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+            static u32 Bits(M m) { return static_cast<u32>(_mm_movemask_ps(m)); }
+        };
+#endif
+
+#if defined(JG_SIMD_AVX)
+        template <>
+        struct PacketLanes<8>
+        {
+            using V = __m256;
+            using M = __m256;
+
+            static V Load(const f32* p) { return _mm256_load_ps(p); }
+            static void Store(f32* p, V v) { _mm256_store_ps(p, v); }
+            static V Set(f32 x) { return _mm256_set1_ps(x); }
+            static V Add(V a, V b) { return _mm256_add_ps(a, b); }
+            static V Sub(V a, V b) { return _mm256_sub_ps(a, b); }
+            static V Mul(V a, V b) { return _mm256_mul_ps(a, b); }
+            static V Div(V a, V b) { return _mm256_div_ps(a, b); }
+            static V Min(V a, V b) { return _mm256_min_ps(a, b); }
+            static V Max(V a, V b) { return _mm256_max_ps(a, b); }
+            static V Sqrt(V a) { return _mm256_sqrt_ps(a); }
+            static M Le(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+            static M Lt(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+            static M Eq(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+            static M And(M a, M b) { return _mm256_and_ps(a, b); }
+            static M Or(M a, M b) { return _mm256_or_ps(a, b); }
+            static M AndNot(M a, M b) { return _mm256_andnot_ps(b, a); }
+            static V Select(M m, V a, V b) { return _mm256_blendv_ps(b, a, m); }
+            static u32 Bits(M m) { return static_cast<u32>(_mm256_movemask_ps(m)); }
+        };
+#elif defined(JG_SIMD_SSE)
+        // Without AVX, 8 lanes are two SSE registers
+        template <>
+        struct PacketLanes<8>
+        {
+            struct V { __m128 lo, hi; };
+            using M = V;
+            using L = PacketLanes<4>;
+
+            static V Load(const f32* p) { return V{ L::Load(p), L::Load(p + 4) }; }
+            static void Store(f32* p, V v) { L::Store(p, v.lo); L::Store(p + 4, v.hi); }
+            static V Set(f32 x) { return V{ L::Set(x), L::Set(x) }; }
+            static V Add(V a, V b) { return V{ L::Add(a.lo, b.lo), L::Add(a.hi, b.hi) }; }
+            static V Sub(V a, V b) { return V{ L::Sub(a.lo, b.lo), L::Sub(a.hi, b.hi) }; }
+            static V Mul(V a, V b) { return V{ L::Mul(a.lo, b.lo), L::Mul(a.hi, b.hi) }; }
+            static V Div(V a, V b) { return V{ L::Div(a.lo, b.lo), L::Div(a.hi, b.hi) }; }
+            static V Min(V a, V b) { return V{ L::Min(a.lo, b.lo), L::Min(a.hi, b.hi) }; }
+            static V Max(V a, V b) { return V{ L::Max(a.lo, b.lo), L::Max(a.hi, b.hi) }; }
+            static V Sqrt(V a) { return V{ L::Sqrt(a.lo), L::Sqrt(a.hi) }; }
+            static M Le(V a, V b) { return M{ L::Le(a.lo, b.lo), L::Le(a.hi, b.hi) }; }
+            static M Lt(V a, V b) { return M{ L::Lt(a.lo, b.lo), L::Lt(a.hi, b.hi) }; }
+            static M Eq(V a, V b) { return M{ L::Eq(a.lo, b.lo), L::Eq(a.hi, b.hi) }; }
+            static M And(M a, M b) { return M{ L::And(a.lo, b.lo), L::And(a.hi, b.hi) }; }
+            static M Or(M a, M b) { return M{ L::Or(a.lo, b.lo), L::Or(a.hi, b.hi) }; }
+            static M AndNot(M a, M b) { return M{ L::AndNot(a.lo, b.lo), L::AndNot(a.hi, b.hi) }; }
+            static V Select(M m, V a, V b) { return V{ L::Select(m.lo, a.lo, b.lo), L::Select(m.hi, a.hi, b.hi) }; }
+            static u32 Bits(M m) { return L::Bits(m.lo) | (L::Bits(m.hi) << 4); }
+        };
+#endif
+    }
+
+    /*
+     * The packet forms of the Intersect functions in jray.h: lane i of the
+     * result is set when ray i is live and hits, and outT[i] is then its t.
+     * The other lanes of outT are left unspecified. Each lane makes the same
+     * decisions as the scalar function on that ray.
+     */
+    template <size_t W>
+    u32 Intersect(const RayPacket<W>& rays, const AABB2f& box, std::array<f32, W>& outT)
+    {
+        using L = detail::PacketLanes<W>;
+        constexpr auto INF = std::numeric_limits<f32>::infinity();
+        const auto zero = L::Set(0.0f);
+        const auto maxT = L::Load(rays.maxT.data());
+
+        // Per axis: the slab's t range, unbounded where the ray runs parallel to it and starts inside
+        const auto slab = [&](const f32* origin, const f32* direction, const f32* invDirection, f32 lo, f32 hi,
+                              typename L::V& tLo, typename L::V& tHi) {
+            const auto o = L::Load(origin);
+            const auto inv = L::Load(invDirection);
+            const auto t0 = L::Mul(L::Sub(L::Set(lo), o), inv);
+            const auto t1 = L::Mul(L::Sub(L::Set(hi), o), inv);
+            const auto parallel = L::Eq(L::Load(direction), zero);
+            tLo = L::Select(parallel, L::Set(-INF), L::Min(t0, t1));
+            tHi = L::Select(parallel, L::Set(INF), L::Max(t0, t1));
+            const auto inside = L::And(L::Le(L::Set(lo), o), L::Le(o, L::Set(hi)));
+            return L::Or(L::AndNot(L::Eq(zero, zero), parallel), inside);
+        };
+        typename L::V loX, hiX, loY, hiY;
+        const auto okX = slab(rays.originX.data(), rays.directionX.data(), rays.invDirectionX.data(), box.min.x, box.max.x, loX, hiX);
+        const auto okY = slab(rays.originY.data(), rays.directionY.data(), rays.invDirectionY.data(), box.min.y, box.max.y, loY, hiY);
+
+        const auto tNear = L::Max(L::Max(zero, loX), loY);
+        const auto tFar = L::Min(L::Min(maxT, hiX), hiY);
+        L::Store(outT.data(), tNear);
+        return L::Bits(L::And(L::And(okX, okY), L::Le(tNear, tFar)));
+    }
+
+    template <size_t W>
+    u32 IntersectCircle(const RayPacket<W>& rays, const Vec2f& center, f32 radius, std::array<f32, W>& outT)
+    {
+        using L = detail::PacketLanes<W>;
+        const auto zero = L::Set(0.0f);
+        const auto maxT = L::Load(rays.maxT.data());
+        const auto dx = L::Load(rays.directionX.data());
+        const auto dy = L::Load(rays.directionY.data());
+        const auto mx = L::Sub(L::Load(rays.originX.data()), L::Set(center.x));
+        const auto my = L::Sub(L::Load(rays.originY.data()), L::Set(center.y));
+
+        const auto a = L::Add(L::Mul(dx, dx), L::Mul(dy, dy));
+        const auto b = L::Add(L::Mul(mx, dx), L::Mul(my, dy));
+        const auto c = L::Sub(L::Add(L::Mul(mx, mx), L::Mul(my, my)), L::Set(radius * radius));
+        const auto disc = L::Sub(L::Mul(b, b), L::Mul(a, c));
+
+        // Outside lanes need to be heading in and not pass wide; a is then > 0
+        const auto inside = L::Le(c, zero);
+        const auto approaching = L::And(L::Lt(b, zero), L::Le(zero, disc));
+        const auto safeA = L::Select(approaching, a, L::Set(1.0f));
+        const auto t = L::Div(L::Sub(L::Sub(zero, b), L::Sqrt(L::Max(disc, zero))), safeA);
+        const auto tHit = L::Select(inside, zero, t);
+        L::Store(outT.data(), tHit);
+        const auto hit = L::And(L::Or(inside, approaching), L::Le(tHit, maxT));
+        return L::Bits(L::And(hit, L::Le(zero, maxT)));
+    }
+
+    template <size_t W>
+    u32 IntersectSegment(const RayPacket<W>& rays, const Vec2f& a, const Vec2f& b, std::array<f32, W>& outT)
+    {
+        using L = detail::PacketLanes<W>;
+        const auto zero = L::Set(0.0f);
+        const auto dx = L::Load(rays.directionX.data());
+        const auto dy = L::Load(rays.directionY.data());
+        const auto ex = L::Set(b.x - a.x);
+        const auto ey = L::Set(b.y - a.y);
+        const auto mx = L::Sub(L::Set(a.x), L::Load(rays.originX.data()));
+        const auto my = L::Sub(L::Set(a.y), L::Load(rays.originY.data()));
+
+        const auto denom = L::Sub(L::Mul(dx, ey), L::Mul(dy, ex));
+        const auto parallel = L::Eq(denom, zero);
+        const auto safeDenom = L::Select(parallel, L::Set(1.0f), denom);
+        const auto t = L::Div(L::Sub(L::Mul(mx, ey), L::Mul(my, ex)), safeDenom);
+        L::Store(outT.data(), t);
+
+        // 0 <= u <= 1 without a second divide: compare u's numerator with the denominator, both made positive
+        const auto flip = L::Lt(denom, zero);
+        const auto uNum = L::Sub(L::Mul(mx, dy), L::Mul(my, dx));
+        const auto u = L::Select(flip, L::Sub(zero, uNum), uNum);
+        const auto d = L::Select(flip, L::Sub(zero, denom), denom);
+
+        const auto inT = L::And(L::Le(zero, t), L::Le(t, L::Load(rays.maxT.data())));
+        const auto inU = L::And(L::Le(zero, u), L::Le(u, d));
+        return L::Bits(L::AndNot(L::And(inT, inU), parallel));
+    }
+
+    // Stops as soon as every lane has been clipped away, often after an edge or two for rays that miss
+    template <size_t W>
+    u32 IntersectConvexPolygon(const RayPacket<W>& rays, Span<const Vec2f> vertices, std::array<f32, W>& outT)
+    {
+        using L = detail::PacketLanes<W>;
+        const auto zero = L::Set(0.0f);
+        const auto ox = L::Load(rays.originX.data());
+        const auto oy = L::Load(rays.originY.data());
+        const auto dx = L::Load(rays.directionX.data());
+        const auto dy = L::Load(rays.directionY.data());
+        auto tEnter = zero;
+        auto tExit = L::Load(rays.maxT.data());
+        auto live = L::Le(tEnter, tExit);
+        if (L::Bits(live) == 0)
+            return 0;
+
+        for (size_t i = 0; i < vertices.size(); ++i)
+        {
+            const auto& v = vertices[i];
+            const auto& next = vertices[i + 1 < vertices.size() ? i + 1 : 0];
+            const auto nx = L::Set(next.y - v.y);
+            const auto ny = L::Set(v.x - next.x);
+            const auto num = L::Add(L::Mul(nx, L::Sub(L::Set(v.x), ox)), L::Mul(ny, L::Sub(L::Set(v.y), oy)));
+            const auto den = L::Add(L::Mul(nx, dx), L::Mul(ny, dy));
+
+            // Parallel lanes survive only on the inner side of the edge
+            const auto parallel = L::Eq(den, zero);
+            live = L::AndNot(live, L::And(parallel, L::Lt(num, zero)));
+            const auto t = L::Div(num, L::Select(parallel, L::Set(1.0f), den));
+            const auto entering = L::Lt(den, zero);
+            const auto exiting = L::Lt(zero, den);
+            tEnter = L::Select(entering, L::Max(t, tEnter), tEnter);
+            tExit = L::Select(exiting, L::Min(t, tExit), tExit);
+            live = L::And(live, L::Le(tEnter, tExit));
+            if (L::Bits(live) == 0)
+                return 0;
+        }
+        L::Store(outT.data(), tEnter);
+        return L::Bits(live);
+    }
+}
+
+#endif // J_RAY_PACKET_H
@@ -0,0 +1,309 @@
+#ifndef J_SPATIAL_HASH_H
+#define J_SPATIAL_HASH_H
+
+#include <cassert> // assert
+#include <cmath> // std::floor
+#include <limits> // std::numeric_limits
+#include <vector> // std::vector
+
+#include "jtypes.h"
+#include "math/jvec.h"
+#include "jaabb.h"
+#include "jray.h"
+
+namespace jg
+{
+    /*
+     * Uniform grid over an unbounded 2D world for broad-phase queries. Cells
+     * are hashed into a fixed number of buckets; each bucket is one contiguous
+     * array of (proxy, cell) entries, so a cell lookup is a single linear scan.
+     * A box is listed in every cell it overlaps, which works best when the cell
+     * size is about the size of a typical box.
+     *
+     * Queries are const and keep no state in the grid, so several threads may
+     * query concurrently as long as nobody inserts, moves or removes.
+     */
+    class SpatialHashGrid
+    {
+    public:
+        using ProxyId = u32;
+        static constexpr ProxyId INVALID_PROXY = ~0u;
+
+        // bucketCount is rounded up to a power of two
+        explicit SpatialHashGrid(f32 cellSize, size_t bucketCount = 4096)
+            : m_cellSize{ cellSize }
+            , m_invCellSize{ 1.0f / cellSize }
+        {
+            assert(cellSize > 0.0f);
+            size_t count = 1;
+            while (count < bucketCount)
+                count *= 2;
+            m_buckets.resize(count);
+        }
+
+        ProxyId Insert(const AABB2f& box)
+        {
+            assert(!IsEmpty(box));
+            ProxyId id;
+            if (m_freeList != INVALID_PROXY)
+            {
+                id = m_freeList;
+                m_freeList = m_proxies[id].nextFree;
+            }
+            else
+            {
+                id = static_cast<ProxyId>(m_proxies.size());
+                m_proxies.emplace_back();
+            }
+            auto& proxy = m_proxies[id];
+            proxy.box = box;
+            proxy.cells = CellRangeOf(box);
+            proxy.nextFree = INVALID_PROXY;
+            proxy.alive = true;
+            AddToCells(id, proxy.cells);
+            ++m_count;
+            return id;
+        }
+
+        // Only touches the buckets when the box crosses into different cells
+        void Move(ProxyId id, const AABB2f& box)
+        {
+            assert(Contains(id) && !IsEmpty(box));
+            auto& proxy = m_proxies[id];
+            const auto cells = CellRangeOf(box);
+            proxy.box = box;
+            if (cells == proxy.cells)
+                return;
+            RemoveFromCells(id, proxy.cells);
+            proxy.cells = cells;
+            AddToCells(id, cells);
+        }
+
+        void Remove(ProxyId id)
+        {
+            assert(Contains(id));
+            auto& proxy = m_proxies[id];
+            RemoveFromCells(id, proxy.cells);
+            proxy.alive = false;
+            proxy.nextFree = m_freeList;
+            m_freeList = id;
+            --m_count;
+        }
+
+        bool Contains(ProxyId id) const { return id < m_proxies.size() && m_proxies[id].alive; }
+        const AABB2f& GetBox(ProxyId id) const { assert(Contains(id)); return m_proxies[id].box; }
+
+        size_t size() const { return m_count; }
+        bool empty() const { return m_count == 0; }
+        f32 CellSize() const { return m_cellSize; }
+
+        // Calls visit(id) once for every proxy whose box intersects region
+        template <typename F>
+        void Query(const AABB2f& region, F&& visit) const
+        {
+            const auto range = CellRangeOf(region);
+            const auto cellCount = static_cast<u64>(range.maxX - range.minX + 1) * static_cast<u64>(range.maxY - range.minY + 1);
+
+            // A proxy spanning several cells is reported only from its first
+            // cell inside the query range, so no per-query visited set is needed
+            const auto visitEntry = [&](const Entry& e) {
+                const auto& proxy = m_proxies[e.proxy];
+                const auto ownerX = proxy.cells.minX > range.minX ? proxy.cells.minX : range.minX;
+                const auto ownerY = proxy.cells.minY > range.minY ? proxy.cells.minY : range.minY;
+                if (e.cellX == ownerX && e.cellY == ownerY && Intersects(proxy.box, region))
+                    visit(e.proxy);
+            };
+
+            // Huge regions: one pass over every bucket beats hashing each cell
+            if (cellCount > m_buckets.size())
+            {
+                for (const auto& bucket : m_buckets)
+                {
+                    for (const auto& e : bucket)
+                    {
+                        if (e.cellX >= range.minX && e.cellX <= range.maxX && e.cellY >= range.minY && e.cellY <= range.maxY)
+                            visitEntry(e);
+                    }
+                }
+                return;
+            }
+
+            for (auto y = range.minY; y <= range.maxY; ++y)
+            {
+                for (auto x = range.minX; x <= range.maxX; ++x)
+                {
+                    for (const auto& e : m_buckets[BucketOf(x, y)])
+                    {
+                        if (e.cellX == x && e.cellY == y)
+                            visitEntry(e);
+                    }
+                }
+            }
+        }
+
+        /*
+         * Walks the cells along ray front to back up to maxT (which must be
+         * finite) and calls visit(id, t) for every proxy the ray hits, where t
+         * is the entry distance. Hits are reported cell by cell, so they are only
+         * roughly sorted by t. Return false from visit to stop early.
+         */
+        template <typename F>
+        void Raycast(const Ray2f& ray, f32 maxT, F&& visit) const
+        {
+            RaycastClipped(ray, maxT, visit);
+        }
+
+        // Nearest proxy hit by ray within maxT, or INVALID_PROXY; its distance goes to outT
+        ProxyId RaycastClosest(const Ray2f& ray, f32 maxT, f32& outT) const
+        {
+            auto best = INVALID_PROXY;
+            auto limit = maxT;
+            // Every hit shortens the walk, so it ends at the first cell past the nearest hit
+            RaycastClipped(ray, limit, [&](ProxyId id, f32 t) {
+                best = id;
+                limit = t;
+                return true;
+            });
+            outT = limit;
+            return best;
+        }
+
+    private:
+        struct CellRange
+        {
+            i32 minX, minY, maxX, maxY;
+
+            bool operator==(const CellRange& other) const
+            {
+                return minX == other.minX && minY == other.minY && maxX == other.maxX && maxY == other.maxY;
+            }
+        };
+
+        struct Proxy
+        {
+            AABB2f box;
+            CellRange cells{};
+            ProxyId nextFree = INVALID_PROXY;
+            bool alive = false;
+        };
+
+        struct Entry
+        {
+            ProxyId proxy;
+            i32 cellX, cellY;
+        };
+
+        // Raycast with a limit the visitor may lower while the walk is in progress
+        template <typename F>
+        void RaycastClipped(const Ray2f& ray, f32& maxT, F&& visit) const
+        {
+            assert(maxT >= 0.0f && maxT < std::numeric_limits<f32>::infinity());
+
+            const auto& o = ray.origin;
+            const auto& d = ray.direction;
+            const Vec2f invDir{ d.x == 0.0f ? 0.0f : 1.0f / d.x, d.y == 0.0f ? 0.0f : 1.0f / d.y };
+            constexpr auto inf = std::numeric_limits<f32>::infinity();
+
+            // Amanatides-Woo traversal
+            auto x = CellCoord(o.x);
+            auto y = CellCoord(o.y);
+            const i32 stepX = d.x > 0.0f ? 1 : (d.x < 0.0f ? -1 : 0);
+            const i32 stepY = d.y > 0.0f ? 1 : (d.y < 0.0f ? -1 : 0);
+            const auto deltaX = stepX != 0 ? m_cellSize * (invDir.x < 0.0f ? -invDir.x : invDir.x) : inf;
+            const auto deltaY = stepY != 0 ? m_cellSize * (invDir.y < 0.0f ? -invDir.y : invDir.y) : inf;
+            auto nextX = stepX != 0 ? (static_cast<f32>(x + (stepX > 0)) * m_cellSize - o.x) * invDir.x : inf;
+            auto nextY = stepY != 0 ? (static_cast<f32>(y + (stepY > 0)) * m_cellSize - o.y) * invDir.y : inf;
+
+            // Proxies spanning several cells can be met again further along;
+            // only those need remembering
+            std::vector<ProxyId> reported;
+
+            auto tEnter = 0.0f;
+            while (tEnter <= maxT)
+            {
+                for (const auto& e : m_buckets[BucketOf(x, y)])
+                {
+                    if (e.cellX != x || e.cellY != y)
+                        continue;
+                    const auto& proxy = m_proxies[e.proxy];
+                    auto t = 0.0f;
+                    if (!detail::IntersectSlabs(o, d, invDir, proxy.box, maxT, t))
+                        continue;
+                    if (proxy.cells.minX != proxy.cells.maxX || proxy.cells.minY != proxy.cells.maxY)
+                    {
+                        auto seen = false;
+                        for (const auto r : reported)
+                            seen = seen || r == e.proxy;
+                        if (seen)
+                            continue;
+                        reported.push_back(e.proxy);
+                    }
+                    if (!visit(e.proxy, t))
+                        return;
+                }
+
+                if (nextX < nextY)
+                {
+                    tEnter = nextX;
+                    nextX += deltaX;
+                    x += stepX;
+                }
+                else
+                {
+                    tEnter = nextY;
+                    nextY += deltaY;
+                    y += stepY;
+                }
+            }
+        }
+
+        i32 CellCoord(f32 v) const { return static_cast<i32>(std::floor(v * m_invCellSize)); }
+
+        CellRange CellRangeOf(const AABB2f& box) const
+        {
+            return CellRange{ CellCoord(box.min.x), CellCoord(box.min.y), CellCoord(box.max.x), CellCoord(box.max.y) };
+        }
+
+        size_t BucketOf(i32 x, i32 y) const
+        {
+            const auto h = static_cast<u32>(x) * 73856093u ^ static_cast<u32>(y) * 19349663u;
+            return h & (m_buckets.size() - 1);
+        }
+
+        void AddToCells(ProxyId id, const CellRange& cells)
+        {
+            for (auto y = cells.minY; y <= cells.maxY; ++y)
+                for (auto x = cells.minX; x <= cells.maxX; ++x)
+                    m_buckets[BucketOf(x, y)].push_back(Entry{ id, x, y });
+        }
+
+        void RemoveFromCells(ProxyId id, const CellRange& cells)
+        {
+            for (auto y = cells.minY; y <= cells.maxY; ++y)
+            {
+                for (auto x = cells.minX; x <= cells.maxX; ++x)
+                {
+                    auto& bucket = m_buckets[BucketOf(x, y)];
+                    for (size_t i = 0; i < bucket.size(); ++i)
+                    {
+                        if (bucket[i].proxy == id && bucket[i].cellX == x && bucket[i].cellY == y)
+                        {
+                            bucket[i] = bucket.back();
+                            bucket.pop_back();
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+
+        f32 m_cellSize;
+        f32 m_invCellSize;
+        std::vector<std::vector<Entry>> m_buckets;
+        std::vector<Proxy> m_proxies;
+        ProxyId m_freeList = INVALID_PROXY;
+        size_t m_count = 0;
+    };
+}
+
+#endif // J_SPATIAL_HASH_H
@@ -2,5 +2,13 @@
 #define JANGINE_H
 
 #include "math/jmath.h"
+#include "memory/jmemory.h"
+#include "geometry/jgeometry.h"
+#include "jobs/jjobs.h"
+#include "scene/jscene.h"
+#include "render/jrender.h"
+#include "ecs/jecs.h"
+#include "particles/jparticles.h"
+#include "physics/jphysics.h"
 
 #endif // JANGINE_H
@@ -0,0 +1,7 @@
+#ifndef J_JOBS_H
+#define J_JOBS_H
+
+#include "jthread_pool.h"
+#include "jparallel.h"
+
+#endif // J_JOBS_H
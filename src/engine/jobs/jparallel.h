@@ -0,0 +1,58 @@
+#ifndef J_PARALLEL_H
+#define J_PARALLEL_H
+
+#include <cassert> // assert
+#include <cstddef> // size_t
+
+#include "jspan.h"
+#include "math/jbatch.h"
+#include "jthread_pool.h"
+
+namespace jg
+{
+    namespace jobs
+    {
+        /*
+         * Calls fn(first, last) over consecutive chunks of [begin, end) on the
+         * pool and returns when all chunks are done. grain is the chunk size;
+         * 0 picks about four chunks per thread. Chunks may run on the calling
+         * thread, and fn may itself use the pool.
+         */
+        template <typename F>
+        void ParallelFor(ThreadPool& pool, size_t begin, size_t end, size_t grain, F&& fn)
+        {
+            if (begin >= end)
+                return;
+            const auto count = end - begin;
+            if (grain == 0)
+                grain = (count + pool.ThreadCount() * 4 - 1) / (pool.ThreadCount() * 4);
+            if (count <= grain || pool.ThreadCount() == 1)
+            {
+                fn(begin, end);
+                return;
+            }
+
+            TaskGroup group;
+            for (auto first = begin; first < end; first += grain)
+            {
+                const auto last = end - first > grain ? first + grain : end;
+                pool.Run(group, [&fn, first, last] { fn(first, last); });
+            }
+            pool.Wait(group);
+        }
+
+        // ComposeTransforms from jbatch.h, split across the pool
+        inline void ComposeTransforms(ThreadPool& pool,
+                                      Span<const Mat3f> parents, Span<const Mat3f> locals, Span<Mat3f> out,
+                                      size_t grain = 4096)
+        {
+            assert(parents.size() == locals.size() && out.size() >= locals.size());
+            ParallelFor(pool, 0, locals.size(), grain, [&](size_t first, size_t last) {
+                ComposeTransforms(parents.Subspan(first, last - first), locals.Subspan(first, last - first),
+                                  out.Subspan(first, last - first));
+            });
+        }
+    }
+}
+
+#endif // J_PARALLEL_H
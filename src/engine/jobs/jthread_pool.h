@@ -0,0 +1,233 @@
+#ifndef J_THREAD_POOL_H
+#define J_THREAD_POOL_H
+
+#include <atomic> // std::atomic
+#include <chrono> // std::chrono::milliseconds
+#include <condition_variable> // std::condition_variable
+#include <cstddef> // size_t
+#include <deque> // std::deque
+#include <exception> // std::exception_ptr, std::current_exception, std::rethrow_exception
+#include <functional> // std::function
+#include <memory> // std::unique_ptr
+#include <mutex> // std::mutex, std::lock_guard, std::unique_lock
+#include <thread> // std::thread
+#include <utility> // std::forward, std::exchange
+#include <vector> // std::vector
+
+namespace jg
+{
+    namespace jobs
+    {
+        // Join point for a set of tasks; see ThreadPool::Wait
+        class TaskGroup
+        {
+        public:
+            TaskGroup() = default;
+            TaskGroup(const TaskGroup&) = delete;
+            TaskGroup& operator=(const TaskGroup&) = delete;
+
+            bool Done() const { return m_pending.load(std::memory_order_acquire) == 0; }
+
+        private:
+            friend class ThreadPool;
+
+            void Fail(std::exception_ptr error)
+            {
+                std::lock_guard<std::mutex> lock{ m_errorMutex };
+                if (!m_error)
+                    m_error = std::move(error);
+            }
+
+            std::atomic<size_t> m_pending{ 0 };
+            // First exception thrown by one of the tasks, rethrown by Wait
+            std::mutex m_errorMutex;
+            std::exception_ptr m_error;
+        };
+
+        namespace detail
+        {
+            // Which pool queue the current thread owns; threads outside any pool share queue 0
+            struct WorkerSlot
+            {
+                const void* pool = nullptr;
+                size_t index = 0;
+            };
+
+            inline WorkerSlot& CurrentWorker()
+            {
+                thread_local WorkerSlot slot;
+                return slot;
+            }
+        }
+
+        /*
+         * Work-stealing thread pool. Every worker owns a task deque: it pushes
+         * and pops at the back (newest first, cache-warm), and idle workers
+         * steal from the front of the others (oldest first, usually the largest
+         * pieces of work). Threads that are not workers submit to a shared queue.
+         *
+         * Fork/join: Run() adds tasks to a TaskGroup and Wait() returns once
+         * they have all finished. A waiting thread runs queued tasks itself
+         * instead of blocking, so tasks may fork and wait on nested groups
+         * without starving the pool.
+         *
+         * A task that throws still counts as finished. The first exception of a
+         * group is kept and rethrown by Wait() once every task of the group has
+         * finished; later ones are dropped. The other tasks are not cancelled.
+         */
+        class ThreadPool
+        {
+        public:
+            // threadCount includes the thread that calls Wait(); 1 runs everything inline
+            explicit ThreadPool(size_t threadCount = DefaultThreadCount())
+            {
+                const auto count = threadCount > 0 ? threadCount : 1;
+                for (size_t i = 0; i < count; ++i)
+                    m_queues.push_back(std::make_unique<Queue>());
+                for (size_t i = 1; i < count; ++i)
+                    m_threads.emplace_back([this, i] { WorkerLoop(i); });
+            }
+
+            ~ThreadPool()
+            {
+                {
+                    std::lock_guard<std::mutex> lock{ m_sleepMutex };
+                    m_stop = true;
+                }
+                m_wake.notify_all();
+                for (auto& thread : m_threads)
+                    thread.join();
+            }
+
+            ThreadPool(const ThreadPool&) = delete;
+            ThreadPool& operator=(const ThreadPool&) = delete;
+
+            static size_t DefaultThreadCount()
+            {
+                const auto hw = std::thread::hardware_concurrency();
+                return hw > 0 ? hw : 1;
+            }
+
+            size_t ThreadCount() const { return m_queues.size(); }
+
+            template <typename F>
+            void Run(TaskGroup& group, F&& fn)
+            {
+                group.m_pending.fetch_add(1, std::memory_order_relaxed);
+                auto& queue = *m_queues[CurrentQueue()];
+                {
+                    std::lock_guard<std::mutex> lock{ queue.mutex };
+                    queue.tasks.push_back(Task{ std::function<void()>{ std::forward<F>(fn) }, &group });
+                }
+                m_queued.fetch_add(1, std::memory_order_release);
+                {
+                    // Pairs with the predicate check in WorkerLoop so the wakeup cannot be lost
+                    std::lock_guard<std::mutex> lock{ m_sleepMutex };
+                }
+                m_wake.notify_one();
+            }
+
+            // Runs queued tasks until every task in group has finished, then rethrows the group's first exception
+            void Wait(TaskGroup& group)
+            {
+                const auto self = CurrentQueue();
+                while (!group.Done())
+                {
+                    if (!TryRunOne(self))
+                        std::this_thread::yield();
+                }
+                // Written before the failing task's m_pending decrement, which Done() acquired
+                if (group.m_error)
+                    std::rethrow_exception(std::exchange(group.m_error, nullptr));
+            }
+
+        private:
+            // Idle workers recheck the queues at least this often, in case a wakeup is missed
+            static constexpr std::chrono::milliseconds IDLE_TIMEOUT{ 10 };
+
+            struct Task
+            {
+                std::function<void()> fn;
+                TaskGroup* group;
+            };
+
+            struct Queue
+            {
+                std::mutex mutex;
+                std::deque<Task> tasks;
+            };
+
+            size_t CurrentQueue() const
+            {
+                const auto& slot = detail::CurrentWorker();
+                return slot.pool == this ? slot.index : 0;
+            }
+
+            bool TryPop(size_t index, bool steal, Task& out)
+            {
+                auto& queue = *m_queues[index];
+                std::lock_guard<std::mutex> lock{ queue.mutex };
+                if (queue.tasks.empty())
+                    return false;
+                if (steal)
+                {
+                    out = std::move(queue.tasks.front());
+                    queue.tasks.pop_front();
+                }
+                else
+                {
+                    out = std::move(queue.tasks.back());
+                    queue.tasks.pop_back();
+                }
+                m_queued.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+
+            bool TryRunOne(size_t self)
+            {
+                Task task;
+                auto found = TryPop(self, false, task);
+                for (size_t i = 1; !found && i < m_queues.size(); ++i)
+                    found = TryPop((self + i) % m_queues.size(), true, task);
+                if (!found)
+                    return false;
+
+                try
+                {
+                    task.fn();
+                }
+                catch (...)
+                {
+                    task.group->Fail(std::current_exception());
+                }
+                task.group->m_pending.fetch_sub(1, std::memory_order_acq_rel);
+                return true;
+            }
+
+            void WorkerLoop(size_t index)
+            {
+                detail::CurrentWorker() = detail::WorkerSlot{ this, index };
+                for (;;)
+                {
+                    if (TryRunOne(index))
+                        continue;
+
+                    std::unique_lock<std::mutex> lock{ m_sleepMutex };
+                    m_wake.wait_for(lock, IDLE_TIMEOUT, [this] { return m_stop || m_queued.load(std::memory_order_acquire) > 0; });
+                    if (m_stop)
+                        return;
+                }
+            }
+
+            std::vector<std::unique_ptr<Queue>> m_queues;
+            std::vector<std::thread> m_threads;
+
+            std::atomic<size_t> m_queued{ 0 };
+            std::mutex m_sleepMutex;
+            std::condition_variable m_wake;
+            bool m_stop = false;
+        };
+    }
+}
+
+#endif // J_THREAD_POOL_H
@@ -0,0 +1,54 @@
+#ifndef J_SPAN_H
+#define J_SPAN_H
+
+#include <cassert> // assert
+#include <cstddef> // size_t
+#include <type_traits> // std::enable_if_t, std::is_convertible_v
+#include <utility> // std::declval
+
+namespace jg
+{
+    // Non-owning view over a contiguous sequence (a minimal C++17 stand-in for std::span)
+    template <typename T>
+    struct Span
+    {
+        T* ptr = nullptr;
+        size_t count = 0;
+
+        constexpr Span() = default;
+        constexpr Span(T* p, size_t n) : ptr{ p }, count{ n } {}
+
+        template <size_t N>
+        constexpr Span(T (&arr)[N]) : ptr{ arr }, count{ N } {}
+
+        // Any contiguous container exposing data() and size(), e.g. std::vector or std::array
+        template <typename C, typename = std::enable_if_t<
+            std::is_convertible_v<decltype(std::declval<C&>().data()), T*>>>
+        constexpr Span(C& c) : ptr{ c.data() }, count{ c.size() } {}
+
+        // Span<T> -> Span<const T>
+        template <typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+        constexpr Span(const Span<U>& other) : ptr{ other.ptr }, count{ other.count } {}
+
+        constexpr T& operator[](size_t index) const
+        {
+            assert(index < count);
+            return ptr[index];
+        }
+
+        constexpr T* data() const { return ptr; }
+        constexpr size_t size() const { return count; }
+        constexpr bool empty() const { return count == 0; }
+
+        constexpr T* begin() const { return ptr; }
+        constexpr T* end() const { return ptr + count; }
+
+        constexpr Span Subspan(size_t offset, size_t n) const
+        {
+            assert(offset + n <= count);
+            return Span{ ptr + offset, n };
+        }
+    };
+}
+
+#endif // J_SPAN_H
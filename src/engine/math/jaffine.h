@@ -0,0 +1,177 @@
+#ifndef J_AFFINE_H
+#define J_AFFINE_H
+
+#include <cassert> // assert
+#include <array> // std::array
+
+#include "jtypes.h"
+#include "jvec.h"
+#include "jmatrix.h"
+#include "jmath_consts.h"
+#include "jcmath.h"
+
+namespace jg
+{
+    /*
+     * 2D affine transform stored as the top two rows of a homogenous 3x3 matrix.
+     * The implicit bottom row is always (0, 0, 1), so it takes 6 values instead
+     * of 9 and composing two transforms costs 12 multiplies instead of 27.
+     *
+     * | m00 m01 m02 |
+     * | m10 m11 m12 |
+     * |  0   0   1  |
+     */
+    template <typename T>
+    struct Affine2
+    {
+        union
+        {
+            struct
+            {
+                T m00, m10,
+                  m01, m11,
+                  m02, m12;
+            };
+            std::array<T, 6> data;
+            std::array<Vec<T, 2>, 3> col;
+        };
+
+        static constexpr Affine2 Identity()
+        {
+            return Affine2{
+                static_cast<T>(1), static_cast<T>(0),
+                static_cast<T>(0), static_cast<T>(1),
+                static_cast<T>(0), static_cast<T>(0)
+            };
+        }
+        static constexpr Affine2 Translation(const T& x, const T& y)
+        {
+            return Affine2{
+                static_cast<T>(1), static_cast<T>(0),
+                static_cast<T>(0), static_cast<T>(1),
+                                x,                 y
+            };
+        }
+        static constexpr Affine2 Scale(const T& x, const T& y)
+        {
+            return Affine2{
+                                x, static_cast<T>(0),
+                static_cast<T>(0),                 y,
+                static_cast<T>(0), static_cast<T>(0)
+            };
+        }
+        static constexpr Affine2 Rotation(const T& rad)
+        {
+            const auto sinRad = Sin(rad);
+            const auto cosRad = Cos(rad);
+            return Affine2{
+                           cosRad,            sinRad,
+                          -sinRad,            cosRad,
+                static_cast<T>(0), static_cast<T>(0)
+            };
+        }
+
+        explicit constexpr Affine2() : data{} {}
+        explicit constexpr Affine2(const T& x0, const T& y0,
+                                   const T& x1, const T& y1,
+                                   const T& x2, const T& y2) :
+            m00{x0}, m10{y0},
+            m01{x1}, m11{y1},
+            m02{x2}, m12{y2} {}
+
+        // Drops the bottom row, which is expected to be (0, 0, 1)
+        explicit constexpr Affine2(const Mat<T, 3, 3>& mat) :
+            m00{mat.m00}, m10{mat.m10},
+            m01{mat.m01}, m11{mat.m11},
+            m02{mat.m02}, m12{mat.m12} {}
+
+        constexpr Vec<T, 2>& operator[](size_t index)
+        {
+            assert(index < 3);
+            return col[index];
+        }
+        constexpr const Vec<T, 2>& operator[](size_t index) const
+        {
+            assert(index < 3);
+            return col[index];
+        }
+    };
+
+    template <typename T>
+    constexpr Mat<T, 3, 3> ToMat3(const Affine2<T>& aff)
+    {
+        return Mat<T, 3, 3>{
+            aff.m00, aff.m10, static_cast<T>(0),
+            aff.m01, aff.m11, static_cast<T>(0),
+            aff.m02, aff.m12, static_cast<T>(1)
+        };
+    }
+
+    // Applies rhs first, then lhs, same as the equivalent Mat3 product
+    template <typename T>
+    constexpr Affine2<T> operator*(const Affine2<T>& lhs, const Affine2<T>& rhs)
+    {
+        return Affine2<T>{
+            lhs.m00 * rhs.m00 + lhs.m01 * rhs.m10,
+            lhs.m10 * rhs.m00 + lhs.m11 * rhs.m10,
+
+            lhs.m00 * rhs.m01 + lhs.m01 * rhs.m11,
+            lhs.m10 * rhs.m01 + lhs.m11 * rhs.m11,
+
+            lhs.m00 * rhs.m02 + lhs.m01 * rhs.m12 + lhs.m02,
+            lhs.m10 * rhs.m02 + lhs.m11 * rhs.m12 + lhs.m12
+        };
+    }
+
+    // Point (w = 1): affected by translation
+    template <typename T>
+    constexpr Vec<T, 2> TransformPoint(const Affine2<T>& aff, const Vec<T, 2>& p)
+    {
+        return Vec<T, 2>{
+            aff.m00 * p.x + aff.m01 * p.y + aff.m02,
+            aff.m10 * p.x + aff.m11 * p.y + aff.m12
+        };
+    }
+
+    // Direction (w = 0): ignores translation
+    template <typename T>
+    constexpr Vec<T, 2> TransformVector(const Affine2<T>& aff, const Vec<T, 2>& v)
+    {
+        return Vec<T, 2>{
+            aff.m00 * v.x + aff.m01 * v.y,
+            aff.m10 * v.x + aff.m11 * v.y
+        };
+    }
+
+    template <typename T>
+    constexpr T Determinant(const Affine2<T>& aff)
+    {
+        return aff.m00 * aff.m11 - aff.m01 * aff.m10;
+    }
+
+    template <typename T>
+    constexpr Affine2<T> Inverse(const Affine2<T>& aff)
+    {
+        const auto det = Determinant(aff);
+        assert(Abs(det) > static_cast<T>(EPSILON_F32));
+        const auto invDet = static_cast<T>(1) / det;
+
+        const auto i00 =  aff.m11 * invDet;
+        const auto i10 = -aff.m10 * invDet;
+        const auto i01 = -aff.m01 * invDet;
+        const auto i11 =  aff.m00 * invDet;
+
+        return Affine2<T>{
+            i00, i10,
+            i01, i11,
+            -(i00 * aff.m02 + i01 * aff.m12),
+            -(i10 * aff.m02 + i11 * aff.m12)
+        };
+    }
+
+
+
+    using Affine2f = Affine2<f32>;
+}
+
+#endif // J_AFFINE_H
@@ -0,0 +1,391 @@
+#ifndef J_ARRAY_H
+#define J_ARRAY_H
+
+#include <cassert> // assert
+#include <cstdint> // uintptr_t
+#include <cstring> // std::memcpy, std::memset
+#include <iterator> // std::random_access_iterator_tag
+#include <memory> // std::allocator_traits
+#include <type_traits> // std::is_trivially_copyable_v, std::is_default_constructible_v
+#include <utility> // std::swap
+
+#include "jtypes.h"
+#include "jspan.h"
+#include "jvec.h"
+#include "jmatrix.h"
+#include "memory/jaligned_allocator.h"
+
+/*
+ * Growable containers of Vec/Mat for bulk data, with a guaranteed base
+ * alignment so kernels can use aligned SIMD loads.
+ *
+ * AoS stores whole elements back to back (Vec3f stays 12 bytes) and hands out
+ * Vec& / Span<Vec>. SoA stores one stream per component (all x, then all y,
+ * ...); every stream starts on an Align boundary and has room for PaddedSize()
+ * values, so a kernel can run full SIMD width over the tail without a scalar
+ * remainder loop. SoA elements are read and written through a proxy that
+ * converts to and from the Vec/Mat type.
+ */
+namespace jg
+{
+    enum class Layout
+    {
+        AoS,
+        SoA
+    };
+
+    namespace detail
+    {
+        template <typename E>
+        constexpr size_t COMPONENTS = std::tuple_size<decltype(E::data)>::value;
+
+        template <typename E>
+        constexpr E ZeroElement()
+        {
+            using T = typename decltype(E::data)::value_type;
+            if constexpr (std::is_default_constructible_v<E>)
+                return E{};
+            else
+                return E{ T{} };
+        }
+
+        // Reference to element i of an SoA array; T is const for read-only access
+        template <typename E, typename T>
+        struct SoaRef
+        {
+            T* base;
+            size_t stride;
+            size_t index;
+
+            operator E() const
+            {
+                auto e = ZeroElement<E>();
+                for (size_t k = 0; k < COMPONENTS<E>; ++k)
+                    e.data[k] = base[k * stride + index];
+                return e;
+            }
+
+            const SoaRef& operator=(const E& e) const
+            {
+                for (size_t k = 0; k < COMPONENTS<E>; ++k)
+                    base[k * stride + index] = e.data[k];
+                return *this;
+            }
+            const SoaRef& operator=(const SoaRef& other) const { return *this = static_cast<E>(other); }
+
+            T& Component(size_t k) const
+            {
+                assert(k < COMPONENTS<E>);
+                return base[k * stride + index];
+            }
+        };
+
+        template <typename E, typename T>
+        struct SoaIterator
+        {
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = E;
+            using difference_type = std::ptrdiff_t;
+            using reference = SoaRef<E, T>;
+            using pointer = void;
+
+            T* base;
+            size_t stride;
+            size_t index;
+
+            reference operator*() const { return reference{ base, stride, index }; }
+            reference operator[](difference_type n) const { return reference{ base, stride, index + n }; }
+
+            SoaIterator& operator++() { ++index; return *this; }
+            SoaIterator operator++(int) { auto ret = *this; ++index; return ret; }
+            SoaIterator& operator--() { --index; return *this; }
+            SoaIterator operator--(int) { auto ret = *this; --index; return ret; }
+            SoaIterator& operator+=(difference_type n) { index += n; return *this; }
+            SoaIterator& operator-=(difference_type n) { index -= n; return *this; }
+            SoaIterator operator+(difference_type n) const { return SoaIterator{ base, stride, index + n }; }
+            SoaIterator operator-(difference_type n) const { return SoaIterator{ base, stride, index - n }; }
+            difference_type operator-(const SoaIterator& other) const
+            {
+                return static_cast<difference_type>(index) - static_cast<difference_type>(other.index);
+            }
+
+            bool operator==(const SoaIterator& other) const { return index == other.index; }
+            bool operator!=(const SoaIterator& other) const { return index != other.index; }
+            bool operator<(const SoaIterator& other) const { return index < other.index; }
+        };
+
+        inline bool IsAligned(const void* p, size_t align)
+        {
+            return (reinterpret_cast<uintptr_t>(p) & (align - 1)) == 0;
+        }
+
+        // Lets the optimizer use aligned loads/stores on p
+        template <size_t Align, typename T>
+        T* AssumeAligned(T* p)
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<T*>(__builtin_assume_aligned(p, Align));
+#else
+            return p;
+#endif
+        }
+    }
+
+    template <typename E, Layout L, size_t Align, typename Alloc>
+    class ElementArray;
+
+    template <typename E, size_t Align, typename Alloc>
+    class ElementArray<E, Layout::AoS, Align, Alloc>
+    {
+        static_assert(std::is_trivially_copyable_v<E>);
+        static_assert((Align & (Align - 1)) == 0 && Align >= alignof(E));
+
+        using Traits = typename std::allocator_traits<Alloc>::template rebind_traits<E>;
+        using Allocator = typename Traits::allocator_type;
+
+    public:
+        using value_type = E;
+        using iterator = E*;
+        using const_iterator = const E*;
+
+        static constexpr Layout LAYOUT = Layout::AoS;
+        static constexpr size_t ALIGNMENT = Align;
+
+        explicit ElementArray(const Alloc& alloc = Alloc{}) : m_alloc{ alloc } {}
+        explicit ElementArray(size_t count, const Alloc& alloc = Alloc{}) : m_alloc{ alloc } { resize(count); }
+        ElementArray(const ElementArray& other) : m_alloc{ other.m_alloc }
+        {
+            reserve(other.m_size);
+            if (other.m_size != 0)
+                std::memcpy(m_data, other.m_data, other.m_size * sizeof(E));
+            m_size = other.m_size;
+        }
+        ElementArray(ElementArray&& other) noexcept : m_alloc{ other.m_alloc } { Swap(other); }
+        ElementArray& operator=(ElementArray other) noexcept { Swap(other); return *this; }
+        ~ElementArray() { if (m_data) Traits::deallocate(m_alloc, m_data, m_capacity); }
+
+        E& operator[](size_t index) { assert(index < m_size); return m_data[index]; }
+        const E& operator[](size_t index) const { assert(index < m_size); return m_data[index]; }
+
+        E Get(size_t index) const { return (*this)[index]; }
+        void Set(size_t index, const E& e) { (*this)[index] = e; }
+
+        void push_back(const E& e)
+        {
+            if (m_size == m_capacity)
+            {
+                // e may refer into this array, so copy it before reserve() frees the storage
+                const E value = e;
+                reserve(m_capacity ? m_capacity * 2 : 16);
+                m_data[m_size++] = value;
+                return;
+            }
+            m_data[m_size++] = e;
+        }
+
+        void reserve(size_t count)
+        {
+            if (count <= m_capacity)
+                return;
+            auto* data = Traits::allocate(m_alloc, count);
+            assert(detail::IsAligned(data, Align));
+            if (m_data)
+            {
+                std::memcpy(data, m_data, m_size * sizeof(E));
+                Traits::deallocate(m_alloc, m_data, m_capacity);
+            }
+            m_data = data;
+            m_capacity = count;
+        }
+
+        // New elements are zero
+        void resize(size_t count)
+        {
+            reserve(count);
+            for (auto i = m_size; i < count; ++i)
+                m_data[i] = detail::ZeroElement<E>();
+            m_size = count;
+        }
+
+        void clear() { m_size = 0; }
+
+        size_t size() const { return m_size; }
+        size_t capacity() const { return m_capacity; }
+        bool empty() const { return m_size == 0; }
+
+        E* data() { return m_data; }
+        const E* data() const { return m_data; }
+
+        Span<E> AsSpan() { return Span<E>{ m_data, m_size }; }
+        Span<const E> AsSpan() const { return Span<const E>{ m_data, m_size }; }
+
+        iterator begin() { return m_data; }
+        iterator end() { return m_data + m_size; }
+        const_iterator begin() const { return m_data; }
+        const_iterator end() const { return m_data + m_size; }
+
+    private:
+        void Swap(ElementArray& other) noexcept
+        {
+            std::swap(m_alloc, other.m_alloc);
+            std::swap(m_data, other.m_data);
+            std::swap(m_size, other.m_size);
+            std::swap(m_capacity, other.m_capacity);
+        }
+
+        Allocator m_alloc;
+        E* m_data = nullptr;
+        size_t m_size = 0;
+        size_t m_capacity = 0;
+    };
+
+    template <typename E, size_t Align, typename Alloc>
+    class ElementArray<E, Layout::SoA, Align, Alloc>
+    {
+        using T = typename decltype(E::data)::value_type;
+        static constexpr size_t N = detail::COMPONENTS<E>;
+
+        static_assert(std::is_trivially_copyable_v<T>);
+        static_assert((Align & (Align - 1)) == 0 && Align >= alignof(T));
+
+        using Traits = typename std::allocator_traits<Alloc>::template rebind_traits<T>;
+        using Allocator = typename Traits::allocator_type;
+
+    public:
+        using value_type = E;
+        using reference = detail::SoaRef<E, T>;
+        using const_reference = detail::SoaRef<E, const T>;
+        using iterator = detail::SoaIterator<E, T>;
+        using const_iterator = detail::SoaIterator<E, const T>;
+
+        static constexpr Layout LAYOUT = Layout::SoA;
+        static constexpr size_t ALIGNMENT = Align;
+        // Values per Align block; streams are padded to a multiple of this
+        static constexpr size_t LANES = Align / sizeof(T) > 0 ? Align / sizeof(T) : 1;
+
+        explicit ElementArray(const Alloc& alloc = Alloc{}) : m_alloc{ alloc } {}
+        explicit ElementArray(size_t count, const Alloc& alloc = Alloc{}) : m_alloc{ alloc } { resize(count); }
+        ElementArray(const ElementArray& other) : m_alloc{ other.m_alloc }
+        {
+            reserve(other.m_size);
+            if (other.m_size != 0)
+            {
+                for (size_t k = 0; k < N; ++k)
+                    std::memcpy(m_data + k * m_stride, other.m_data + k * other.m_stride, other.m_size * sizeof(T));
+            }
+            m_size = other.m_size;
+        }
+        ElementArray(ElementArray&& other) noexcept : m_alloc{ other.m_alloc } { Swap(other); }
+        ElementArray& operator=(ElementArray other) noexcept { Swap(other); return *this; }
+        ~ElementArray() { if (m_data) Traits::deallocate(m_alloc, m_data, m_stride * N); }
+
+        reference operator[](size_t index) { assert(index < m_size); return reference{ m_data, m_stride, index }; }
+        const_reference operator[](size_t index) const { assert(index < m_size); return const_reference{ m_data, m_stride, index }; }
+
+        E Get(size_t index) const { return (*this)[index]; }
+        void Set(size_t index, const E& e) { (*this)[index] = e; }
+
+        void push_back(const E& e)
+        {
+            if (m_size == m_stride)
+                reserve(m_stride ? m_stride * 2 : 16);
+            ++m_size;
+            Set(m_size - 1, e);
+        }
+
+        // Capacity is rounded up to whole Align blocks per stream
+        void reserve(size_t count)
+        {
+            const auto stride = (count + LANES - 1) / LANES * LANES;
+            if (stride <= m_stride)
+                return;
+            auto* data = Traits::allocate(m_alloc, stride * N);
+            assert(detail::IsAligned(data, Align));
+            for (size_t k = 0; k < N; ++k)
+            {
+                if (m_data)
+                    std::memcpy(data + k * stride, m_data + k * m_stride, m_size * sizeof(T));
+                // Padding past size() is zeroed here and by a shrinking resize() or clear(),
+                // so full-width kernels always read defined values
+                std::memset(static_cast<void*>(data + k * stride + m_size), 0, (stride - m_size) * sizeof(T));
+            }
+            if (m_data)
+                Traits::deallocate(m_alloc, m_data, m_stride * N);
+            m_data = data;
+            m_stride = stride;
+        }
+
+        // New elements are zero, and so are the values a shrink drops
+        void resize(size_t count)
+        {
+            reserve(count);
+            const auto first = count < m_size ? count : m_size;
+            const auto last = count < m_size ? m_size : count;
+            for (size_t k = 0; k < N && first != last; ++k)
+                std::memset(static_cast<void*>(m_data + k * m_stride + first), 0, (last - first) * sizeof(T));
+            m_size = count;
+        }
+
+        void clear() { resize(0); }
+
+        size_t size() const { return m_size; }
+        size_t capacity() const { return m_stride; }
+        bool empty() const { return m_size == 0; }
+
+        // size() rounded up to whole Align blocks; streams may be read and written up to here
+        size_t PaddedSize() const { return (m_size + LANES - 1) / LANES * LANES; }
+        // Distance in values between the starts of two component streams
+        size_t Stride() const { return m_stride; }
+
+        // Stream of component k: data[k] of every element (x, y, ... for Vec; column-major for Mat)
+        Span<T> Component(size_t k)
+        {
+            assert(k < N);
+            return Span<T>{ m_data + k * m_stride, m_size };
+        }
+        Span<const T> Component(size_t k) const
+        {
+            assert(k < N);
+            return Span<const T>{ m_data + k * m_stride, m_size };
+        }
+
+        // Raw stream k for bulk kernels: Align-aligned, valid up to PaddedSize()
+        T* ComponentData(size_t k)
+        {
+            assert(k < N);
+            return detail::AssumeAligned<Align>(m_data + k * m_stride);
+        }
+        const T* ComponentData(size_t k) const
+        {
+            assert(k < N);
+            return detail::AssumeAligned<Align>(m_data + k * m_stride);
+        }
+
+        iterator begin() { return iterator{ m_data, m_stride, 0 }; }
+        iterator end() { return iterator{ m_data, m_stride, m_size }; }
+        const_iterator begin() const { return const_iterator{ m_data, m_stride, 0 }; }
+        const_iterator end() const { return const_iterator{ m_data, m_stride, m_size }; }
+
+    private:
+        void Swap(ElementArray& other) noexcept
+        {
+            std::swap(m_alloc, other.m_alloc);
+            std::swap(m_data, other.m_data);
+            std::swap(m_size, other.m_size);
+            std::swap(m_stride, other.m_stride);
+        }
+
+        Allocator m_alloc;
+        T* m_data = nullptr;
+        size_t m_size = 0;
+        size_t m_stride = 0;
+    };
+
+    template <typename T, size_t N, Layout L = Layout::AoS, size_t Align = 16, typename Alloc = memory::AlignedAllocator<T, Align>>
+    using VecArray = ElementArray<Vec<T, N>, L, Align, Alloc>;
+
+    template <typename T, size_t M, size_t N, Layout L = Layout::AoS, size_t Align = 16, typename Alloc = memory::AlignedAllocator<T, Align>>
+    using MatArray = ElementArray<Mat<T, M, N>, L, Align, Alloc>;
+}
+
+#endif // J_ARRAY_H
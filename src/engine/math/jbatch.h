@@ -0,0 +1,81 @@
+#ifndef J_BATCH_H
+#define J_BATCH_H
+
+#include <cassert> // assert
+
+#include "jtypes.h"
+#include "jspan.h"
+#include "jsimd.h"
+#include "jmatrix.h"
+
+namespace jg
+{
+    /*
+     * Applies a 2D affine matrix (as built by Mat3f::Translation2D, Scale2D and
+     * Rotation2D) to structure-of-arrays points:
+     *
+     *   outX[i] = m00 * xs[i] + m01 * ys[i] + m02
+     *   outY[i] = m10 * xs[i] + m11 * ys[i] + m12
+     *
+     * The implicit w = 1 is folded into the translation column and the bottom row
+     * is assumed to be (0, 0, 1). Outputs may alias the inputs.
+     */
+    inline void TransformPoints2D(const Mat3f& mat,
+                                  Span<const f32> xs, Span<const f32> ys,
+                                  Span<f32> outX, Span<f32> outY)
+    {
+        assert(xs.size() == ys.size());
+        assert(outX.size() >= xs.size() && outY.size() >= xs.size());
+
+        const auto count = xs.size();
+        size_t i = 0;
+
+#if defined(JG_SIMD_AVX)
+        {
+            const auto m00 = _mm256_set1_ps(mat.m00), m01 = _mm256_set1_ps(mat.m01), m02 = _mm256_set1_ps(mat.m02);
+            const auto m10 = _mm256_set1_ps(mat.m10), m11 = _mm256_set1_ps(mat.m11), m12 = _mm256_set1_ps(mat.m12);
+            for (; i + 8 <= count; i += 8)
+            {
+                const auto x = _mm256_loadu_ps(xs.data() + i);
+                const auto y = _mm256_loadu_ps(ys.data() + i);
+                _mm256_storeu_ps(outX.data() + i, MulAdd(m00, x, MulAdd(m01, y, m02)));
+                _mm256_storeu_ps(outY.data() + i, MulAdd(m10, x, MulAdd(m11, y, m12)));
+            }
+        }
+#endif
+
+#if defined(JG_SIMD_SSE)
+        {
+            const auto m00 = _mm_set1_ps(mat.m00), m01 = _mm_set1_ps(mat.m01), m02 = _mm_set1_ps(mat.m02);
+            const auto m10 = _mm_set1_ps(mat.m10), m11 = _mm_set1_ps(mat.m11), m12 = _mm_set1_ps(mat.m12);
+            for (; i + 4 <= count; i += 4)
+            {
+                const auto x = _mm_loadu_ps(xs.data() + i);
+                const auto y = _mm_loadu_ps(ys.data() + i);
+                _mm_storeu_ps(outX.data() + i, MulAdd(m00, x, MulAdd(m01, y, m02)));
+                _mm_storeu_ps(outY.data() + i, MulAdd(m10, x, MulAdd(m11, y, m12)));
+            }
+        }
+#endif
+
+        for (; i < count; ++i)
+        {
+            const auto x = xs[i];
+            const auto y = ys[i];
+            outX[i] = mat.m00 * x + mat.m01 * y + mat.m02;
+            outY[i] = mat.m10 * x + mat.m11 * y + mat.m12;
+        }
+    }
+
+    // out[i] = parents[i] * locals[i]: local-to-parent transforms composed into parent space
+    inline void ComposeTransforms(Span<const Mat3f> parents, Span<const Mat3f> locals, Span<Mat3f> out)
+    {
+        assert(parents.size() == locals.size());
+        assert(out.size() >= locals.size());
+
+        for (size_t i = 0; i < locals.size(); ++i)
+            out[i] = parents[i] * locals[i];
+    }
+}
+
+#endif // J_BATCH_H
@@ -0,0 +1,114 @@
+#ifndef J_CMATH_H
+#define J_CMATH_H
+
+#include <cmath> // std::sqrt, std::sin, std::cos
+#include <limits> // std::numeric_limits
+#include <type_traits> // std::enable_if_t, std::is_floating_point_v
+
+#include "jtypes.h"
+
+/*
+ * True while the enclosing constexpr function is being evaluated at compile
+ * time. Lets the math functions use libm at runtime and a constexpr-capable
+ * implementation in constant expressions.
+ */
+#if defined(__cpp_lib_is_constant_evaluated)
+    #define JG_IS_CONSTANT_EVALUATED() std::is_constant_evaluated()
+#else
+    // Available as a builtin in GCC 9+, Clang 9+ and MSVC 19.25+, including in C++17 mode
+    #define JG_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+
+namespace jg
+{
+    template <typename T>
+    constexpr T Abs(const T& v) { return v < T{} ? -v : v; }
+
+    namespace cx
+    {
+        constexpr f64 PI_F64 = 3.14159265358979323846;
+
+        // Newton-Raphson on an argument scaled into [0.25, 4], accurate to about 1 ulp of f64
+        constexpr f64 Sqrt(f64 x)
+        {
+            if (!(x >= 0.0))
+                return std::numeric_limits<f64>::quiet_NaN();
+            if (x == 0.0 || x == std::numeric_limits<f64>::infinity())
+                return x;
+
+            auto scale = 1.0;
+            while (x > 4.0)
+            {
+                x *= 0.25;
+                scale *= 2.0;
+            }
+            while (x < 0.25)
+            {
+                x *= 4.0;
+                scale *= 0.5;
+            }
+
+            auto guess = 1.0;
+            for (auto i = 0; i < 8; ++i)
+                guess = 0.5 * (guess + x / guess);
+            return guess * scale;
+        }
+
+        // Taylor series after reducing to [-pi/2, pi/2]. Accurate to about 1e-15
+        // absolute for |x| < 1e6, losing precision as |x| grows
+        constexpr f64 Sin(f64 x)
+        {
+            constexpr auto twoPi = 2.0 * PI_F64;
+            auto turns = x / twoPi;
+            auto whole = static_cast<f64>(static_cast<i64>(turns + (turns < 0.0 ? -0.5 : 0.5)));
+            auto r = x - whole * twoPi;
+
+            if (r > 0.5 * PI_F64)
+                r = PI_F64 - r;
+            else if (r < -0.5 * PI_F64)
+                r = -PI_F64 - r;
+
+            auto term = r;
+            auto sum = r;
+            for (auto n = 1; n < 12; ++n)
+            {
+                term *= -r * r / static_cast<f64>((2 * n) * (2 * n + 1));
+                sum += term;
+            }
+            return sum;
+        }
+
+        constexpr f64 Cos(f64 x) { return Sin(x + 0.5 * PI_F64); }
+    }
+
+    /*
+     * constexpr-capable sqrt, sin and cos. At runtime they forward to the
+     * standard library; in constant expressions they use the jg::cx versions,
+     * which agree with libm to within 1 ulp of f32
+     */
+    template <typename T, typename = std::enable_if_t<std::is_floating_point_v<T>>>
+    constexpr T Sqrt(const T& x)
+    {
+        if (JG_IS_CONSTANT_EVALUATED())
+            return static_cast<T>(cx::Sqrt(static_cast<f64>(x)));
+        return std::sqrt(x);
+    }
+
+    template <typename T, typename = std::enable_if_t<std::is_floating_point_v<T>>>
+    constexpr T Sin(const T& x)
+    {
+        if (JG_IS_CONSTANT_EVALUATED())
+            return static_cast<T>(cx::Sin(static_cast<f64>(x)));
+        return std::sin(x);
+    }
+
+    template <typename T, typename = std::enable_if_t<std::is_floating_point_v<T>>>
+    constexpr T Cos(const T& x)
+    {
+        if (JG_IS_CONSTANT_EVALUATED())
+            return static_cast<T>(cx::Cos(static_cast<f64>(x)));
+        return std::cos(x);
+    }
+}
+
+#endif // J_CMATH_H
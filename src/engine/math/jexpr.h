@@ -0,0 +1,262 @@
+#ifndef J_EXPR_H
+#define J_EXPR_H
+
+#include <type_traits> // std::enable_if_t, std::is_base_of_v, std::is_arithmetic_v
+
+#include "jtypes.h"
+#include "jsimd.h"
+#include "jvec.h"
+#include "jmatrix.h"
+
+/*
+ * Opt-in expression templates for element-wise Vec/Mat arithmetic.
+ *
+ * Wrapping an operand in expr::Lazy() turns the operators that follow into
+ * nodes that only record the expression. Nothing is computed until the tree is
+ * handed to expr::Eval() or expr::Assign(), which then run a single loop over
+ * the elements with no intermediate Vec/Mat:
+ *
+ *   out = expr::Eval(expr::Lazy(a) + expr::Lazy(b) * s - c);
+ *   expr::Assign(out, expr::Lazy(a) + expr::Lazy(b) * s - c);
+ *
+ * Operator precedence still applies: in Lazy(a) + b * s, b * s is an eager
+ * product, so scaled operands need their own Lazy().
+ *
+ * With SSE, f32 results whose size is a multiple of 4 (Vec4f, Mat4f, Vec<f32, 8>,
+ * ...) are evaluated 4 lanes at a time, so Vec4f keeps the speed of its eager
+ * SSE operators. Other types and constant expressions use the scalar loop.
+ *
+ * Only element-wise operations are fused (+, -, negation, scaling). Mat * Mat
+ * and Mat * Vec stay eager. Nodes reference their operands, so an expression
+ * must be evaluated within the full-expression that builds it.
+ */
+namespace jg
+{
+    namespace expr
+    {
+        template <typename C>
+        struct Traits;
+
+        template <typename T, size_t N>
+        struct Traits<Vec<T, N>>
+        {
+            using Scalar = T;
+            static constexpr size_t SIZE = N;
+            static constexpr Vec<T, N> Make() { return Vec<T, N>{ T{} }; }
+        };
+
+        template <typename T, size_t M, size_t N>
+        struct Traits<Mat<T, M, N>>
+        {
+            using Scalar = T;
+            static constexpr size_t SIZE = M * N;
+            static constexpr Mat<T, M, N> Make() { return Mat<T, M, N>{}; }
+        };
+
+        // CRTP tag shared by every expression node
+        template <typename Derived>
+        struct Node {};
+
+        template <typename E>
+        constexpr bool IS_NODE = std::is_base_of_v<Node<E>, E>;
+
+        template <typename C, typename = void>
+        constexpr bool IS_OPERAND = false;
+        template <typename C>
+        constexpr bool IS_OPERAND<C, std::void_t<decltype(Traits<C>::SIZE)>> = true;
+
+#if defined(JG_SIMD_SSE)
+        // Evaluated through Packet(), 4 elements per __m128
+        template <typename C>
+        constexpr bool IS_PACKED = std::is_same_v<typename Traits<C>::Scalar, f32> && Traits<C>::SIZE % 4 == 0;
+#endif
+
+        // Leaf referencing a Vec or Mat
+        template <typename C>
+        struct Ref : Node<Ref<C>>
+        {
+            using Result = C;
+            using Scalar = typename Traits<C>::Scalar;
+
+            const C& operand;
+
+            explicit constexpr Ref(const C& c) : operand{ c } {}
+            constexpr Scalar operator[](size_t index) const { return operand.data[index]; }
+#if defined(JG_SIMD_SSE)
+            __m128 Packet(size_t index) const
+            {
+                if constexpr (alignof(C) % 16 == 0)
+                    return _mm_load_ps(&operand.data[index]);
+                return _mm_loadu_ps(&operand.data[index]);
+            }
+#endif
+        };
+
+        // Leaf broadcasting a scalar to every element
+        template <typename T>
+        struct Constant : Node<Constant<T>>
+        {
+            using Scalar = T;
+
+            T value;
+
+            explicit constexpr Constant(const T& v) : value{ v } {}
+            constexpr T operator[](size_t) const { return value; }
+#if defined(JG_SIMD_SSE)
+            __m128 Packet(size_t) const { return _mm_set1_ps(value); }
+#endif
+        };
+
+        struct Add
+        {
+            template <typename T> static constexpr T Apply(const T& a, const T& b) { return a + b; }
+#if defined(JG_SIMD_SSE)
+            static __m128 Apply(__m128 a, __m128 b) { return _mm_add_ps(a, b); }
+#endif
+        };
+
+        struct Sub
+        {
+            template <typename T> static constexpr T Apply(const T& a, const T& b) { return a - b; }
+#if defined(JG_SIMD_SSE)
+            static __m128 Apply(__m128 a, __m128 b) { return _mm_sub_ps(a, b); }
+#endif
+        };
+
+        struct Mul
+        {
+            template <typename T> static constexpr T Apply(const T& a, const T& b) { return a * b; }
+#if defined(JG_SIMD_SSE)
+            static __m128 Apply(__m128 a, __m128 b) { return _mm_mul_ps(a, b); }
+#endif
+        };
+
+        struct Div
+        {
+            template <typename T> static constexpr T Apply(const T& a, const T& b) { return a / b; }
+#if defined(JG_SIMD_SSE)
+            static __m128 Apply(__m128 a, __m128 b) { return _mm_div_ps(a, b); }
+#endif
+        };
+
+        // L always carries the result type; scalars only ever appear as R
+        template <typename Op, typename L, typename R>
+        struct Binary : Node<Binary<Op, L, R>>
+        {
+            using Result = typename L::Result;
+            using Scalar = typename L::Scalar;
+
+            L lhs;
+            R rhs;
+
+            explicit constexpr Binary(const L& l, const R& r) : lhs{ l }, rhs{ r } {}
+            constexpr Scalar operator[](size_t index) const { return Op::Apply(lhs[index], rhs[index]); }
+#if defined(JG_SIMD_SSE)
+            __m128 Packet(size_t index) const { return Op::Apply(lhs.Packet(index), rhs.Packet(index)); }
+#endif
+        };
+
+        template <typename E>
+        struct Negate : Node<Negate<E>>
+        {
+            using Result = typename E::Result;
+            using Scalar = typename E::Scalar;
+
+            E operand;
+
+            explicit constexpr Negate(const E& e) : operand{ e } {}
+            constexpr Scalar operator[](size_t index) const { return -operand[index]; }
+#if defined(JG_SIMD_SSE)
+            // Flip the sign bit so -0.0f matches the scalar path
+            __m128 Packet(size_t index) const { return _mm_xor_ps(operand.Packet(index), _mm_set1_ps(-0.0f)); }
+#endif
+        };
+
+        template <typename C, typename = std::enable_if_t<IS_OPERAND<C>>>
+        constexpr Ref<C> Lazy(const C& c) { return Ref<C>{ c }; }
+
+        template <typename E>
+        constexpr const E& Wrap(const Node<E>& e) { return static_cast<const E&>(e); }
+        template <typename C, typename = std::enable_if_t<IS_OPERAND<C>>>
+        constexpr Ref<C> Wrap(const C& c) { return Ref<C>{ c }; }
+
+        template <typename C, typename E>
+        constexpr void Assign(C& dst, const Node<E>& e)
+        {
+            static_assert(std::is_same_v<C, typename E::Result>, "Expression does not evaluate to the destination type");
+            const auto& node = static_cast<const E&>(e);
+#if defined(JG_SIMD_SSE)
+            if constexpr (IS_PACKED<C>)
+            {
+                if (!JG_IS_CONSTANT_EVALUATED())
+                {
+                    for (size_t i = 0; i < Traits<C>::SIZE; i += 4)
+                    {
+                        if constexpr (alignof(C) % 16 == 0)
+                            _mm_store_ps(&dst.data[i], node.Packet(i));
+                        else
+                            _mm_storeu_ps(&dst.data[i], node.Packet(i));
+                    }
+                    return;
+                }
+            }
+#endif
+            for (size_t i = 0; i < Traits<C>::SIZE; ++i)
+                dst.data[i] = node[i];
+        }
+
+        template <typename E>
+        constexpr typename E::Result Eval(const Node<E>& e)
+        {
+            auto ret = Traits<typename E::Result>::Make();
+            Assign(ret, e);
+            return ret;
+        }
+
+        // At least one side must already be an expression so plain Vec/Mat arithmetic stays eager
+        template <typename L, typename R>
+        constexpr bool IS_ELEMENTWISE = (IS_NODE<L> || IS_NODE<R>)
+                                     && (IS_NODE<L> || IS_OPERAND<L>)
+                                     && (IS_NODE<R> || IS_OPERAND<R>);
+
+        template <typename L, typename R, typename = std::enable_if_t<IS_ELEMENTWISE<L, R>>>
+        constexpr auto operator+(const L& lhs, const R& rhs)
+        {
+            using LE = std::decay_t<decltype(Wrap(lhs))>;
+            using RE = std::decay_t<decltype(Wrap(rhs))>;
+            static_assert(std::is_same_v<typename LE::Result, typename RE::Result>, "Operand types differ");
+            return Binary<Add, LE, RE>{ Wrap(lhs), Wrap(rhs) };
+        }
+
+        template <typename L, typename R, typename = std::enable_if_t<IS_ELEMENTWISE<L, R>>>
+        constexpr auto operator-(const L& lhs, const R& rhs)
+        {
+            using LE = std::decay_t<decltype(Wrap(lhs))>;
+            using RE = std::decay_t<decltype(Wrap(rhs))>;
+            static_assert(std::is_same_v<typename LE::Result, typename RE::Result>, "Operand types differ");
+            return Binary<Sub, LE, RE>{ Wrap(lhs), Wrap(rhs) };
+        }
+
+        template <typename E>
+        constexpr Negate<E> operator-(const Node<E>& e) { return Negate<E>{ static_cast<const E&>(e) }; }
+
+        template <typename E, typename S, typename = std::enable_if_t<std::is_arithmetic_v<S>>>
+        constexpr auto operator*(const Node<E>& e, const S& s)
+        {
+            using T = typename E::Scalar;
+            return Binary<Mul, E, Constant<T>>{ static_cast<const E&>(e), Constant<T>{ static_cast<T>(s) } };
+        }
+
+        template <typename E, typename S, typename = std::enable_if_t<std::is_arithmetic_v<S>>>
+        constexpr auto operator*(const S& s, const Node<E>& e) { return e * s; }
+
+        template <typename E, typename S, typename = std::enable_if_t<std::is_arithmetic_v<S>>>
+        constexpr auto operator/(const Node<E>& e, const S& s)
+        {
+            using T = typename E::Scalar;
+            return Binary<Div, E, Constant<T>>{ static_cast<const E&>(e), Constant<T>{ static_cast<T>(s) } };
+        }
+    }
+}
+
+#endif // J_EXPR_H
@@ -0,0 +1,181 @@
+#ifndef J_FAST_MATH_H
+#define J_FAST_MATH_H
+
+#include <cstring> // std::memcpy
+
+#include "jtypes.h"
+#include "jsimd.h"
+#include "jvec.h"
+#include "jmatrix.h"
+#include "jmath_consts.h"
+
+/*
+ * Approximate f32 math for hot loops (physics, steering, particles) where
+ * libm precision is not needed. Error bounds are measured against the f64
+ * libm result and checked in fastmath_test.cpp.
+ */
+namespace jg
+{
+    namespace fast
+    {
+        namespace detail
+        {
+            inline u32 ToBits(f32 f)
+            {
+                u32 u;
+                std::memcpy(&u, &f, sizeof(u));
+                return u;
+            }
+
+            inline f32 FromBits(u32 u)
+            {
+                f32 f;
+                std::memcpy(&f, &u, sizeof(f));
+                return f;
+            }
+
+            // Plain C++ rather than cvtss2si so loops over these functions still auto-vectorize
+            inline i32 RoundToInt(f32 x)
+            {
+                return static_cast<i32>(x + (x < 0.0f ? -0.5f : 0.5f));
+            }
+
+            // Bit-level initial guess plus two Newton steps, max relative error 5e-6
+            inline f32 RSqrtNewton(f32 x)
+            {
+                auto est = FromBits(0x5f375a86u - (ToBits(x) >> 1));
+                est = est * (1.5f - 0.5f * x * est * est);
+                return est * (1.5f - 0.5f * x * est * est);
+            }
+        }
+
+        /*
+         * 1 / sqrt(x) for x > 0.
+         * SSE: rsqrtss plus one Newton step, max relative error 5e-7.
+         * Portable: bit-level initial guess plus two Newton steps, max relative error 5e-6.
+         */
+        inline f32 RSqrt(f32 x)
+        {
+#if defined(JG_SIMD_SSE)
+            const auto est = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x)));
+            return est * (1.5f - 0.5f * x * est * est);
+#else
+            return detail::RSqrtNewton(x);
+#endif
+        }
+
+        // vec / Length(vec) with one RSqrt and N multiplies instead of a sqrt and N divides
+        template <size_t N>
+        Vec<f32, N> NormalizeFast(const Vec<f32, N>& vec) { return vec * RSqrt(LengthSq(vec)); }
+
+#if defined(JG_SIMD_SSE)
+        inline Vec<f32, 4> NormalizeFast(const Vec<f32, 4>& vec)
+        {
+            const auto lenSq = DotSplat(vec, vec);
+            const auto est = _mm_rsqrt_ps(lenSq);
+            // est * (1.5 - 0.5 * lenSq * est^2)
+            const auto refined = _mm_mul_ps(est, _mm_sub_ps(_mm_set1_ps(1.5f),
+                _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), lenSq), _mm_mul_ps(est, est))));
+            return Vec<f32, 4>{ _mm_mul_ps(vec.simd, refined) };
+        }
+#endif
+
+        struct SinCosResult
+        {
+            f32 sin;
+            f32 cos;
+        };
+
+        /*
+         * Sine and cosine from one shared range reduction.
+         * Max absolute error 2e-7 for |x| <= 8192; beyond that the reduction
+         * loses precision like any single-precision implementation.
+         */
+        inline SinCosResult SinCos(f32 x)
+        {
+            // Quadrant of x, then x - quadrant * pi/2 with pi/2 split in three for extra precision
+            const auto quadrant = detail::RoundToInt(x * 0.636619772f);
+            const auto q = static_cast<f32>(quadrant);
+            auto r = x - q * 1.5703125f;
+            r -= q * 4.83751296997e-4f;
+            r -= q * 7.54978995489e-8f;
+
+            const auto r2 = r * r;
+            const auto s = r + r * r2 * (-1.6666654611e-1f + r2 * (8.3321608736e-3f + r2 * -1.9515295891e-4f));
+            const auto c = 1.0f - 0.5f * r2 + r2 * r2 * (4.166664568298827e-2f + r2 * (-1.388731625493765e-3f + r2 * 2.443315711809948e-5f));
+
+            // Odd quadrants swap sin and cos; the sign flips follow the quadrant bits.
+            // Blending on bits keeps both polynomials live even when a caller only
+            // reads one of them, otherwise the unused one becomes a branch that
+            // blocks vectorization
+            const auto swapMask = 0u - static_cast<u32>(quadrant & 1);
+            const auto sBits = detail::ToBits(s);
+            const auto cBits = detail::ToBits(c);
+            const auto sinBits = (sBits & ~swapMask) | (cBits & swapMask);
+            const auto cosBits = (cBits & ~swapMask) | (sBits & swapMask);
+            return SinCosResult{
+                detail::FromBits(sinBits ^ (static_cast<u32>(quadrant & 2) << 30)),
+                detail::FromBits(cosBits ^ (static_cast<u32>((quadrant + 1) & 2) << 30))
+            };
+        }
+
+        // Mat3f::Rotation2D with a single SinCos
+        inline Mat3f Rotation2D(f32 rad)
+        {
+            const auto sc = SinCos(rad);
+            return Mat3f{
+                 sc.cos, sc.sin, 0.0f,
+                -sc.sin, sc.cos, 0.0f,
+                   0.0f,   0.0f, 1.0f
+            };
+        }
+
+        /*
+         * atan2(y, x) in [-pi, pi]. Max absolute error 5e-7 rad.
+         * Returns 0 for (0, 0).
+         */
+        inline f32 Atan2(f32 y, f32 x)
+        {
+            const auto ax = x < 0.0f ? -x : x;
+            const auto ay = y < 0.0f ? -y : y;
+            const auto maxAbs = ax > ay ? ax : ay;
+            const auto minAbs = ax > ay ? ay : ax;
+
+            // atan on [0, 1], then unfold the octant. Selects rather than
+            // branches so loops over Atan2 auto-vectorize; clamping the divisor
+            // instead of testing for (0, 0) only affects denormal inputs
+            const auto z = minAbs / (maxAbs > 1.17549435e-38f ? maxAbs : 1.17549435e-38f);
+            const auto z2 = z * z;
+            auto a = z * (0.99999934f + z2 * (-0.33329856f + z2 * (0.19946536f + z2 * (-0.13908534f
+                   + z2 * (0.09642004f + z2 * (-0.05590988f + z2 * (0.02186123f + z2 * -0.00405400f)))))));
+
+            // Select between constants only: selecting between two computed
+            // values turns back into a branch under -ftrapping-math
+            a += (ay > ax ? 1.0f : 0.0f) * (HALF_PI - 2.0f * a);
+            a += (x < 0.0f ? 1.0f : 0.0f) * (PI - 2.0f * a);
+            return (y < 0.0f ? -1.0f : 1.0f) * a;
+        }
+
+        /*
+         * e^x. Max relative error 3e-7 for x in [-87, 88]; returns 0 below
+         * and +inf above that range.
+         */
+        inline f32 Exp(f32 x)
+        {
+            const auto clamped = x < -87.0f ? -87.0f : (x > 88.0f ? 88.0f : x);
+
+            // e^x = 2^n * e^r with n = round(x / ln2) and |r| <= ln2 / 2
+            const auto n = detail::RoundToInt(clamped * 1.44269504f);
+            const auto fn = static_cast<f32>(n);
+            auto r = clamped - fn * 0.693359375f;
+            r -= fn * -2.12194440e-4f;
+
+            const auto p = 1.0f + r * (1.0f + r * (0.5f + r * (1.6666665459e-1f
+                         + r * (4.1665795894e-2f + r * (8.3334519073e-3f + r * 1.3981999507e-3f)))));
+            const auto result = p * detail::FromBits(static_cast<u32>(n + 127) << 23);
+            return x < -87.0f ? 0.0f : (x > 88.0f ? detail::FromBits(0x7f800000u) : result);
+        }
+    }
+}
+
+#endif // J_FAST_MATH_H
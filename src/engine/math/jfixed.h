@@ -0,0 +1,208 @@
+#ifndef J_FIXED_H
+#define J_FIXED_H
+
+#include <cassert> // assert
+#include <array> // std::array
+
+#include "jtypes.h"
+#include "jcmath.h"
+#include "jvec.h"
+#include "jmatrix.h"
+
+namespace jg
+{
+    /*
+     * Signed 16.16 fixed point: a raw i32 in units of 1/65536, covering
+     * [-32768, 32768) in steps of about 1.5e-5. Every operation is integer
+     * arithmetic and therefore bit-identical on every platform and compiler.
+     * Addition wraps on overflow; products and quotients are computed in 64
+     * bits and truncated back to 32.
+     *
+     * Together with Sqrt, Sin and Cos below and the Vec/Mat overloads, this is
+     * the math backend for lockstep simulation: converting from floating
+     * point is only deterministic for constants, never for computed values.
+     */
+    struct fixed
+    {
+        static constexpr i32 FRACTION_BITS = 16;
+        static constexpr i32 ONE = 1 << FRACTION_BITS;
+
+        i32 raw = 0;
+
+        static constexpr fixed FromRaw(i32 r)
+        {
+            fixed f;
+            f.raw = r;
+            return f;
+        }
+
+        constexpr fixed() = default;
+        explicit constexpr fixed(int value) : raw{ static_cast<i32>(static_cast<u32>(value) << FRACTION_BITS) } {}
+        // Rounds half away from zero; value must be in range
+        explicit constexpr fixed(f64 value) : raw{ static_cast<i32>(value * ONE + (value < 0.0 ? -0.5 : 0.5)) } {}
+        explicit constexpr fixed(f32 value) : fixed{ static_cast<f64>(value) } {}
+
+        explicit constexpr operator f64() const { return static_cast<f64>(raw) / ONE; }
+        explicit constexpr operator f32() const { return static_cast<f32>(static_cast<f64>(*this)); }
+        // Rounds toward negative infinity
+        explicit constexpr operator int() const { return raw >> FRACTION_BITS; }
+
+        constexpr fixed operator-() const { return FromRaw(static_cast<i32>(0u - static_cast<u32>(raw))); }
+
+        constexpr fixed& operator+=(fixed rhs) { raw = static_cast<i32>(static_cast<u32>(raw) + static_cast<u32>(rhs.raw)); return *this; }
+        constexpr fixed& operator-=(fixed rhs) { raw = static_cast<i32>(static_cast<u32>(raw) - static_cast<u32>(rhs.raw)); return *this; }
+        // Rounded to nearest
+        constexpr fixed& operator*=(fixed rhs)
+        {
+            raw = static_cast<i32>((static_cast<i64>(raw) * rhs.raw + (ONE >> 1)) >> FRACTION_BITS);
+            return *this;
+        }
+        // Truncated toward zero
+        constexpr fixed& operator/=(fixed rhs)
+        {
+            assert(rhs.raw != 0);
+            raw = static_cast<i32>(static_cast<i64>(raw) * ONE / rhs.raw);
+            return *this;
+        }
+    };
+
+    constexpr fixed operator+(fixed lhs, fixed rhs) { return lhs += rhs; }
+    constexpr fixed operator-(fixed lhs, fixed rhs) { return lhs -= rhs; }
+    constexpr fixed operator*(fixed lhs, fixed rhs) { return lhs *= rhs; }
+    constexpr fixed operator/(fixed lhs, fixed rhs) { return lhs /= rhs; }
+
+    constexpr bool operator==(fixed lhs, fixed rhs) { return lhs.raw == rhs.raw; }
+    constexpr bool operator!=(fixed lhs, fixed rhs) { return lhs.raw != rhs.raw; }
+    constexpr bool operator<(fixed lhs, fixed rhs) { return lhs.raw < rhs.raw; }
+    constexpr bool operator>(fixed lhs, fixed rhs) { return lhs.raw > rhs.raw; }
+    constexpr bool operator<=(fixed lhs, fixed rhs) { return lhs.raw <= rhs.raw; }
+    constexpr bool operator>=(fixed lhs, fixed rhs) { return lhs.raw >= rhs.raw; }
+
+    namespace detail
+    {
+        // Largest r with r * r <= n
+        constexpr u64 ISqrt(u64 n)
+        {
+            if (!JG_IS_CONSTANT_EVALUATED())
+            {
+                // The f64 root is only an estimate, off by at most one after rounding n;
+                // the integer fix-up makes the result exact, so it is still deterministic
+                auto r = static_cast<u64>(std::sqrt(static_cast<f64>(n)));
+                r = r > 0xFFFFFFFFu ? 0xFFFFFFFFu : r;
+                while (r * r > n)
+                    --r;
+                while (r < 0xFFFFFFFFu && (r + 1) * (r + 1) <= n)
+                    ++r;
+                return r;
+            }
+
+            u64 root = 0;
+            u64 bit = u64{ 1 } << 62;
+            while (bit > n)
+                bit >>= 2;
+            while (bit != 0)
+            {
+                if (n >= root + bit)
+                {
+                    n -= root + bit;
+                    root = (root >> 1) + bit;
+                }
+                else
+                {
+                    root >>= 1;
+                }
+                bit >>= 2;
+            }
+            return root;
+        }
+
+        // Quarter sine wave, sin(i * pi / 512) for i in [0, 256], in raw 16.16 units.
+        // Built at compile time, so every build carries the same table
+        constexpr i32 SIN_TABLE_STEPS = 256;
+
+        constexpr std::array<i32, SIN_TABLE_STEPS + 1> MakeSinTable()
+        {
+            std::array<i32, SIN_TABLE_STEPS + 1> table{};
+            for (i32 i = 0; i <= SIN_TABLE_STEPS; ++i)
+                table[i] = static_cast<i32>(cx::Sin(i * cx::PI_F64 / (2 * SIN_TABLE_STEPS)) * fixed::ONE + 0.5);
+            return table;
+        }
+
+        inline constexpr auto SIN_TABLE = MakeSinTable();
+
+        // Angle as a fraction of a full turn: 2^32 is one turn, so wrapping is free
+        constexpr u32 TurnPhase(fixed rad)
+        {
+            // round(2^32 / (2 * pi)), applied to raw = rad * 2^16
+            constexpr i64 PHASE_PER_RAW = 683565276;
+            return static_cast<u32>(static_cast<u64>(rad.raw * PHASE_PER_RAW) >> fixed::FRACTION_BITS);
+        }
+
+        // Linear interpolation between table entries; the error is below 5e-6, under one raw unit
+        constexpr fixed SinPhase(u32 phase)
+        {
+            constexpr u32 QUARTER = 1u << 30;
+            constexpr u32 STEP_BITS = 30 - 8; // log2(QUARTER / SIN_TABLE_STEPS)
+            static_assert(SIN_TABLE_STEPS == 1 << 8, "STEP_BITS assumes 256 steps");
+
+            const auto quadrant = phase >> 30;
+            auto p = phase & (QUARTER - 1);
+            if (quadrant & 1)
+                p = QUARTER - p;
+
+            const auto index = p >> STEP_BITS;
+            const auto fraction = static_cast<i64>(p & ((1u << STEP_BITS) - 1));
+            auto raw = SIN_TABLE[index];
+            if (index < SIN_TABLE_STEPS)
+                raw += static_cast<i32>(((SIN_TABLE[index + 1] - raw) * fraction + (i64{ 1 } << (STEP_BITS - 1))) >> STEP_BITS);
+            return fixed::FromRaw(quadrant & 2 ? -raw : raw);
+        }
+    }
+
+    // Integer square root of raw * 2^16, rounded down; negative input gives 0
+    constexpr fixed Sqrt(fixed x)
+    {
+        if (x.raw <= 0)
+            return fixed{};
+        return fixed::FromRaw(static_cast<i32>(detail::ISqrt(static_cast<u64>(x.raw) << fixed::FRACTION_BITS)));
+    }
+
+    // Table based, for any angle in radians. Picked up by Mat3::Rotation2D and friends
+    constexpr fixed Sin(fixed rad) { return detail::SinPhase(detail::TurnPhase(rad)); }
+    constexpr fixed Cos(fixed rad) { return detail::SinPhase(detail::TurnPhase(rad) + (1u << 30)); }
+
+    /*
+     * Vec overloads that keep the full 32.32 products in 64 bits and round
+     * once, instead of rounding every term. The sums wrap in u64 like fixed
+     * addition does, which needs a product of about 2^62, i.e. a result far
+     * outside the fixed range. Length also squares in 64 bits, so it does not
+     * overflow until the result itself leaves the fixed range, for any N.
+     */
+    template <size_t N>
+    constexpr fixed Dot(const Vec<fixed, N>& lhs, const Vec<fixed, N>& rhs)
+    {
+        u64 sum = 0;
+        for (size_t i = 0; i < N; ++i)
+            sum += static_cast<u64>(static_cast<i64>(lhs[i].raw) * rhs[i].raw);
+        const auto rounded = static_cast<i64>(sum + (fixed::ONE >> 1));
+        return fixed::FromRaw(static_cast<i32>(rounded >> fixed::FRACTION_BITS));
+    }
+
+    template <size_t N>
+    constexpr fixed Length(const Vec<fixed, N>& vec)
+    {
+        u64 sum = 0;
+        for (size_t i = 0; i < N; ++i)
+            sum += static_cast<u64>(static_cast<i64>(vec[i].raw) * vec[i].raw);
+        return fixed::FromRaw(static_cast<i32>(detail::ISqrt(sum)));
+    }
+
+    using Vec2fx = Vec<fixed, 2>;
+    using Vec3fx = Vec<fixed, 3>;
+    using Vec4fx = Vec<fixed, 4>;
+    using Mat2fx = Mat<fixed, 2, 2>;
+    using Mat3fx = Mat<fixed, 3, 3>;
+    using Mat4fx = Mat<fixed, 4, 4>;
+}
+
+#endif // J_FIXED_H
@@ -0,0 +1,125 @@
+#ifndef J_HALF_H
+#define J_HALF_H
+
+#include <cstring> // std::memcpy
+
+#include "jtypes.h"
+#include "jsimd.h"
+#include "jcmath.h"
+#include "jvec.h"
+
+namespace jg
+{
+    namespace detail
+    {
+        inline u32 F32Bits(f32 f)
+        {
+            u32 u;
+            std::memcpy(&u, &f, sizeof(u));
+            return u;
+        }
+
+        inline f32 F32FromBits(u32 u)
+        {
+            f32 f;
+            std::memcpy(&f, &u, sizeof(f));
+            return f;
+        }
+
+        // Round to nearest even; overflow goes to infinity, NaNs stay quiet NaNs
+        inline u16 F32ToF16Bits(f32 value)
+        {
+#if defined(JG_SIMD_F16C)
+            return static_cast<u16>(_cvtss_sh(value, _MM_FROUND_TO_NEAREST_INT));
+#else
+            auto x = F32Bits(value);
+            const auto sign = (x >> 16) & 0x8000u;
+            x &= 0x7FFFFFFFu;
+
+            if (x >= 0x47800000u) // >= 65536, infinity or NaN
+                return static_cast<u16>(sign | (x > 0x7F800000u ? 0x7E00u : 0x7C00u));
+            if (x < 0x38800000u) // Below the smallest normal half: let the FPU round the subnormal
+                return static_cast<u16>(sign | (F32Bits(F32FromBits(x) + 0.5f) - 0x3F000000u));
+
+            // Rebias the exponent and round the 13 dropped mantissa bits to even
+            const auto mantissaOdd = (x >> 13) & 1u;
+            x += 0xC8000FFFu + mantissaOdd;
+            return static_cast<u16>(sign | (x >> 13));
+#endif
+        }
+
+        // Exact
+        inline f32 F16BitsToF32(u16 bits)
+        {
+#if defined(JG_SIMD_F16C)
+            return _cvtsh_ss(bits);
+#else
+            const auto sign = static_cast<u32>(bits & 0x8000u) << 16;
+            const auto exponent = (bits >> 10) & 0x1Fu;
+            const auto mantissa = static_cast<u32>(bits & 0x3FFu);
+
+            if (exponent == 0) // Zero or subnormal: mantissa * 2^-24
+                return F32FromBits(sign | F32Bits(static_cast<f32>(mantissa) * 5.9604645e-8f));
+            if (exponent == 31)
+                return F32FromBits(sign | 0x7F800000u | (mantissa << 13));
+            return F32FromBits(sign | ((exponent + 112u) << 23) | (mantissa << 13));
+#endif
+        }
+    }
+
+    /*
+     * IEEE 754 binary16: 1 sign, 5 exponent and 10 mantissa bits, about 3
+     * significant digits and a range of +-65504. A storage format: arithmetic
+     * converts to f32, computes and rounds back, so keep hot math in f32 and
+     * convert whole arrays with PackHalf/UnpackHalf (jpack.h).
+     */
+    struct f16
+    {
+        u16 bits = 0;
+
+        static constexpr f16 FromBits(u16 b)
+        {
+            f16 h;
+            h.bits = b;
+            return h;
+        }
+
+        constexpr f16() = default;
+        explicit f16(f32 value) : bits{ detail::F32ToF16Bits(value) } {}
+        explicit f16(f64 value) : f16{ static_cast<f32>(value) } {}
+        explicit f16(int value) : f16{ static_cast<f32>(value) } {}
+
+        explicit operator f32() const { return detail::F16BitsToF32(bits); }
+        explicit operator f64() const { return static_cast<f64>(static_cast<f32>(*this)); }
+
+        f16 operator-() const { return FromBits(static_cast<u16>(bits ^ 0x8000u)); }
+
+        f16& operator+=(f16 rhs) { return *this = f16{ static_cast<f32>(*this) + static_cast<f32>(rhs) }; }
+        f16& operator-=(f16 rhs) { return *this = f16{ static_cast<f32>(*this) - static_cast<f32>(rhs) }; }
+        f16& operator*=(f16 rhs) { return *this = f16{ static_cast<f32>(*this) * static_cast<f32>(rhs) }; }
+        f16& operator/=(f16 rhs) { return *this = f16{ static_cast<f32>(*this) / static_cast<f32>(rhs) }; }
+    };
+
+    static_assert(sizeof(f16) == 2, "f16 must stay two bytes for packed arrays");
+
+    inline f16 operator+(f16 lhs, f16 rhs) { return lhs += rhs; }
+    inline f16 operator-(f16 lhs, f16 rhs) { return lhs -= rhs; }
+    inline f16 operator*(f16 lhs, f16 rhs) { return lhs *= rhs; }
+    inline f16 operator/(f16 lhs, f16 rhs) { return lhs /= rhs; }
+
+    // By value, so -0 == +0 and NaN compares unequal like f32
+    inline bool operator==(f16 lhs, f16 rhs) { return static_cast<f32>(lhs) == static_cast<f32>(rhs); }
+    inline bool operator!=(f16 lhs, f16 rhs) { return !(lhs == rhs); }
+    inline bool operator<(f16 lhs, f16 rhs) { return static_cast<f32>(lhs) < static_cast<f32>(rhs); }
+    inline bool operator>(f16 lhs, f16 rhs) { return rhs < lhs; }
+    inline bool operator<=(f16 lhs, f16 rhs) { return static_cast<f32>(lhs) <= static_cast<f32>(rhs); }
+    inline bool operator>=(f16 lhs, f16 rhs) { return rhs <= lhs; }
+
+    inline f16 Sqrt(f16 x) { return f16{ Sqrt(static_cast<f32>(x)) }; }
+
+    using Vec2h = Vec<f16, 2>;
+    using Vec3h = Vec<f16, 3>;
+    using Vec4h = Vec<f16, 4>;
+}
+
+#endif // J_HALF_H
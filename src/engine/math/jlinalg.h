@@ -0,0 +1,335 @@
+#ifndef J_LINALG_H
+#define J_LINALG_H
+
+#include <cassert> // assert
+#include <array> // std::array
+#include <optional> // std::optional, std::nullopt
+#include <type_traits> // std::is_floating_point
+
+#include "jtypes.h"
+#include "jvec.h"
+#include "jmatrix.h"
+#include "jmath_consts.h"
+#include "jcmath.h"
+
+/*
+ * Fixed-size decompositions and solvers for the generic Mat. Everything is
+ * constexpr and works on the column-major data array; the inner loops run
+ * down columns so they stay contiguous.
+ *
+ * A matrix counts as singular (or not positive definite, or rank deficient)
+ * when a pivot falls to N * epsilon times its largest element, and the
+ * Decompose* functions then return std::nullopt. Decompose once and Solve
+ * as often as needed; solving never forms an explicit inverse.
+ */
+namespace jg
+{
+    template <typename T, size_t N>
+    struct LUDecomposition
+    {
+        Mat<T, N, N> lu; // Unit lower L below the diagonal, U on and above it
+        std::array<size_t, N> pivots{}; // Row i of P * A is row pivots[i] of A
+        T sign = static_cast<T>(1); // Determinant of P
+    };
+
+    template <typename T, size_t N>
+    struct CholeskyDecomposition
+    {
+        Mat<T, N, N> l; // Lower triangular, zero above the diagonal
+    };
+
+    template <typename T, size_t M, size_t N>
+    struct QRDecomposition
+    {
+        Mat<T, M, N> qr; // Householder vectors on and below the diagonal, R above it
+        Vec<T, N> rDiag{ T{} }; // Diagonal of R
+        Vec<T, N> tau{ T{} }; // Reflector k is I - tau[k] * v * v^T
+    };
+
+    namespace detail
+    {
+        template <typename T, size_t M, size_t N>
+        constexpr T SingularTolerance(const Mat<T, M, N>& mat)
+        {
+            auto maxAbs = T{};
+            for (size_t i = 0; i < M * N; ++i)
+                maxAbs = Abs(mat.data[i]) > maxAbs ? Abs(mat.data[i]) : maxAbs;
+            return static_cast<T>(M > N ? M : N) * EPSILON<T> * maxAbs;
+        }
+
+        // Partial pivoting LU in place; false once a pivot is at or below tolerance
+        template <typename T, size_t N>
+        constexpr bool DecomposeLU(LUDecomposition<T, N>& dec, T tolerance)
+        {
+            auto& a = dec.lu.data;
+            for (size_t i = 0; i < N; ++i)
+                dec.pivots[i] = i;
+
+            for (size_t k = 0; k < N; ++k)
+            {
+                auto p = k;
+                for (size_t i = k + 1; i < N; ++i)
+                    p = Abs(a[k * N + i]) > Abs(a[k * N + p]) ? i : p;
+                if (Abs(a[k * N + p]) <= tolerance)
+                    return false;
+
+                if (p != k)
+                {
+                    for (size_t j = 0; j < N; ++j)
+                    {
+                        const auto tmp = a[j * N + k];
+                        a[j * N + k] = a[j * N + p];
+                        a[j * N + p] = tmp;
+                    }
+                    const auto tmp = dec.pivots[k];
+                    dec.pivots[k] = dec.pivots[p];
+                    dec.pivots[p] = tmp;
+                    dec.sign = -dec.sign;
+                }
+
+                const auto invPivot = static_cast<T>(1) / a[k * N + k];
+                for (size_t i = k + 1; i < N; ++i)
+                    a[k * N + i] *= invPivot;
+                for (size_t j = k + 1; j < N; ++j)
+                {
+                    const auto f = a[j * N + k];
+                    for (size_t i = k + 1; i < N; ++i)
+                        a[j * N + i] -= a[k * N + i] * f;
+                }
+            }
+            return true;
+        }
+    }
+
+    template <typename T, size_t N>
+    constexpr std::optional<LUDecomposition<T, N>> DecomposeLU(const Mat<T, N, N>& mat)
+    {
+        static_assert(std::is_floating_point<T>::value, "DecomposeLU needs a floating point type");
+        LUDecomposition<T, N> dec{ mat };
+        if (!detail::DecomposeLU(dec, detail::SingularTolerance(mat)))
+            return std::nullopt;
+        return dec;
+    }
+
+    // Solves A * x = b for the decomposed A
+    template <typename T, size_t N>
+    constexpr Vec<T, N> Solve(const LUDecomposition<T, N>& dec, const Vec<T, N>& b)
+    {
+        const auto& a = dec.lu.data;
+        Vec<T, N> x{ T{} };
+        for (size_t i = 0; i < N; ++i)
+            x[i] = b[dec.pivots[i]];
+
+        // L * y = P * b, then U * x = y
+        for (size_t k = 0; k < N; ++k)
+        {
+            const auto yk = x[k];
+            for (size_t i = k + 1; i < N; ++i)
+                x[i] -= a[k * N + i] * yk;
+        }
+        for (size_t k = N; k-- > 0;)
+        {
+            x[k] /= a[k * N + k];
+            const auto xk = x[k];
+            for (size_t i = 0; i < k; ++i)
+                x[i] -= a[k * N + i] * xk;
+        }
+        return x;
+    }
+
+    // Solves A * X = B column by column
+    template <typename T, size_t N, size_t K>
+    constexpr Mat<T, N, K> Solve(const LUDecomposition<T, N>& dec, const Mat<T, N, K>& b)
+    {
+        Mat<T, N, K> x;
+        for (size_t j = 0; j < K; ++j)
+        {
+            Vec<T, N> col{ T{} };
+            for (size_t i = 0; i < N; ++i)
+                col[i] = b.data[j * N + i];
+            col = Solve(dec, col);
+            for (size_t i = 0; i < N; ++i)
+                x.data[j * N + i] = col[i];
+        }
+        return x;
+    }
+
+    template <typename T, size_t N>
+    constexpr T Determinant(const LUDecomposition<T, N>& dec)
+    {
+        auto det = dec.sign;
+        for (size_t k = 0; k < N; ++k)
+            det *= dec.lu.data[k * N + k];
+        return det;
+    }
+
+    // Solves A * x = b through LU; nullopt if A is singular
+    template <typename T, size_t N>
+    constexpr std::optional<Vec<T, N>> Solve(const Mat<T, N, N>& mat, const Vec<T, N>& b)
+    {
+        const auto dec = DecomposeLU(mat);
+        if (!dec)
+            return std::nullopt;
+        return Solve(*dec, b);
+    }
+
+    // Any size; Mat3 and Mat4 keep their closed-form overloads
+    template <typename T, size_t N>
+    constexpr T Determinant(const Mat<T, N, N>& mat)
+    {
+        static_assert(std::is_floating_point<T>::value, "Determinant needs a floating point type");
+        // Only an exactly zero pivot makes the determinant zero
+        LUDecomposition<T, N> dec{ mat };
+        if (!detail::DecomposeLU(dec, T{}))
+            return T{};
+        return Determinant(dec);
+    }
+
+    // nullopt if mat is singular
+    template <typename T, size_t N>
+    constexpr std::optional<Mat<T, N, N>> TryInverse(const Mat<T, N, N>& mat)
+    {
+        const auto dec = DecomposeLU(mat);
+        if (!dec)
+            return std::nullopt;
+        Mat<T, N, N> identity;
+        for (size_t i = 0; i < N; ++i)
+            identity.data[i * N + i] = static_cast<T>(1);
+        return Solve(*dec, identity);
+    }
+
+    // Any size; asserts on a singular matrix like the Mat3 and Mat4 overloads. Prefer Solve
+    template <typename T, size_t N>
+    constexpr Mat<T, N, N> Inverse(const Mat<T, N, N>& mat)
+    {
+        const auto inverse = TryInverse(mat);
+        assert(inverse.has_value());
+        return inverse ? *inverse : Mat<T, N, N>{};
+    }
+
+    // A = L * L^T for a symmetric positive definite A; only the lower triangle of mat is read
+    template <typename T, size_t N>
+    constexpr std::optional<CholeskyDecomposition<T, N>> DecomposeCholesky(const Mat<T, N, N>& mat)
+    {
+        static_assert(std::is_floating_point<T>::value, "DecomposeCholesky needs a floating point type");
+        const auto tolerance = detail::SingularTolerance(mat);
+        CholeskyDecomposition<T, N> dec;
+        auto& l = dec.l.data;
+        for (size_t j = 0; j < N; ++j)
+        {
+            for (size_t i = j; i < N; ++i)
+                l[j * N + i] = mat.data[j * N + i];
+            // Subtract the contribution of the columns already done
+            for (size_t k = 0; k < j; ++k)
+            {
+                const auto ljk = l[k * N + j];
+                for (size_t i = j; i < N; ++i)
+                    l[j * N + i] -= l[k * N + i] * ljk;
+            }
+
+            const auto d = l[j * N + j];
+            if (d <= tolerance)
+                return std::nullopt;
+            const auto diag = Sqrt(d);
+            const auto invDiag = static_cast<T>(1) / diag;
+            l[j * N + j] = diag;
+            for (size_t i = j + 1; i < N; ++i)
+                l[j * N + i] *= invDiag;
+        }
+        return dec;
+    }
+
+    template <typename T, size_t N>
+    constexpr Vec<T, N> Solve(const CholeskyDecomposition<T, N>& dec, const Vec<T, N>& b)
+    {
+        const auto& l = dec.l.data;
+        auto x = b;
+        // L * y = b, then L^T * x = y
+        for (size_t k = 0; k < N; ++k)
+        {
+            x[k] /= l[k * N + k];
+            const auto yk = x[k];
+            for (size_t i = k + 1; i < N; ++i)
+                x[i] -= l[k * N + i] * yk;
+        }
+        for (size_t k = N; k-- > 0;)
+        {
+            auto sum = x[k];
+            for (size_t i = k + 1; i < N; ++i)
+                sum -= l[k * N + i] * x[i];
+            x[k] = sum / l[k * N + k];
+        }
+        return x;
+    }
+
+    // Householder QR of a tall or square matrix; nullopt if its columns are linearly dependent
+    template <typename T, size_t M, size_t N>
+    constexpr std::optional<QRDecomposition<T, M, N>> DecomposeQR(const Mat<T, M, N>& mat)
+    {
+        static_assert(std::is_floating_point<T>::value, "DecomposeQR needs a floating point type");
+        static_assert(M >= N, "DecomposeQR needs at least as many rows as columns");
+        const auto tolerance = detail::SingularTolerance(mat);
+        QRDecomposition<T, M, N> dec{ mat };
+        auto& a = dec.qr.data;
+        for (size_t k = 0; k < N; ++k)
+        {
+            auto normSq = T{};
+            for (size_t i = k; i < M; ++i)
+                normSq += a[k * M + i] * a[k * M + i];
+            const auto norm = Sqrt(normSq);
+            if (norm <= tolerance)
+                return std::nullopt;
+
+            // Reflect onto -sign(x_k) * |x| * e_k so v_k does not cancel
+            const auto alpha = a[k * M + k] > T{} ? -norm : norm;
+            a[k * M + k] -= alpha;
+            const auto tau = static_cast<T>(-1) / (alpha * a[k * M + k]);
+            dec.rDiag[k] = alpha;
+            dec.tau[k] = tau;
+
+            for (size_t j = k + 1; j < N; ++j)
+            {
+                auto dot = T{};
+                for (size_t i = k; i < M; ++i)
+                    dot += a[k * M + i] * a[j * M + i];
+                const auto s = tau * dot;
+                for (size_t i = k; i < M; ++i)
+                    a[j * M + i] -= s * a[k * M + i];
+            }
+        }
+        return dec;
+    }
+
+    // Least-squares solution of A * x = b, exact when A is square
+    template <typename T, size_t M, size_t N>
+    constexpr Vec<T, N> Solve(const QRDecomposition<T, M, N>& dec, const Vec<T, M>& b)
+    {
+        const auto& a = dec.qr.data;
+        auto y = b;
+        // Q^T * b
+        for (size_t k = 0; k < N; ++k)
+        {
+            auto dot = T{};
+            for (size_t i = k; i < M; ++i)
+                dot += a[k * M + i] * y[i];
+            const auto s = dec.tau[k] * dot;
+            for (size_t i = k; i < M; ++i)
+                y[i] -= s * a[k * M + i];
+        }
+
+        // R * x = (Q^T * b)[0, N)
+        Vec<T, N> x{ T{} };
+        for (size_t i = 0; i < N; ++i)
+            x[i] = y[i];
+        for (size_t k = N; k-- > 0;)
+        {
+            x[k] /= dec.rDiag[k];
+            const auto xk = x[k];
+            for (size_t i = 0; i < k; ++i)
+                x[i] -= a[k * M + i] * xk;
+        }
+        return x;
+    }
+}
+
+#endif // J_LINALG_H
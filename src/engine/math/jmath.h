@@ -2,15 +2,25 @@
 #define J_MATH_H
 
 #include <type_traits>
-#include <cmath>
 
+#include "jcmath.h"
 #include "jvec.h"
 #include "jmatrix.h"
+#include "jbatch.h"
+#include "jaffine.h"
+#include "jfastmath.h"
+#include "jrotor.h"
+#include "jquat.h"
+#include "jarray.h"
+#include "jlinalg.h"
+#include "jhalf.h"
+#include "jfixed.h"
+#include "jpack.h"
 
 namespace jg
 {
     template <typename T, typename = std::enable_if_t<std::is_floating_point_v<T>>>
-    inline constexpr bool FP_EQ(T a, T b) { return std::abs(a - b) < EPSILON<T>; }
+    inline constexpr bool FP_EQ(T a, T b) { return Abs(a - b) < EPSILON<T>; }
 
     template <typename T, typename = std::enable_if_t<std::is_floating_point_v<T>>>
     inline constexpr bool FP_IS_ZERO(T a) { return -EPSILON<T> < a && a < EPSILON<T>; }
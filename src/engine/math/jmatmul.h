@@ -0,0 +1,210 @@
+#ifndef J_MATMUL_H
+#define J_MATMUL_H
+
+#include <cstddef> // size_t
+#include <type_traits> // std::integral_constant
+#include <utility> // std::index_sequence
+
+#include "jtypes.h"
+#include "jsimd.h"
+
+/*
+ * Register-blocked kernel behind the generic Mat operator*. Matrices are
+ * column-major, so one output column is a sum of lhs columns scaled by rhs
+ * scalars:
+ *
+ *   out.col[j] = sum_k lhs.col[k] * rhs(k, j)
+ *
+ * The kernel keeps a block of ROWS x COLS outputs in registers for the whole
+ * k loop. The lhs column slice is loaded once per k and reused for every
+ * output column in the block, each rhs scalar is broadcast once, and every
+ * output element is stored once (rows shared by two overlapping lane groups
+ * twice, with the same value). No load or store runs past the end of a column.
+ */
+namespace jg
+{
+    namespace detail
+    {
+        // Calls f(std::integral_constant<size_t, I>{}) for I in [0, COUNT)
+        template <typename F, size_t... I>
+        inline void UnrollImpl(F&& f, std::index_sequence<I...>)
+        {
+            (f(std::integral_constant<size_t, I>{}), ...);
+        }
+
+        template <size_t COUNT, typename F>
+        inline void Unroll(F&& f)
+        {
+            UnrollImpl(f, std::make_index_sequence<COUNT>{});
+        }
+
+        // W consecutive elements of a column; NEXT is the width to fall back to for leftover rows
+        template <typename T, size_t W>
+        struct MatLanes;
+
+        template <typename T>
+        struct MatLanes<T, 1>
+        {
+            using Reg = T;
+            static constexpr size_t NEXT = 0;
+            static Reg Zero() { return T{}; }
+            static Reg Load(const T* p) { return *p; }
+            static Reg Broadcast(T v) { return v; }
+            static void Store(T* p, Reg v) { *p = v; }
+            static Reg MulAdd(Reg a, Reg b, Reg c) { return a * b + c; }
+        };
+
+#if defined(JG_SIMD_SSE)
+        template <>
+        struct MatLanes<f32, 4>
+        {
+            using Reg = __m128;
+            static constexpr size_t NEXT = 2;
+            static Reg Zero() { return _mm_setzero_ps(); }
+            static Reg Load(const f32* p) { return _mm_loadu_ps(p); }
+            static Reg Broadcast(f32 v) { return _mm_set1_ps(v); }
+            static void Store(f32* p, Reg v) { _mm_storeu_ps(p, v); }
+            static Reg MulAdd(Reg a, Reg b, Reg c) { return jg::MulAdd(a, b, c); }
+        };
+
+        // Two floats in the low half of an SSE register
+        template <>
+        struct MatLanes<f32, 2>
+        {
+            using Reg = __m128;
+            static constexpr size_t NEXT = 1;
+            static Reg Zero() { return _mm_setzero_ps(); }
+            static Reg Load(const f32* p) { return _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const f64*>(p))); }
+            static Reg Broadcast(f32 v) { return _mm_set1_ps(v); }
+            static void Store(f32* p, Reg v) { _mm_store_sd(reinterpret_cast<f64*>(p), _mm_castps_pd(v)); }
+            static Reg MulAdd(Reg a, Reg b, Reg c) { return jg::MulAdd(a, b, c); }
+        };
+
+        template <>
+        struct MatLanes<f64, 2>
+        {
+            using Reg = __m128d;
+            static constexpr size_t NEXT = 1;
+            static Reg Zero() { return _mm_setzero_pd(); }
+            static Reg Load(const f64* p) { return _mm_loadu_pd(p); }
+            static Reg Broadcast(f64 v) { return _mm_set1_pd(v); }
+            static void Store(f64* p, Reg v) { _mm_storeu_pd(p, v); }
+            static Reg MulAdd(Reg a, Reg b, Reg c) { return jg::MulAdd(a, b, c); }
+        };
+#endif
+
+#if defined(JG_SIMD_AVX)
+        template <>
+        struct MatLanes<f32, 8>
+        {
+            using Reg = __m256;
+            static constexpr size_t NEXT = 4;
+            static Reg Zero() { return _mm256_setzero_ps(); }
+            static Reg Load(const f32* p) { return _mm256_loadu_ps(p); }
+            static Reg Broadcast(f32 v) { return _mm256_set1_ps(v); }
+            static void Store(f32* p, Reg v) { _mm256_storeu_ps(p, v); }
+            static Reg MulAdd(Reg a, Reg b, Reg c) { return jg::MulAdd(a, b, c); }
+        };
+
+        template <>
+        struct MatLanes<f64, 4>
+        {
+            using Reg = __m256d;
+            static constexpr size_t NEXT = 2;
+            static Reg Zero() { return _mm256_setzero_pd(); }
+            static Reg Load(const f64* p) { return _mm256_loadu_pd(p); }
+            static Reg Broadcast(f64 v) { return _mm256_set1_pd(v); }
+            static void Store(f64* p, Reg v) { _mm256_storeu_pd(p, v); }
+            static Reg MulAdd(Reg a, Reg b, Reg c) { return jg::MulAdd(a, b, c); }
+        };
+#endif
+
+        // Widest lane count available for T
+        template <typename T>
+        constexpr size_t MatWidestLanes()
+        {
+#if defined(JG_SIMD_AVX)
+            if (std::is_same<T, f32>::value)
+                return 8;
+            if (std::is_same<T, f64>::value)
+                return 4;
+#elif defined(JG_SIMD_SSE)
+            if (std::is_same<T, f32>::value)
+                return 4;
+            if (std::is_same<T, f64>::value)
+                return 2;
+#endif
+            return 1;
+        }
+
+        // Outputs held in registers per block; leaves room for the lhs slice and a broadcast
+        constexpr size_t MAT_MUL_ACCUMULATORS = 8;
+
+        // Start row of the r-th lane group from ROW; the last group is pulled back to end at row M
+        template <size_t W, size_t M, size_t ROW>
+        constexpr size_t MatGroupRow(size_t r) { return ROW + r * W < M - W ? ROW + r * W : M - W; }
+
+        // out rows [ROW, ROW + RB * W) (clamped to M) x columns [col, col + CB)
+        template <typename T, size_t W, size_t RB, size_t CB, size_t M, size_t N, size_t ROW>
+        inline void MatMulBlock(const T* lhs, const T* rhs, T* out, size_t col)
+        {
+            using L = MatLanes<T, W>;
+            typename L::Reg acc[CB][RB];
+            Unroll<CB>([&](auto c) { Unroll<RB>([&](auto r) { acc[c][r] = L::Zero(); }); });
+
+            for (size_t k = 0; k < N; ++k)
+            {
+                typename L::Reg a[RB];
+                Unroll<RB>([&](auto r) { a[r] = L::Load(lhs + k * M + MatGroupRow<W, M, ROW>(r)); });
+                Unroll<CB>([&](auto c) {
+                    const auto b = L::Broadcast(rhs[(col + c) * N + k]);
+                    Unroll<RB>([&](auto r) { acc[c][r] = L::MulAdd(a[r], b, acc[c][r]); });
+                });
+            }
+
+            Unroll<CB>([&](auto c) {
+                Unroll<RB>([&](auto r) { L::Store(out + (col + c) * M + MatGroupRow<W, M, ROW>(r), acc[c][r]); });
+            });
+        }
+
+        /*
+         * Every output column for rows [ROW, M) in groups of W rows. When M is
+         * not a multiple of W the last group overlaps the one before it instead
+         * of falling back to scalars: overlapping rows are computed twice with
+         * the same operations in the same order, so both stores write the same
+         * value. Matrices shorter than W use the next narrower lanes.
+         */
+        template <typename T, size_t W, size_t M, size_t N, size_t K, size_t ROW>
+        inline void MatMulRows(const T* lhs, const T* rhs, T* out)
+        {
+            if constexpr (M < W)
+            {
+                MatMulRows<T, MatLanes<T, W>::NEXT, M, N, K, ROW>(lhs, rhs, out);
+            }
+            else if constexpr (ROW < M)
+            {
+                constexpr size_t GROUPS = (M - ROW + W - 1) / W;
+                constexpr size_t RB = GROUPS < 4 ? GROUPS : 4;
+                constexpr size_t CB_MAX = MAT_MUL_ACCUMULATORS / RB;
+                constexpr size_t CB = CB_MAX < K ? CB_MAX : K;
+
+                constexpr size_t FULL = K / CB * CB;
+                for (size_t col = 0; col < FULL; col += CB)
+                    MatMulBlock<T, W, RB, CB, M, N, ROW>(lhs, rhs, out, col);
+                if constexpr (FULL < K)
+                    MatMulBlock<T, W, RB, K - FULL, M, N, ROW>(lhs, rhs, out, FULL);
+
+                MatMulRows<T, W, M, N, K, ROW + RB * W>(lhs, rhs, out);
+            }
+        }
+
+        // out (M x K) = lhs (M x N) * rhs (N x K), all column-major; out must not alias the inputs
+        template <typename T, size_t M, size_t N, size_t K>
+        inline void MatMul(const T* lhs, const T* rhs, T* out)
+        {
+            MatMulRows<T, MatWidestLanes<T>(), M, N, K, 0>(lhs, rhs, out);
+        }
+    }
+}
+
+#endif // J_MATMUL_H
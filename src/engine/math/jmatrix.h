@@ -2,14 +2,24 @@
 #define J_MATRIX_H
 
 #include <cassert> // assert
-#include <cmath> // std::sin, std::cos
 #include <array> // std::array
 #include <initializer_list> // std::initializer_list
 
 #include "jtypes.h"
 #include "jvec.h"
 #include "jmath_consts.h"
-
+#include "jsimd.h"
+#include "jcmath.h"
+#include "jmatmul.h"
+
+/*
+ * Every operation here is constexpr. The generic Mat is built through data,
+ * so its operators index data directly; Mat3/Mat4 are built through their named
+ * members and have their own unrolled overloads. operator[] returns a reference
+ * into the aliased col array, which is never the active member in a constant
+ * expression; read a column there with Column(i), which copies it from data or
+ * m00..m33.
+ */
 namespace jg
 {
     template <typename T, size_t M, size_t N>
@@ -22,11 +32,12 @@ namespace jg
         };
 
         constexpr Mat() : data{} {}
-        constexpr Mat(std::initializer_list<T> l)
+        constexpr Mat(std::initializer_list<T> l) : data{}
         {
             assert(l.size() <= M * N);
-            std::copy_n(std::begin(l), l.size(), data.data());
-            std::fill_n(data.data() + l.size(), M * N - l.size(), T{});
+            size_t i = 0;
+            for (const auto& val : l)
+                data[i++] = val;
         }
 
         constexpr Vec<T, M>& operator[](size_t index)
@@ -40,68 +51,93 @@ namespace jg
             return col[index];
         }
 
+        // Copy of a column, also usable in constant expressions
+        constexpr Vec<T, M> Column(size_t index) const
+        {
+            assert(index < N);
+            Vec<T, M> column{ T{} };
+            for (size_t i = 0; i < M; ++i)
+                column[i] = data[index * M + i];
+            return column;
+        }
+
         constexpr Mat operator-() const
         {
             auto ret = *this;
-            for (auto i = 0; i < M * N; ++i)
+            for (size_t i = 0; i < M * N; ++i)
                 ret.data[i] = -ret.data[i];
             return ret;
         }
     };
 
     template <typename T, size_t M, size_t N>
-    Mat<T, M, N> operator+(const Mat<T, M, N>& lhs, const Mat<T, M, N>& rhs)
+    constexpr Mat<T, M, N> operator+(const Mat<T, M, N>& lhs, const Mat<T, M, N>& rhs)
     {
         auto ret = lhs;
-        for (auto i = 0; i < M * N; ++i)
+        for (size_t i = 0; i < M * N; ++i)
             ret.data[i] += rhs.data[i];
         return ret;
     }
 
     template <typename T, size_t M, size_t N>
-    Mat<T, M, N> operator-(const Mat<T, M, N>& lhs, const Mat<T, M, N>& rhs) { return lhs + -rhs; }
+    constexpr Mat<T, M, N> operator-(const Mat<T, M, N>& lhs, const Mat<T, M, N>& rhs)
+    {
+        auto ret = lhs;
+        for (size_t i = 0; i < M * N; ++i)
+            ret.data[i] -= rhs.data[i];
+        return ret;
+    }
 
     template <typename T, size_t M, size_t N, size_t K>
-    Mat<T, M, K> operator*(const Mat<T, M, N>& lhs, const Mat<T, N, K>& rhs)
+    constexpr Mat<T, M, K> operator*(const Mat<T, M, N>& lhs, const Mat<T, N, K>& rhs)
     {
         Mat<T, M, K> ret;
-        for (auto i = 0; i < K; ++i)
-            for (auto j = 0; j < M; ++j)
-                for (auto k = 0; k < N; ++k)
-                    ret[i][j] += lhs[k][j] * rhs[i][k];
+        if (!JG_IS_CONSTANT_EVALUATED())
+        {
+            // Register-blocked and vectorized for f32/f64, see jmatmul.h
+            detail::MatMul<T, M, N, K>(lhs.data.data(), rhs.data.data(), ret.data.data());
+            return ret;
+        }
+        for (size_t i = 0; i < K; ++i)
+            for (size_t j = 0; j < M; ++j)
+                for (size_t k = 0; k < N; ++k)
+                    ret.data[i * M + j] += lhs.data[k * M + j] * rhs.data[i * N + k];
         return ret;
     }
 
     template <typename T, size_t M, size_t N>
-    Vec<T, M> operator*(const Mat<T, M, N>& lhs, const Vec<T, N>& rhs)
+    constexpr Vec<T, M> operator*(const Mat<T, M, N>& lhs, const Vec<T, N>& rhs)
     {
-        Vec<T, M> ret;
-        for (auto i = 0; i < M; ++i)
-            for (auto j = 0; j < N; ++j)
-                ret[i] += lhs[j][i] * rhs[j];
+        Vec<T, M> ret{ T{} };
+        for (size_t i = 0; i < M; ++i)
+            for (size_t j = 0; j < N; ++j)
+                ret[i] += lhs.data[j * M + i] * rhs[j];
         return ret;
     }
 
     template <typename T, size_t M, size_t N>
-    Mat<T, M, N> operator*(const Mat<T, M, N>& lhs, const T& rhs)
+    constexpr Mat<T, M, N> operator*(const Mat<T, M, N>& lhs, const T& rhs)
     {
         auto ret = lhs;
-        for (auto i = 0; i < N; ++i)
-            for (auto j = 0; j < M; ++j)
-                ret[i][j] *= rhs;
+        for (size_t i = 0; i < M * N; ++i)
+            ret.data[i] *= rhs;
         return ret;
     }
 
     template <typename T, size_t M, size_t N>
-    Mat<T, M, N> operator*(const T& lhs, const Mat<T, M, N>& rhs) { return rhs * lhs; }
+    constexpr Mat<T, M, N> operator*(const T& lhs, const Mat<T, M, N>& rhs) { return rhs * lhs; }
 
     template <typename T, size_t M>
-    Mat<T, M, M> Transpose(const Mat<T, M, M>& mat)
+    constexpr Mat<T, M, M> Transpose(const Mat<T, M, M>& mat)
     {
         auto transposed = mat;
-        for (auto i = 0; i < M; ++i)
-            for (auto j = i + 1; j < M; ++j)
-                std::swap(transposed[i][j], transposed[j][i]);
+        for (size_t i = 0; i < M; ++i)
+            for (size_t j = i + 1; j < M; ++j)
+            {
+                const auto tmp = transposed.data[i * M + j];
+                transposed.data[i * M + j] = transposed.data[j * M + i];
+                transposed.data[j * M + i] = tmp;
+            }
         return transposed;
     }
 
@@ -146,10 +182,10 @@ namespace jg
                 static_cast<T>(0), static_cast<T>(0), static_cast<T>(1)
             };
         }
-        static Mat Rotation2D(const T& rad)
+        static constexpr Mat Rotation2D(const T& rad)
         {
-            const auto sinRad = std::sin(rad);
-            const auto cosRad = std::cos(rad);
+            const auto sinRad = Sin(rad);
+            const auto cosRad = Cos(rad);
             return Mat{
                            cosRad,            sinRad, static_cast<T>(0),
                           -sinRad,            cosRad, static_cast<T>(0),
@@ -157,7 +193,7 @@ namespace jg
             };
         }
 
-        explicit constexpr Mat() : data{} {}
+        explicit constexpr Mat() : m00{}, m10{}, m20{}, m01{}, m11{}, m21{}, m02{}, m12{}, m22{} {}
         explicit constexpr Mat(const T& x0, const T& y0, const T& z0,
                                const T& x1, const T& y1, const T& z1,
                                const T& x2, const T& y2, const T& z2) :
@@ -176,6 +212,15 @@ namespace jg
             return col[index];
         }
 
+        // Copy of a column, also usable in constant expressions
+        constexpr Vec<T, 3> Column(size_t index) const
+        {
+            assert(index < 3);
+            return index == 0 ? Vec<T, 3>{ m00, m10, m20 }
+                 : index == 1 ? Vec<T, 3>{ m01, m11, m21 }
+                 : Vec<T, 3>{ m02, m12, m22 };
+        }
+
         constexpr Mat operator-() const
         {
             return Mat{ -m00, -m10, -m20,
@@ -184,6 +229,67 @@ namespace jg
         }
     };
 
+    template <typename T>
+    constexpr Mat<T, 3, 3> operator+(const Mat<T, 3, 3>& lhs, const Mat<T, 3, 3>& rhs)
+    {
+        return Mat<T, 3, 3>{
+            lhs.m00 + rhs.m00, lhs.m10 + rhs.m10, lhs.m20 + rhs.m20,
+            lhs.m01 + rhs.m01, lhs.m11 + rhs.m11, lhs.m21 + rhs.m21,
+            lhs.m02 + rhs.m02, lhs.m12 + rhs.m12, lhs.m22 + rhs.m22
+        };
+    }
+
+    template <typename T>
+    constexpr Mat<T, 3, 3> operator-(const Mat<T, 3, 3>& lhs, const Mat<T, 3, 3>& rhs)
+    {
+        return Mat<T, 3, 3>{
+            lhs.m00 - rhs.m00, lhs.m10 - rhs.m10, lhs.m20 - rhs.m20,
+            lhs.m01 - rhs.m01, lhs.m11 - rhs.m11, lhs.m21 - rhs.m21,
+            lhs.m02 - rhs.m02, lhs.m12 - rhs.m12, lhs.m22 - rhs.m22
+        };
+    }
+
+    template <typename T>
+    constexpr Mat<T, 3, 3> operator*(const Mat<T, 3, 3>& lhs, const T& rhs)
+    {
+        return Mat<T, 3, 3>{
+            lhs.m00 * rhs, lhs.m10 * rhs, lhs.m20 * rhs,
+            lhs.m01 * rhs, lhs.m11 * rhs, lhs.m21 * rhs,
+            lhs.m02 * rhs, lhs.m12 * rhs, lhs.m22 * rhs
+        };
+    }
+
+    template <typename T>
+    constexpr Mat<T, 3, 3> operator*(const T& lhs, const Mat<T, 3, 3>& rhs) { return rhs * lhs; }
+
+    template <typename T>
+    constexpr Vec<T, 3> operator*(const Mat<T, 3, 3>& lhs, const Vec<T, 3>& rhs)
+    {
+        return Vec<T, 3>{
+            lhs.m00 * rhs.x + lhs.m01 * rhs.y + lhs.m02 * rhs.z,
+            lhs.m10 * rhs.x + lhs.m11 * rhs.y + lhs.m12 * rhs.z,
+            lhs.m20 * rhs.x + lhs.m21 * rhs.y + lhs.m22 * rhs.z
+        };
+    }
+
+    template <typename T>
+    constexpr Mat<T, 3, 3> operator*(const Mat<T, 3, 3>& lhs, const Mat<T, 3, 3>& rhs)
+    {
+        return Mat<T, 3, 3>{
+            lhs.m00 * rhs.m00 + lhs.m01 * rhs.m10 + lhs.m02 * rhs.m20,
+            lhs.m10 * rhs.m00 + lhs.m11 * rhs.m10 + lhs.m12 * rhs.m20,
+            lhs.m20 * rhs.m00 + lhs.m21 * rhs.m10 + lhs.m22 * rhs.m20,
+
+            lhs.m00 * rhs.m01 + lhs.m01 * rhs.m11 + lhs.m02 * rhs.m21,
+            lhs.m10 * rhs.m01 + lhs.m11 * rhs.m11 + lhs.m12 * rhs.m21,
+            lhs.m20 * rhs.m01 + lhs.m21 * rhs.m11 + lhs.m22 * rhs.m21,
+
+            lhs.m00 * rhs.m02 + lhs.m01 * rhs.m12 + lhs.m02 * rhs.m22,
+            lhs.m10 * rhs.m02 + lhs.m11 * rhs.m12 + lhs.m12 * rhs.m22,
+            lhs.m20 * rhs.m02 + lhs.m21 * rhs.m12 + lhs.m22 * rhs.m22
+        };
+    }
+
     template <typename T>
     constexpr Mat<T, 3, 3> Transpose(const Mat<T, 3, 3>& mat)
     {
@@ -206,7 +312,7 @@ namespace jg
     constexpr Mat<T, 3, 3> Inverse(const Mat<T, 3, 3>& mat)
     {
         const auto det = Determinant(mat);
-        assert(std::abs(det) > static_cast<T>(EPSILON_F32));
+        assert(Abs(det) > static_cast<T>(EPSILON_F32));
 
         /*
          * Each element is the determinant of each minor 2x2 matrix of the transposed matrix
@@ -244,7 +350,343 @@ namespace jg
 
 
 
+    template <typename T>
+    struct Mat<T, 4, 4>
+    {
+        union
+        {
+            struct
+            {
+                T m00, m10, m20, m30,
+                  m01, m11, m21, m31,
+                  m02, m12, m22, m32,
+                  m03, m13, m23, m33;
+            };
+            std::array<T, 16> data;
+            std::array<Vec<T, 4>, 4> col;
+        };
+
+        static constexpr Mat Identity()
+        {
+            return Translation3D(static_cast<T>(0), static_cast<T>(0), static_cast<T>(0));
+        }
+        static constexpr Mat Translation3D(const T& x, const T& y, const T& z)
+        {
+            return Mat{
+                static_cast<T>(1), static_cast<T>(0), static_cast<T>(0), static_cast<T>(0),
+                static_cast<T>(0), static_cast<T>(1), static_cast<T>(0), static_cast<T>(0),
+                static_cast<T>(0), static_cast<T>(0), static_cast<T>(1), static_cast<T>(0),
+                                x,                 y,                 z, static_cast<T>(1)
+            };
+        }
+        static constexpr Mat Scale3D(const T& x, const T& y, const T& z)
+        {
+            return Mat{
+                                x, static_cast<T>(0), static_cast<T>(0), static_cast<T>(0),
+                static_cast<T>(0),                 y, static_cast<T>(0), static_cast<T>(0),
+                static_cast<T>(0), static_cast<T>(0),                 z, static_cast<T>(0),
+                static_cast<T>(0), static_cast<T>(0), static_cast<T>(0), static_cast<T>(1)
+            };
+        }
+        static constexpr Mat RotationX(const T& rad)
+        {
+            const auto sinRad = Sin(rad);
+            const auto cosRad = Cos(rad);
+            return Mat{
+                static_cast<T>(1), static_cast<T>(0), static_cast<T>(0), static_cast<T>(0),
+                static_cast<T>(0),            cosRad,            sinRad, static_cast<T>(0),
+                static_cast<T>(0),           -sinRad,            cosRad, static_cast<T>(0),
+                static_cast<T>(0), static_cast<T>(0), static_cast<T>(0), static_cast<T>(1)
+            };
+        }
+        static constexpr Mat RotationY(const T& rad)
+        {
+            const auto sinRad = Sin(rad);
+            const auto cosRad = Cos(rad);
+            return Mat{
+                           cosRad, static_cast<T>(0),           -sinRad, static_cast<T>(0),
+                static_cast<T>(0), static_cast<T>(1), static_cast<T>(0), static_cast<T>(0),
+                           sinRad, static_cast<T>(0),            cosRad, static_cast<T>(0),
+                static_cast<T>(0), static_cast<T>(0), static_cast<T>(0), static_cast<T>(1)
+            };
+        }
+        // Same as Mat3::Rotation2D, lifted to 3D
+        static constexpr Mat RotationZ(const T& rad)
+        {
+            const auto sinRad = Sin(rad);
+            const auto cosRad = Cos(rad);
+            return Mat{
+                           cosRad,            sinRad, static_cast<T>(0), static_cast<T>(0),
+                          -sinRad,            cosRad, static_cast<T>(0), static_cast<T>(0),
+                static_cast<T>(0), static_cast<T>(0), static_cast<T>(1), static_cast<T>(0),
+                static_cast<T>(0), static_cast<T>(0), static_cast<T>(0), static_cast<T>(1)
+            };
+        }
+        // Maps the given box to the [-1, 1] clip-space cube
+        static constexpr Mat Orthographic(const T& left, const T& right,
+                                          const T& bottom, const T& top,
+                                          const T& zNear, const T& zFar)
+        {
+            const auto two = static_cast<T>(2);
+            return Mat{
+                two / (right - left), static_cast<T>(0), static_cast<T>(0), static_cast<T>(0),
+                static_cast<T>(0), two / (top - bottom), static_cast<T>(0), static_cast<T>(0),
+                static_cast<T>(0), static_cast<T>(0), -two / (zFar - zNear), static_cast<T>(0),
+                -(right + left) / (right - left),
+                -(top + bottom) / (top - bottom),
+                -(zFar + zNear) / (zFar - zNear),
+                static_cast<T>(1)
+            };
+        }
+
+        explicit constexpr Mat() :
+            m00{}, m10{}, m20{}, m30{},
+            m01{}, m11{}, m21{}, m31{},
+            m02{}, m12{}, m22{}, m32{},
+            m03{}, m13{}, m23{}, m33{} {}
+        explicit constexpr Mat(const T& x0, const T& y0, const T& z0, const T& w0,
+                               const T& x1, const T& y1, const T& z1, const T& w1,
+                               const T& x2, const T& y2, const T& z2, const T& w2,
+                               const T& x3, const T& y3, const T& z3, const T& w3) :
+            m00{x0}, m10{y0}, m20{z0}, m30{w0},
+            m01{x1}, m11{y1}, m21{z1}, m31{w1},
+            m02{x2}, m12{y2}, m22{z2}, m32{w2},
+            m03{x3}, m13{y3}, m23{z3}, m33{w3} {}
+        explicit constexpr Mat(const Vec<T, 4>& c0, const Vec<T, 4>& c1, const Vec<T, 4>& c2, const Vec<T, 4>& c3) :
+            m00{c0.x}, m10{c0.y}, m20{c0.z}, m30{c0.w},
+            m01{c1.x}, m11{c1.y}, m21{c1.z}, m31{c1.w},
+            m02{c2.x}, m12{c2.y}, m22{c2.z}, m32{c2.w},
+            m03{c3.x}, m13{c3.y}, m23{c3.z}, m33{c3.w} {}
+
+        constexpr Vec<T, 4>& operator[](size_t index)
+        {
+            assert(index < 4);
+            return col[index];
+        }
+        constexpr const Vec<T, 4>& operator[](size_t index) const
+        {
+            assert(index < 4);
+            return col[index];
+        }
+
+        // Copy of a column, also usable in constant expressions
+        constexpr Vec<T, 4> Column(size_t index) const
+        {
+            assert(index < 4);
+            return index == 0 ? Vec<T, 4>{ m00, m10, m20, m30 }
+                 : index == 1 ? Vec<T, 4>{ m01, m11, m21, m31 }
+                 : index == 2 ? Vec<T, 4>{ m02, m12, m22, m32 }
+                 : Vec<T, 4>{ m03, m13, m23, m33 };
+        }
+
+        constexpr Mat operator-() const
+        {
+            return Mat{ -m00, -m10, -m20, -m30,
+                        -m01, -m11, -m21, -m31,
+                        -m02, -m12, -m22, -m32,
+                        -m03, -m13, -m23, -m33 };
+        }
+    };
+
+    template <typename T>
+    constexpr Vec<T, 4> operator*(const Mat<T, 4, 4>& lhs, const Vec<T, 4>& rhs)
+    {
+        return Vec<T, 4>{
+            lhs.m00 * rhs.x + lhs.m01 * rhs.y + lhs.m02 * rhs.z + lhs.m03 * rhs.w,
+            lhs.m10 * rhs.x + lhs.m11 * rhs.y + lhs.m12 * rhs.z + lhs.m13 * rhs.w,
+            lhs.m20 * rhs.x + lhs.m21 * rhs.y + lhs.m22 * rhs.z + lhs.m23 * rhs.w,
+            lhs.m30 * rhs.x + lhs.m31 * rhs.y + lhs.m32 * rhs.z + lhs.m33 * rhs.w
+        };
+    }
+
+    template <typename T>
+    constexpr Mat<T, 4, 4> operator*(const Mat<T, 4, 4>& lhs, const Mat<T, 4, 4>& rhs)
+    {
+        return Mat<T, 4, 4>{
+            lhs * Vec<T, 4>{ rhs.m00, rhs.m10, rhs.m20, rhs.m30 },
+            lhs * Vec<T, 4>{ rhs.m01, rhs.m11, rhs.m21, rhs.m31 },
+            lhs * Vec<T, 4>{ rhs.m02, rhs.m12, rhs.m22, rhs.m32 },
+            lhs * Vec<T, 4>{ rhs.m03, rhs.m13, rhs.m23, rhs.m33 }
+        };
+    }
+
+    template <typename T>
+    constexpr Mat<T, 4, 4> operator+(const Mat<T, 4, 4>& lhs, const Mat<T, 4, 4>& rhs)
+    {
+        return Mat<T, 4, 4>{
+            lhs.m00 + rhs.m00, lhs.m10 + rhs.m10, lhs.m20 + rhs.m20, lhs.m30 + rhs.m30,
+            lhs.m01 + rhs.m01, lhs.m11 + rhs.m11, lhs.m21 + rhs.m21, lhs.m31 + rhs.m31,
+            lhs.m02 + rhs.m02, lhs.m12 + rhs.m12, lhs.m22 + rhs.m22, lhs.m32 + rhs.m32,
+            lhs.m03 + rhs.m03, lhs.m13 + rhs.m13, lhs.m23 + rhs.m23, lhs.m33 + rhs.m33
+        };
+    }
+
+    template <typename T>
+    constexpr Mat<T, 4, 4> operator-(const Mat<T, 4, 4>& lhs, const Mat<T, 4, 4>& rhs)
+    {
+        return Mat<T, 4, 4>{
+            lhs.m00 - rhs.m00, lhs.m10 - rhs.m10, lhs.m20 - rhs.m20, lhs.m30 - rhs.m30,
+            lhs.m01 - rhs.m01, lhs.m11 - rhs.m11, lhs.m21 - rhs.m21, lhs.m31 - rhs.m31,
+            lhs.m02 - rhs.m02, lhs.m12 - rhs.m12, lhs.m22 - rhs.m22, lhs.m32 - rhs.m32,
+            lhs.m03 - rhs.m03, lhs.m13 - rhs.m13, lhs.m23 - rhs.m23, lhs.m33 - rhs.m33
+        };
+    }
+
+    template <typename T>
+    constexpr Mat<T, 4, 4> operator*(const Mat<T, 4, 4>& lhs, const T& rhs)
+    {
+        return Mat<T, 4, 4>{
+            lhs.m00 * rhs, lhs.m10 * rhs, lhs.m20 * rhs, lhs.m30 * rhs,
+            lhs.m01 * rhs, lhs.m11 * rhs, lhs.m21 * rhs, lhs.m31 * rhs,
+            lhs.m02 * rhs, lhs.m12 * rhs, lhs.m22 * rhs, lhs.m32 * rhs,
+            lhs.m03 * rhs, lhs.m13 * rhs, lhs.m23 * rhs, lhs.m33 * rhs
+        };
+    }
+
+    template <typename T>
+    constexpr Mat<T, 4, 4> operator*(const T& lhs, const Mat<T, 4, 4>& rhs) { return rhs * lhs; }
+
+    template <typename T>
+    constexpr Mat<T, 4, 4> Transpose(const Mat<T, 4, 4>& mat)
+    {
+        return Mat<T, 4, 4>{
+            mat.m00, mat.m01, mat.m02, mat.m03,
+            mat.m10, mat.m11, mat.m12, mat.m13,
+            mat.m20, mat.m21, mat.m22, mat.m23,
+            mat.m30, mat.m31, mat.m32, mat.m33
+        };
+    }
+
+    /*
+     * Determinant and inverse share the six 2x2 minors of the top two rows (s*)
+     * and the six 2x2 minors of the bottom two rows (c*)
+     */
+    template <typename T>
+    constexpr T Determinant(const Mat<T, 4, 4>& mat)
+    {
+        const auto s0 = mat.m00 * mat.m11 - mat.m10 * mat.m01;
+        const auto s1 = mat.m00 * mat.m12 - mat.m10 * mat.m02;
+        const auto s2 = mat.m00 * mat.m13 - mat.m10 * mat.m03;
+        const auto s3 = mat.m01 * mat.m12 - mat.m11 * mat.m02;
+        const auto s4 = mat.m01 * mat.m13 - mat.m11 * mat.m03;
+        const auto s5 = mat.m02 * mat.m13 - mat.m12 * mat.m03;
+
+        const auto c5 = mat.m22 * mat.m33 - mat.m32 * mat.m23;
+        const auto c4 = mat.m21 * mat.m33 - mat.m31 * mat.m23;
+        const auto c3 = mat.m21 * mat.m32 - mat.m31 * mat.m22;
+        const auto c2 = mat.m20 * mat.m33 - mat.m30 * mat.m23;
+        const auto c1 = mat.m20 * mat.m32 - mat.m30 * mat.m22;
+        const auto c0 = mat.m20 * mat.m31 - mat.m30 * mat.m21;
+
+        return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+    }
+
+    template <typename T>
+    constexpr Mat<T, 4, 4> Inverse(const Mat<T, 4, 4>& mat)
+    {
+        const auto s0 = mat.m00 * mat.m11 - mat.m10 * mat.m01;
+        const auto s1 = mat.m00 * mat.m12 - mat.m10 * mat.m02;
+        const auto s2 = mat.m00 * mat.m13 - mat.m10 * mat.m03;
+        const auto s3 = mat.m01 * mat.m12 - mat.m11 * mat.m02;
+        const auto s4 = mat.m01 * mat.m13 - mat.m11 * mat.m03;
+        const auto s5 = mat.m02 * mat.m13 - mat.m12 * mat.m03;
+
+        const auto c5 = mat.m22 * mat.m33 - mat.m32 * mat.m23;
+        const auto c4 = mat.m21 * mat.m33 - mat.m31 * mat.m23;
+        const auto c3 = mat.m21 * mat.m32 - mat.m31 * mat.m22;
+        const auto c2 = mat.m20 * mat.m33 - mat.m30 * mat.m23;
+        const auto c1 = mat.m20 * mat.m32 - mat.m30 * mat.m22;
+        const auto c0 = mat.m20 * mat.m31 - mat.m30 * mat.m21;
+
+        const auto det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+        assert(Abs(det) > static_cast<T>(EPSILON_F32));
+        const auto invDet = static_cast<T>(1) / det;
+
+        // Adjugate, written column by column
+        return Mat<T, 4, 4>{
+            ( mat.m11 * c5 - mat.m12 * c4 + mat.m13 * c3) * invDet,
+            (-mat.m10 * c5 + mat.m12 * c2 - mat.m13 * c1) * invDet,
+            ( mat.m10 * c4 - mat.m11 * c2 + mat.m13 * c0) * invDet,
+            (-mat.m10 * c3 + mat.m11 * c1 - mat.m12 * c0) * invDet,
+
+            (-mat.m01 * c5 + mat.m02 * c4 - mat.m03 * c3) * invDet,
+            ( mat.m00 * c5 - mat.m02 * c2 + mat.m03 * c1) * invDet,
+            (-mat.m00 * c4 + mat.m01 * c2 - mat.m03 * c0) * invDet,
+            ( mat.m00 * c3 - mat.m01 * c1 + mat.m02 * c0) * invDet,
+
+            ( mat.m31 * s5 - mat.m32 * s4 + mat.m33 * s3) * invDet,
+            (-mat.m30 * s5 + mat.m32 * s2 - mat.m33 * s1) * invDet,
+            ( mat.m30 * s4 - mat.m31 * s2 + mat.m33 * s0) * invDet,
+            (-mat.m30 * s3 + mat.m31 * s1 - mat.m32 * s0) * invDet,
+
+            (-mat.m21 * s5 + mat.m22 * s4 - mat.m23 * s3) * invDet,
+            ( mat.m20 * s5 - mat.m22 * s2 + mat.m23 * s1) * invDet,
+            (-mat.m20 * s4 + mat.m21 * s2 - mat.m23 * s0) * invDet,
+            ( mat.m20 * s3 - mat.m21 * s1 + mat.m22 * s0) * invDet
+        };
+    }
+
+    /*
+     * Inverse of an affine matrix (bottom row 0 0 0 1), e.g. any product of
+     * Translation3D, Scale3D and Rotation*:
+     *
+     * | A t |^-1   | A^-1  -A^-1 * t |
+     * | 0 1 |    = | 0      1        |
+     *
+     * Only the 3x3 block is inverted, roughly a third of the work of Inverse()
+     */
+    template <typename T>
+    constexpr Mat<T, 4, 4> AffineInverse(const Mat<T, 4, 4>& mat)
+    {
+        const auto a00 = mat.m11 * mat.m22 - mat.m12 * mat.m21;
+        const auto a10 = mat.m12 * mat.m20 - mat.m10 * mat.m22;
+        const auto a20 = mat.m10 * mat.m21 - mat.m11 * mat.m20;
+
+        const auto det = mat.m00 * a00 + mat.m01 * a10 + mat.m02 * a20;
+        assert(Abs(det) > static_cast<T>(EPSILON_F32));
+        const auto invDet = static_cast<T>(1) / det;
+
+        const auto i00 = a00 * invDet;
+        const auto i10 = a10 * invDet;
+        const auto i20 = a20 * invDet;
+        const auto i01 = (mat.m02 * mat.m21 - mat.m01 * mat.m22) * invDet;
+        const auto i11 = (mat.m00 * mat.m22 - mat.m02 * mat.m20) * invDet;
+        const auto i21 = (mat.m01 * mat.m20 - mat.m00 * mat.m21) * invDet;
+        const auto i02 = (mat.m01 * mat.m12 - mat.m02 * mat.m11) * invDet;
+        const auto i12 = (mat.m02 * mat.m10 - mat.m00 * mat.m12) * invDet;
+        const auto i22 = (mat.m00 * mat.m11 - mat.m01 * mat.m10) * invDet;
+
+        return Mat<T, 4, 4>{
+            i00, i10, i20, static_cast<T>(0),
+            i01, i11, i21, static_cast<T>(0),
+            i02, i12, i22, static_cast<T>(0),
+            -(i00 * mat.m03 + i01 * mat.m13 + i02 * mat.m23),
+            -(i10 * mat.m03 + i11 * mat.m13 + i12 * mat.m23),
+            -(i20 * mat.m03 + i21 * mat.m13 + i22 * mat.m23),
+            static_cast<T>(1)
+        };
+    }
+
+
+
+#if defined(JG_SIMD_SSE)
+    constexpr Vec<f32, 4> operator*(const Mat<f32, 4, 4>& lhs, const Vec<f32, 4>& rhs)
+    {
+        if (JG_IS_CONSTANT_EVALUATED())
+            return operator*<f32>(lhs, rhs);
+
+        auto ret = _mm_mul_ps(lhs.col[0].simd, _mm_set1_ps(rhs.x));
+        ret = MulAdd(lhs.col[1].simd, _mm_set1_ps(rhs.y), ret);
+        ret = MulAdd(lhs.col[2].simd, _mm_set1_ps(rhs.z), ret);
+        ret = MulAdd(lhs.col[3].simd, _mm_set1_ps(rhs.w), ret);
+        return Vec<f32, 4>{ ret };
+    }
+#endif
+
+
+
     using Mat3f = Mat<f32, 3, 3>;
+    using Mat4f = Mat<f32, 4, 4>;
 }
 
 
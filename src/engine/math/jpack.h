@@ -0,0 +1,144 @@
+#ifndef J_PACK_H
+#define J_PACK_H
+
+#include <cassert> // assert
+
+#include "jtypes.h"
+#include "jspan.h"
+#include "jsimd.h"
+#include "jvec.h"
+#include "jhalf.h"
+#include "jfixed.h"
+
+/*
+ * Bulk conversion between f32 arrays and the compact f16 and 16.16 fixed
+ * formats, for vertex streams and network snapshots. Each kernel returns
+ * exactly what the element-wise conversion of the scalar type would, so
+ * packed data does not depend on which path ran.
+ */
+namespace jg
+{
+    inline void PackHalf(Span<const f32> in, Span<f16> out)
+    {
+        assert(out.size() >= in.size());
+        const auto count = in.size();
+        size_t i = 0;
+
+#if defined(JG_SIMD_F16C) && defined(JG_SIMD_AVX)
+        for (; i + 8 <= count; i += 8)
+        {
+            const auto h = _mm256_cvtps_ph(_mm256_loadu_ps(in.data() + i), _MM_FROUND_TO_NEAREST_INT);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out.data() + i), h);
+        }
+#endif
+#if defined(JG_SIMD_F16C)
+        for (; i + 4 <= count; i += 4)
+        {
+            const auto h = _mm_cvtps_ph(_mm_loadu_ps(in.data() + i), _MM_FROUND_TO_NEAREST_INT);
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(out.data() + i), h);
+        }
+#endif
+
+        for (; i < count; ++i)
+            out[i] = f16{ in[i] };
+    }
+
+    inline void UnpackHalf(Span<const f16> in, Span<f32> out)
+    {
+        assert(out.size() >= in.size());
+        const auto count = in.size();
+        size_t i = 0;
+
+#if defined(JG_SIMD_F16C) && defined(JG_SIMD_AVX)
+        for (; i + 8 <= count; i += 8)
+        {
+            const auto h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in.data() + i));
+            _mm256_storeu_ps(out.data() + i, _mm256_cvtph_ps(h));
+        }
+#endif
+#if defined(JG_SIMD_F16C)
+        for (; i + 4 <= count; i += 4)
+        {
+            const auto h = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(in.data() + i));
+            _mm_storeu_ps(out.data() + i, _mm_cvtph_ps(h));
+        }
+#endif
+
+        for (; i < count; ++i)
+            out[i] = static_cast<f32>(in[i]);
+    }
+
+    // Values must lie within the fixed range, [-32768, 32768)
+    inline void PackFixed(Span<const f32> in, Span<fixed> out)
+    {
+        assert(out.size() >= in.size());
+        const auto count = in.size();
+        size_t i = 0;
+
+#if defined(JG_SIMD_SSE)
+        {
+            // Scaling by 2^16 and the truncated remainder are both exact in f32,
+            // so rounding half away from zero matches the scalar f64 path
+            const auto scale = _mm_set1_ps(static_cast<f32>(fixed::ONE));
+            const auto half = _mm_set1_ps(0.5f);
+            const auto minusHalf = _mm_set1_ps(-0.5f);
+            for (; i + 4 <= count; i += 4)
+            {
+                const auto y = _mm_mul_ps(_mm_loadu_ps(in.data() + i), scale);
+                const auto t = _mm_cvttps_epi32(y);
+                const auto rem = _mm_sub_ps(y, _mm_cvtepi32_ps(t));
+                // Masks are -1 where true
+                const auto up = _mm_castps_si128(_mm_cmpge_ps(rem, half));
+                const auto down = _mm_castps_si128(_mm_cmple_ps(rem, minusHalf));
+                const auto r = _mm_add_epi32(_mm_sub_epi32(t, up), down);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out.data() + i), r);
+            }
+        }
+#endif
+
+        for (; i < count; ++i)
+            out[i] = fixed{ in[i] };
+    }
+
+    inline void UnpackFixed(Span<const fixed> in, Span<f32> out)
+    {
+        assert(out.size() >= in.size());
+        const auto count = in.size();
+        size_t i = 0;
+
+#if defined(JG_SIMD_SSE)
+        {
+            // One rounding in the int -> float conversion, then an exact scale
+            const auto scale = _mm_set1_ps(1.0f / static_cast<f32>(fixed::ONE));
+            for (; i + 4 <= count; i += 4)
+            {
+                const auto raw = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in.data() + i));
+                _mm_storeu_ps(out.data() + i, _mm_mul_ps(_mm_cvtepi32_ps(raw), scale));
+            }
+        }
+#endif
+
+        for (; i < count; ++i)
+            out[i] = static_cast<f32>(in[i]);
+    }
+
+    namespace detail
+    {
+        static_assert(sizeof(Vec3f) == 3 * sizeof(f32) && sizeof(Vec3h) == 3 * sizeof(f16) && sizeof(Vec3fx) == 3 * sizeof(fixed),
+                      "Vec3 arrays must be tightly packed to convert them as flat arrays");
+
+        template <typename T>
+        Span<T> Flatten(Span<Vec<T, 3>> vecs) { return Span<T>{ reinterpret_cast<T*>(vecs.data()), vecs.size() * 3 }; }
+
+        template <typename T>
+        Span<const T> Flatten(Span<const Vec<T, 3>> vecs) { return Span<const T>{ reinterpret_cast<const T*>(vecs.data()), vecs.size() * 3 }; }
+    }
+
+    // Vec3 overloads: 12-byte positions and normals to 6 or 12 bytes and back
+    inline void PackHalf(Span<const Vec3f> in, Span<Vec3h> out) { PackHalf(detail::Flatten(in), detail::Flatten(out)); }
+    inline void UnpackHalf(Span<const Vec3h> in, Span<Vec3f> out) { UnpackHalf(detail::Flatten(in), detail::Flatten(out)); }
+    inline void PackFixed(Span<const Vec3f> in, Span<Vec3fx> out) { PackFixed(detail::Flatten(in), detail::Flatten(out)); }
+    inline void UnpackFixed(Span<const Vec3fx> in, Span<Vec3f> out) { UnpackFixed(detail::Flatten(in), detail::Flatten(out)); }
+}
+
+#endif // J_PACK_H
@@ -0,0 +1,95 @@
+#ifndef J_ROTOR_H
+#define J_ROTOR_H
+
+#include <cmath> // std::atan2, std::acos
+
+#include "jtypes.h"
+#include "jvec.h"
+#include "jmatrix.h"
+#include "jcmath.h"
+
+namespace jg
+{
+    /*
+     * 2D rotation stored as a unit complex number c + s*i, with c = cos(angle)
+     * and s = sin(angle). Rotating a vector costs 4 multiplies and 2 adds, and
+     * composing two rotations is a complex product.
+     */
+    template <typename T>
+    struct Rotor2
+    {
+        T c, s;
+
+        static constexpr Rotor2 Identity() { return Rotor2{ static_cast<T>(1), static_cast<T>(0) }; }
+        static constexpr Rotor2 FromAngle(const T& rad) { return Rotor2{ Cos(rad), Sin(rad) }; }
+
+        explicit constexpr Rotor2() : c{ static_cast<T>(1) }, s{ static_cast<T>(0) } {}
+        explicit constexpr Rotor2(const T& nc, const T& ns) : c{ nc }, s{ ns } {}
+    };
+
+    // Applies rhs first, then lhs
+    template <typename T>
+    constexpr Rotor2<T> operator*(const Rotor2<T>& lhs, const Rotor2<T>& rhs)
+    {
+        return Rotor2<T>{
+            lhs.c * rhs.c - lhs.s * rhs.s,
+            lhs.s * rhs.c + lhs.c * rhs.s
+        };
+    }
+
+    template <typename T>
+    constexpr Vec<T, 2> Rotate(const Rotor2<T>& r, const Vec<T, 2>& v)
+    {
+        return Vec<T, 2>{ r.c * v.x - r.s * v.y, r.s * v.x + r.c * v.y };
+    }
+
+    // Inverse of a unit rotor
+    template <typename T>
+    constexpr Rotor2<T> Conjugate(const Rotor2<T>& r) { return Rotor2<T>{ r.c, -r.s }; }
+
+    template <typename T>
+    constexpr T Dot(const Rotor2<T>& lhs, const Rotor2<T>& rhs) { return lhs.c * rhs.c + lhs.s * rhs.s; }
+
+    template <typename T>
+    constexpr Rotor2<T> Normalize(const Rotor2<T>& r)
+    {
+        const auto invLen = static_cast<T>(1) / Sqrt(Dot(r, r));
+        return Rotor2<T>{ r.c * invLen, r.s * invLen };
+    }
+
+    template <typename T>
+    T Angle(const Rotor2<T>& r) { return std::atan2(r.s, r.c); }
+
+    // Same matrix as Mat3::Rotation2D(Angle(r))
+    template <typename T>
+    constexpr Mat<T, 3, 3> ToMat3(const Rotor2<T>& r)
+    {
+        return Mat<T, 3, 3>{
+                          r.c,               r.s, static_cast<T>(0),
+                         -r.s,               r.c, static_cast<T>(0),
+            static_cast<T>(0), static_cast<T>(0), static_cast<T>(1)
+        };
+    }
+
+    // Normalized lerp: cheap, constant-speed only for small angles
+    template <typename T>
+    constexpr Rotor2<T> Nlerp(const Rotor2<T>& a, const Rotor2<T>& b, const T& t)
+    {
+        return Normalize(Rotor2<T>{ a.c + (b.c - a.c) * t, a.s + (b.s - a.s) * t });
+    }
+
+    // Constant angular speed along the shorter arc
+    template <typename T>
+    Rotor2<T> Slerp(const Rotor2<T>& a, const Rotor2<T>& b, const T& t)
+    {
+        // Relative rotation a^-1 * b, scaled by t
+        const auto rel = Conjugate(a) * b;
+        return a * Rotor2<T>::FromAngle(std::atan2(rel.s, rel.c) * t);
+    }
+
+
+
+    using Rotor2f = Rotor2<f32>;
+}
+
+#endif // J_ROTOR_H
@@ -0,0 +1,78 @@
+#ifndef J_SIMD_H
+#define J_SIMD_H
+
+/*
+ * Compile-time switch for the intrinsic-backed math paths.
+ *
+ * JG_SIMD_SSE is defined when SSE2 is available (always the case on x64) and
+ * JG_SIMD_AVX when the compiler targets AVX (JG_SIMD_FMA if it also has FMA).
+ * JG_SIMD_F16C marks hardware float <-> half conversion.
+ * Define JG_NO_SIMD to force the portable scalar implementations everywhere.
+ */
+#if !defined(JG_NO_SIMD)
+    #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #define JG_SIMD_SSE 1
+        #include <emmintrin.h>
+    #endif
+
+    #if defined(JG_SIMD_SSE) && defined(__AVX__)
+        #define JG_SIMD_AVX 1
+        #include <immintrin.h>
+    #endif
+
+    #if defined(JG_SIMD_AVX) && defined(__FMA__)
+        #define JG_SIMD_FMA 1
+    #endif
+
+    // MSVC has no __F16C__; every AVX2 CPU has F16C
+    #if defined(JG_SIMD_SSE) && (defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__)))
+        #define JG_SIMD_F16C 1
+        #include <immintrin.h>
+    #endif
+#endif
+
+namespace jg
+{
+#if defined(JG_SIMD_SSE)
+    // a * b + c, fused when the target supports it
+    inline __m128 MulAdd(__m128 a, __m128 b, __m128 c)
+    {
+    #if defined(JG_SIMD_FMA)
+        return _mm_fmadd_ps(a, b, c);
+    #else
+        return _mm_add_ps(_mm_mul_ps(a, b), c);
+    #endif
+    }
+
+    inline __m128d MulAdd(__m128d a, __m128d b, __m128d c)
+    {
+    #if defined(JG_SIMD_FMA)
+        return _mm_fmadd_pd(a, b, c);
+    #else
+        return _mm_add_pd(_mm_mul_pd(a, b), c);
+    #endif
+    }
+#endif
+
+#if defined(JG_SIMD_AVX)
+    inline __m256 MulAdd(__m256 a, __m256 b, __m256 c)
+    {
+    #if defined(JG_SIMD_FMA)
+        return _mm256_fmadd_ps(a, b, c);
+    #else
+        return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+    #endif
+    }
+
+    inline __m256d MulAdd(__m256d a, __m256d b, __m256d c)
+    {
+    #if defined(JG_SIMD_FMA)
+        return _mm256_fmadd_pd(a, b, c);
+    #else
+        return _mm256_add_pd(_mm256_mul_pd(a, b), c);
+    #endif
+    }
+#endif
+}
+
+#endif // J_SIMD_H
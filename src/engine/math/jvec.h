@@ -2,11 +2,17 @@
 #define J_VEC_H
 
 #include <cassert> // assert
-#include <cmath> // std::sqrt
 #include <array> // std::array
 
 #include "jtypes.h"
-
+#include "jsimd.h"
+#include "jcmath.h"
+
+/*
+ * Every operation here is constexpr. Vec2/3/4 are built through their named
+ * members, so in constant expressions operator[] reads those instead of the
+ * aliased data array.
+ */
 namespace jg
 {
     template <typename T, size_t N>
@@ -14,9 +20,9 @@ namespace jg
     {
         std::array<T, N> data;
 
-        explicit constexpr Vec(const T& val)
+        explicit constexpr Vec(const T& val) : data{}
         {
-            for (auto i = 0; i < N; ++i)
+            for (size_t i = 0; i < N; ++i)
                 data[i] = val;
         }
 
@@ -34,68 +40,91 @@ namespace jg
         constexpr Vec operator-() const
         {
             auto out = *this;
-            for (auto i = 0; i < N; ++i)
-                out.data[i] = -out.data[i];
+            for (size_t i = 0; i < N; ++i)
+                out[i] = -out[i];
             return out;
         }
     };
 
     template <typename T, size_t N>
-    Vec<T, N> operator+(const Vec<T, N>& lhs, const Vec<T, N>& rhs)
+    constexpr Vec<T, N> operator+(const Vec<T, N>& lhs, const Vec<T, N>& rhs)
     {
         auto ret = lhs;
-        for (auto i = 0; i < N; ++i)
-            ret.data[i] += rhs.data[i];
+        for (size_t i = 0; i < N; ++i)
+            ret[i] += rhs[i];
         return ret;
     }
 
     template <typename T, size_t N>
-    Vec<T, N> operator-(const Vec<T, N>& lhs, const Vec<T, N>& rhs)
+    constexpr Vec<T, N> operator-(const Vec<T, N>& lhs, const Vec<T, N>& rhs)
     {
-        return lhs + -rhs;
+        auto ret = lhs;
+        for (size_t i = 0; i < N; ++i)
+            ret[i] -= rhs[i];
+        return ret;
     }
 
     template <typename T, size_t N>
-    Vec<T, N> operator*(const Vec<T, N>& lhs, const T& rhs)
+    constexpr Vec<T, N> operator*(const Vec<T, N>& lhs, const T& rhs)
     {
         auto ret = lhs;
-        for (auto i = 0; i < N; ++i)
-            ret.data[i] *= rhs;
+        for (size_t i = 0; i < N; ++i)
+            ret[i] *= rhs;
         return ret;
     }
 
     template <typename T, size_t N>
-    Vec<T, N> operator*(const T& lhs, const Vec<T, N>& rhs)
+    constexpr Vec<T, N> operator*(const T& lhs, const Vec<T, N>& rhs)
     {
         return rhs * lhs;
     }
 
     template <typename T, size_t N>
-    Vec<T, N> operator/(const Vec<T, N>& lhs, const T& rhs)
+    constexpr Vec<T, N> operator/(const Vec<T, N>& lhs, const T& rhs)
     {
         auto ret = lhs;
-        for (auto i = 0; i < N; ++i)
-            ret.data[i] /= rhs;
+        for (size_t i = 0; i < N; ++i)
+            ret[i] /= rhs;
         return ret;
     }
 
     template <typename T, size_t N>
-    T Dot(const Vec<T, N>& lhs, const Vec<T, N>& rhs)
+    constexpr T Dot(const Vec<T, N>& lhs, const Vec<T, N>& rhs)
     {
         auto ret = T{};
-        for (auto i = 0; i < N; ++i)
-            ret += lhs.data[i] * rhs.data[i];
+        for (size_t i = 0; i < N; ++i)
+            ret += lhs[i] * rhs[i];
         return ret;
     }
 
     template <typename T, size_t N>
-    T LengthSq(const Vec<T, N>& vec) { return Dot(vec, vec); }
+    constexpr T LengthSq(const Vec<T, N>& vec) { return Dot(vec, vec); }
+
+    template <typename T, size_t N>
+    constexpr T Length(const Vec<T, N>& vec) { return Sqrt(LengthSq(vec)); }
+
+    template <typename T, size_t N>
+    constexpr Vec<T, N> Normalize(const Vec<T, N>& vec) { return vec / Length(vec); }
 
+    // Component-wise minimum
     template <typename T, size_t N>
-    T Length(const Vec<T, N>& vec) { return std::sqrt(LengthSq(vec)); }
+    constexpr Vec<T, N> Min(const Vec<T, N>& lhs, const Vec<T, N>& rhs)
+    {
+        auto ret = lhs;
+        for (size_t i = 0; i < N; ++i)
+            ret[i] = rhs[i] < lhs[i] ? rhs[i] : lhs[i];
+        return ret;
+    }
 
+    // Component-wise maximum
     template <typename T, size_t N>
-    Vec<T, N> Normalize(const Vec<T, N>& vec) { return vec / Length(vec); }
+    constexpr Vec<T, N> Max(const Vec<T, N>& lhs, const Vec<T, N>& rhs)
+    {
+        auto ret = lhs;
+        for (size_t i = 0; i < N; ++i)
+            ret[i] = rhs[i] > lhs[i] ? rhs[i] : lhs[i];
+        return ret;
+    }
 
 
 
@@ -115,17 +144,33 @@ namespace jg
         constexpr T& operator[](size_t index)
         {
             assert(index < 2);
+            if (JG_IS_CONSTANT_EVALUATED())
+                return index == 0 ? x : y;
             return data[index];
         }
         constexpr const T& operator[](size_t index) const
         {
             assert(index < 2);
+            if (JG_IS_CONSTANT_EVALUATED())
+                return index == 0 ? x : y;
             return data[index];
         }
 
         constexpr Vec operator-() const { return Vec{ -x, -y }; }
     };
 
+    // z of the 3D cross product of (lhs, 0) and (rhs, 0)
+    template <typename T>
+    constexpr T Cross(const Vec<T, 2>& lhs, const Vec<T, 2>& rhs) { return lhs.x * rhs.y - lhs.y * rhs.x; }
+
+    // (0, 0, s) x (v, 0): v rotated a quarter turn counter-clockwise, scaled by s
+    template <typename T>
+    constexpr Vec<T, 2> Cross(const T& s, const Vec<T, 2>& v) { return Vec<T, 2>{ -s * v.y, s * v.x }; }
+
+    // (v, 0) x (0, 0, s)
+    template <typename T>
+    constexpr Vec<T, 2> Cross(const Vec<T, 2>& v, const T& s) { return Vec<T, 2>{ s * v.y, -s * v.x }; }
+
 
 
     template <typename T>
@@ -147,11 +192,15 @@ namespace jg
         constexpr T& operator[](size_t index)
         {
             assert(index < 3);
+            if (JG_IS_CONSTANT_EVALUATED())
+                return index == 0 ? x : (index == 1 ? y : z);
             return data[index];
         }
         constexpr const T& operator[](size_t index) const
         {
             assert(index < 3);
+            if (JG_IS_CONSTANT_EVALUATED())
+                return index == 0 ? x : (index == 1 ? y : z);
             return data[index];
         }
 
@@ -159,7 +208,7 @@ namespace jg
     };
 
     template <typename T>
-    Vec<T, 3> Cross(const Vec<T, 3>& lhs, const Vec<T, 3>& rhs)
+    constexpr Vec<T, 3> Cross(const Vec<T, 3>& lhs, const Vec<T, 3>& rhs)
     {
         return Vec<T, 3>{
             lhs.y * rhs.z - lhs.z * rhs.y,
@@ -189,17 +238,115 @@ namespace jg
         constexpr T& operator[](size_t index)
         {
             assert(index < 4);
+            if (JG_IS_CONSTANT_EVALUATED())
+                return index == 0 ? x : (index == 1 ? y : (index == 2 ? z : w));
             return data[index];
         }
         constexpr const T& operator[](size_t index) const
         {
             assert(index < 4);
+            if (JG_IS_CONSTANT_EVALUATED())
+                return index == 0 ? x : (index == 1 ? y : (index == 2 ? z : w));
+            return data[index];
+        }
+
+        constexpr Vec operator-() const { return Vec{ -x, -y, -z, -w }; }
+    };
+
+
+
+#if defined(JG_SIMD_SSE)
+    template <>
+    struct alignas(16) Vec<f32, 4>
+    {
+        union
+        {
+            std::array<f32, 4> data;
+            struct { f32 x, y, z, w; };
+            struct { f32 r, g, b, a; };
+            Vec<f32, 2> xy;
+            Vec<f32, 3> xyz;
+            Vec<f32, 3> rgb;
+            __m128 simd;
+        };
+
+        explicit constexpr Vec(const f32& val = 0.0f) : x{ val }, y{ val }, z{ val }, w{ val } {}
+        explicit constexpr Vec(const f32& nx, const f32& ny, const f32& nz, const f32& nw) : x{ nx }, y{ ny }, z{ nz }, w{ nw } {}
+        explicit Vec(__m128 v) : simd{ v } {}
+
+        constexpr f32& operator[](size_t index)
+        {
+            assert(index < 4);
+            if (JG_IS_CONSTANT_EVALUATED())
+                return index == 0 ? x : (index == 1 ? y : (index == 2 ? z : w));
+            return data[index];
+        }
+        constexpr const f32& operator[](size_t index) const
+        {
+            assert(index < 4);
+            if (JG_IS_CONSTANT_EVALUATED())
+                return index == 0 ? x : (index == 1 ? y : (index == 2 ? z : w));
             return data[index];
         }
 
         constexpr Vec operator-() const { return Vec{ -x, -y, -z, -w }; }
     };
 
+    // The intrinsics are not constexpr, so constant expressions take the scalar path
+
+    constexpr Vec<f32, 4> operator+(const Vec<f32, 4>& lhs, const Vec<f32, 4>& rhs)
+    {
+        if (JG_IS_CONSTANT_EVALUATED())
+            return Vec<f32, 4>{ lhs.x + rhs.x, lhs.y + rhs.y, lhs.z + rhs.z, lhs.w + rhs.w };
+        return Vec<f32, 4>{ _mm_add_ps(lhs.simd, rhs.simd) };
+    }
+
+    constexpr Vec<f32, 4> operator-(const Vec<f32, 4>& lhs, const Vec<f32, 4>& rhs)
+    {
+        if (JG_IS_CONSTANT_EVALUATED())
+            return Vec<f32, 4>{ lhs.x - rhs.x, lhs.y - rhs.y, lhs.z - rhs.z, lhs.w - rhs.w };
+        return Vec<f32, 4>{ _mm_sub_ps(lhs.simd, rhs.simd) };
+    }
+
+    constexpr Vec<f32, 4> operator*(const Vec<f32, 4>& lhs, const f32& rhs)
+    {
+        if (JG_IS_CONSTANT_EVALUATED())
+            return Vec<f32, 4>{ lhs.x * rhs, lhs.y * rhs, lhs.z * rhs, lhs.w * rhs };
+        return Vec<f32, 4>{ _mm_mul_ps(lhs.simd, _mm_set1_ps(rhs)) };
+    }
+
+    constexpr Vec<f32, 4> operator*(const f32& lhs, const Vec<f32, 4>& rhs) { return rhs * lhs; }
+
+    constexpr Vec<f32, 4> operator/(const Vec<f32, 4>& lhs, const f32& rhs)
+    {
+        if (JG_IS_CONSTANT_EVALUATED())
+            return Vec<f32, 4>{ lhs.x / rhs, lhs.y / rhs, lhs.z / rhs, lhs.w / rhs };
+        return Vec<f32, 4>{ _mm_div_ps(lhs.simd, _mm_set1_ps(rhs)) };
+    }
+
+    // Dot product broadcast to all 4 lanes
+    inline __m128 DotSplat(const Vec<f32, 4>& lhs, const Vec<f32, 4>& rhs)
+    {
+        const auto mul = _mm_mul_ps(lhs.simd, rhs.simd);
+        const auto sum = _mm_add_ps(mul, _mm_shuffle_ps(mul, mul, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_add_ps(sum, _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(1, 0, 3, 2)));
+    }
+
+    constexpr f32 Dot(const Vec<f32, 4>& lhs, const Vec<f32, 4>& rhs)
+    {
+        if (JG_IS_CONSTANT_EVALUATED())
+            return lhs.x * rhs.x + lhs.y * rhs.y + lhs.z * rhs.z + lhs.w * rhs.w;
+        return _mm_cvtss_f32(DotSplat(lhs, rhs));
+    }
+
+    constexpr Vec<f32, 4> Normalize(const Vec<f32, 4>& vec)
+    {
+        if (JG_IS_CONSTANT_EVALUATED())
+            return vec / Sqrt(Dot(vec, vec));
+        return Vec<f32, 4>{ _mm_div_ps(vec.simd, _mm_sqrt_ps(DotSplat(vec, vec))) };
+    }
+#endif
+
 
 
     // Aliases
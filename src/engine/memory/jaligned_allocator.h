@@ -0,0 +1,49 @@
+#ifndef J_ALIGNED_ALLOCATOR_H
+#define J_ALIGNED_ALLOCATOR_H
+
+#include <cstddef> // size_t
+#include <new> // operator new, std::align_val_t, std::bad_array_new_length
+
+namespace jg
+{
+    namespace memory
+    {
+        // Standard allocator returning Align-aligned blocks, e.g. std::vector<Vec3f, AlignedAllocator<Vec3f, 32>>
+        template <typename T, size_t Align = alignof(T)>
+        struct AlignedAllocator
+        {
+            static_assert((Align & (Align - 1)) == 0, "Align must be a power of two");
+            static_assert(Align >= alignof(T), "Align must not weaken the alignment of T");
+
+            using value_type = T;
+
+            template <typename U>
+            struct rebind { using other = AlignedAllocator<U, (Align > alignof(U) ? Align : alignof(U))>; };
+
+            static constexpr size_t ALIGNMENT = Align;
+
+            constexpr AlignedAllocator() = default;
+            template <typename U, size_t A>
+            constexpr AlignedAllocator(const AlignedAllocator<U, A>&) {}
+
+            T* allocate(size_t n)
+            {
+                if (n > static_cast<size_t>(-1) / sizeof(T))
+                    throw std::bad_array_new_length{};
+                return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{ Align }));
+            }
+
+            void deallocate(T* p, size_t)
+            {
+                ::operator delete(p, std::align_val_t{ Align });
+            }
+        };
+
+        template <typename T, size_t A, typename U, size_t B>
+        constexpr bool operator==(const AlignedAllocator<T, A>&, const AlignedAllocator<U, B>&) { return true; }
+        template <typename T, size_t A, typename U, size_t B>
+        constexpr bool operator!=(const AlignedAllocator<T, A>&, const AlignedAllocator<U, B>&) { return false; }
+    }
+}
+
+#endif // J_ALIGNED_ALLOCATOR_H
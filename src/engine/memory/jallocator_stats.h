@@ -0,0 +1,23 @@
+#ifndef J_ALLOCATOR_STATS_H
+#define J_ALLOCATOR_STATS_H
+
+#include <cstddef> // size_t
+
+namespace jg
+{
+    namespace memory
+    {
+        // Usage counters shared by the engine allocators; sizes are in bytes
+        struct AllocatorStats
+        {
+            size_t used = 0;
+            size_t peak = 0;
+            size_t capacity = 0;
+            size_t allocations = 0;
+            // Requests refused because the allocator was full
+            size_t failures = 0;
+        };
+    }
+}
+
+#endif // J_ALLOCATOR_STATS_H
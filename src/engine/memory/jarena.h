@@ -0,0 +1,125 @@
+#ifndef J_ARENA_H
+#define J_ARENA_H
+
+#include <cassert> // assert
+#include <cstddef> // size_t
+#include <cstdint> // uintptr_t
+#include <new> // operator new, std::align_val_t, std::bad_alloc
+
+#include "jtypes.h"
+#include "jspan.h"
+#include "jallocator_stats.h"
+
+namespace jg
+{
+    namespace memory
+    {
+        /*
+         * Linear (bump) allocator over one owned block. Individual frees are
+         * no-ops; memory is released all at once by Reset() or back to a
+         * Marker by Rewind().
+         */
+        class Arena
+        {
+        public:
+            static constexpr size_t BLOCK_ALIGNMENT = 64;
+
+            // Position to Rewind() to, releasing everything allocated after it
+            using Marker = size_t;
+
+            explicit Arena(size_t capacity)
+                : m_begin{ static_cast<u8*>(::operator new(capacity, std::align_val_t{ BLOCK_ALIGNMENT })) }
+            {
+                m_stats.capacity = capacity;
+            }
+            ~Arena() { ::operator delete(m_begin, std::align_val_t{ BLOCK_ALIGNMENT }); }
+
+            Arena(const Arena&) = delete;
+            Arena& operator=(const Arena&) = delete;
+
+            // Returns nullptr when the arena is exhausted
+            void* Allocate(size_t size, size_t align = alignof(std::max_align_t))
+            {
+                assert((align & (align - 1)) == 0);
+                const auto base = reinterpret_cast<uintptr_t>(m_begin);
+                const auto start = (base + m_stats.used + align - 1) & ~(static_cast<uintptr_t>(align) - 1);
+                const auto offset = static_cast<size_t>(start - base);
+                if (offset > m_stats.capacity || size > m_stats.capacity - offset)
+                {
+                    ++m_stats.failures;
+                    return nullptr;
+                }
+                m_stats.used = offset + size;
+                m_stats.peak = m_stats.used > m_stats.peak ? m_stats.used : m_stats.peak;
+                ++m_stats.allocations;
+                return m_begin + offset;
+            }
+
+            // Uninitialized storage for count objects; empty when the arena is exhausted
+            template <typename T>
+            Span<T> AllocateArray(size_t count, size_t align = alignof(T))
+            {
+                if (count > static_cast<size_t>(-1) / sizeof(T))
+                    return Span<T>{};
+                auto* p = static_cast<T*>(Allocate(count * sizeof(T), align));
+                return p ? Span<T>{ p, count } : Span<T>{};
+            }
+
+            Marker GetMarker() const { return m_stats.used; }
+            void Rewind(Marker marker)
+            {
+                assert(marker <= m_stats.used);
+                m_stats.used = marker;
+            }
+            void Reset() { m_stats.used = 0; }
+
+            size_t Used() const { return m_stats.used; }
+            size_t Capacity() const { return m_stats.capacity; }
+            const AllocatorStats& Stats() const { return m_stats; }
+
+        private:
+            u8* m_begin;
+            AllocatorStats m_stats;
+        };
+
+        // Standard allocator drawing from an Arena; deallocate is a no-op
+        template <typename T, size_t Align = alignof(T)>
+        struct ArenaAllocator
+        {
+            static_assert((Align & (Align - 1)) == 0, "Align must be a power of two");
+            static_assert(Align >= alignof(T), "Align must not weaken the alignment of T");
+
+            using value_type = T;
+
+            template <typename U>
+            struct rebind { using other = ArenaAllocator<U, (Align > alignof(U) ? Align : alignof(U))>; };
+
+            static constexpr size_t ALIGNMENT = Align;
+
+            Arena* arena;
+
+            explicit ArenaAllocator(Arena& a) : arena{ &a } {}
+            template <typename U, size_t A>
+            ArenaAllocator(const ArenaAllocator<U, A>& other) : arena{ other.arena } {}
+
+            T* allocate(size_t n)
+            {
+                if (n > static_cast<size_t>(-1) / sizeof(T))
+                    throw std::bad_alloc{};
+                auto* p = arena->Allocate(n * sizeof(T), Align);
+                if (p == nullptr)
+                    throw std::bad_alloc{};
+                return static_cast<T*>(p);
+            }
+
+            void deallocate(T*, size_t) {}
+        };
+
+        template <typename T, size_t A, typename U, size_t B>
+        bool operator==(const ArenaAllocator<T, A>& lhs, const ArenaAllocator<U, B>& rhs) { return lhs.arena == rhs.arena; }
+        template <typename T, size_t A, typename U, size_t B>
+        bool operator!=(const ArenaAllocator<T, A>& lhs, const ArenaAllocator<U, B>& rhs) { return lhs.arena != rhs.arena; }
+    }
+}
+
+#endif // J_ARENA_H
@@ -0,0 +1,62 @@
+#ifndef J_FRAME_ARENA_H
+#define J_FRAME_ARENA_H
+
+#include <cstddef> // size_t
+
+#include "jarena.h"
+
+namespace jg
+{
+    namespace memory
+    {
+        /*
+         * Per-frame scratch memory: an Arena that is reset at the start of
+         * every frame, so culling lists, batched transforms and other
+         * temporaries never reach malloc. Tracks the high-water mark across
+         * frames to size the capacity.
+         */
+        class FrameArena
+        {
+        public:
+            explicit FrameArena(size_t capacity) : m_arena{ capacity } {}
+
+            // Releases everything allocated during the previous frame
+            void BeginFrame()
+            {
+                m_lastFrameUsed = m_arena.Used();
+                m_peakFrameUsed = m_lastFrameUsed > m_peakFrameUsed ? m_lastFrameUsed : m_peakFrameUsed;
+                m_arena.Reset();
+                ++m_frameCount;
+            }
+
+            // Returns nullptr when this frame's budget is exhausted
+            void* Allocate(size_t size, size_t align = alignof(std::max_align_t)) { return m_arena.Allocate(size, align); }
+
+            template <typename T>
+            Span<T> AllocateArray(size_t count, size_t align = alignof(T)) { return m_arena.AllocateArray<T>(count, align); }
+
+            // For ArenaAllocator-backed containers that live for one frame
+            Arena& GetArena() { return m_arena; }
+
+            size_t Used() const { return m_arena.Used(); }
+            size_t Capacity() const { return m_arena.Capacity(); }
+            size_t LastFrameUsed() const { return m_lastFrameUsed; }
+            // Largest amount used by any completed frame
+            size_t PeakFrameUsed() const { return m_peakFrameUsed; }
+            size_t FrameCount() const { return m_frameCount; }
+            // Lifetime counters; peak here includes the frame in progress
+            const AllocatorStats& Stats() const { return m_arena.Stats(); }
+
+        private:
+            Arena m_arena;
+            size_t m_lastFrameUsed = 0;
+            size_t m_peakFrameUsed = 0;
+            size_t m_frameCount = 0;
+        };
+
+        template <typename T>
+        using FrameAllocator = ArenaAllocator<T>;
+    }
+}
+
+#endif // J_FRAME_ARENA_H
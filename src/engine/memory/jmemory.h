@@ -0,0 +1,10 @@
+#ifndef J_MEMORY_H
+#define J_MEMORY_H
+
+#include "jallocator_stats.h"
+#include "jaligned_allocator.h"
+#include "jarena.h"
+#include "jframe_arena.h"
+#include "jpool.h"
+
+#endif // J_MEMORY_H
@@ -0,0 +1,138 @@
+#ifndef J_POOL_H
+#define J_POOL_H
+
+#include <cassert> // assert
+#include <cstddef> // size_t
+#include <cstdint> // uintptr_t
+#include <new> // operator new, std::align_val_t, std::bad_alloc
+
+#include "jtypes.h"
+#include "jallocator_stats.h"
+
+namespace jg
+{
+    namespace memory
+    {
+        /*
+         * Fixed-size block allocator: one up-front slab carved into equal
+         * blocks, with an intrusive free list. Allocate and Free are O(1) and
+         * never touch the system heap after construction.
+         */
+        class Pool
+        {
+        public:
+            explicit Pool(size_t blockSize, size_t blockCount, size_t align = alignof(std::max_align_t))
+                : m_blockSize{ RoundUp(blockSize < sizeof(FreeBlock) ? sizeof(FreeBlock) : blockSize, align) }
+                , m_blockCount{ blockCount }
+                , m_align{ align }
+                , m_begin{ static_cast<u8*>(::operator new(m_blockSize * blockCount, std::align_val_t{ align })) }
+            {
+                assert((align & (align - 1)) == 0 && align >= alignof(FreeBlock));
+                // Thread the free list front to back so early allocations are contiguous
+                for (size_t i = blockCount; i-- > 0;)
+                    m_free = new (m_begin + i * m_blockSize) FreeBlock{ m_free };
+                m_stats.capacity = m_blockSize * blockCount;
+            }
+            ~Pool() { ::operator delete(m_begin, std::align_val_t{ m_align }); }
+
+            Pool(const Pool&) = delete;
+            Pool& operator=(const Pool&) = delete;
+
+            // Returns nullptr when every block is in use
+            void* Allocate()
+            {
+                if (m_free == nullptr)
+                {
+                    ++m_stats.failures;
+                    return nullptr;
+                }
+                auto* block = m_free;
+                m_free = block->next;
+                m_stats.used += m_blockSize;
+                m_stats.peak = m_stats.used > m_stats.peak ? m_stats.used : m_stats.peak;
+                ++m_stats.allocations;
+                return block;
+            }
+
+            void Free(void* p)
+            {
+                assert(Owns(p));
+                m_free = new (p) FreeBlock{ m_free };
+                m_stats.used -= m_blockSize;
+            }
+
+            bool Owns(const void* p) const
+            {
+                const auto addr = reinterpret_cast<uintptr_t>(p);
+                const auto begin = reinterpret_cast<uintptr_t>(m_begin);
+                return addr >= begin && addr < begin + m_blockSize * m_blockCount
+                    && (addr - begin) % m_blockSize == 0;
+            }
+
+            size_t BlockSize() const { return m_blockSize; }
+            size_t BlockCount() const { return m_blockCount; }
+            size_t Alignment() const { return m_align; }
+            size_t BlocksInUse() const { return m_stats.used / m_blockSize; }
+            const AllocatorStats& Stats() const { return m_stats; }
+
+        private:
+            struct FreeBlock
+            {
+                FreeBlock* next;
+            };
+
+            static size_t RoundUp(size_t size, size_t align) { return (size + align - 1) & ~(align - 1); }
+
+            size_t m_blockSize;
+            size_t m_blockCount;
+            size_t m_align;
+            u8* m_begin;
+            FreeBlock* m_free = nullptr;
+            AllocatorStats m_stats;
+        };
+
+        /*
+         * Standard allocator for node-based containers (std::list, std::map,
+         * std::unordered_map nodes): single-object requests that fit a block
+         * come from the Pool, anything else falls back to operator new.
+         */
+        template <typename T>
+        struct PoolAllocator
+        {
+            using value_type = T;
+
+            Pool* pool;
+
+            explicit PoolAllocator(Pool& p) : pool{ &p } {}
+            template <typename U>
+            PoolAllocator(const PoolAllocator<U>& other) : pool{ other.pool } {}
+
+            T* allocate(size_t n)
+            {
+                if (n == 1 && sizeof(T) <= pool->BlockSize() && alignof(T) <= pool->Alignment())
+                {
+                    if (auto* p = pool->Allocate())
+                        return static_cast<T*>(p);
+                }
+                if (n > static_cast<size_t>(-1) / sizeof(T))
+                    throw std::bad_alloc{};
+                return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{ alignof(T) }));
+            }
+
+            void deallocate(T* p, size_t)
+            {
+                if (pool->Owns(p))
+                    pool->Free(p);
+                else
+                    ::operator delete(p, std::align_val_t{ alignof(T) });
+            }
+        };
+
+        template <typename T, typename U>
+        bool operator==(const PoolAllocator<T>& lhs, const PoolAllocator<U>& rhs) { return lhs.pool == rhs.pool; }
+        template <typename T, typename U>
+        bool operator!=(const PoolAllocator<T>& lhs, const PoolAllocator<U>& rhs) { return lhs.pool != rhs.pool; }
+    }
+}
+
+#endif // J_POOL_H
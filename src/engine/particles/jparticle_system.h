@@ -0,0 +1,347 @@
+#ifndef J_PARTICLE_SYSTEM_H
+#define J_PARTICLE_SYSTEM_H
+
+#include <algorithm> // std::max
+#include <cassert> // assert
+#include <vector> // std::vector
+
+#include "jtypes.h"
+#include "jspan.h"
+#include "math/jsimd.h"
+#include "math/jvec.h"
+#include "math/jcmath.h"
+#include "memory/jaligned_allocator.h"
+#include "jobs/jparallel.h"
+
+namespace jg
+{
+    // Accelerates particles toward center (away for negative strength), fading linearly to zero at radius
+    struct ForceField
+    {
+        Vec2f center{ 0.0f };
+        f32 strength = 0.0f; // Acceleration at the center
+        f32 radius = 1.0f;
+    };
+
+    enum class Integrator
+    {
+        Euler, // Semi-implicit: v += a * dt, then x += v * dt
+        Verlet // Velocity Verlet: second order in position, one force evaluation per step
+    };
+
+    /*
+     * Fixed-capacity particle pool in structure-of-arrays layout: one
+     * 64-byte aligned f32 array per coordinate, so the update streams each
+     * array once and works on 4 particles per SSE instruction.
+     *
+     * Acceleration is gravity minus drag * velocity plus every force field,
+     * evaluated inside the integration pass instead of in separate sweeps.
+     * Particles whose age reaches their lifetime are removed after the pass
+     * by moving the last live particle into their slot, so the arrays stay
+     * packed but particle order is not kept.
+     */
+    class ParticleSystem
+    {
+    public:
+        // Particles per update chunk; a multiple of the SIMD width so chunks start aligned
+        static constexpr size_t UPDATE_GRAIN = 16384;
+
+        explicit ParticleSystem(size_t capacity) : m_capacity{ capacity }
+        {
+            for (auto* array : { &m_x, &m_y, &m_vx, &m_vy, &m_ax, &m_ay, &m_age, &m_lifetime })
+                array->resize(capacity);
+        }
+
+        // Returns false, emitting nothing, when the pool is full
+        bool Emit(const Vec2f& position, const Vec2f& velocity, f32 lifetime)
+        {
+            if (m_count == m_capacity)
+                return false;
+            const auto i = m_count++;
+            m_x[i] = position.x;
+            m_y[i] = position.y;
+            m_vx[i] = velocity.x;
+            m_vy[i] = velocity.y;
+            m_age[i] = 0.0f;
+            m_lifetime[i] = lifetime;
+            // Verlet carries the acceleration over from the previous step
+            Acceleration(CurrentForces(), position.x, position.y, velocity.x, velocity.y, m_ax[i], m_ay[i]);
+            return true;
+        }
+
+        void Clear() { m_count = 0; }
+
+        // Advances every particle by dt, then removes the ones that expired
+        void Update(f32 dt)
+        {
+            const auto chunks = BeginUpdate();
+            for (size_t c = 0; c < chunks; ++c)
+                UpdateChunk(c, dt);
+            RemoveDead();
+        }
+
+        // The same, with chunks of UPDATE_GRAIN particles spread over the pool
+        void Update(jobs::ThreadPool& pool, f32 dt)
+        {
+            const auto chunks = BeginUpdate();
+            jobs::ParallelFor(pool, 0, chunks, 1, [this, dt](size_t first, size_t last) {
+                for (auto c = first; c < last; ++c)
+                    UpdateChunk(c, dt);
+            });
+            RemoveDead();
+        }
+
+        void SetIntegrator(Integrator integrator) { m_integrator = integrator; }
+        void SetGravity(const Vec2f& gravity) { m_gravity = gravity; }
+        // Velocity is damped by drag per second
+        void SetDrag(f32 drag) { m_drag = drag; }
+        void AddForceField(const ForceField& field)
+        {
+            assert(field.radius > 0.0f);
+            m_fields.push_back(field);
+        }
+        void ClearForceFields() { m_fields.clear(); }
+
+        Integrator GetIntegrator() const { return m_integrator; }
+        const Vec2f& GetGravity() const { return m_gravity; }
+        f32 GetDrag() const { return m_drag; }
+        Span<const ForceField> ForceFields() const { return Span<const ForceField>{ m_fields.data(), m_fields.size() }; }
+
+        Span<const f32> PositionsX() const { return Live(m_x); }
+        Span<const f32> PositionsY() const { return Live(m_y); }
+        Span<const f32> VelocitiesX() const { return Live(m_vx); }
+        Span<const f32> VelocitiesY() const { return Live(m_vy); }
+        Span<const f32> Ages() const { return Live(m_age); }
+        Span<const f32> Lifetimes() const { return Live(m_lifetime); }
+
+        size_t size() const { return m_count; }
+        bool empty() const { return m_count == 0; }
+        size_t Capacity() const { return m_capacity; }
+
+    private:
+        using Array = std::vector<f32, memory::AlignedAllocator<f32, 64>>;
+
+#if defined(JG_SIMD_SSE)
+        // A force field broadcast to every lane, prepared once per update
+        struct FieldLanes
+        {
+            __m128 centerX, centerY, strength, invRadius;
+        };
+#endif
+
+        struct Forces
+        {
+            f32 gx, gy, drag;
+            const ForceField* fields;
+            size_t fieldCount;
+#if defined(JG_SIMD_SSE)
+            const FieldLanes* lanes;
+#endif
+        };
+
+        static constexpr f32 MIN_DISTANCE = 1e-6f;
+
+        Forces CurrentForces() const
+        {
+#if defined(JG_SIMD_SSE)
+            return { m_gravity.x, m_gravity.y, m_drag, m_fields.data(), m_fields.size(), m_fieldLanes.data() };
+#else
+            return { m_gravity.x, m_gravity.y, m_drag, m_fields.data(), m_fields.size() };
+#endif
+        }
+
+        Span<const f32> Live(const Array& array) const { return Span<const f32>{ array.data(), m_count }; }
+
+        static void Acceleration(const Forces& f, f32 x, f32 y, f32 vx, f32 vy, f32& ax, f32& ay)
+        {
+            ax = f.gx - f.drag * vx;
+            ay = f.gy - f.drag * vy;
+            for (size_t k = 0; k < f.fieldCount; ++k)
+            {
+                const auto& field = f.fields[k];
+                const auto dx = field.center.x - x;
+                const auto dy = field.center.y - y;
+                const auto dist = Sqrt(dx * dx + dy * dy);
+                const auto falloff = std::max(1.0f - dist / field.radius, 0.0f);
+                const auto s = field.strength * falloff / std::max(dist, MIN_DISTANCE);
+                ax += s * dx;
+                ay += s * dy;
+            }
+        }
+
+#if defined(JG_SIMD_SSE)
+        static void Acceleration(const Forces& f, __m128 x, __m128 y, __m128 vx, __m128 vy, __m128& ax, __m128& ay)
+        {
+            const auto minusDrag = _mm_set1_ps(-f.drag);
+            ax = MulAdd(minusDrag, vx, _mm_set1_ps(f.gx));
+            ay = MulAdd(minusDrag, vy, _mm_set1_ps(f.gy));
+            for (size_t k = 0; k < f.fieldCount; ++k)
+            {
+                const auto& field = f.lanes[k];
+                const auto dx = _mm_sub_ps(field.centerX, x);
+                const auto dy = _mm_sub_ps(field.centerY, y);
+                // rsqrt plus one Newton step is accurate to about 1e-7 and needs no divide
+                const auto distSq = _mm_max_ps(MulAdd(dx, dx, _mm_mul_ps(dy, dy)), _mm_set1_ps(MIN_DISTANCE * MIN_DISTANCE));
+                const auto estimate = _mm_rsqrt_ps(distSq);
+                const auto invDist = _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), estimate),
+                    _mm_sub_ps(_mm_set1_ps(3.0f), _mm_mul_ps(distSq, _mm_mul_ps(estimate, estimate))));
+                const auto dist = _mm_mul_ps(distSq, invDist);
+                const auto falloff = _mm_max_ps(_mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(dist, field.invRadius)), _mm_setzero_ps());
+                const auto s = _mm_mul_ps(_mm_mul_ps(field.strength, falloff), invDist);
+                ax = MulAdd(s, dx, ax);
+                ay = MulAdd(s, dy, ay);
+            }
+        }
+#endif
+
+        size_t BeginUpdate()
+        {
+            m_chunkCount = (m_count + UPDATE_GRAIN - 1) / UPDATE_GRAIN;
+            if (m_dead.size() < m_chunkCount)
+                m_dead.resize(m_chunkCount);
+            for (size_t c = 0; c < m_chunkCount; ++c)
+                m_dead[c].clear();
+#if defined(JG_SIMD_SSE)
+            m_fieldLanes.clear();
+            for (const auto& field : m_fields)
+            {
+                m_fieldLanes.push_back(FieldLanes{ _mm_set1_ps(field.center.x), _mm_set1_ps(field.center.y),
+                                                   _mm_set1_ps(field.strength), _mm_set1_ps(1.0f / field.radius) });
+            }
+#endif
+            return m_chunkCount;
+        }
+
+        void UpdateChunk(size_t chunk, f32 dt)
+        {
+            const auto first = chunk * UPDATE_GRAIN;
+            const auto last = first + UPDATE_GRAIN < m_count ? first + UPDATE_GRAIN : m_count;
+            auto& dead = m_dead[chunk];
+            const auto forces = CurrentForces();
+            const auto verlet = m_integrator == Integrator::Verlet;
+            auto i = first;
+
+#if defined(JG_SIMD_SSE)
+            {
+                const auto vdt = _mm_set1_ps(dt);
+                const auto halfDt = _mm_set1_ps(0.5f * dt);
+                const auto halfDt2 = _mm_set1_ps(0.5f * dt * dt);
+                for (; i + 4 <= last; i += 4)
+                {
+                    auto x = _mm_load_ps(&m_x[i]);
+                    auto y = _mm_load_ps(&m_y[i]);
+                    auto vx = _mm_load_ps(&m_vx[i]);
+                    auto vy = _mm_load_ps(&m_vy[i]);
+                    __m128 ax, ay;
+                    if (verlet)
+                    {
+                        const auto oldAx = _mm_load_ps(&m_ax[i]);
+                        const auto oldAy = _mm_load_ps(&m_ay[i]);
+                        x = MulAdd(oldAx, halfDt2, MulAdd(vx, vdt, x));
+                        y = MulAdd(oldAy, halfDt2, MulAdd(vy, vdt, y));
+                        Acceleration(forces, x, y, vx, vy, ax, ay);
+                        vx = MulAdd(_mm_add_ps(oldAx, ax), halfDt, vx);
+                        vy = MulAdd(_mm_add_ps(oldAy, ay), halfDt, vy);
+                        _mm_store_ps(&m_ax[i], ax);
+                        _mm_store_ps(&m_ay[i], ay);
+                    }
+                    else
+                    {
+                        Acceleration(forces, x, y, vx, vy, ax, ay);
+                        vx = MulAdd(ax, vdt, vx);
+                        vy = MulAdd(ay, vdt, vy);
+                        x = MulAdd(vx, vdt, x);
+                        y = MulAdd(vy, vdt, y);
+                    }
+                    _mm_store_ps(&m_x[i], x);
+                    _mm_store_ps(&m_y[i], y);
+                    _mm_store_ps(&m_vx[i], vx);
+                    _mm_store_ps(&m_vy[i], vy);
+
+                    const auto age = _mm_add_ps(_mm_load_ps(&m_age[i]), vdt);
+                    _mm_store_ps(&m_age[i], age);
+                    auto expired = _mm_movemask_ps(_mm_cmpge_ps(age, _mm_load_ps(&m_lifetime[i])));
+                    for (; expired != 0; expired &= expired - 1)
+                        dead.push_back(static_cast<u32>(i + CountTrailingZeros(expired)));
+                }
+            }
+#endif
+
+            for (; i < last; ++i)
+            {
+                auto& x = m_x[i];
+                auto& y = m_y[i];
+                auto& vx = m_vx[i];
+                auto& vy = m_vy[i];
+                f32 ax, ay;
+                if (verlet)
+                {
+                    x += vx * dt + m_ax[i] * (0.5f * dt * dt);
+                    y += vy * dt + m_ay[i] * (0.5f * dt * dt);
+                    Acceleration(forces, x, y, vx, vy, ax, ay);
+                    vx += (m_ax[i] + ax) * (0.5f * dt);
+                    vy += (m_ay[i] + ay) * (0.5f * dt);
+                    m_ax[i] = ax;
+                    m_ay[i] = ay;
+                }
+                else
+                {
+                    Acceleration(forces, x, y, vx, vy, ax, ay);
+                    vx += ax * dt;
+                    vy += ay * dt;
+                    x += vx * dt;
+                    y += vy * dt;
+                }
+                m_age[i] += dt;
+                if (m_age[i] >= m_lifetime[i])
+                    dead.push_back(static_cast<u32>(i));
+            }
+        }
+
+        static u32 CountTrailingZeros(int mask)
+        {
+            u32 n = 0;
+            for (; (mask & 1) == 0; mask >>= 1)
+                ++n;
+            return n;
+        }
+
+        // Chunks are in order and each lists its dead ascending, so walking back to front always
+        // finds a live particle at the end to fill the hole with
+        void RemoveDead()
+        {
+            for (auto c = m_chunkCount; c-- > 0;)
+            {
+                const auto& dead = m_dead[c];
+                for (auto k = dead.size(); k-- > 0;)
+                {
+                    const auto hole = dead[k];
+                    const auto last = --m_count;
+                    if (hole == last)
+                        continue;
+                    for (auto* array : { &m_x, &m_y, &m_vx, &m_vy, &m_ax, &m_ay, &m_age, &m_lifetime })
+                        (*array)[hole] = (*array)[last];
+                }
+            }
+        }
+
+        Array m_x, m_y, m_vx, m_vy;
+        Array m_ax, m_ay; // Acceleration at the end of the last step, for Verlet
+        Array m_age, m_lifetime;
+        size_t m_count = 0;
+        size_t m_capacity;
+
+        std::vector<std::vector<u32>> m_dead; // Per update chunk, kept to reuse their memory
+        size_t m_chunkCount = 0;
+
+        Integrator m_integrator = Integrator::Euler;
+        Vec2f m_gravity{ 0.0f };
+        f32 m_drag = 0.0f;
+        std::vector<ForceField> m_fields;
+#if defined(JG_SIMD_SSE)
+        std::vector<FieldLanes> m_fieldLanes;
+#endif
+    };
+}
+
+#endif // J_PARTICLE_SYSTEM_H
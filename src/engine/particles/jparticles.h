@@ -0,0 +1,6 @@
+#ifndef J_PARTICLES_H
+#define J_PARTICLES_H
+
+#include "jparticle_system.h"
+
+#endif // J_PARTICLES_H
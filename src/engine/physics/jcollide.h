@@ -0,0 +1,259 @@
+#ifndef J_COLLIDE_H
+#define J_COLLIDE_H
+
+#include <array> // std::array
+#include <limits> // std::numeric_limits
+
+#include "jtypes.h"
+#include "math/jvec.h"
+#include "math/jcmath.h"
+#include "jshape.h"
+
+namespace jg
+{
+    namespace physics
+    {
+        // Penetration the solver leaves alone, so resting contacts do not jitter. Lengths are in meters
+        constexpr f32 LINEAR_SLOP = 0.005f;
+
+        // Shapes closer than this get contact points before they touch, which stops fast bodies overshooting
+        constexpr f32 SPECULATIVE_DISTANCE = 4.0f * LINEAR_SLOP;
+
+        struct ManifoldPoint
+        {
+            Vec2f point{ 0.0f }; // World space, halfway between the two surfaces
+            f32 separation = 0.0f; // Negative when overlapping
+            u32 id = 0; // Names the features that made the point, so it can be matched across steps
+        };
+
+        // Up to two contact points sharing one normal, which points from shape A to shape B
+        struct Manifold
+        {
+            Vec2f normal{ 0.0f };
+            std::array<ManifoldPoint, 2> points;
+            u32 count = 0;
+        };
+
+        namespace detail
+        {
+            // A polygon moved into world space
+            struct WorldPolygon
+            {
+                std::array<Vec2f, MAX_POLYGON_VERTICES> vertices;
+                std::array<Vec2f, MAX_POLYGON_VERTICES> normals;
+                u32 count;
+            };
+
+            inline WorldPolygon ToWorld(const Shape& shape, const Pose& pose)
+            {
+                WorldPolygon poly;
+                poly.count = shape.count;
+                for (u32 i = 0; i < shape.count; ++i)
+                {
+                    poly.vertices[i] = Apply(pose, shape.vertices[i]);
+                    poly.normals[i] = Rotate(pose.rotation, shape.normals[i]);
+                }
+                return poly;
+            }
+
+            // Largest distance of b in front of an edge of a, and that edge
+            inline f32 FindMaxSeparation(const WorldPolygon& a, const WorldPolygon& b, u32& edge)
+            {
+                auto best = std::numeric_limits<f32>::lowest();
+                for (u32 i = 0; i < a.count; ++i)
+                {
+                    auto deepest = std::numeric_limits<f32>::max();
+                    for (u32 j = 0; j < b.count; ++j)
+                    {
+                        const auto s = Dot(a.normals[i], b.vertices[j] - a.vertices[i]);
+                        deepest = s < deepest ? s : deepest;
+                    }
+                    if (deepest > best)
+                    {
+                        best = deepest;
+                        edge = i;
+                    }
+                }
+                return best;
+            }
+
+            // Keeps the part of segment in where Dot(normal, p) <= offset
+            inline u32 ClipSegment(const std::array<Vec2f, 2>& in, std::array<Vec2f, 2>& out, const Vec2f& normal, f32 offset)
+            {
+                const auto d0 = Dot(normal, in[0]) - offset;
+                const auto d1 = Dot(normal, in[1]) - offset;
+                u32 count = 0;
+                if (d0 <= 0.0f)
+                    out[count++] = in[0];
+                if (d1 <= 0.0f)
+                    out[count++] = in[1];
+                if (d0 * d1 < 0.0f)
+                    out[count++] = in[0] + (in[1] - in[0]) * (d0 / (d0 - d1));
+                return count;
+            }
+
+            /*
+             * Names a polygon-polygon point by the reference edge, the incident
+             * edge and the end of the reference edge it is nearer. Whether the
+             * point was clipped is left out: for boxes of the same width the
+             * incident vertices sit right on the clip planes and would flip
+             * between the two every step, losing the warm start.
+             */
+            constexpr u32 PolygonFeatureId(bool flip, u32 referenceEdge, u32 incidentEdge, u32 end)
+            {
+                return (flip ? 1u << 24 : 0u) | (referenceEdge << 16) | (incidentEdge << 8) | end;
+            }
+        }
+
+        inline Manifold CollideCircles(const Shape& a, const Pose& poseA, const Shape& b, const Pose& poseB)
+        {
+            Manifold m;
+            const auto d = poseB.position - poseA.position;
+            const auto distSq = LengthSq(d);
+            const auto reach = a.radius + b.radius + SPECULATIVE_DISTANCE;
+            if (distSq > reach * reach)
+                return m;
+
+            const auto dist = Sqrt(distSq);
+            m.normal = dist > 0.0f ? d / dist : Vec2f{ 0.0f, 1.0f };
+            const auto separation = dist - a.radius - b.radius;
+            m.points[0] = ManifoldPoint{ poseA.position + m.normal * (a.radius + 0.5f * separation), separation, 0 };
+            m.count = 1;
+            return m;
+        }
+
+        // Polygon a against circle b
+        inline Manifold CollidePolygonCircle(const Shape& a, const Pose& poseA, const Shape& b, const Pose& poseB)
+        {
+            Manifold m;
+            const auto center = ApplyInverse(poseA, poseB.position);
+
+            // Edge the center is furthest in front of
+            auto separation = std::numeric_limits<f32>::lowest();
+            u32 edge = 0;
+            for (u32 i = 0; i < a.count; ++i)
+            {
+                const auto s = Dot(a.normals[i], center - a.vertices[i]);
+                if (s > b.radius + SPECULATIVE_DISTANCE)
+                    return m;
+                if (s > separation)
+                {
+                    separation = s;
+                    edge = i;
+                }
+            }
+
+            // Closest feature: the edge itself, or one of its end vertices when the center lies beyond them
+            const auto& v1 = a.vertices[edge];
+            const auto& v2 = a.vertices[(edge + 1) % a.count];
+            auto normal = a.normals[edge];
+            auto feature = edge << 1;
+            if (separation > 0.0f)
+            {
+                const auto* corner = Dot(center - v1, v2 - v1) <= 0.0f ? &v1
+                                   : Dot(center - v2, v1 - v2) <= 0.0f ? &v2
+                                   : nullptr;
+                if (corner)
+                {
+                    const auto d = center - *corner;
+                    const auto dist = Length(d);
+                    if (dist > b.radius + SPECULATIVE_DISTANCE)
+                        return m;
+                    normal = d / dist;
+                    separation = dist;
+                    feature = ((corner == &v1 ? edge : (edge + 1) % a.count) << 1) | 1;
+                }
+            }
+            separation -= b.radius;
+
+            m.normal = Rotate(poseA.rotation, normal);
+            m.points[0] = ManifoldPoint{ poseB.position - m.normal * (b.radius + 0.5f * separation), separation, feature };
+            m.count = 1;
+            return m;
+        }
+
+        /*
+         * Separating axis test over the edge normals of both polygons. The
+         * edge with the largest separation is the reference face, the most
+         * anti-parallel edge of the other polygon is clipped against its side
+         * planes, and the clipped ends within SPECULATIVE_DISTANCE become the
+         * contact points.
+         */
+        inline Manifold CollidePolygons(const Shape& a, const Pose& poseA, const Shape& b, const Pose& poseB)
+        {
+            Manifold m;
+            const auto polyA = detail::ToWorld(a, poseA);
+            const auto polyB = detail::ToWorld(b, poseB);
+
+            u32 edgeA = 0;
+            const auto separationA = detail::FindMaxSeparation(polyA, polyB, edgeA);
+            if (separationA > SPECULATIVE_DISTANCE)
+                return m;
+            u32 edgeB = 0;
+            const auto separationB = detail::FindMaxSeparation(polyB, polyA, edgeB);
+            if (separationB > SPECULATIVE_DISTANCE)
+                return m;
+
+            // Prefer A unless B is clearly better, so the choice does not flicker between steps
+            const auto flip = separationB > separationA + 0.1f * LINEAR_SLOP;
+            const auto& ref = flip ? polyB : polyA;
+            const auto& inc = flip ? polyA : polyB;
+            const auto refEdge = flip ? edgeB : edgeA;
+            const auto& refNormal = ref.normals[refEdge];
+
+            u32 incEdge = 0;
+            auto minDot = std::numeric_limits<f32>::max();
+            for (u32 i = 0; i < inc.count; ++i)
+            {
+                const auto d = Dot(refNormal, inc.normals[i]);
+                if (d < minDot)
+                {
+                    minDot = d;
+                    incEdge = i;
+                }
+            }
+            const std::array<Vec2f, 2> incident{ inc.vertices[incEdge], inc.vertices[(incEdge + 1) % inc.count] };
+
+            const auto& r1 = ref.vertices[refEdge];
+            const auto& r2 = ref.vertices[(refEdge + 1) % ref.count];
+            const auto tangent = Cross(1.0f, refNormal);
+            std::array<Vec2f, 2> clip1;
+            std::array<Vec2f, 2> clip2;
+            if (detail::ClipSegment(incident, clip1, -tangent, -Dot(tangent, r1)) < 2)
+                return m;
+            if (detail::ClipSegment(clip1, clip2, tangent, Dot(tangent, r2)) < 2)
+                return m;
+
+            m.normal = flip ? -refNormal : refNormal;
+            const u32 nearR1 = Dot(tangent, clip2[0]) <= Dot(tangent, clip2[1]) ? 0 : 1;
+            for (u32 k = 0; k < 2; ++k)
+            {
+                const auto separation = Dot(refNormal, clip2[k] - r1);
+                if (separation <= SPECULATIVE_DISTANCE)
+                {
+                    const auto id = detail::PolygonFeatureId(flip, refEdge, incEdge, k == nearR1 ? 0 : 1);
+                    m.points[m.count++] = ManifoldPoint{ clip2[k] - refNormal * (0.5f * separation), separation, id };
+                }
+            }
+            return m;
+        }
+
+        // Dispatches on the shape types. The normal points from a to b
+        inline Manifold Collide(const Shape& a, const Pose& poseA, const Shape& b, const Pose& poseB)
+        {
+            if (a.type == ShapeType::Polygon)
+            {
+                return b.type == ShapeType::Polygon ? CollidePolygons(a, poseA, b, poseB)
+                                                    : CollidePolygonCircle(a, poseA, b, poseB);
+            }
+            if (b.type == ShapeType::Circle)
+                return CollideCircles(a, poseA, b, poseB);
+
+            auto m = CollidePolygonCircle(b, poseB, a, poseA);
+            m.normal = -m.normal;
+            return m;
+        }
+    }
+}
+
+#endif // J_COLLIDE_H
@@ -0,0 +1,8 @@
+#ifndef J_PHYSICS_H
+#define J_PHYSICS_H
+
+#include "jshape.h"
+#include "jcollide.h"
+#include "jphysics_world.h"
+
+#endif // J_PHYSICS_H
@@ -0,0 +1,744 @@
+#ifndef J_PHYSICS_WORLD_H
+#define J_PHYSICS_WORLD_H
+
+#include <algorithm> // std::sort, std::lower_bound, std::remove_if, std::min, std::max
+#include <array> // std::array
+#include <cassert> // assert
+#include <vector> // std::vector
+
+#include "jtypes.h"
+#include "jspan.h"
+#include "math/jvec.h"
+#include "math/jrotor.h"
+#include "math/jmatrix.h"
+#include "geometry/jaabb.h"
+#include "geometry/jspatial_hash.h"
+#include "jobs/jparallel.h"
+#include "jshape.h"
+#include "jcollide.h"
+
+namespace jg
+{
+    namespace physics
+    {
+        using BodyId = u32;
+        constexpr BodyId INVALID_BODY = ~0u;
+
+        struct BodyDef
+        {
+            Shape shape = MakeCircle(0.5f);
+            Vec2f position{ 0.0f };
+            f32 angle = 0.0f;
+            Vec2f velocity{ 0.0f };
+            f32 angularVelocity = 0.0f;
+            f32 density = 1.0f; // 0 makes the body static
+            f32 friction = 0.6f;
+            f32 restitution = 0.0f;
+        };
+
+        // A touching pair. The impulses are the ones the solver settled on, and warm start the next step
+        struct Contact
+        {
+            BodyId bodyA = INVALID_BODY;
+            BodyId bodyB = INVALID_BODY; // Static when bodyA is not
+            Manifold manifold;
+            std::array<f32, 2> normalImpulses{};
+            std::array<f32, 2> tangentImpulses{};
+        };
+
+        /*
+         * Rigid bodies with one convex shape each, stepped with a sequential
+         * impulse solver. Each step:
+         *
+         *   1. finds pairs whose boxes overlap in a SpatialHashGrid and builds
+         *      their contact manifolds, matching each point to last step's by
+         *      feature id to reuse its impulses;
+         *   2. splits the bodies into islands, the groups connected through
+         *      contacts between dynamic bodies;
+         *   3. solves each island on its own, applying impulses to velocities
+         *      over a fixed number of iterations, then moves the bodies.
+         *
+         * Islands share no dynamic bodies, so the threaded Step hands them to
+         * the pool in batches. Results do not depend on the thread count. Body
+         * handles stay valid until destroyed and are reused afterwards.
+         */
+        class World
+        {
+        public:
+            static constexpr size_t BODY_GRAIN = 256; // Bodies per narrow phase and integration chunk
+            static constexpr size_t ISLAND_BATCH_CONTACTS = 256; // Contacts per solver task, roughly
+            static constexpr u32 DEFAULT_VELOCITY_ITERATIONS = 8;
+            static constexpr f32 BAUMGARTE = 0.2f; // Fraction of the penetration pushed out per step
+            static constexpr f32 MAX_CORRECTION_VELOCITY = 4.0f;
+            static constexpr f32 RESTITUTION_THRESHOLD = 1.0f; // Slower impacts do not bounce
+
+            // Broad phase grid: cells about the size of a typical body, and about as many buckets as cells in use
+            explicit World(f32 cellSize = 1.0f, size_t gridBuckets = 32768) : m_grid{ cellSize, gridBuckets } {}
+
+            BodyId CreateBody(const BodyDef& def)
+            {
+                assert(def.density >= 0.0f && def.friction >= 0.0f);
+                BodyId id;
+                if (m_freeList != INVALID_BODY)
+                {
+                    id = m_freeList;
+                    m_freeList = m_bodies[id].nextFree;
+                }
+                else
+                {
+                    id = static_cast<BodyId>(m_bodies.size());
+                    m_bodies.emplace_back();
+                    m_shapes.emplace_back();
+                    m_boxes.emplace_back();
+                    m_parent.emplace_back();
+                    m_localIndex.emplace_back();
+                }
+
+                auto& body = m_bodies[id];
+                body = Body{};
+                body.pose = Pose{ def.position, Rotor2f::FromAngle(def.angle) };
+                body.angle = def.angle;
+                body.friction = def.friction;
+                body.restitution = def.restitution;
+                body.alive = true;
+                if (def.density > 0.0f)
+                {
+                    const auto mass = ComputeMass(def.shape, def.density);
+                    body.invMass = 1.0f / mass.mass;
+                    body.invInertia = mass.inertia > 0.0f ? 1.0f / mass.inertia : 0.0f;
+                    body.velocity = def.velocity;
+                    body.angularVelocity = def.angularVelocity;
+                }
+                m_shapes[id] = def.shape;
+                m_boxes[id] = FatBox(id);
+
+                body.proxy = m_grid.Insert(m_boxes[id]);
+                if (body.proxy >= m_proxyBody.size())
+                    m_proxyBody.resize(body.proxy + 1);
+                m_proxyBody[body.proxy] = id;
+                ++m_count;
+                return id;
+            }
+
+            void DestroyBody(BodyId id)
+            {
+                assert(IsAlive(id));
+                auto& body = m_bodies[id];
+                m_grid.Remove(body.proxy);
+                body.alive = false;
+                body.nextFree = m_freeList;
+                m_freeList = id;
+                --m_count;
+                // Keeps the order, which the next step's warm start lookup relies on
+                m_contacts.erase(std::remove_if(m_contacts.begin(), m_contacts.end(), [id](const Contact& c) {
+                    return c.bodyA == id || c.bodyB == id;
+                }), m_contacts.end());
+            }
+
+            bool IsAlive(BodyId id) const { return id < m_bodies.size() && m_bodies[id].alive; }
+
+            void Step(f32 dt)
+            {
+                StepWith([](size_t count, auto&& fn) {
+                    for (size_t i = 0; i < count; ++i)
+                        fn(i);
+                }, dt);
+            }
+
+            // The same, with the narrow phase, integration and islands spread over the pool
+            void Step(jobs::ThreadPool& pool, f32 dt)
+            {
+                StepWith([&pool](size_t count, auto&& fn) {
+                    jobs::ParallelFor(pool, 0, count, 1, [&fn](size_t first, size_t last) {
+                        for (auto i = first; i < last; ++i)
+                            fn(i);
+                    });
+                }, dt);
+            }
+
+            void SetGravity(const Vec2f& gravity) { m_gravity = gravity; }
+            void SetVelocityIterations(u32 iterations) { m_velocityIterations = iterations; }
+            const Vec2f& GetGravity() const { return m_gravity; }
+            u32 GetVelocityIterations() const { return m_velocityIterations; }
+
+            const Vec2f& GetPosition(BodyId id) const { return Get(id).pose.position; }
+            f32 GetAngle(BodyId id) const { return Get(id).angle; }
+            const Pose& GetPose(BodyId id) const { return Get(id).pose; }
+            const Vec2f& GetVelocity(BodyId id) const { return Get(id).velocity; }
+            f32 GetAngularVelocity(BodyId id) const { return Get(id).angularVelocity; }
+            const Shape& GetShape(BodyId id) const { assert(IsAlive(id)); return m_shapes[id]; }
+            bool IsStatic(BodyId id) const { return Get(id).invMass == 0.0f; }
+
+            // Body to world, for rendering
+            Mat3f GetTransform(BodyId id) const
+            {
+                const auto& pose = Get(id).pose;
+                return Mat3f::Translation2D(pose.position.x, pose.position.y) * ToMat3(pose.rotation);
+            }
+
+            void SetVelocity(BodyId id, const Vec2f& velocity)
+            {
+                assert(!IsStatic(id));
+                m_bodies[id].velocity = velocity;
+            }
+            void SetAngularVelocity(BodyId id, f32 angularVelocity)
+            {
+                assert(!IsStatic(id));
+                m_bodies[id].angularVelocity = angularVelocity;
+            }
+
+            // Impulse in N*s at a world space point
+            void ApplyImpulse(BodyId id, const Vec2f& impulse, const Vec2f& point)
+            {
+                assert(IsAlive(id));
+                auto& body = m_bodies[id];
+                body.velocity = body.velocity + impulse * body.invMass;
+                body.angularVelocity += body.invInertia * Cross(point - body.pose.position, impulse);
+            }
+
+            // Sorted by (bodyA, bodyB)
+            Span<const Contact> Contacts() const { return Span<const Contact>{ m_contacts.data(), m_contacts.size() }; }
+            // Islands solved by the last step. Bodies touching nothing are not in one
+            size_t IslandCount() const { return m_islandCount; }
+
+            size_t size() const { return m_count; }
+            bool empty() const { return m_count == 0; }
+
+        private:
+            struct Body
+            {
+                Pose pose;
+                f32 angle = 0.0f;
+                Vec2f velocity{ 0.0f };
+                f32 angularVelocity = 0.0f;
+                f32 invMass = 0.0f; // 0 for static bodies
+                f32 invInertia = 0.0f;
+                f32 friction = 0.0f;
+                f32 restitution = 0.0f;
+                SpatialHashGrid::ProxyId proxy = SpatialHashGrid::INVALID_PROXY;
+                BodyId nextFree = INVALID_BODY;
+                bool alive = false;
+            };
+
+            // Island-local copy of what the solver needs from a body
+            struct SolverBody
+            {
+                Vec2f velocity;
+                f32 angularVelocity;
+                f32 invMass;
+                f32 invInertia;
+            };
+
+            struct ConstraintPoint
+            {
+                Vec2f rA, rB; // From each centroid to the contact point
+                f32 normalMass, tangentMass;
+                f32 velocityBias; // Normal velocity the point must reach: negative lets a gap close, positive pushes out
+                f32 normalImpulse, tangentImpulse;
+            };
+
+            struct Constraint
+            {
+                u32 a, b; // Island-local solver bodies
+                u32 contact;
+                u32 count;
+                Vec2f normal;
+                f32 friction;
+                std::array<ConstraintPoint, 2> points;
+                // Two-point normal block: K couples the points through the bodies' rotation
+                bool block;
+                f32 k11, k12, k22;
+                f32 inv11, inv12, inv22;
+            };
+
+            struct ChunkScratch
+            {
+                std::vector<Contact> contacts;
+                std::vector<BodyId> candidates;
+            };
+
+            static constexpr u32 NO_ISLAND = ~0u;
+
+            const Body& Get(BodyId id) const
+            {
+                assert(IsAlive(id));
+                return m_bodies[id];
+            }
+
+            bool IsDynamic(BodyId id) const { return m_bodies[id].invMass > 0.0f; }
+
+            // Grown by half the speculative distance, so two boxes overlap as soon as contact points could appear
+            AABB2f FatBox(BodyId id) const
+            {
+                const auto box = ComputeAABB(m_shapes[id], m_bodies[id].pose);
+                const Vec2f margin{ 0.5f * SPECULATIVE_DISTANCE };
+                return AABB2f{ box.min - margin, box.max + margin };
+            }
+
+            template <typename ForEach>
+            void StepWith(ForEach&& forEach, f32 dt)
+            {
+                if (dt <= 0.0f)
+                    return;
+                const auto chunks = (m_bodies.size() + BODY_GRAIN - 1) / BODY_GRAIN;
+
+                if (m_chunks.size() < chunks)
+                    m_chunks.resize(chunks);
+                forEach(chunks, [this](size_t c) { FindContacts(c); });
+                MergeContacts(chunks);
+
+                forEach(chunks, [this, dt](size_t c) { IntegrateVelocities(c, dt); });
+                BuildIslands();
+                forEach(m_batchStart.size() - 1, [this, dt](size_t batch) {
+                    for (auto island = m_batchStart[batch]; island < m_batchStart[batch + 1]; ++island)
+                        SolveIsland(island, dt);
+                });
+
+                forEach(chunks, [this, dt](size_t c) { IntegratePositions(c, dt); });
+                for (BodyId i = 0; i < m_bodies.size(); ++i)
+                {
+                    if (m_bodies[i].alive && IsDynamic(i))
+                        m_grid.Move(m_bodies[i].proxy, m_boxes[i]);
+                }
+            }
+
+            /*
+             * Contacts of the dynamic bodies in chunk c with higher numbered
+             * or static bodies, so every pair is found once, from bodyA. Old
+             * contacts are sorted by (bodyA, bodyB) and so are the chunk
+             * outputs once joined, which keeps the lookup a binary search.
+             */
+            void FindContacts(size_t c)
+            {
+                auto& scratch = m_chunks[c];
+                scratch.contacts.clear();
+                const auto last = std::min(m_bodies.size(), (c + 1) * BODY_GRAIN);
+                for (auto i = static_cast<BodyId>(c * BODY_GRAIN); i < last; ++i)
+                {
+                    if (!m_bodies[i].alive || !IsDynamic(i))
+                        continue;
+
+                    auto& candidates = scratch.candidates;
+                    candidates.clear();
+                    m_grid.Query(m_boxes[i], [&](SpatialHashGrid::ProxyId proxy) {
+                        const auto j = m_proxyBody[proxy];
+                        if (j > i || (j != i && !IsDynamic(j)))
+                            candidates.push_back(j);
+                    });
+                    std::sort(candidates.begin(), candidates.end());
+
+                    for (const auto j : candidates)
+                    {
+                        Contact contact;
+                        contact.manifold = Collide(m_shapes[i], m_bodies[i].pose, m_shapes[j], m_bodies[j].pose);
+                        if (contact.manifold.count == 0)
+                            continue;
+                        contact.bodyA = i;
+                        contact.bodyB = j;
+                        WarmStartFromLastStep(contact);
+                        scratch.contacts.push_back(contact);
+                    }
+                }
+            }
+
+            void WarmStartFromLastStep(Contact& contact) const
+            {
+                const auto it = std::lower_bound(m_contacts.begin(), m_contacts.end(), contact, [](const Contact& lhs, const Contact& rhs) {
+                    return lhs.bodyA < rhs.bodyA || (lhs.bodyA == rhs.bodyA && lhs.bodyB < rhs.bodyB);
+                });
+                if (it == m_contacts.end() || it->bodyA != contact.bodyA || it->bodyB != contact.bodyB)
+                    return;
+                for (u32 k = 0; k < contact.manifold.count; ++k)
+                {
+                    for (u32 l = 0; l < it->manifold.count; ++l)
+                    {
+                        if (it->manifold.points[l].id == contact.manifold.points[k].id)
+                        {
+                            contact.normalImpulses[k] = it->normalImpulses[l];
+                            contact.tangentImpulses[k] = it->tangentImpulses[l];
+                            break;
+                        }
+                    }
+                }
+            }
+
+            void MergeContacts(size_t chunks)
+            {
+                m_contacts.clear();
+                for (size_t c = 0; c < chunks; ++c)
+                    m_contacts.insert(m_contacts.end(), m_chunks[c].contacts.begin(), m_chunks[c].contacts.end());
+            }
+
+            void IntegrateVelocities(size_t c, f32 dt)
+            {
+                const auto dv = m_gravity * dt;
+                const auto last = std::min(m_bodies.size(), (c + 1) * BODY_GRAIN);
+                for (auto i = c * BODY_GRAIN; i < last; ++i)
+                {
+                    auto& body = m_bodies[i];
+                    if (body.alive && body.invMass > 0.0f)
+                        body.velocity = body.velocity + dv;
+                }
+            }
+
+            void IntegratePositions(size_t c, f32 dt)
+            {
+                const auto last = std::min(m_bodies.size(), (c + 1) * BODY_GRAIN);
+                for (auto i = static_cast<BodyId>(c * BODY_GRAIN); i < last; ++i)
+                {
+                    auto& body = m_bodies[i];
+                    if (!body.alive || body.invMass == 0.0f)
+                        continue;
+                    body.pose.position = body.pose.position + body.velocity * dt;
+                    body.angle += body.angularVelocity * dt;
+                    body.pose.rotation = Rotor2f::FromAngle(body.angle);
+                    m_boxes[i] = FatBox(i);
+                }
+            }
+
+            u32 Find(u32 i)
+            {
+                while (m_parent[i] != i)
+                {
+                    m_parent[i] = m_parent[m_parent[i]];
+                    i = m_parent[i];
+                }
+                return i;
+            }
+
+            /*
+             * Union-find over contacts between dynamic bodies, then a counting
+             * sort of bodies and contacts by island. Islands are numbered in
+             * order of their first contact and batched in that order, so the
+             * split does not depend on the thread count.
+             */
+            void BuildIslands()
+            {
+                const auto bodyCount = static_cast<u32>(m_bodies.size());
+                for (u32 i = 0; i < bodyCount; ++i)
+                    m_parent[i] = i;
+                for (const auto& c : m_contacts)
+                {
+                    if (!IsDynamic(c.bodyB))
+                        continue;
+                    const auto a = Find(c.bodyA);
+                    const auto b = Find(c.bodyB);
+                    if (a != b)
+                        m_parent[std::max(a, b)] = std::min(a, b);
+                }
+
+                // m_localIndex holds the island of each root until SolveIsland reuses it
+                auto& islandOf = m_localIndex;
+                std::fill(islandOf.begin(), islandOf.end(), NO_ISLAND);
+                m_contactIsland.resize(m_contacts.size());
+                m_islandContactStart.assign(1, 0);
+                u32 islands = 0;
+                for (size_t k = 0; k < m_contacts.size(); ++k)
+                {
+                    const auto root = Find(m_contacts[k].bodyA);
+                    if (islandOf[root] == NO_ISLAND)
+                    {
+                        islandOf[root] = islands++;
+                        m_islandContactStart.push_back(0);
+                    }
+                    m_contactIsland[k] = islandOf[root];
+                    ++m_islandContactStart[islandOf[root] + 1];
+                }
+                m_islandCount = islands;
+
+                m_islandBodyStart.assign(islands + 1, 0);
+                m_bodyIsland.resize(bodyCount);
+                for (u32 i = 0; i < bodyCount; ++i)
+                {
+                    m_bodyIsland[i] = NO_ISLAND;
+                    if (m_bodies[i].alive && IsDynamic(i))
+                    {
+                        m_bodyIsland[i] = islandOf[Find(i)];
+                        if (m_bodyIsland[i] != NO_ISLAND)
+                            ++m_islandBodyStart[m_bodyIsland[i] + 1];
+                    }
+                }
+
+                for (u32 k = 0; k < islands; ++k)
+                {
+                    m_islandContactStart[k + 1] += m_islandContactStart[k];
+                    m_islandBodyStart[k + 1] += m_islandBodyStart[k];
+                }
+                m_islandContacts.resize(m_contacts.size());
+                m_islandBodies.resize(m_islandBodyStart[islands]);
+                m_fill.assign(m_islandContactStart.begin(), m_islandContactStart.end() - 1);
+                for (u32 k = 0; k < m_contacts.size(); ++k)
+                    m_islandContacts[m_fill[m_contactIsland[k]]++] = k;
+                m_fill.assign(m_islandBodyStart.begin(), m_islandBodyStart.end() - 1);
+                for (u32 i = 0; i < bodyCount; ++i)
+                {
+                    if (m_bodyIsland[i] != NO_ISLAND)
+                        m_islandBodies[m_fill[m_bodyIsland[i]]++] = i;
+                }
+
+                m_batchStart.assign(1, 0);
+                for (u32 k = 0; k < islands; ++k)
+                {
+                    if (m_islandContactStart[k + 1] - m_islandContactStart[m_batchStart.back()] >= ISLAND_BATCH_CONTACTS || k + 1 == islands)
+                        m_batchStart.push_back(k + 1);
+                }
+
+                // One extra solver body per island stands in for every static body
+                m_solverBodies.resize(m_islandBodies.size() + islands);
+                m_constraints.resize(m_contacts.size());
+            }
+
+            void SolveIsland(u32 island, f32 dt)
+            {
+                const auto bodyFirst = m_islandBodyStart[island];
+                const auto bodyLast = m_islandBodyStart[island + 1];
+                auto* bodies = m_solverBodies.data() + bodyFirst + island;
+                bodies[0] = SolverBody{ Vec2f{ 0.0f }, 0.0f, 0.0f, 0.0f };
+                for (auto k = bodyFirst; k < bodyLast; ++k)
+                {
+                    const auto id = m_islandBodies[k];
+                    const auto& body = m_bodies[id];
+                    const auto local = k - bodyFirst + 1;
+                    m_localIndex[id] = local;
+                    bodies[local] = SolverBody{ body.velocity, body.angularVelocity, body.invMass, body.invInertia };
+                }
+
+                const auto first = m_islandContactStart[island];
+                const auto count = m_islandContactStart[island + 1] - first;
+                auto* constraints = m_constraints.data() + first;
+                for (u32 k = 0; k < count; ++k)
+                    PrepareConstraint(constraints[k], m_islandContacts[first + k], bodies, 1.0f / dt);
+                for (u32 k = 0; k < count; ++k)
+                    WarmStart(constraints[k], bodies);
+                for (u32 it = 0; it < m_velocityIterations; ++it)
+                {
+                    for (u32 k = 0; k < count; ++k)
+                        SolveConstraint(constraints[k], bodies);
+                }
+
+                for (u32 k = 0; k < count; ++k)
+                {
+                    const auto& constraint = constraints[k];
+                    auto& contact = m_contacts[constraint.contact];
+                    for (u32 p = 0; p < constraint.count; ++p)
+                    {
+                        contact.normalImpulses[p] = constraint.points[p].normalImpulse;
+                        contact.tangentImpulses[p] = constraint.points[p].tangentImpulse;
+                    }
+                }
+                for (auto k = bodyFirst; k < bodyLast; ++k)
+                {
+                    auto& body = m_bodies[m_islandBodies[k]];
+                    const auto& solved = bodies[k - bodyFirst + 1];
+                    body.velocity = solved.velocity;
+                    body.angularVelocity = solved.angularVelocity;
+                }
+            }
+
+            void PrepareConstraint(Constraint& constraint, u32 contactIndex, const SolverBody* bodies, f32 invDt) const
+            {
+                const auto& contact = m_contacts[contactIndex];
+                const auto& bodyA = m_bodies[contact.bodyA];
+                const auto& bodyB = m_bodies[contact.bodyB];
+                constraint.a = m_localIndex[contact.bodyA];
+                constraint.b = IsDynamic(contact.bodyB) ? m_localIndex[contact.bodyB] : 0;
+                constraint.contact = contactIndex;
+                constraint.count = contact.manifold.count;
+                constraint.normal = contact.manifold.normal;
+                constraint.friction = Sqrt(bodyA.friction * bodyB.friction);
+                const auto restitution = std::max(bodyA.restitution, bodyB.restitution);
+
+                const auto& a = bodies[constraint.a];
+                const auto& b = bodies[constraint.b];
+                const auto& n = constraint.normal;
+                const auto t = Cross(n, 1.0f);
+                for (u32 p = 0; p < constraint.count; ++p)
+                {
+                    const auto& mp = contact.manifold.points[p];
+                    auto& cp = constraint.points[p];
+                    cp.rA = mp.point - bodyA.pose.position;
+                    cp.rB = mp.point - bodyB.pose.position;
+
+                    const auto rnA = Cross(cp.rA, n);
+                    const auto rnB = Cross(cp.rB, n);
+                    const auto kNormal = a.invMass + b.invMass + a.invInertia * rnA * rnA + b.invInertia * rnB * rnB;
+                    cp.normalMass = kNormal > 0.0f ? 1.0f / kNormal : 0.0f;
+                    const auto rtA = Cross(cp.rA, t);
+                    const auto rtB = Cross(cp.rB, t);
+                    const auto kTangent = a.invMass + b.invMass + a.invInertia * rtA * rtA + b.invInertia * rtB * rtB;
+                    cp.tangentMass = kTangent > 0.0f ? 1.0f / kTangent : 0.0f;
+
+                    // A gap may close within the step; an overlap beyond the slop is pushed out over a few steps
+                    if (mp.separation > 0.0f)
+                        cp.velocityBias = -mp.separation * invDt;
+                    else
+                        cp.velocityBias = std::min(BAUMGARTE * invDt * std::max(0.0f, -(mp.separation + LINEAR_SLOP)), MAX_CORRECTION_VELOCITY);
+
+                    const auto dv = b.velocity + Cross(b.angularVelocity, cp.rB) - a.velocity - Cross(a.angularVelocity, cp.rA);
+                    const auto vn = Dot(dv, n);
+                    if (restitution > 0.0f && vn < -RESTITUTION_THRESHOLD)
+                        cp.velocityBias = std::max(cp.velocityBias, -restitution * vn);
+
+                    cp.normalImpulse = contact.normalImpulses[p];
+                    cp.tangentImpulse = contact.tangentImpulses[p];
+                }
+
+                // Solving both normal impulses at once keeps a box resting on
+                // two points from rocking, unless K is too badly conditioned to invert
+                constraint.block = false;
+                if (constraint.count == 2)
+                {
+                    const auto& p1 = constraint.points[0];
+                    const auto& p2 = constraint.points[1];
+                    const auto rn1A = Cross(p1.rA, n);
+                    const auto rn1B = Cross(p1.rB, n);
+                    const auto rn2A = Cross(p2.rA, n);
+                    const auto rn2B = Cross(p2.rB, n);
+                    const auto k11 = a.invMass + b.invMass + a.invInertia * rn1A * rn1A + b.invInertia * rn1B * rn1B;
+                    const auto k22 = a.invMass + b.invMass + a.invInertia * rn2A * rn2A + b.invInertia * rn2B * rn2B;
+                    const auto k12 = a.invMass + b.invMass + a.invInertia * rn1A * rn2A + b.invInertia * rn1B * rn2B;
+                    const auto det = k11 * k22 - k12 * k12;
+                    if (k11 * k11 < 1000.0f * det)
+                    {
+                        constraint.block = true;
+                        constraint.k11 = k11;
+                        constraint.k12 = k12;
+                        constraint.k22 = k22;
+                        const auto invDet = 1.0f / det;
+                        constraint.inv11 = k22 * invDet;
+                        constraint.inv12 = -k12 * invDet;
+                        constraint.inv22 = k11 * invDet;
+                    }
+                }
+            }
+
+            static void ApplyPointImpulse(SolverBody& a, SolverBody& b, const ConstraintPoint& cp, const Vec2f& impulse)
+            {
+                a.velocity = a.velocity - impulse * a.invMass;
+                a.angularVelocity -= a.invInertia * Cross(cp.rA, impulse);
+                b.velocity = b.velocity + impulse * b.invMass;
+                b.angularVelocity += b.invInertia * Cross(cp.rB, impulse);
+            }
+
+            // Last step's impulses, applied up front so the iterations start close to the answer
+            static void WarmStart(const Constraint& constraint, SolverBody* bodies)
+            {
+                auto& a = bodies[constraint.a];
+                auto& b = bodies[constraint.b];
+                const auto t = Cross(constraint.normal, 1.0f);
+                for (u32 p = 0; p < constraint.count; ++p)
+                {
+                    const auto& cp = constraint.points[p];
+                    ApplyPointImpulse(a, b, cp, constraint.normal * cp.normalImpulse + t * cp.tangentImpulse);
+                }
+            }
+
+            // Friction first, so the normal impulses it is bounded by get the last word
+            static void SolveConstraint(Constraint& constraint, SolverBody* bodies)
+            {
+                auto& a = bodies[constraint.a];
+                auto& b = bodies[constraint.b];
+                const auto& n = constraint.normal;
+                const auto t = Cross(n, 1.0f);
+                for (u32 p = 0; p < constraint.count; ++p)
+                {
+                    auto& cp = constraint.points[p];
+                    const auto dv = b.velocity + Cross(b.angularVelocity, cp.rB) - a.velocity - Cross(a.angularVelocity, cp.rA);
+                    const auto maxFriction = constraint.friction * cp.normalImpulse;
+                    const auto impulse = std::min(std::max(cp.tangentImpulse - cp.tangentMass * Dot(dv, t), -maxFriction), maxFriction);
+                    ApplyPointImpulse(a, b, cp, t * (impulse - cp.tangentImpulse));
+                    cp.tangentImpulse = impulse;
+                }
+                if (constraint.block)
+                {
+                    SolveNormalBlock(constraint, a, b);
+                    return;
+                }
+                for (u32 p = 0; p < constraint.count; ++p)
+                {
+                    auto& cp = constraint.points[p];
+                    const auto dv = b.velocity + Cross(b.angularVelocity, cp.rB) - a.velocity - Cross(a.angularVelocity, cp.rA);
+                    const auto impulse = std::max(cp.normalImpulse - cp.normalMass * (Dot(dv, n) - cp.velocityBias), 0.0f);
+                    ApplyPointImpulse(a, b, cp, n * (impulse - cp.normalImpulse));
+                    cp.normalImpulse = impulse;
+                }
+            }
+
+            /*
+             * The 2x2 mixed LCP for both normal impulses x: find x >= 0 with
+             * vn = K * x + q >= 0 and x_i * vn_i = 0, where q is the normal
+             * velocity before any normal impulse, less the bias. Tries each
+             * combination of active points in turn; one of them always holds.
+             */
+            static void SolveNormalBlock(Constraint& constraint, SolverBody& a, SolverBody& b)
+            {
+                auto& p1 = constraint.points[0];
+                auto& p2 = constraint.points[1];
+                const auto& n = constraint.normal;
+                const auto dv1 = b.velocity + Cross(b.angularVelocity, p1.rB) - a.velocity - Cross(a.angularVelocity, p1.rA);
+                const auto dv2 = b.velocity + Cross(b.angularVelocity, p2.rB) - a.velocity - Cross(a.angularVelocity, p2.rA);
+                const auto old1 = p1.normalImpulse;
+                const auto old2 = p2.normalImpulse;
+                const auto q1 = Dot(dv1, n) - p1.velocityBias - (constraint.k11 * old1 + constraint.k12 * old2);
+                const auto q2 = Dot(dv2, n) - p2.velocityBias - (constraint.k12 * old1 + constraint.k22 * old2);
+
+                // Both active, then only the first, only the second, neither
+                auto x1 = -(constraint.inv11 * q1 + constraint.inv12 * q2);
+                auto x2 = -(constraint.inv12 * q1 + constraint.inv22 * q2);
+                if (x1 < 0.0f || x2 < 0.0f)
+                {
+                    x1 = -p1.normalMass * q1;
+                    x2 = 0.0f;
+                    if (x1 < 0.0f || constraint.k12 * x1 + q2 < 0.0f)
+                    {
+                        x1 = 0.0f;
+                        x2 = -p2.normalMass * q2;
+                        if (x2 < 0.0f || constraint.k12 * x2 + q1 < 0.0f)
+                        {
+                            x2 = 0.0f;
+                            if (q1 < 0.0f || q2 < 0.0f)
+                                return;
+                        }
+                    }
+                }
+
+                ApplyPointImpulse(a, b, p1, n * (x1 - old1));
+                ApplyPointImpulse(a, b, p2, n * (x2 - old2));
+                p1.normalImpulse = x1;
+                p2.normalImpulse = x2;
+            }
+
+            std::vector<Body> m_bodies;
+            std::vector<Shape> m_shapes;
+            std::vector<AABB2f> m_boxes; // Fat boxes, handed to the grid after each step
+            BodyId m_freeList = INVALID_BODY;
+            size_t m_count = 0;
+
+            SpatialHashGrid m_grid;
+            std::vector<BodyId> m_proxyBody;
+
+            std::vector<Contact> m_contacts;
+            std::vector<ChunkScratch> m_chunks;
+
+            std::vector<u32> m_parent;
+            std::vector<u32> m_localIndex; // Island-local solver body of each dynamic body
+            std::vector<u32> m_contactIsland;
+            std::vector<u32> m_bodyIsland;
+            std::vector<u32> m_islandContactStart;
+            std::vector<u32> m_islandContacts;
+            std::vector<u32> m_islandBodyStart;
+            std::vector<u32> m_islandBodies;
+            std::vector<u32> m_batchStart; // First island of each solver batch
+            std::vector<u32> m_fill;
+            size_t m_islandCount = 0;
+
+            std::vector<SolverBody> m_solverBodies;
+            std::vector<Constraint> m_constraints; // In island order, parallel to m_islandContacts
+
+            Vec2f m_gravity{ 0.0f, -9.8f };
+            u32 m_velocityIterations = DEFAULT_VELOCITY_ITERATIONS;
+        };
+    }
+}
+
+#endif // J_PHYSICS_WORLD_H
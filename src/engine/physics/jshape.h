@@ -0,0 +1,178 @@
+#ifndef J_SHAPE_H
+#define J_SHAPE_H
+
+#include <algorithm> // std::sort, std::copy
+#include <array> // std::array
+#include <cassert> // assert
+
+#include "jtypes.h"
+#include "jspan.h"
+#include "math/jvec.h"
+#include "math/jrotor.h"
+#include "math/jmath_consts.h"
+#include "geometry/jaabb.h"
+
+namespace jg
+{
+    namespace physics
+    {
+        constexpr size_t MAX_POLYGON_VERTICES = 8;
+
+        // Position of the body centroid and its rotation about it
+        struct Pose
+        {
+            Vec2f position{ 0.0f };
+            Rotor2f rotation = Rotor2f::Identity();
+        };
+
+        // Body space to world space
+        inline Vec2f Apply(const Pose& pose, const Vec2f& point) { return Rotate(pose.rotation, point) + pose.position; }
+
+        // World space to body space
+        inline Vec2f ApplyInverse(const Pose& pose, const Vec2f& point) { return Rotate(Conjugate(pose.rotation), point - pose.position); }
+
+        enum class ShapeType : u8
+        {
+            Circle,
+            Polygon
+        };
+
+        /*
+         * Convex collision shape in body space. Polygons are counter-clockwise
+         * with their centroid at the body origin, so the body position is also
+         * its center of mass. Use the Make functions rather than filling one in.
+         */
+        struct Shape
+        {
+            ShapeType type = ShapeType::Circle;
+            u32 count = 0; // Polygon vertices
+            f32 radius = 0.0f; // Circles only
+            std::array<Vec2f, MAX_POLYGON_VERTICES> vertices;
+            std::array<Vec2f, MAX_POLYGON_VERTICES> normals; // normals[i] is the outward unit normal of edge (i, i + 1)
+        };
+
+        struct MassData
+        {
+            f32 mass = 0.0f;
+            f32 inertia = 0.0f; // About the centroid
+        };
+
+        inline Shape MakeCircle(f32 radius)
+        {
+            assert(radius > 0.0f);
+            Shape shape;
+            shape.type = ShapeType::Circle;
+            shape.radius = radius;
+            return shape;
+        }
+
+        inline Shape MakeBox(f32 halfWidth, f32 halfHeight)
+        {
+            assert(halfWidth > 0.0f && halfHeight > 0.0f);
+            Shape shape;
+            shape.type = ShapeType::Polygon;
+            shape.count = 4;
+            shape.vertices[0] = Vec2f{ -halfWidth, -halfHeight };
+            shape.vertices[1] = Vec2f{ halfWidth, -halfHeight };
+            shape.vertices[2] = Vec2f{ halfWidth, halfHeight };
+            shape.vertices[3] = Vec2f{ -halfWidth, halfHeight };
+            shape.normals[0] = Vec2f{ 0.0f, -1.0f };
+            shape.normals[1] = Vec2f{ 1.0f, 0.0f };
+            shape.normals[2] = Vec2f{ 0.0f, 1.0f };
+            shape.normals[3] = Vec2f{ -1.0f, 0.0f };
+            return shape;
+        }
+
+        /*
+         * Convex hull of 3 to MAX_POLYGON_VERTICES points in any order. Points
+         * inside the hull or on one of its edges are dropped, and the result is
+         * shifted so its centroid is at the origin.
+         */
+        inline Shape MakePolygon(Span<const Vec2f> points)
+        {
+            assert(points.size() >= 3 && points.size() <= MAX_POLYGON_VERTICES);
+
+            // Monotone chain: lower hull left to right, then upper hull back
+            std::array<Vec2f, MAX_POLYGON_VERTICES> sorted;
+            std::copy(points.begin(), points.end(), sorted.begin());
+            std::sort(sorted.begin(), sorted.begin() + points.size(), [](const Vec2f& a, const Vec2f& b) {
+                return a.x < b.x || (a.x == b.x && a.y < b.y);
+            });
+            std::array<Vec2f, 2 * MAX_POLYGON_VERTICES> hull;
+            size_t count = 0;
+            for (size_t i = 0; i < points.size(); ++i)
+            {
+                while (count >= 2 && Cross(hull[count - 1] - hull[count - 2], sorted[i] - hull[count - 2]) <= 0.0f)
+                    --count;
+                hull[count++] = sorted[i];
+            }
+            const auto lower = count + 1;
+            for (auto i = points.size() - 1; i-- > 0;)
+            {
+                while (count >= lower && Cross(hull[count - 1] - hull[count - 2], sorted[i] - hull[count - 2]) <= 0.0f)
+                    --count;
+                hull[count++] = sorted[i];
+            }
+            --count; // The last point repeats the first
+            assert(count >= 3 && "points are collinear");
+
+            // Area-weighted centroid of the triangle fan from the first vertex
+            Vec2f centroid{ 0.0f };
+            f32 area = 0.0f;
+            for (size_t i = 1; i + 1 < count; ++i)
+            {
+                const auto a = Cross(hull[i] - hull[0], hull[i + 1] - hull[0]) * 0.5f;
+                centroid = centroid + (hull[0] + hull[i] + hull[i + 1]) * (a / 3.0f);
+                area += a;
+            }
+            centroid = centroid / area;
+
+            Shape shape;
+            shape.type = ShapeType::Polygon;
+            shape.count = static_cast<u32>(count);
+            for (size_t i = 0; i < count; ++i)
+                shape.vertices[i] = hull[i] - centroid;
+            for (size_t i = 0; i < count; ++i)
+                shape.normals[i] = Normalize(Cross(shape.vertices[(i + 1) % count] - shape.vertices[i], 1.0f));
+            return shape;
+        }
+
+        inline MassData ComputeMass(const Shape& shape, f32 density)
+        {
+            if (shape.type == ShapeType::Circle)
+            {
+                const auto r2 = shape.radius * shape.radius;
+                const auto mass = density * PI * r2;
+                return MassData{ mass, mass * r2 * 0.5f };
+            }
+
+            // Sum over the triangles (origin, v1, v2); the origin is the centroid
+            f32 area = 0.0f;
+            f32 inertia = 0.0f;
+            for (u32 i = 0; i < shape.count; ++i)
+            {
+                const auto& v1 = shape.vertices[i];
+                const auto& v2 = shape.vertices[(i + 1) % shape.count];
+                const auto d = Cross(v1, v2);
+                area += 0.5f * d;
+                const auto intX2 = v1.x * v1.x + v2.x * v1.x + v2.x * v2.x;
+                const auto intY2 = v1.y * v1.y + v2.y * v1.y + v2.y * v2.y;
+                inertia += (0.25f / 3.0f) * d * (intX2 + intY2);
+            }
+            return MassData{ density * area, density * inertia };
+        }
+
+        inline AABB2f ComputeAABB(const Shape& shape, const Pose& pose)
+        {
+            if (shape.type == ShapeType::Circle)
+                return AABB2f::FromCenterExtents(pose.position, Vec2f{ shape.radius });
+
+            auto box = AABB2f::Empty();
+            for (u32 i = 0; i < shape.count; ++i)
+                box = Merge(box, Apply(pose, shape.vertices[i]));
+            return box;
+        }
+    }
+}
+
+#endif // J_SHAPE_H
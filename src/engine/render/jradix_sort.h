@@ -0,0 +1,82 @@
+#ifndef J_RADIX_SORT_H
+#define J_RADIX_SORT_H
+
+#include <array> // std::array
+#include <cassert> // assert
+#include <utility> // std::swap
+
+#include "jtypes.h"
+#include "jspan.h"
+
+namespace jg
+{
+    /*
+     * Stable LSD radix sort of values by their u64 keys, 8 bits per pass.
+     * One read builds the histograms of every digit up front, and a digit
+     * that is the same in every key skips its pass, so keys that only use
+     * their low and high bytes cost two passes, not eight.
+     *
+     * The scratch spans must be at least as large as keys; the sorted result
+     * always ends up in keys and values.
+     */
+    inline void RadixSort(Span<u64> keys, Span<u32> values, Span<u64> keyScratch, Span<u32> valueScratch)
+    {
+        constexpr size_t DIGITS = sizeof(u64);
+        constexpr size_t BUCKETS = 256;
+
+        const auto count = keys.size();
+        assert(values.size() == count);
+        assert(keyScratch.size() >= count && valueScratch.size() >= count);
+        if (count < 2)
+            return;
+
+        std::array<std::array<u32, BUCKETS>, DIGITS> histograms{};
+        for (size_t i = 0; i < count; ++i)
+        {
+            auto key = keys[i];
+            for (size_t d = 0; d < DIGITS; ++d, key >>= 8)
+                ++histograms[d][key & 0xFF];
+        }
+
+        auto* srcKeys = keys.data();
+        auto* srcValues = values.data();
+        auto* dstKeys = keyScratch.data();
+        auto* dstValues = valueScratch.data();
+        for (size_t d = 0; d < DIGITS; ++d)
+        {
+            auto& histogram = histograms[d];
+            const auto shift = d * 8;
+            if (histogram[(srcKeys[0] >> shift) & 0xFF] == count)
+                continue;
+
+            // Counts to starting offsets
+            u32 offset = 0;
+            for (auto& bucket : histogram)
+            {
+                const auto n = bucket;
+                bucket = offset;
+                offset += n;
+            }
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                const auto slot = histogram[(srcKeys[i] >> shift) & 0xFF]++;
+                dstKeys[slot] = srcKeys[i];
+                dstValues[slot] = srcValues[i];
+            }
+            std::swap(srcKeys, dstKeys);
+            std::swap(srcValues, dstValues);
+        }
+
+        if (srcKeys != keys.data())
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                keys[i] = srcKeys[i];
+                values[i] = srcValues[i];
+            }
+        }
+    }
+}
+
+#endif // J_RADIX_SORT_H
@@ -0,0 +1,575 @@
+#ifndef J_RASTERIZER_H
+#define J_RASTERIZER_H
+
+#include <algorithm> // std::fill, std::max, std::min
+#include <cassert> // assert
+#include <cmath> // std::floor
+#include <vector> // std::vector
+
+#include "jtypes.h"
+#include "jspan.h"
+#include "math/jsimd.h"
+#include "math/jvec.h"
+#include "math/jmatrix.h"
+#include "math/jcmath.h"
+#include "jobs/jparallel.h"
+#include "jsprite_batch.h"
+
+namespace jg
+{
+    /*
+     * RGBA8 pixels packed like SpriteBatcher::PackColor, red in the low byte.
+     * Rows are padded to a multiple of 4 pixels and the height to a multiple
+     * of 4 rows, so the rasterizer's 4x4 blocks never need bounds checks;
+     * read pixels through At() or row by row with stride.
+     */
+    struct Framebuffer
+    {
+        u32 width = 0;
+        u32 height = 0;
+        u32 stride = 0;
+        std::vector<u32> pixels;
+
+        Framebuffer() = default;
+        Framebuffer(u32 w, u32 h) :
+            width{ w }, height{ h }, stride{ (w + 3) & ~3u },
+            pixels(static_cast<size_t>(stride) * ((h + 3) & ~3u), 0u) {}
+
+        void Clear(u32 color) { std::fill(pixels.begin(), pixels.end(), color); }
+
+        u32& At(u32 x, u32 y)
+        {
+            assert(x < width && y < height);
+            return pixels[static_cast<size_t>(y) * stride + x];
+        }
+        const u32& At(u32 x, u32 y) const
+        {
+            assert(x < width && y < height);
+            return pixels[static_cast<size_t>(y) * stride + x];
+        }
+    };
+
+    /*
+     * CPU rasterizer for 2D triangles with per-vertex colors, blended
+     * source-over into a Framebuffer.
+     *
+     * Draw calls only queue triangles. Render() sets them up in parallel,
+     * bins them into TILE_SIZE square screen tiles and rasterizes the tiles in
+     * parallel. Every tile draws its triangles in submission order, so the
+     * image does not depend on the thread count.
+     *
+     * Vertices snap to 1/16 pixel and coverage uses exact integer edge
+     * functions with the top-left fill rule: triangles sharing an edge cover
+     * each pixel centre exactly once, in every build. Tiles are walked in
+     * 4x4 pixel blocks; blocks entirely inside the triangle skip the edge
+     * tests, and the others test four pixels at a time with SIMD.
+     */
+    class TileRasterizer
+    {
+    public:
+        static constexpr u32 TILE_SIZE = 64;
+        static constexpr i32 SUBPIXEL_BITS = 4;
+        // Triangles with a vertex further than this from the origin, in pixels, are dropped
+        static constexpr f32 GUARD_BAND = 32768.0f;
+
+        // Queues indexed triangles. transform maps positions to pixels; pixel centres sit at +0.5
+        void Draw(const Mat3f& transform, Span<const Vec2f> positions, Span<const Vec4f> colors, Span<const u32> indices)
+        {
+            assert(positions.size() == colors.size());
+            assert(indices.size() % 3 == 0);
+            for (size_t i = 0; i < indices.size(); i += 3)
+            {
+                Triangle tri;
+                for (size_t k = 0; k < 3; ++k)
+                {
+                    const auto v = indices[i + k];
+                    assert(v < positions.size());
+                    tri.position[k] = TransformPoint(transform, positions[v]);
+                    tri.color[k] = colors[v];
+                }
+                m_triangles.push_back(tri);
+            }
+        }
+
+        // Quads as written by SpriteBatcher, two triangles each; uvs are ignored
+        void DrawQuads(const Mat3f& transform, Span<const SpriteVertex> vertices)
+        {
+            assert(vertices.size() % SpriteBatcher::VERTICES_PER_SPRITE == 0);
+            for (size_t i = 0; i < vertices.size(); i += SpriteBatcher::VERTICES_PER_SPRITE)
+            {
+                Vec2f p[4];
+                Vec4f c[4];
+                for (size_t k = 0; k < 4; ++k)
+                {
+                    p[k] = TransformPoint(transform, vertices[i + k].position);
+                    c[k] = SpriteBatcher::UnpackColor(vertices[i + k].color);
+                }
+                m_triangles.push_back(Triangle{ { p[0], p[1], p[2] }, { c[0], c[1], c[2] } });
+                m_triangles.push_back(Triangle{ { p[2], p[3], p[0] }, { c[2], c[3], c[0] } });
+            }
+        }
+
+        size_t TriangleCount() const { return m_triangles.size(); }
+
+        // Drops the queued triangles without drawing them
+        void Clear() { m_triangles.clear(); }
+
+        // Draws and then clears the queued triangles
+        void Render(jobs::ThreadPool& pool, Framebuffer& target)
+        {
+            m_setups.resize(m_triangles.size());
+            jobs::ParallelFor(pool, 0, m_triangles.size(), SETUP_GRAIN, [this, &target](size_t first, size_t last) {
+                SetupTriangles(first, last, target);
+            });
+            Bin(target);
+            jobs::ParallelFor(pool, 0, TileCount(target), 1, [this, &target](size_t first, size_t last) {
+                for (auto tile = first; tile < last; ++tile)
+                    RasterizeTile(tile, target);
+            });
+            m_triangles.clear();
+        }
+
+        // Same, on the calling thread only
+        void Render(Framebuffer& target)
+        {
+            m_setups.resize(m_triangles.size());
+            SetupTriangles(0, m_triangles.size(), target);
+            Bin(target);
+            for (size_t tile = 0; tile < TileCount(target); ++tile)
+                RasterizeTile(tile, target);
+            m_triangles.clear();
+        }
+
+    private:
+        static constexpr size_t SETUP_GRAIN = 4096;
+        static constexpr i32 SUBPIXEL_SCALE = 1 << SUBPIXEL_BITS;
+        static constexpr i32 SUBPIXEL_HALF = SUBPIXEL_SCALE / 2;
+
+        struct Triangle
+        {
+            Vec2f position[3];
+            Vec4f color[3];
+        };
+
+        enum : u32
+        {
+            FLAG_FLAT = 1, // One color, so nothing to interpolate
+            FLAG_OPAQUE = 2 // Alpha 1 everywhere, so no blending
+        };
+
+        struct Setup
+        {
+            // Edge k runs from vertex k to k + 1. E = a * x + b * y + c in subpixels is >= 0
+            // inside, with the fill rule folded into c
+            i64 c[3];
+            i32 a[3];
+            i32 b[3];
+            // Pixel bounds, inclusive and clipped to the target; empty when minX > maxX
+            i32 minX, minY, maxX, maxY;
+            f32 invArea;
+            u32 flags;
+            u32 flatColor;
+            Vec4f color0;
+            Vec4f delta1; // color1 - color0, weighted by the edge function of edge 2
+            Vec4f delta2; // color2 - color0, weighted by the edge function of edge 0
+        };
+
+        static Vec2f TransformPoint(const Mat3f& m, const Vec2f& p)
+        {
+            return Vec2f{ m.m00 * p.x + m.m01 * p.y + m.m02, m.m10 * p.x + m.m11 * p.y + m.m12 };
+        }
+
+        static i32 Snap(f32 v) { return static_cast<i32>(std::floor(v * static_cast<f32>(SUBPIXEL_SCALE) + 0.5f)); }
+
+        // First and last pixel index whose centre lies in [lo, hi], in subpixels
+        static i32 FirstPixel(i32 lo) { return -((SUBPIXEL_HALF - lo) >> SUBPIXEL_BITS); }
+        static i32 LastPixel(i32 hi) { return (hi - SUBPIXEL_HALF) >> SUBPIXEL_BITS; }
+
+        static size_t TilesX(const Framebuffer& target) { return (target.width + TILE_SIZE - 1) / TILE_SIZE; }
+        static size_t TileCount(const Framebuffer& target) { return TilesX(target) * ((target.height + TILE_SIZE - 1) / TILE_SIZE); }
+
+        void SetupTriangles(size_t first, size_t last, const Framebuffer& target)
+        {
+            for (auto i = first; i < last; ++i)
+                SetupTriangle(m_triangles[i], target, m_setups[i]);
+        }
+
+        static void SetupTriangle(const Triangle& tri, const Framebuffer& target, Setup& s)
+        {
+            s.minX = s.minY = 1;
+            s.maxX = s.maxY = 0;
+            for (const auto& p : tri.position)
+            {
+                // Also rejects NaN
+                if (!(Abs(p.x) <= GUARD_BAND && Abs(p.y) <= GUARD_BAND))
+                    return;
+            }
+
+            i32 x[3], y[3];
+            for (size_t k = 0; k < 3; ++k)
+            {
+                x[k] = Snap(tri.position[k].x);
+                y[k] = Snap(tri.position[k].y);
+            }
+            auto area = static_cast<i64>(x[1] - x[0]) * (y[2] - y[0]) - static_cast<i64>(y[1] - y[0]) * (x[2] - x[0]);
+            if (area == 0)
+                return;
+
+            // Either winding draws; flip clockwise triangles so the inside is positive
+            size_t order[3] = { 0, 1, 2 };
+            if (area < 0)
+            {
+                order[1] = 2;
+                order[2] = 1;
+                area = -area;
+            }
+
+            i32 vx[3], vy[3];
+            for (size_t k = 0; k < 3; ++k)
+            {
+                vx[k] = x[order[k]];
+                vy[k] = y[order[k]];
+            }
+            for (size_t k = 0; k < 3; ++k)
+            {
+                const auto j = (k + 1) % 3;
+                s.a[k] = vy[k] - vy[j];
+                s.b[k] = vx[j] - vx[k];
+                s.c[k] = static_cast<i64>(vx[k]) * vy[j] - static_cast<i64>(vy[k]) * vx[j];
+                // Top-left rule: pixel centres exactly on any other edge belong to the neighbour
+                const auto topLeft = s.a[k] > 0 || (s.a[k] == 0 && s.b[k] > 0);
+                if (!topLeft)
+                    s.c[k] -= 1;
+            }
+
+            const auto maxX = static_cast<i32>(target.width) - 1;
+            const auto maxY = static_cast<i32>(target.height) - 1;
+            s.minX = std::max(FirstPixel(std::min({ vx[0], vx[1], vx[2] })), 0);
+            s.minY = std::max(FirstPixel(std::min({ vy[0], vy[1], vy[2] })), 0);
+            s.maxX = std::min(LastPixel(std::max({ vx[0], vx[1], vx[2] })), maxX);
+            s.maxY = std::min(LastPixel(std::max({ vy[0], vy[1], vy[2] })), maxY);
+            s.invArea = 1.0f / static_cast<f32>(area);
+
+            const auto& c0 = tri.color[order[0]];
+            const auto& c1 = tri.color[order[1]];
+            const auto& c2 = tri.color[order[2]];
+            s.color0 = c0;
+            s.delta1 = Vec4f{ c1.x - c0.x, c1.y - c0.y, c1.z - c0.z, c1.w - c0.w };
+            s.delta2 = Vec4f{ c2.x - c0.x, c2.y - c0.y, c2.z - c0.z, c2.w - c0.w };
+
+            s.flags = 0;
+            if (c0.x == c1.x && c0.y == c1.y && c0.z == c1.z && c0.w == c1.w &&
+                c0.x == c2.x && c0.y == c2.y && c0.z == c2.z && c0.w == c2.w)
+                s.flags |= FLAG_FLAT;
+            if (c0.w >= 1.0f && c1.w >= 1.0f && c2.w >= 1.0f)
+                s.flags |= FLAG_OPAQUE;
+            s.flatColor = SpriteBatcher::PackColor(c0);
+        }
+
+        // Lists every triangle index per tile, in submission order, in one flat array
+        void Bin(const Framebuffer& target)
+        {
+            const auto tilesX = TilesX(target);
+            const auto tileCount = TileCount(target);
+            m_binStart.assign(tileCount + 1, 0);
+
+            const auto forEachTile = [tilesX](const Setup& s, auto&& fn) {
+                if (s.minX > s.maxX || s.minY > s.maxY)
+                    return;
+                for (auto ty = static_cast<size_t>(s.minY) / TILE_SIZE; ty <= static_cast<size_t>(s.maxY) / TILE_SIZE; ++ty)
+                    for (auto tx = static_cast<size_t>(s.minX) / TILE_SIZE; tx <= static_cast<size_t>(s.maxX) / TILE_SIZE; ++tx)
+                        fn(ty * tilesX + tx);
+            };
+
+            for (const auto& s : m_setups)
+                forEachTile(s, [this](size_t tile) { ++m_binStart[tile + 1]; });
+            for (size_t tile = 0; tile < tileCount; ++tile)
+                m_binStart[tile + 1] += m_binStart[tile];
+
+            m_binTriangles.resize(m_binStart[tileCount]);
+            m_binCursor.assign(m_binStart.begin(), m_binStart.end() - 1);
+            for (size_t i = 0; i < m_setups.size(); ++i)
+                forEachTile(m_setups[i], [this, i](size_t tile) { m_binTriangles[m_binCursor[tile]++] = static_cast<u32>(i); });
+        }
+
+        void RasterizeTile(size_t tile, Framebuffer& target) const
+        {
+            const auto tilesX = TilesX(target);
+            const auto tileX = static_cast<i32>((tile % tilesX) * TILE_SIZE);
+            const auto tileY = static_cast<i32>((tile / tilesX) * TILE_SIZE);
+            const auto tileLastX = tileX + static_cast<i32>(TILE_SIZE) - 1;
+            const auto tileLastY = tileY + static_cast<i32>(TILE_SIZE) - 1;
+
+            for (auto i = m_binStart[tile]; i < m_binStart[tile + 1]; ++i)
+            {
+                const auto& s = m_setups[m_binTriangles[i]];
+                // Tiles are a multiple of 4 wide, so aligning to blocks stays inside the tile
+                const auto x0 = std::max(s.minX, tileX) & ~3;
+                const auto y0 = std::max(s.minY, tileY) & ~3;
+                const auto x1 = std::min(s.maxX, tileLastX);
+                const auto y1 = std::min(s.maxY, tileLastY);
+                RasterizeBlocks(s, x0, y0, x1, y1, target);
+            }
+        }
+
+        // Per-triangle constants for walking 4x4 blocks
+        struct BlockWalk
+        {
+            i64 rowStart[3]; // Edge values at the current block row's first pixel centre
+            i64 blockStepX[3];
+            i64 blockStepY[3];
+            i64 lo[3]; // Smallest and largest offset from a block's first pixel to any of its 16
+            i64 hi[3];
+            i32 pixelStepX[3];
+            i32 pixelStepY[3];
+#if defined(JG_SIMD_SSE)
+            __m128i laneStepX[3]; // 0, 1, 2 and 3 pixel steps
+            __m128i laneStepY[3];
+#endif
+        };
+
+        // Any edge value in a block that is not wholly outside fits in 32 bits once clamped to
+        // this: an edge the block is inside stays positive across it, and one it crosses is small
+        static constexpr i64 EDGE_CLAMP = i64{ 1 } << 30;
+        static_assert(6 * 2 * static_cast<i64>(GUARD_BAND) * SUBPIXEL_SCALE * SUBPIXEL_SCALE < EDGE_CLAMP,
+                      "A block's edge span must stay below the clamp");
+
+        static void RasterizeBlocks(const Setup& s, i32 x0, i32 y0, i32 x1, i32 y1, Framebuffer& target)
+        {
+            const auto sx = static_cast<i64>(x0) * SUBPIXEL_SCALE + SUBPIXEL_HALF;
+            const auto sy = static_cast<i64>(y0) * SUBPIXEL_SCALE + SUBPIXEL_HALF;
+            BlockWalk walk;
+            for (size_t k = 0; k < 3; ++k)
+            {
+                const auto dx = s.a[k] * SUBPIXEL_SCALE;
+                const auto dy = s.b[k] * SUBPIXEL_SCALE;
+                walk.rowStart[k] = s.a[k] * sx + s.b[k] * sy + s.c[k];
+                walk.blockStepX[k] = 4 * static_cast<i64>(dx);
+                walk.blockStepY[k] = 4 * static_cast<i64>(dy);
+                walk.lo[k] = 3 * (static_cast<i64>(std::min(dx, 0)) + std::min(dy, 0));
+                walk.hi[k] = 3 * (static_cast<i64>(std::max(dx, 0)) + std::max(dy, 0));
+                walk.pixelStepX[k] = dx;
+                walk.pixelStepY[k] = dy;
+#if defined(JG_SIMD_SSE)
+                walk.laneStepX[k] = _mm_setr_epi32(0, dx, 2 * dx, 3 * dx);
+                walk.laneStepY[k] = _mm_set1_epi32(dy);
+#endif
+            }
+
+            // Block columns of a row can be clipped to the span where every edge might still pass:
+            // edge k passes column j when rowStart + hi + j * blockStepX >= 0. The quotient is only
+            // ever compared near small column numbers, where f64 is off by far less than the slack
+            constexpr f64 SLACK = 1e-6;
+            f64 invStepX[3];
+            for (size_t k = 0; k < 3; ++k)
+                invStepX[k] = walk.blockStepX[k] != 0 ? 1.0 / static_cast<f64>(walk.blockStepX[k]) : 0.0;
+            const auto lastColumn = static_cast<f64>((x1 - x0) / 4);
+
+            for (auto by = y0; by <= y1; by += 4)
+            {
+                auto first = 0.0;
+                auto last = lastColumn;
+                for (size_t k = 0; k < 3; ++k)
+                {
+                    const auto reach = walk.rowStart[k] + walk.hi[k];
+                    if (walk.blockStepX[k] == 0)
+                    {
+                        last = reach < 0 ? -1.0 : last;
+                        continue;
+                    }
+                    const auto crossing = -static_cast<f64>(reach) * invStepX[k];
+                    if (walk.blockStepX[k] > 0)
+                        first = std::max(first, crossing - SLACK);
+                    else
+                        last = std::min(last, crossing + SLACK);
+                }
+
+                if (first <= last)
+                {
+                    // Both lie in [0, lastColumn], so the casts are floors
+                    auto firstColumn = static_cast<i32>(first);
+                    firstColumn += static_cast<f64>(firstColumn) < first ? 1 : 0;
+                    const auto columnEnd = x0 + 4 * static_cast<i32>(last);
+                    auto* row = target.pixels.data() + static_cast<size_t>(by) * target.stride;
+                    i64 e[3];
+                    for (size_t k = 0; k < 3; ++k)
+                        e[k] = walk.rowStart[k] + firstColumn * walk.blockStepX[k];
+                    for (auto bx = x0 + 4 * firstColumn; bx <= columnEnd; bx += 4)
+                    {
+                        // Outside an edge everywhere in the block: skip. Inside all three: no edge tests
+                        // The sign of the OR is set when any term is negative, without a branch per edge
+                        const auto outside = ((e[0] + walk.hi[0]) | (e[1] + walk.hi[1]) | (e[2] + walk.hi[2])) < 0;
+                        if (!outside)
+                        {
+                            const auto covered = ((e[0] + walk.lo[0]) | (e[1] + walk.lo[1]) | (e[2] + walk.lo[2])) >= 0;
+                            DrawBlock(s, walk, e, covered, row + bx, target.stride);
+                        }
+                        for (size_t k = 0; k < 3; ++k)
+                            e[k] += walk.blockStepX[k];
+                    }
+                }
+                for (size_t k = 0; k < 3; ++k)
+                    walk.rowStart[k] += walk.blockStepY[k];
+            }
+        }
+
+        static void DrawBlock(const Setup& s, const BlockWalk& walk, const i64 (&origin)[3], bool covered, u32* dst, size_t stride)
+        {
+            i32 e[3];
+            for (size_t k = 0; k < 3; ++k)
+                e[k] = static_cast<i32>(std::min(std::max(origin[k], -EDGE_CLAMP), EDGE_CLAMP));
+            const auto flat = (s.flags & FLAG_FLAT) != 0;
+            const auto opaque = (s.flags & FLAG_OPAQUE) != 0;
+
+            // Barycentric weights of vertices 1 and 2 and their per-pixel steps
+            auto w1 = 0.0f, w2 = 0.0f, w1dx = 0.0f, w1dy = 0.0f, w2dx = 0.0f, w2dy = 0.0f;
+            if (!flat)
+            {
+                w1 = static_cast<f32>(origin[2]) * s.invArea;
+                w2 = static_cast<f32>(origin[0]) * s.invArea;
+                w1dx = static_cast<f32>(walk.pixelStepX[2]) * s.invArea;
+                w1dy = static_cast<f32>(walk.pixelStepY[2]) * s.invArea;
+                w2dx = static_cast<f32>(walk.pixelStepX[0]) * s.invArea;
+                w2dy = static_cast<f32>(walk.pixelStepY[0]) * s.invArea;
+            }
+
+#if defined(JG_SIMD_SSE)
+            if (covered && flat && opaque)
+            {
+                const auto color = _mm_set1_epi32(static_cast<int>(s.flatColor));
+                for (i32 row = 0; row < 4; ++row, dst += stride)
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), color);
+                return;
+            }
+
+            const auto minusOne = _mm_set1_epi32(-1);
+            __m128i laneE[3];
+            for (size_t k = 0; k < 3; ++k)
+                laneE[k] = _mm_add_epi32(_mm_set1_epi32(e[k]), walk.laneStepX[k]);
+            const auto lane = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+
+            for (i32 row = 0; row < 4; ++row, dst += stride)
+            {
+                auto mask = minusOne;
+                if (!covered)
+                {
+                    for (size_t k = 0; k < 3; ++k)
+                    {
+                        mask = _mm_and_si128(mask, _mm_cmpgt_epi32(laneE[k], minusOne));
+                        laneE[k] = _mm_add_epi32(laneE[k], walk.laneStepY[k]);
+                    }
+                    // A masked store of an empty row is cheaper than a mispredicted skip,
+                    // unless there is shading to save
+                    if (!(flat && opaque) && _mm_movemask_epi8(mask) == 0)
+                        continue;
+                }
+
+                auto* p = reinterpret_cast<__m128i*>(dst);
+                const auto old = _mm_loadu_si128(p);
+                __m128i src;
+                if (flat && opaque)
+                {
+                    src = _mm_set1_epi32(static_cast<int>(s.flatColor));
+                }
+                else
+                {
+                    __m128 channel[4];
+                    if (flat)
+                    {
+                        for (size_t c = 0; c < 4; ++c)
+                            channel[c] = _mm_set1_ps(s.color0[c]);
+                    }
+                    else
+                    {
+                        const auto rowF = static_cast<f32>(row);
+                        const auto pw1 = _mm_add_ps(_mm_set1_ps(w1 + rowF * w1dy), _mm_mul_ps(lane, _mm_set1_ps(w1dx)));
+                        const auto pw2 = _mm_add_ps(_mm_set1_ps(w2 + rowF * w2dy), _mm_mul_ps(lane, _mm_set1_ps(w2dx)));
+                        for (size_t c = 0; c < 4; ++c)
+                        {
+                            const auto v = _mm_add_ps(_mm_set1_ps(s.color0[c]),
+                                _mm_add_ps(_mm_mul_ps(pw1, _mm_set1_ps(s.delta1[c])), _mm_mul_ps(pw2, _mm_set1_ps(s.delta2[c]))));
+                            channel[c] = _mm_min_ps(_mm_max_ps(v, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+                        }
+                    }
+                    if (!opaque)
+                    {
+                        // Source over: rgb = src * a + dst * (1 - a), alpha = a + dstA * (1 - a)
+                        const auto alpha = channel[3];
+                        const auto inv = _mm_sub_ps(_mm_set1_ps(1.0f), alpha);
+                        for (size_t c = 0; c < 4; ++c)
+                        {
+                            const auto d = _mm_and_si128(_mm_srli_epi32(old, static_cast<int>(c * 8)), _mm_set1_epi32(0xFF));
+                            const auto dstC = _mm_mul_ps(_mm_cvtepi32_ps(d), _mm_set1_ps(1.0f / 255.0f));
+                            const auto srcC = c == 3 ? _mm_set1_ps(1.0f) : channel[c];
+                            channel[c] = _mm_add_ps(_mm_mul_ps(srcC, alpha), _mm_mul_ps(dstC, inv));
+                        }
+                    }
+                    src = _mm_setzero_si128();
+                    for (size_t c = 0; c < 4; ++c)
+                    {
+                        const auto v = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(channel[c], _mm_set1_ps(255.0f)), _mm_set1_ps(0.5f)));
+                        src = _mm_or_si128(src, _mm_slli_epi32(v, static_cast<int>(c * 8)));
+                    }
+                }
+                _mm_storeu_si128(p, _mm_or_si128(_mm_and_si128(mask, src), _mm_andnot_si128(mask, old)));
+            }
+#else
+            if (covered && flat && opaque)
+            {
+                for (i32 row = 0; row < 4; ++row, dst += stride)
+                    std::fill(dst, dst + 4, s.flatColor);
+                return;
+            }
+
+            for (i32 row = 0; row < 4; ++row, dst += stride)
+            {
+                for (i32 col = 0; col < 4; ++col)
+                {
+                    auto inside = true;
+                    for (size_t k = 0; k < 3 && !covered; ++k)
+                        inside = inside && e[k] + col * walk.pixelStepX[k] + row * walk.pixelStepY[k] >= 0;
+                    if (!inside)
+                        continue;
+
+                    if (flat && opaque)
+                    {
+                        dst[col] = s.flatColor;
+                        continue;
+                    }
+
+                    const auto pw1 = w1 + static_cast<f32>(row) * w1dy + static_cast<f32>(col) * w1dx;
+                    const auto pw2 = w2 + static_cast<f32>(row) * w2dy + static_cast<f32>(col) * w2dx;
+                    f32 channel[4];
+                    for (size_t c = 0; c < 4; ++c)
+                    {
+                        const auto v = flat ? s.color0[c] : s.color0[c] + (pw1 * s.delta1[c] + pw2 * s.delta2[c]);
+                        channel[c] = v < 0.0f ? 0.0f : (v > 1.0f ? 1.0f : v);
+                    }
+                    if (!opaque)
+                    {
+                        const auto alpha = channel[3];
+                        for (size_t c = 0; c < 4; ++c)
+                        {
+                            const auto dstC = static_cast<f32>((dst[col] >> (c * 8)) & 0xFF) * (1.0f / 255.0f);
+                            const auto srcC = c == 3 ? 1.0f : channel[c];
+                            channel[c] = srcC * alpha + dstC * (1.0f - alpha);
+                        }
+                    }
+                    u32 packed = 0;
+                    for (size_t c = 0; c < 4; ++c)
+                        packed |= static_cast<u32>(channel[c] * 255.0f + 0.5f) << (c * 8);
+                    dst[col] = packed;
+                }
+            }
+#endif
+        }
+
+        std::vector<Triangle> m_triangles;
+        std::vector<Setup> m_setups;
+        std::vector<u32> m_binStart; // Tile t's triangles are m_binTriangles[m_binStart[t], m_binStart[t + 1])
+        std::vector<u32> m_binCursor;
+        std::vector<u32> m_binTriangles;
+    };
+}
+
+#endif // J_RASTERIZER_H
@@ -0,0 +1,8 @@
+#ifndef J_RENDER_H
+#define J_RENDER_H
+
+#include "jradix_sort.h"
+#include "jsprite_batch.h"
+#include "jrasterizer.h"
+
+#endif // J_RENDER_H
@@ -0,0 +1,205 @@
+#ifndef J_SPRITE_BATCH_H
+#define J_SPRITE_BATCH_H
+
+#include <cassert> // assert
+#include <cstdint> // uintptr_t
+#include <vector> // std::vector
+
+#include "jtypes.h"
+#include "jspan.h"
+#include "math/jsimd.h"
+#include "math/jvec.h"
+#include "math/jmatrix.h"
+#include "jradix_sort.h"
+
+namespace jg
+{
+    /*
+     * One textured quad. The quad is the unit square centred on the origin,
+     * mapped by transform (size, rotation and any parent transform) and then
+     * offset by position. uvRect is (u0, v0, u1, v1): u runs along the quad's
+     * local x axis and v along its local y axis.
+     */
+    struct Sprite
+    {
+        Mat3f transform{ Mat3f::Identity() };
+        Vec2f position{ 0.0f };
+        Vec4f uvRect{ 0.0f, 0.0f, 1.0f, 1.0f };
+        Vec4f color{ 1.0f };
+        u32 texture = 0;
+        u32 layer = 0; // Lower layers draw first
+    };
+
+    // Color is RGBA8, red in the lowest byte: the byte order of a normalized u8x4 vertex attribute
+    struct SpriteVertex
+    {
+        Vec2f position;
+        Vec2f uv;
+        u32 color;
+    };
+
+    static_assert(sizeof(SpriteVertex) == 20, "SpriteVertex must match the vertex layout: 2 + 2 floats and one u32");
+
+    // One draw call: spriteCount quads starting at quad firstSprite
+    struct SpriteBatch
+    {
+        u32 texture;
+        u32 layer;
+        u32 firstSprite;
+        u32 spriteCount;
+    };
+
+    /*
+     * Sorts sprites by layer, then texture, and writes their quads in that
+     * order straight into a caller-supplied vertex buffer, typically a mapped
+     * GPU buffer. Sprites in the same layer and texture keep their submission
+     * order, so overlapping sprites still draw back to front.
+     *
+     * Only the keys and an index array are sorted; sprites are read in sorted
+     * order and every vertex is written exactly once, front to back, which is
+     * what write-combined memory wants. The batcher keeps its scratch arrays
+     * between frames, so it stops allocating once it has seen its largest frame.
+     */
+    class SpriteBatcher
+    {
+    public:
+        static constexpr size_t VERTICES_PER_SPRITE = 4;
+        static constexpr size_t INDICES_PER_SPRITE = 6;
+
+        // vertices needs room for VERTICES_PER_SPRITE * sprites.size() vertices
+        Span<const SpriteBatch> Build(Span<const Sprite> sprites, Span<SpriteVertex> vertices)
+        {
+            const auto count = sprites.size();
+            assert(vertices.size() >= count * VERTICES_PER_SPRITE);
+            assert(count <= ~u32{ 0 });
+
+            m_keys.resize(count);
+            m_order.resize(count);
+            m_keyScratch.resize(count);
+            m_orderScratch.resize(count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                m_keys[i] = static_cast<u64>(sprites[i].layer) << 32 | sprites[i].texture;
+                m_order[i] = static_cast<u32>(i);
+            }
+            RadixSort(Span<u64>{ m_keys }, Span<u32>{ m_order }, Span<u64>{ m_keyScratch }, Span<u32>{ m_orderScratch });
+
+            m_batches.clear();
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (i == 0 || m_keys[i] != m_keys[i - 1])
+                {
+                    const auto& first = sprites[m_order[i]];
+                    m_batches.push_back(SpriteBatch{ first.texture, first.layer, static_cast<u32>(i), 0 });
+                }
+                ++m_batches.back().spriteCount;
+            }
+
+            auto* out = vertices.data();
+#if defined(JG_SIMD_SSE)
+            // Whole quads are 80 bytes, so from a 16-byte aligned buffer every quad can be
+            // streamed past the cache in five aligned stores
+            static_assert(VERTICES_PER_SPRITE * sizeof(SpriteVertex) % 16 == 0, "quads must be whole SSE stores");
+            constexpr size_t STORES_PER_QUAD = VERTICES_PER_SPRITE * sizeof(SpriteVertex) / sizeof(__m128);
+            if (reinterpret_cast<uintptr_t>(out) % 16 == 0)
+            {
+                for (size_t i = 0; i < count; ++i, out += VERTICES_PER_SPRITE)
+                {
+                    // Sorted order is a gather; fetch a few sprites ahead
+                    if (i + PREFETCH_DISTANCE < count)
+                        _mm_prefetch(reinterpret_cast<const char*>(&sprites[m_order[i + PREFETCH_DISTANCE]]), _MM_HINT_T0);
+
+                    alignas(16) SpriteVertex quad[VERTICES_PER_SPRITE];
+                    WriteQuad(sprites[m_order[i]], quad);
+                    const auto* src = reinterpret_cast<const f32*>(quad);
+                    auto* dst = reinterpret_cast<f32*>(out);
+                    for (size_t k = 0; k < STORES_PER_QUAD; ++k)
+                        _mm_stream_ps(dst + k * 4, _mm_load_ps(src + k * 4));
+                }
+                // Streaming stores are weakly ordered; publish them before the buffer is handed on
+                _mm_sfence();
+                return Batches();
+            }
+#endif
+            for (size_t i = 0; i < count; ++i, out += VERTICES_PER_SPRITE)
+                WriteQuad(sprites[m_order[i]], out);
+
+            return Batches();
+        }
+
+        // The batches of the last Build, in draw order
+        Span<const SpriteBatch> Batches() const { return Span<const SpriteBatch>{ m_batches.data(), m_batches.size() }; }
+
+        // Clamped to [0, 1] and rounded to the nearest step
+        static u32 PackColor(const Vec4f& color)
+        {
+#if defined(JG_SIMD_SSE)
+            const auto clamped = _mm_min_ps(_mm_max_ps(color.simd, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+            const auto scaled = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(clamped, _mm_set1_ps(255.0f)), _mm_set1_ps(0.5f)));
+            const auto bytes = _mm_packus_epi16(_mm_packs_epi32(scaled, scaled), scaled);
+            return static_cast<u32>(_mm_cvtsi128_si32(bytes));
+#else
+            u32 packed = 0;
+            for (size_t i = 0; i < 4; ++i)
+            {
+                const auto c = color[i] < 0.0f ? 0.0f : (color[i] > 1.0f ? 1.0f : color[i]);
+                packed |= static_cast<u32>(c * 255.0f + 0.5f) << (i * 8);
+            }
+            return packed;
+#endif
+        }
+
+        static Vec4f UnpackColor(u32 packed)
+        {
+            constexpr auto scale = 1.0f / 255.0f;
+            return Vec4f{ static_cast<f32>(packed & 0xFF) * scale, static_cast<f32>((packed >> 8) & 0xFF) * scale,
+                          static_cast<f32>((packed >> 16) & 0xFF) * scale, static_cast<f32>(packed >> 24) * scale };
+        }
+
+    private:
+        static constexpr size_t PREFETCH_DISTANCE = 16;
+
+        static void WriteQuad(const Sprite& sprite, SpriteVertex* out)
+        {
+            const auto& m = sprite.transform;
+            // Half of each local axis, and the centre in world space
+            const auto ax = 0.5f * m.m00, ay = 0.5f * m.m10;
+            const auto bx = 0.5f * m.m01, by = 0.5f * m.m11;
+            const auto cx = m.m02 + sprite.position.x;
+            const auto cy = m.m12 + sprite.position.y;
+
+            const auto& uv = sprite.uvRect;
+            const auto color = PackColor(sprite.color);
+
+            out[0] = SpriteVertex{ Vec2f{ cx - ax - bx, cy - ay - by }, Vec2f{ uv.x, uv.y }, color };
+            out[1] = SpriteVertex{ Vec2f{ cx + ax - bx, cy + ay - by }, Vec2f{ uv.z, uv.y }, color };
+            out[2] = SpriteVertex{ Vec2f{ cx + ax + bx, cy + ay + by }, Vec2f{ uv.z, uv.w }, color };
+            out[3] = SpriteVertex{ Vec2f{ cx - ax + bx, cy - ay + by }, Vec2f{ uv.x, uv.w }, color };
+        }
+
+        std::vector<u64> m_keys;
+        std::vector<u32> m_order;
+        std::vector<u64> m_keyScratch;
+        std::vector<u32> m_orderScratch;
+        std::vector<SpriteBatch> m_batches;
+    };
+
+    // Two counter-clockwise triangles per quad, (0, 1, 2) and (2, 3, 0); fill once and reuse
+    inline void WriteQuadIndices(Span<u32> indices, size_t spriteCount)
+    {
+        assert(indices.size() >= spriteCount * SpriteBatcher::INDICES_PER_SPRITE);
+        for (size_t i = 0; i < spriteCount; ++i)
+        {
+            const auto base = static_cast<u32>(i * SpriteBatcher::VERTICES_PER_SPRITE);
+            auto* out = indices.data() + i * SpriteBatcher::INDICES_PER_SPRITE;
+            out[0] = base;
+            out[1] = base + 1;
+            out[2] = base + 2;
+            out[3] = base + 2;
+            out[4] = base + 3;
+            out[5] = base;
+        }
+    }
+}
+
+#endif // J_SPRITE_BATCH_H
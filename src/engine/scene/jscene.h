@@ -0,0 +1,6 @@
+#ifndef J_SCENE_H
+#define J_SCENE_H
+
+#include "jtransform_hierarchy.h"
+
+#endif // J_SCENE_H
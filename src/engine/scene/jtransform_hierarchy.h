@@ -0,0 +1,275 @@
+#ifndef J_TRANSFORM_HIERARCHY_H
+#define J_TRANSFORM_HIERARCHY_H
+
+#include <algorithm> // std::fill
+#include <cassert> // assert
+#include <vector> // std::vector
+
+#include "jtypes.h"
+#include "math/jvec.h"
+#include "math/jmatrix.h"
+#include "math/jcmath.h"
+
+namespace jg
+{
+    /*
+     * 2D scene graph. Every node has a local translation, rotation (radians)
+     * and scale, applied as T * R * S, and a world matrix
+     * world = parent world * local.
+     *
+     * Node data lives in flat arrays sorted by depth, so a parent always
+     * comes before its children and Update() is one forward pass. Setters
+     * only flag the node. Update() recomputes flagged nodes and their
+     * descendants and leaves every other world matrix untouched.
+     *
+     * Creating, destroying and reparenting nodes re-sorts the arrays on the
+     * next Update(). That costs O(n), so do it far less often than moving nodes.
+     */
+    class TransformHierarchy
+    {
+    public:
+        using NodeId = u32;
+        static constexpr NodeId INVALID_NODE = ~0u;
+
+        NodeId Create(NodeId parent = INVALID_NODE)
+        {
+            assert(parent == INVALID_NODE || Contains(parent));
+            NodeId id;
+            if (m_freeList != INVALID_NODE)
+            {
+                id = m_freeList;
+                m_freeList = m_indexOf[id];
+            }
+            else
+            {
+                id = static_cast<NodeId>(m_indexOf.size());
+                m_indexOf.push_back(INVALID_NODE);
+            }
+
+            // Appended out of order; Update() sorts it into its depth
+            m_indexOf[id] = static_cast<u32>(m_nodeOf.size());
+            m_nodeOf.push_back(id);
+            m_parent.push_back(parent == INVALID_NODE ? INVALID_NODE : m_indexOf[parent]);
+            m_translation.push_back(Vec2f{ 0.0f });
+            m_rotation.push_back(0.0f);
+            m_scale.push_back(Vec2f{ 1.0f });
+            m_world.push_back(Mat3f::Identity());
+            m_dirty.push_back(1);
+            m_structureDirty = true;
+            ++m_count;
+            return id;
+        }
+
+        // Destroys node and all of its descendants
+        void Destroy(NodeId id)
+        {
+            assert(Contains(id));
+            if (m_structureDirty)
+                Rebuild();
+
+            // Sorted, so one pass reaches the whole subtree
+            const auto root = m_indexOf[id];
+            for (auto i = root; i < m_nodeOf.size(); ++i)
+            {
+                const auto p = m_parent[i];
+                if (i != root && (p == INVALID_NODE || m_nodeOf[p] != INVALID_NODE))
+                    continue;
+                const auto node = m_nodeOf[i];
+                m_nodeOf[i] = INVALID_NODE;
+                m_indexOf[node] = m_freeList;
+                m_freeList = node;
+                --m_count;
+            }
+            m_structureDirty = true;
+        }
+
+        // Moves node under parent (INVALID_NODE for a root), keeping its local transform
+        void SetParent(NodeId id, NodeId parent)
+        {
+            assert(Contains(id) && (parent == INVALID_NODE || Contains(parent)));
+            const auto index = m_indexOf[id];
+            const auto parentIndex = parent == INVALID_NODE ? INVALID_NODE : m_indexOf[parent];
+#if !defined(NDEBUG)
+            for (auto p = parentIndex; p != INVALID_NODE; p = m_parent[p])
+                assert(p != index && "SetParent would create a cycle");
+#endif
+            m_parent[index] = parentIndex;
+            m_dirty[index] = 1;
+            m_structureDirty = true;
+        }
+
+        NodeId GetParent(NodeId id) const
+        {
+            assert(Contains(id));
+            const auto p = m_parent[m_indexOf[id]];
+            return p == INVALID_NODE ? INVALID_NODE : m_nodeOf[p];
+        }
+
+        void SetTranslation(NodeId id, const Vec2f& translation) { const auto i = Index(id); m_translation[i] = translation; m_dirty[i] = 1; }
+        void SetRotation(NodeId id, f32 rad) { const auto i = Index(id); m_rotation[i] = rad; m_dirty[i] = 1; }
+        void SetScale(NodeId id, const Vec2f& scale) { const auto i = Index(id); m_scale[i] = scale; m_dirty[i] = 1; }
+        void SetLocal(NodeId id, const Vec2f& translation, f32 rad, const Vec2f& scale)
+        {
+            const auto i = Index(id);
+            m_translation[i] = translation;
+            m_rotation[i] = rad;
+            m_scale[i] = scale;
+            m_dirty[i] = 1;
+        }
+
+        const Vec2f& GetTranslation(NodeId id) const { return m_translation[Index(id)]; }
+        f32 GetRotation(NodeId id) const { return m_rotation[Index(id)]; }
+        const Vec2f& GetScale(NodeId id) const { return m_scale[Index(id)]; }
+        Mat3f GetLocal(NodeId id) const { return LocalMatrix(Index(id)); }
+
+        // As of the last Update()
+        const Mat3f& GetWorld(NodeId id) const { return m_world[Index(id)]; }
+
+        bool Contains(NodeId id) const { return id < m_indexOf.size() && IsLive(id); }
+        size_t size() const { return m_count; }
+        bool empty() const { return m_count == 0; }
+
+        // Recomputes the world matrices of changed nodes and their descendants; returns how many
+        size_t Update()
+        {
+            if (m_structureDirty)
+                Rebuild();
+
+            size_t updated = 0;
+            const auto count = m_nodeOf.size();
+            for (size_t i = 0; i < count; ++i)
+            {
+                // Parents come first, so their flag already includes their own ancestors
+                const auto p = m_parent[i];
+                const auto dirty = m_dirty[i] | (p != INVALID_NODE ? m_dirty[p] : u8{ 0 });
+                if (!dirty)
+                    continue;
+                m_dirty[i] = 1;
+                m_world[i] = p != INVALID_NODE ? m_world[p] * LocalMatrix(i) : LocalMatrix(i);
+                ++updated;
+            }
+            std::fill(m_dirty.begin(), m_dirty.end(), u8{ 0 });
+            return updated;
+        }
+
+    private:
+        // Free ids chain through m_indexOf, so a live id is one its array slot points back to
+        bool IsLive(NodeId id) const
+        {
+            const auto i = m_indexOf[id];
+            return i < m_nodeOf.size() && m_nodeOf[i] == id;
+        }
+
+        u32 Index(NodeId id) const
+        {
+            assert(Contains(id));
+            return m_indexOf[id];
+        }
+
+        Mat3f LocalMatrix(size_t i) const
+        {
+            const auto s = Sin(m_rotation[i]);
+            const auto c = Cos(m_rotation[i]);
+            const auto& scale = m_scale[i];
+            const auto& t = m_translation[i];
+            return Mat3f{
+                 c * scale.x, s * scale.x, 0.0f,
+                -s * scale.y, c * scale.y, 0.0f,
+                         t.x,         t.y, 1.0f
+            };
+        }
+
+        // Drops destroyed nodes and stable-sorts the rest by depth
+        void Rebuild()
+        {
+            const auto oldCount = m_nodeOf.size();
+            constexpr u32 UNKNOWN = ~0u;
+
+            // Depth of every live slot; parents may sit after children until sorted
+            std::vector<u32> depth(oldCount, UNKNOWN);
+            std::vector<u32> chain;
+            u32 maxDepth = 0;
+            for (size_t i = 0; i < oldCount; ++i)
+            {
+                if (m_nodeOf[i] == INVALID_NODE)
+                    continue;
+                auto j = static_cast<u32>(i);
+                while (depth[j] == UNKNOWN && m_parent[j] != INVALID_NODE)
+                {
+                    chain.push_back(j);
+                    j = m_parent[j];
+                }
+                auto d = depth[j] == UNKNOWN ? 0u : depth[j];
+                depth[j] = d;
+                while (!chain.empty())
+                {
+                    depth[chain.back()] = ++d;
+                    chain.pop_back();
+                }
+                maxDepth = depth[i] > maxDepth ? depth[i] : maxDepth;
+            }
+
+            // Counting sort: order[k] is the old slot that moves to slot k
+            std::vector<u32> start(maxDepth + 2, 0);
+            for (size_t i = 0; i < oldCount; ++i)
+            {
+                if (m_nodeOf[i] != INVALID_NODE)
+                    ++start[depth[i] + 1];
+            }
+            for (size_t d = 1; d < start.size(); ++d)
+                start[d] += start[d - 1];
+            std::vector<u32> order(m_count);
+            std::vector<u32> newIndex(oldCount, INVALID_NODE);
+            for (size_t i = 0; i < oldCount; ++i)
+            {
+                if (m_nodeOf[i] == INVALID_NODE)
+                    continue;
+                const auto k = start[depth[i]]++;
+                order[k] = static_cast<u32>(i);
+                newIndex[i] = k;
+            }
+
+            Permute(m_nodeOf, order);
+            Permute(m_parent, order);
+            Permute(m_translation, order);
+            Permute(m_rotation, order);
+            Permute(m_scale, order);
+            Permute(m_world, order);
+            Permute(m_dirty, order);
+            for (size_t k = 0; k < order.size(); ++k)
+            {
+                m_indexOf[m_nodeOf[k]] = static_cast<u32>(k);
+                if (m_parent[k] != INVALID_NODE)
+                    m_parent[k] = newIndex[m_parent[k]];
+            }
+            m_structureDirty = false;
+        }
+
+        template <typename T>
+        static void Permute(std::vector<T>& values, const std::vector<u32>& order)
+        {
+            std::vector<T> sorted;
+            sorted.reserve(order.size());
+            for (const auto i : order)
+                sorted.push_back(values[i]);
+            values.swap(sorted);
+        }
+
+        // Indexed by sorted slot
+        std::vector<NodeId> m_nodeOf; // INVALID_NODE once destroyed
+        std::vector<u32> m_parent; // Slot of the parent, or INVALID_NODE for roots
+        std::vector<Vec2f> m_translation;
+        std::vector<f32> m_rotation;
+        std::vector<Vec2f> m_scale;
+        std::vector<Mat3f> m_world;
+        std::vector<u8> m_dirty;
+
+        // Indexed by NodeId: its slot, or the next free id once destroyed
+        std::vector<u32> m_indexOf;
+        NodeId m_freeList = INVALID_NODE;
+        size_t m_count = 0;
+        bool m_structureDirty = false;
+    };
+}
+
+#endif // J_TRANSFORM_HIERARCHY_H
@@ -0,0 +1,130 @@
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <vector>
+
+#include "jangine.h"
+
+TEST(AABB, Basics)
+{
+    const jg::AABB2f a{ jg::Vec2f{ 0.0f, 0.0f }, jg::Vec2f{ 4.0f, 2.0f } };
+    const jg::AABB2f b{ jg::Vec2f{ 3.0f, 1.0f }, jg::Vec2f{ 6.0f, 5.0f } };
+    const jg::AABB2f c{ jg::Vec2f{ 4.5f, 0.0f }, jg::Vec2f{ 5.0f, 0.5f } };
+
+    EXPECT_EQ(jg::Center(a).x, 2.0f);
+    EXPECT_EQ(jg::Extents(a).y, 1.0f);
+    EXPECT_EQ(jg::Size(b).y, 4.0f);
+
+    EXPECT_TRUE(jg::Intersects(a, b));
+    EXPECT_FALSE(jg::Intersects(a, c));
+    // Touching edges count as intersecting
+    EXPECT_TRUE(jg::Intersects(a, jg::AABB2f{ jg::Vec2f{ 4.0f, 2.0f }, jg::Vec2f{ 5.0f, 3.0f } }));
+
+    const auto i = jg::Intersection(a, b);
+    EXPECT_FALSE(jg::IsEmpty(i));
+    EXPECT_EQ(i.min.x, 3.0f);
+    EXPECT_EQ(i.max.y, 2.0f);
+    EXPECT_TRUE(jg::IsEmpty(jg::Intersection(a, c)));
+
+    const auto m = jg::Merge(a, c);
+    EXPECT_EQ(m.max.x, 5.0f);
+    EXPECT_TRUE(jg::Contains(m, a));
+    EXPECT_TRUE(jg::Contains(m, c));
+    EXPECT_FALSE(jg::Contains(a, b));
+    EXPECT_TRUE(jg::Contains(a, jg::Vec2f{ 4.0f, 0.0f }));
+    EXPECT_FALSE(jg::Contains(a, jg::Vec2f{ 4.1f, 0.0f }));
+
+    // Empty() is the identity for Merge
+    EXPECT_TRUE(jg::IsEmpty(jg::AABB3f::Empty()));
+    const auto p = jg::Merge(jg::AABB3f::Empty(), jg::Vec3f{ 1.0f, 2.0f, 3.0f });
+    EXPECT_EQ(p.min.z, 3.0f);
+    EXPECT_EQ(p.max.z, 3.0f);
+
+    const jg::Vec3f points[] = { jg::Vec3f{ 1.0f, -2.0f, 0.0f }, jg::Vec3f{ -1.0f, 5.0f, 2.0f } };
+    const auto fromPoints = jg::AABB3f::FromPoints(points);
+    EXPECT_EQ(fromPoints.min.x, -1.0f);
+    EXPECT_EQ(fromPoints.max.y, 5.0f);
+
+    static_assert(jg::Intersects(jg::AABB2f{ jg::Vec2f{ 0.0f }, jg::Vec2f{ 1.0f } }, jg::AABB2f{ jg::Vec2f{ 0.5f }, jg::Vec2f{ 2.0f } }));
+}
+
+TEST(AABB, Transform)
+{
+    const jg::AABB2f box{ jg::Vec2f{ -1.0f, -2.0f }, jg::Vec2f{ 1.0f, 2.0f } };
+
+    // Translation and scale are exact
+    const auto ts = jg::Transform(jg::Mat3f::Translation2D(10.0f, 5.0f) * jg::Mat3f::Scale2D(2.0f, 0.5f), box);
+    EXPECT_FLOAT_EQ(ts.min.x, 8.0f);
+    EXPECT_FLOAT_EQ(ts.max.y, 6.0f);
+
+    // A 90 degree rotation swaps the extents
+    const auto r = jg::Transform(jg::Mat3f::Rotation2D(1.5707963f), box);
+    EXPECT_NEAR(r.min.x, -2.0f, 1e-5f);
+    EXPECT_NEAR(r.max.y, 1.0f, 1e-5f);
+
+    // Tight: equals the bounds of the transformed corners
+    const auto mat = jg::Mat3f::Translation2D(3.0f, -1.0f) * jg::Mat3f::Rotation2D(0.6f) * jg::Mat3f::Scale2D(1.5f, 1.0f);
+    auto expected = jg::AABB2f::Empty();
+    for (const auto& corner : { box.min, box.max, jg::Vec2f{ box.min.x, box.max.y }, jg::Vec2f{ box.max.x, box.min.y } })
+    {
+        const auto p = mat * jg::Vec3f{ corner.x, corner.y, 1.0f };
+        expected = jg::Merge(expected, jg::Vec2f{ p.x, p.y });
+    }
+    const auto t = jg::Transform(mat, box);
+    for (size_t i = 0; i < 2; ++i)
+    {
+        EXPECT_NEAR(t.min[i], expected.min[i], 1e-5f);
+        EXPECT_NEAR(t.max[i], expected.max[i], 1e-5f);
+    }
+
+    const jg::AABB3f box3{ jg::Vec3f{ 0.0f }, jg::Vec3f{ 1.0f, 2.0f, 3.0f } };
+    const auto t3 = jg::Transform(jg::Mat4f::Translation3D(1.0f, 0.0f, -1.0f) * jg::Mat4f::RotationZ(1.5707963f), box3);
+    EXPECT_NEAR(t3.min.x, -1.0f, 1e-5f);
+    EXPECT_NEAR(t3.max.y, 1.0f, 1e-5f);
+    EXPECT_NEAR(t3.max.z, 2.0f, 1e-5f);
+
+    // Empty boxes stay empty rather than turning into NaN
+    const auto e2 = jg::Transform(jg::Mat3f::Identity(), jg::AABB2f::Empty());
+    EXPECT_TRUE(jg::IsEmpty(e2));
+    EXPECT_EQ(e2.min.x, jg::AABB2f::Empty().min.x);
+    EXPECT_EQ(e2.max.y, jg::AABB2f::Empty().max.y);
+    const auto e3 = jg::Transform(jg::Mat4f::RotationZ(0.3f), jg::AABB3f::Empty());
+    EXPECT_TRUE(jg::IsEmpty(e3));
+    EXPECT_FALSE(std::isnan(e3.min.z));
+    static_assert(jg::IsEmpty(jg::Transform(jg::Mat4f::Identity(), jg::AABB3f::Empty())));
+}
+
+TEST(AABB, OverlapMask)
+{
+    std::vector<jg::AABB2f> boxes;
+    for (auto i = 0; i < 203; ++i)
+    {
+        const auto x = static_cast<float>((i * 37) % 101) - 50.0f;
+        const auto y = static_cast<float>((i * 53) % 89) - 44.0f;
+        boxes.push_back(jg::AABB2f{ jg::Vec2f{ x, y }, jg::Vec2f{ x + 3.0f, y + 2.0f } });
+    }
+    std::vector<float> minX, minY, maxX, maxY;
+    for (const auto& b : boxes)
+    {
+        minX.push_back(b.min.x);
+        minY.push_back(b.min.y);
+        maxX.push_back(b.max.x);
+        maxY.push_back(b.max.y);
+    }
+
+    const jg::AABB2f query{ jg::Vec2f{ -20.0f, -10.0f }, jg::Vec2f{ 15.0f, 25.0f } };
+    std::vector<jg::u64> mask(4, ~0ull);
+    const auto hits = jg::OverlapMask(query, jg::AABB2fSoA{ minX, minY, maxX, maxY }, mask);
+
+    size_t expectedHits = 0;
+    for (size_t i = 0; i < boxes.size(); ++i)
+    {
+        const auto expected = jg::Intersects(query, boxes[i]);
+        expectedHits += expected;
+        EXPECT_EQ(((mask[i / 64] >> (i % 64)) & 1) != 0, expected) << "i = " << i;
+    }
+    EXPECT_EQ(hits, expectedHits);
+    EXPECT_GT(hits, 0u);
+    // Bits past the last box are cleared
+    EXPECT_EQ(mask[3] >> (203 % 64), 0u);
+}
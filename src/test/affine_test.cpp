@@ -0,0 +1,87 @@
+#include "gtest/gtest.h"
+
+#include "jangine.h"
+
+class Affine2 : public ::testing::Test
+{
+protected:
+    void CheckNear(const jg::Affine2f& a, const jg::Mat3f& m)
+    {
+        EXPECT_NEAR(a.m00, m.m00, 1e-5f);
+        EXPECT_NEAR(a.m10, m.m10, 1e-5f);
+        EXPECT_NEAR(a.m01, m.m01, 1e-5f);
+        EXPECT_NEAR(a.m11, m.m11, 1e-5f);
+        EXPECT_NEAR(a.m02, m.m02, 1e-5f);
+        EXPECT_NEAR(a.m12, m.m12, 1e-5f);
+    }
+};
+
+TEST_F(Affine2, Layout)
+{
+    EXPECT_EQ(sizeof(jg::Affine2f), 6 * sizeof(float));
+
+    constexpr jg::Affine2f a;
+    for (auto i = 0; i < 6; ++i)
+        EXPECT_FLOAT_EQ(a.data[i], 0.0f);
+
+    constexpr jg::Affine2f b{ 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f };
+    EXPECT_FLOAT_EQ(b.m10, 2.0f);
+    EXPECT_FLOAT_EQ(b.m01, 3.0f);
+    EXPECT_FLOAT_EQ(b[2].x, 5.0f);
+    EXPECT_FLOAT_EQ(b[2].y, 6.0f);
+}
+
+TEST_F(Affine2, Factories)
+{
+    CheckNear(jg::Affine2f::Identity(), jg::Mat3f::Identity());
+    CheckNear(jg::Affine2f::Translation(3.0f, -2.0f), jg::Mat3f::Translation2D(3.0f, -2.0f));
+    CheckNear(jg::Affine2f::Scale(2.0f, 5.0f), jg::Mat3f::Scale2D(2.0f, 5.0f));
+    CheckNear(jg::Affine2f::Rotation(0.4f), jg::Mat3f::Rotation2D(0.4f));
+}
+
+TEST_F(Affine2, Mat3Conversion)
+{
+    const auto m = jg::Mat3f::Translation2D(1.0f, 2.0f) * jg::Mat3f::Rotation2D(1.1f);
+    const jg::Affine2f a{ m };
+    CheckNear(a, m);
+
+    const auto back = jg::ToMat3(a);
+    for (auto i = 0; i < 9; ++i)
+        EXPECT_FLOAT_EQ(back.data[i], m.data[i]);
+}
+
+TEST_F(Affine2, Compose)
+{
+    const auto t = jg::Mat3f::Translation2D(4.0f, -1.0f);
+    const auto r = jg::Mat3f::Rotation2D(-0.6f);
+    const auto s = jg::Mat3f::Scale2D(0.5f, 3.0f);
+
+    const auto composed = jg::Affine2f{ t } * jg::Affine2f{ r } * jg::Affine2f{ s };
+    CheckNear(composed, t * r * s);
+}
+
+TEST_F(Affine2, Transform)
+{
+    const auto a = jg::Affine2f::Translation(1.0f, 2.0f) * jg::Affine2f::Scale(2.0f, 3.0f);
+
+    const auto p = jg::TransformPoint(a, jg::Vec2f{ 1.0f, 1.0f });
+    EXPECT_FLOAT_EQ(p.x, 3.0f);
+    EXPECT_FLOAT_EQ(p.y, 5.0f);
+
+    const auto v = jg::TransformVector(a, jg::Vec2f{ 1.0f, 1.0f });
+    EXPECT_FLOAT_EQ(v.x, 2.0f);
+    EXPECT_FLOAT_EQ(v.y, 3.0f);
+}
+
+TEST_F(Affine2, Inverse)
+{
+    EXPECT_FLOAT_EQ(jg::Determinant(jg::Affine2f::Scale(2.0f, 3.0f)), 6.0f);
+
+    const auto a = jg::Affine2f::Translation(4.0f, -1.0f)
+                 * jg::Affine2f::Rotation(0.9f)
+                 * jg::Affine2f::Scale(2.0f, 0.25f);
+    const auto inv = jg::Inverse(a);
+
+    CheckNear(inv, jg::Inverse(jg::ToMat3(a)));
+    CheckNear(inv * a, jg::Mat3f::Identity());
+}
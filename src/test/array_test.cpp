@@ -0,0 +1,163 @@
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "jangine.h"
+
+namespace
+{
+    bool IsAligned(const void* p, size_t align) { return reinterpret_cast<std::uintptr_t>(p) % align == 0; }
+
+    jg::Vec3f MakeVec(size_t i) { return jg::Vec3f{ 1.0f * i, 2.0f * i, -1.0f * i }; }
+}
+
+TEST(VecArray, AoS)
+{
+    jg::VecArray<float, 3, jg::Layout::AoS, 64> arr;
+    for (size_t i = 0; i < 100; ++i)
+        arr.push_back(MakeVec(i));
+
+    ASSERT_EQ(arr.size(), 100u);
+    EXPECT_TRUE(IsAligned(arr.data(), 64));
+    // Elements stay tightly packed
+    EXPECT_EQ(reinterpret_cast<const char*>(&arr[1]) - reinterpret_cast<const char*>(&arr[0]), 12);
+
+    size_t i = 0;
+    for (auto& v : arr)
+    {
+        EXPECT_EQ(v.y, 2.0f * i);
+        v.z = 5.0f;
+        ++i;
+    }
+    EXPECT_EQ(arr.Get(42).z, 5.0f);
+
+    const auto span = arr.AsSpan();
+    EXPECT_EQ(span.size(), 100u);
+    EXPECT_EQ(span[7].x, 7.0f);
+
+    arr.resize(120);
+    EXPECT_EQ(arr[119].x, 0.0f);
+
+    // Pushing one of its own elements while full must not read the freed buffer
+    jg::VecArray<float, 3, jg::Layout::AoS, 64> full;
+    for (size_t j = 0; j < 16; ++j)
+        full.push_back(MakeVec(j));
+    ASSERT_EQ(full.size(), full.capacity());
+    full.push_back(full[3]);
+    ASSERT_EQ(full.size(), 17u);
+    EXPECT_EQ(full[16].x, 3.0f);
+    EXPECT_EQ(full[16].z, -3.0f);
+}
+
+TEST(VecArray, SoA)
+{
+    jg::VecArray<float, 3, jg::Layout::SoA, 32> arr;
+    for (size_t i = 0; i < 37; ++i)
+        arr.push_back(MakeVec(i));
+
+    ASSERT_EQ(arr.size(), 37u);
+    EXPECT_EQ(arr.PaddedSize(), 40u);
+    for (size_t k = 0; k < 3; ++k)
+    {
+        const auto stream = arr.Component(k);
+        EXPECT_TRUE(IsAligned(stream.data(), 32));
+        EXPECT_EQ(arr.ComponentData(k), stream.data());
+        EXPECT_EQ(stream.size(), 37u);
+        // Padding lanes are zero
+        for (auto j = stream.size(); j < arr.PaddedSize(); ++j)
+            EXPECT_EQ(stream.data()[j], 0.0f);
+    }
+    EXPECT_EQ(arr.Component(1)[5], 10.0f);
+
+    // Proxy reads and writes whole elements or single components
+    const jg::Vec3f v = arr[9];
+    EXPECT_EQ(v.x, 9.0f);
+    EXPECT_EQ(v.z, -9.0f);
+    arr[9] = jg::Vec3f{ 1.0f, 2.0f, 3.0f };
+    arr[10].Component(2) = 7.0f;
+    EXPECT_EQ(arr.Component(2)[9], 3.0f);
+    EXPECT_EQ(arr.Get(10).z, 7.0f);
+
+    size_t i = 0;
+    for (auto ref : arr)
+    {
+        const jg::Vec3f e = ref;
+        ref = e * 2.0f;
+        ++i;
+    }
+    EXPECT_EQ(i, 37u);
+    EXPECT_EQ(arr.Get(20).y, 80.0f);
+
+    // Copies keep their own storage
+    auto copy = arr;
+    copy[0] = jg::Vec3f{ 9.0f };
+    EXPECT_EQ(arr.Get(0).x, 0.0f);
+    EXPECT_EQ(copy.Get(36).x, 72.0f);
+
+    // Shrinking zeroes what it drops, so the padding stays defined
+    arr.resize(33);
+    EXPECT_EQ(arr.PaddedSize(), 40u);
+    for (auto j = arr.size(); j < arr.PaddedSize(); ++j)
+        EXPECT_EQ(arr.ComponentData(0)[j], 0.0f);
+    arr.clear();
+    EXPECT_TRUE(arr.empty());
+    EXPECT_EQ(arr.ComponentData(1)[20], 0.0f);
+    arr.resize(2);
+    EXPECT_EQ(arr.Get(1).y, 0.0f);
+
+    // Copying an empty array copies nothing
+    const jg::VecArray<float, 3, jg::Layout::SoA, 32> emptySoa;
+    const auto soaCopy = emptySoa;
+    EXPECT_TRUE(soaCopy.empty());
+    const jg::VecArray<float, 3, jg::Layout::AoS> emptyAos;
+    const auto aosCopy = emptyAos;
+    EXPECT_TRUE(aosCopy.empty());
+}
+
+TEST(MatArray, SoA)
+{
+    jg::MatArray<float, 3, 3, jg::Layout::SoA> arr(4);
+    arr[2] = jg::Mat3f::Translation2D(5.0f, 6.0f);
+    const jg::Mat3f m = arr[2];
+    EXPECT_EQ(m.m02, 5.0f);
+    EXPECT_EQ(m.m12, 6.0f);
+    // Component streams follow the column-major data order
+    EXPECT_EQ(arr.Component(6)[2], 5.0f);
+    EXPECT_EQ(arr.Get(1).m00, 0.0f);
+
+    jg::MatArray<float, 4, 4> aos;
+    aos.push_back(jg::Mat4f::Identity());
+    EXPECT_TRUE(IsAligned(aos.data(), 16));
+    EXPECT_EQ(aos[0].m33, 1.0f);
+}
+
+TEST(VecArray, ArenaAllocator)
+{
+    jg::memory::Arena arena{ 4096 };
+    using Alloc = jg::memory::ArenaAllocator<float, 32>;
+    jg::VecArray<float, 2, jg::Layout::SoA, 32, Alloc> soa{ Alloc{ arena } };
+    jg::VecArray<float, 4, jg::Layout::AoS, 32, Alloc> aos{ Alloc{ arena } };
+    for (size_t i = 0; i < 20; ++i)
+    {
+        soa.push_back(jg::Vec2f{ 1.0f * i, 0.5f });
+        aos.push_back(jg::Vec4f{ 1.0f * i });
+    }
+    EXPECT_TRUE(IsAligned(soa.Component(1).data(), 32));
+    EXPECT_TRUE(IsAligned(aos.data(), 32));
+    EXPECT_EQ(soa.Get(19).x, 19.0f);
+    EXPECT_EQ(aos[19].w, 19.0f);
+    EXPECT_GT(arena.Used(), 0u);
+    EXPECT_LE(arena.Used(), arena.Capacity());
+
+    // Exhausting the arena reports bad_alloc through the allocator
+    jg::VecArray<float, 4, jg::Layout::AoS, 32, Alloc> big{ Alloc{ arena } };
+    EXPECT_THROW(big.reserve(1000), std::bad_alloc);
+}
+
+TEST(AlignedAllocator, StdVector)
+{
+    std::vector<jg::Vec3f, jg::memory::AlignedAllocator<jg::Vec3f, 64>> v(10, jg::Vec3f{ 1.0f });
+    EXPECT_TRUE(IsAligned(v.data(), 64));
+    EXPECT_EQ(v[9].z, 1.0f);
+}
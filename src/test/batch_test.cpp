@@ -0,0 +1,45 @@
+#include "gtest/gtest.h"
+
+#include <vector>
+
+#include "jangine.h"
+
+TEST(Batch, TransformPoints2D)
+{
+    // Odd count so the 8-lane, 4-lane and scalar tails are all exercised
+    constexpr auto count = 23;
+    std::vector<float> xs(count), ys(count), outX(count), outY(count);
+    for (auto i = 0; i < count; ++i)
+    {
+        xs[i] = static_cast<float>(i) * 0.5f - 3.0f;
+        ys[i] = 10.0f - static_cast<float>(i);
+    }
+
+    const auto mat = jg::Mat3f::Translation2D(4.0f, -2.0f)
+                   * jg::Mat3f::Rotation2D(0.3f)
+                   * jg::Mat3f::Scale2D(2.0f, 0.5f);
+    jg::TransformPoints2D(mat, xs, ys, outX, outY);
+
+    for (auto i = 0; i < count; ++i)
+    {
+        const auto expected = mat * jg::Vec3f{ xs[i], ys[i], 1.0f };
+        EXPECT_NEAR(outX[i], expected.x, 1e-4f);
+        EXPECT_NEAR(outY[i], expected.y, 1e-4f);
+    }
+}
+
+TEST(Batch, TransformPoints2DInPlace)
+{
+    std::vector<float> xs{ 1.0f, 2.0f, 3.0f, 4.0f, 5.0f };
+    std::vector<float> ys{ -1.0f, -2.0f, -3.0f, -4.0f, -5.0f };
+
+    jg::TransformPoints2D(jg::Mat3f::Translation2D(1.0f, 2.0f), xs, ys, xs, ys);
+    for (auto i = 0; i < 5; ++i)
+    {
+        EXPECT_FLOAT_EQ(xs[i], static_cast<float>(i + 2));
+        EXPECT_FLOAT_EQ(ys[i], static_cast<float>(1 - i));
+    }
+
+    // Empty input is a no-op
+    jg::TransformPoints2D(jg::Mat3f::Identity(), {}, {}, {}, {});
+}
@@ -0,0 +1,134 @@
+#include "gtest/gtest.h"
+
+#include <array>
+#include <cmath>
+
+#include "jangine.h"
+
+namespace
+{
+    constexpr bool Near(float a, float b, float tolerance = 1e-6f) { return jg::Abs(a - b) <= tolerance; }
+
+    // Fixed-angle rotation table, built entirely at compile time
+    constexpr std::array<jg::Mat3f, 8> MakeRotationTable()
+    {
+        std::array<jg::Mat3f, 8> table{
+            jg::Mat3f::Identity(), jg::Mat3f::Identity(), jg::Mat3f::Identity(), jg::Mat3f::Identity(),
+            jg::Mat3f::Identity(), jg::Mat3f::Identity(), jg::Mat3f::Identity(), jg::Mat3f::Identity()
+        };
+        for (size_t i = 0; i < table.size(); ++i)
+            table[i] = jg::Mat3f::Rotation2D(static_cast<float>(i) * 0.25f * jg::PI);
+        return table;
+    }
+    constexpr auto ROTATION_TABLE = MakeRotationTable();
+}
+
+TEST(Constexpr, CMath)
+{
+    static_assert(jg::Sqrt(4.0f) == 2.0f);
+    static_assert(jg::Sqrt(0.0) == 0.0);
+    static_assert(Near(jg::Sqrt(2.0f), 1.41421356f));
+    static_assert(Near(jg::Sin(0.5f * jg::PI), 1.0f));
+    static_assert(Near(jg::Cos(jg::PI), -1.0f));
+    static_assert(Near(jg::Sin(-7.0f), -0.6569866f));
+    static_assert(jg::Abs(-3) == 3);
+
+    // Compile-time versions agree with libm
+    constexpr std::array<float, 6> inputs{ 0.0f, 0.1f, 1.0f, 2.5f, -4.0f, 100.0f };
+    constexpr std::array<float, 6> sines{
+        jg::Sin(inputs[0]), jg::Sin(inputs[1]), jg::Sin(inputs[2]),
+        jg::Sin(inputs[3]), jg::Sin(inputs[4]), jg::Sin(inputs[5])
+    };
+    constexpr std::array<float, 6> cosines{
+        jg::Cos(inputs[0]), jg::Cos(inputs[1]), jg::Cos(inputs[2]),
+        jg::Cos(inputs[3]), jg::Cos(inputs[4]), jg::Cos(inputs[5])
+    };
+    constexpr std::array<float, 6> roots{
+        jg::Sqrt(inputs[0]), jg::Sqrt(inputs[1]), jg::Sqrt(inputs[2]),
+        jg::Sqrt(inputs[3]), jg::Sqrt(100.0f * inputs[5]), jg::Sqrt(1e30f)
+    };
+    for (size_t i = 0; i < inputs.size(); ++i)
+    {
+        EXPECT_FLOAT_EQ(sines[i], std::sin(inputs[i]));
+        EXPECT_FLOAT_EQ(cosines[i], std::cos(inputs[i]));
+    }
+    EXPECT_FLOAT_EQ(roots[1], std::sqrt(0.1f));
+    EXPECT_FLOAT_EQ(roots[3], std::sqrt(2.5f));
+    EXPECT_FLOAT_EQ(roots[4], 100.0f);
+    EXPECT_FLOAT_EQ(roots[5], 1e15f);
+}
+
+TEST(Constexpr, Vector)
+{
+    constexpr jg::Vec2f a{ 3.0f, 4.0f };
+    constexpr jg::Vec2f b{ 1.0f, -1.0f };
+    static_assert((a + b).x == 4.0f && (a - b).y == 5.0f);
+    static_assert((a * 2.0f).y == 8.0f && (2.0f * a).x == 6.0f && (a / 2.0f).x == 1.5f);
+    static_assert(jg::Dot(a, b) == -1.0f);
+    static_assert(jg::LengthSq(a) == 25.0f && jg::Length(a) == 5.0f);
+    static_assert(Near(jg::Normalize(a).x, 0.6f) && a[1] == 4.0f);
+
+    constexpr jg::Vec3f x{ 1.0f, 0.0f, 0.0f };
+    constexpr jg::Vec3f y{ 0.0f, 1.0f, 0.0f };
+    static_assert(jg::Cross(x, y).z == 1.0f);
+    static_assert((x - y)[1] == -1.0f && jg::Length(x + y) == jg::Sqrt(2.0f));
+
+    constexpr jg::Vec4f c{ 1.0f, 2.0f, 3.0f, 4.0f };
+    static_assert((c + c).w == 8.0f && (c - c).z == 0.0f && (c * 3.0f)[1] == 6.0f);
+    static_assert(jg::Dot(c, c) == 30.0f && (-c).x == -1.0f);
+    static_assert(Near(jg::Length(jg::Normalize(c)), 1.0f));
+
+    constexpr jg::Vec<float, 5> d{ 2.0f };
+    static_assert(jg::Dot(d, d) == 20.0f && (d + d)[4] == 4.0f && (-d)[0] == -2.0f);
+
+    EXPECT_FLOAT_EQ(jg::Normalize(a).x, 0.6f);
+}
+
+TEST(Constexpr, Matrix)
+{
+    // Generic
+    constexpr jg::Mat<float, 2, 3> g{ 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f };
+    constexpr jg::Mat<float, 3, 2> h{ 1.0f, -1.0f, 2.0f, 1.0f, 5.0f, -3.0f };
+    static_assert((g * h).data[0] == 8.0f && (g * h).data[3] == 4.0f);
+    static_assert((g + g).data[5] == 12.0f && (g - g).data[2] == 0.0f && (g * 2.0f).data[1] == 4.0f);
+    static_assert((g * jg::Vec3f{ 1.0f, 1.0f, 1.0f }).y == 12.0f);
+
+    constexpr jg::Mat<float, 5, 5> big{ 1.0f, 2.0f };
+    static_assert(jg::Transpose(big).data[5] == 2.0f);
+    constexpr jg::Mat<float, 2, 2> small{ 1.0f, 2.0f, 3.0f, 4.0f };
+    static_assert(small.Column(1)[0] == 3.0f && g.Column(2).y == 6.0f && big.Column(0)[1] == 2.0f);
+
+    // Mat3
+    constexpr auto m = jg::Mat3f::Translation2D(1.0f, 2.0f) * jg::Mat3f::Rotation2D(0.5f * jg::PI);
+    constexpr auto p = m * jg::Vec3f{ 1.0f, 0.0f, 1.0f };
+    static_assert(Near(p.x, 1.0f) && Near(p.y, 3.0f));
+    static_assert(Near(jg::Determinant(m), 1.0f));
+    constexpr auto mi = jg::Inverse(m);
+    static_assert(Near((mi * m).m00, 1.0f) && Near((mi * m).m02, 0.0f));
+    static_assert((m + m).m02 == 2.0f && (m - m).m12 == 0.0f && (m * 2.0f).m12 == 4.0f);
+    constexpr auto r = jg::Mat3f::Rotation2D(0.5f);
+    static_assert(r.Column(0)[0] == r.m00 && r.Column(1)[0] == r.m01 && r.Column(2)[2] == 1.0f);
+    static_assert((jg::Mat3f{} + jg::Mat3f::Identity()).Column(1)[1] == 1.0f);
+
+    static_assert(Near(ROTATION_TABLE[2].m10, 1.0f) && Near(ROTATION_TABLE[4].m00, -1.0f));
+    for (size_t i = 0; i < ROTATION_TABLE.size(); ++i)
+    {
+        const auto runtime = jg::Mat3f::Rotation2D(static_cast<float>(i) * 0.25f * jg::PI);
+        for (auto j = 0; j < 9; ++j)
+            EXPECT_NEAR(ROTATION_TABLE[i].data[j], runtime.data[j], 1e-6f);
+    }
+
+    // Mat4
+    constexpr auto t = jg::Mat4f::Translation3D(1.0f, 2.0f, 3.0f) * jg::Mat4f::RotationZ(0.25f * jg::PI);
+    static_assert(Near(jg::Determinant(t), 1.0f));
+    static_assert(Near((jg::Inverse(t) * t).m11, 1.0f) && Near((jg::AffineInverse(t) * t).m23, 0.0f));
+    static_assert((t * jg::Vec4f{ 0.0f, 0.0f, 0.0f, 1.0f }).z == 3.0f);
+    static_assert((t + t).m23 == 6.0f && jg::Transpose(t).m32 == 3.0f);
+    static_assert(t.Column(3)[2] == 3.0f && t.Column(3).w == 1.0f && Near(t.Column(0)[1], t.m10));
+
+    // Affine2
+    constexpr auto a = jg::Affine2f::Translation(1.0f, 2.0f) * jg::Affine2f::Rotation(0.5f * jg::PI);
+    static_assert(Near(jg::TransformPoint(jg::Inverse(a), jg::Vec2f{ 1.0f, 3.0f }).x, 1.0f));
+
+    EXPECT_NEAR(p.y, 3.0f, 1e-6f);
+}
@@ -0,0 +1,206 @@
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "jangine.h"
+
+namespace
+{
+    using jg::ecs::Entity;
+    using jg::ecs::Position;
+    using jg::ecs::Transform;
+    using jg::ecs::Velocity;
+    using jg::ecs::World;
+
+    using Health = jg::ecs::Component<struct HealthTag, jg::f32>;
+
+    bool IsAligned(const void* p) { return reinterpret_cast<std::uintptr_t>(p) % jg::ecs::COLUMN_ALIGNMENT == 0; }
+}
+
+TEST(Ecs, TaggedComponentsShareTheirValueType)
+{
+    static_assert(std::is_same_v<jg::ecs::ComponentValue<Position>, jg::Vec2f>);
+    static_assert(std::is_same_v<jg::ecs::ComponentValue<const Velocity>, const jg::Vec2f>);
+    static_assert(std::is_same_v<jg::ecs::ComponentValue<jg::Mat3f>, jg::Mat3f>);
+    EXPECT_NE(jg::ecs::ComponentIdOf<Position>(), jg::ecs::ComponentIdOf<Velocity>());
+    EXPECT_EQ(jg::ecs::ComponentIdOf<Position>(), jg::ecs::ComponentIdOf<const Position>());
+    EXPECT_EQ(jg::ecs::GetComponentInfo(jg::ecs::ComponentIdOf<Transform>()).size, sizeof(jg::Mat3f));
+}
+
+TEST(Ecs, CreateGetAndDestroy)
+{
+    World world;
+    const auto a = world.Create<Position, Velocity>(jg::Vec2f{ 1.0f, 2.0f }, jg::Vec2f{ 3.0f, 4.0f });
+    const auto b = world.Create<Position>(jg::Vec2f{ 5.0f, 6.0f });
+    const auto empty = world.Create();
+    EXPECT_EQ(world.size(), 3u);
+    EXPECT_TRUE(world.IsAlive(a) && world.IsAlive(b) && world.IsAlive(empty));
+    EXPECT_FALSE(world.IsAlive(Entity{}));
+
+    EXPECT_EQ(world.Get<Position>(a).y, 2.0f);
+    EXPECT_EQ(world.Get<Velocity>(a).x, 3.0f);
+    EXPECT_EQ(world.Get<Position>(b).x, 5.0f);
+    EXPECT_TRUE(world.Has<Velocity>(a));
+    EXPECT_FALSE(world.Has<Velocity>(b));
+    EXPECT_EQ(world.TryGet<Velocity>(b), nullptr);
+    world.Get<Position>(b).x = 7.0f;
+    EXPECT_EQ(static_cast<const World&>(world).Get<Position>(b).x, 7.0f);
+
+    world.Destroy(a);
+    EXPECT_FALSE(world.IsAlive(a));
+    EXPECT_EQ(world.size(), 2u);
+
+    // The slot is reused under a new generation, so the old handle stays dead
+    const auto c = world.Create<Velocity>(jg::Vec2f{ 0.0f });
+    EXPECT_EQ(c.index, a.index);
+    EXPECT_NE(c.generation, a.generation);
+    EXPECT_FALSE(world.IsAlive(a));
+    EXPECT_TRUE(world.IsAlive(c));
+}
+
+TEST(Ecs, SwapRemoveKeepsOtherEntities)
+{
+    World world;
+    std::vector<Entity> entities;
+    for (int i = 0; i < 10; ++i)
+        entities.push_back(world.Create<Position>(jg::Vec2f{ static_cast<float>(i) }));
+
+    world.Destroy(entities[2]);
+    world.Destroy(entities[9]);
+    world.Destroy(entities[0]);
+    for (int i = 0; i < 10; ++i)
+    {
+        if (i == 0 || i == 2 || i == 9)
+            continue;
+        EXPECT_EQ(world.Get<Position>(entities[i]).x, static_cast<float>(i));
+    }
+
+    // Columns stay packed
+    const auto& arch = world.Archetypes()[1];
+    EXPECT_EQ(arch.size(), 7u);
+    for (size_t row = 0; row < arch.size(); ++row)
+        EXPECT_EQ(arch.Components<Position>()[row].x, world.Get<Position>(arch.Entities()[row]).x);
+}
+
+TEST(Ecs, AddAndRemoveMoveBetweenArchetypes)
+{
+    World world;
+    const auto e = world.Create<Position>(jg::Vec2f{ 1.0f, 2.0f });
+    const auto other = world.Create<Position>(jg::Vec2f{ 3.0f, 4.0f });
+
+    world.Add<Velocity>(e, jg::Vec2f{ 5.0f, 6.0f });
+    EXPECT_TRUE(world.Has<Velocity>(e));
+    EXPECT_EQ(world.Get<Position>(e).y, 2.0f);
+    EXPECT_EQ(world.Get<Velocity>(e).x, 5.0f);
+    EXPECT_EQ(world.Get<Position>(other).x, 3.0f);
+
+    world.Add<Transform>(e, jg::Mat3f::Translation2D(1.0f, 1.0f));
+    world.Remove<Position>(e);
+    EXPECT_FALSE(world.Has<Position>(e));
+    EXPECT_EQ(world.Get<Velocity>(e).y, 6.0f);
+    EXPECT_EQ(world.Get<Transform>(e).data[6], 1.0f);
+
+    // Going back reuses the archetypes already made
+    const auto archetypes = world.Archetypes().size();
+    world.Add<Position>(e, jg::Vec2f{ 9.0f });
+    world.Remove<Transform>(e);
+    world.Remove<Velocity>(e);
+    world.Add<Velocity>(e, jg::Vec2f{ 0.0f });
+    EXPECT_EQ(world.Archetypes().size(), archetypes);
+    EXPECT_EQ(world.Get<Position>(e).x, 9.0f);
+}
+
+TEST(Ecs, QueriesVisitMatchingArchetypesOnly)
+{
+    World world;
+    for (int i = 0; i < 100; ++i)
+    {
+        const auto e = world.Create<Position, Velocity>(jg::Vec2f{ 0.0f }, jg::Vec2f{ 1.0f, 2.0f });
+        if (i % 3 == 0)
+            world.Add<Health>(e, 10.0f);
+        if (i % 5 == 0)
+            world.Remove<Velocity>(e);
+    }
+    world.Create<Velocity>(jg::Vec2f{ 100.0f });
+
+    EXPECT_EQ(world.Count<Position>(), 100u);
+    EXPECT_EQ((world.Count<Position, Velocity>()), 80u);
+    EXPECT_EQ(world.Count<Velocity>(), 81u);
+    EXPECT_EQ(world.Count<Health>(), 34u);
+
+    size_t rows = 0;
+    world.ForEachChunk<Position, const Velocity>([&rows](jg::Span<jg::Vec2f> p, jg::Span<const jg::Vec2f> v) {
+        ASSERT_EQ(p.size(), v.size());
+        EXPECT_TRUE(IsAligned(p.data()) && IsAligned(v.data()));
+        for (size_t i = 0; i < p.size(); ++i)
+            p[i] = p[i] + v[i] * 0.5f;
+        rows += p.size();
+    });
+    EXPECT_EQ(rows, 80u);
+
+    size_t moved = 0;
+    world.ForEach<const Position>([&moved](const jg::Vec2f& p) {
+        moved += p.x == 0.5f && p.y == 1.0f;
+    });
+    EXPECT_EQ(moved, 80u);
+}
+
+TEST(Ecs, RandomChurnMatchesReference)
+{
+    World world;
+    std::vector<Entity> live;
+    std::unordered_map<jg::u32, float> reference; // Entity index -> Health, or absent
+    std::unordered_map<jg::u32, float> positions;
+    jg::u32 state = 12345;
+    const auto next = [&state] { state = state * 1664525u + 1013904223u; return state >> 8; };
+
+    for (int step = 0; step < 20000; ++step)
+    {
+        const auto op = next() % 8;
+        if (op < 3 || live.empty())
+        {
+            const auto x = static_cast<float>(step);
+            live.push_back(world.Create<Position>(jg::Vec2f{ x }));
+            positions[live.back().index] = x;
+            continue;
+        }
+
+        const auto slot = next() % live.size();
+        const auto e = live[slot];
+        if (op == 3)
+        {
+            world.Destroy(e);
+            reference.erase(e.index);
+            positions.erase(e.index);
+            live[slot] = live.back();
+            live.pop_back();
+        }
+        else if (op < 6 && !world.Has<Health>(e))
+        {
+            world.Add<Health>(e, static_cast<float>(step));
+            reference[e.index] = static_cast<float>(step);
+        }
+        else if (world.Has<Health>(e))
+        {
+            world.Remove<Health>(e);
+            reference.erase(e.index);
+        }
+    }
+
+    EXPECT_EQ(world.size(), live.size());
+    EXPECT_EQ(world.Count<Health>(), reference.size());
+    for (const auto e : live)
+    {
+        ASSERT_TRUE(world.IsAlive(e));
+        EXPECT_EQ(world.Get<Position>(e).x, positions[e.index]);
+        const auto* health = world.TryGet<Health>(e);
+        const auto it = reference.find(e.index);
+        ASSERT_EQ(health != nullptr, it != reference.end());
+        if (health)
+        {
+            EXPECT_EQ(*health, it->second);
+        }
+    }
+}
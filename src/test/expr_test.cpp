@@ -0,0 +1,98 @@
+#include "gtest/gtest.h"
+
+#include <cmath>
+
+#include "jangine.h"
+#include "math/jexpr.h"
+
+namespace expr = jg::expr;
+
+TEST(Expr, Vector)
+{
+    const jg::Vec3f a{ 1.0f, 2.0f, 3.0f };
+    const jg::Vec3f b{ 4.0f, -5.0f, 6.0f };
+    const jg::Vec3f c{ 0.5f, 0.5f, -1.0f };
+
+    const auto eager = a + b * 2.0f - c;
+    const auto lazy = expr::Eval(expr::Lazy(a) + expr::Lazy(b) * 2.0f - c);
+    for (auto i = 0; i < 3; ++i)
+        EXPECT_FLOAT_EQ(lazy[i], eager[i]);
+
+    const auto neg = expr::Eval(-expr::Lazy(a) / 2.0f);
+    EXPECT_FLOAT_EQ(neg.x, -0.5f);
+    EXPECT_FLOAT_EQ(neg.y, -1.0f);
+    EXPECT_FLOAT_EQ(neg.z, -1.5f);
+
+    const auto scaled = expr::Eval(3.0f * expr::Lazy(c));
+    EXPECT_FLOAT_EQ(scaled.x, 1.5f);
+    EXPECT_FLOAT_EQ(scaled.z, -3.0f);
+}
+
+TEST(Expr, GenericVector)
+{
+    jg::Vec<float, 7> a{ 1.0f };
+    jg::Vec<float, 7> b{ 2.0f };
+    for (auto i = 0; i < 7; ++i)
+        a[i] = static_cast<float>(i);
+
+    const auto out = expr::Eval(expr::Lazy(a) - expr::Lazy(b) * 0.5f + a);
+    for (auto i = 0; i < 7; ++i)
+        EXPECT_FLOAT_EQ(out[i], 2.0f * static_cast<float>(i) - 1.0f);
+}
+
+TEST(Expr, Assign)
+{
+    jg::Vec4f a{ 1.0f, 2.0f, 3.0f, 4.0f };
+    const jg::Vec4f b{ 1.0f };
+
+    // In-place update where the destination is also an operand
+    expr::Assign(a, expr::Lazy(a) * 2.0f + b);
+    EXPECT_FLOAT_EQ(a.x, 3.0f);
+    EXPECT_FLOAT_EQ(a.y, 5.0f);
+    EXPECT_FLOAT_EQ(a.z, 7.0f);
+    EXPECT_FLOAT_EQ(a.w, 9.0f);
+}
+
+TEST(Expr, Matrix)
+{
+    const auto t = jg::Mat3f::Translation2D(1.0f, 2.0f);
+    const auto s = jg::Mat3f::Scale2D(3.0f, 4.0f);
+
+    const auto eager = t + s * 0.5f - t * 2.0f;
+    const auto lazy = expr::Eval(expr::Lazy(t) + expr::Lazy(s) * 0.5f - expr::Lazy(t) * 2.0f);
+    for (auto i = 0; i < 9; ++i)
+        EXPECT_FLOAT_EQ(lazy.data[i], eager.data[i]);
+
+    const auto m = jg::Mat4f::Translation3D(1.0f, 2.0f, 3.0f);
+    const auto lazy4 = expr::Eval(-expr::Lazy(m) + m);
+    for (auto i = 0; i < 16; ++i)
+        EXPECT_FLOAT_EQ(lazy4.data[i], 0.0f);
+
+    jg::Mat<float, 2, 3> g{ 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f };
+    expr::Assign(g, expr::Lazy(g) / 2.0f);
+    EXPECT_FLOAT_EQ(g[2][1], 3.0f);
+}
+
+TEST(Expr, Packed)
+{
+    // Sizes that are a multiple of 4 take the SSE path when it is available
+    jg::Vec<float, 8> a{ 0.0f };
+    const jg::Vec<float, 8> b{ 3.0f };
+    for (auto i = 0; i < 8; ++i)
+        a[i] = static_cast<float>(i);
+
+    const auto out = expr::Eval(-expr::Lazy(a) * 2.0f + expr::Lazy(b) / 4.0f - a);
+    for (auto i = 0; i < 8; ++i)
+        EXPECT_FLOAT_EQ(out[i], 0.75f - 3.0f * static_cast<float>(i));
+
+    const auto zero = expr::Eval(-expr::Lazy(jg::Vec4f{ 0.0f }));
+    EXPECT_TRUE(std::signbit(zero.x));
+    EXPECT_TRUE(std::signbit(zero.w));
+
+    auto m = jg::Mat4f::Translation3D(1.0f, 2.0f, 3.0f);
+    const auto s = jg::Mat4f::Scale3D(2.0f, 2.0f, 2.0f);
+    const auto eager = m * 0.5f - s + m;
+    expr::Assign(m, expr::Lazy(m) * 0.5f - s + m);
+    for (auto i = 0; i < 16; ++i)
+        EXPECT_FLOAT_EQ(m.data[i], eager.data[i]);
+}
@@ -0,0 +1,97 @@
+#include "gtest/gtest.h"
+
+#include <cmath>
+
+#include "jangine.h"
+
+// Error bounds below match the ones documented in jfastmath.h
+
+TEST(FastMath, RSqrt)
+{
+#if defined(JG_SIMD_SSE)
+    constexpr auto maxRelError = 5e-7;
+#else
+    constexpr auto maxRelError = 5e-6;
+#endif
+    for (auto x = 1e-20; x < 1e20; x *= 1.001)
+    {
+        const auto f = static_cast<float>(x);
+        const auto expected = 1.0 / std::sqrt(static_cast<double>(f));
+        EXPECT_LE(std::abs(jg::fast::RSqrt(f) - expected) / expected, maxRelError) << "x = " << f;
+    }
+}
+
+TEST(FastMath, NormalizeFast)
+{
+    const jg::Vec2f v2{ 3.0f, -4.0f };
+    const auto n2 = jg::fast::NormalizeFast(v2);
+    EXPECT_NEAR(n2.x, 0.6f, 5e-6f);
+    EXPECT_NEAR(n2.y, -0.8f, 5e-6f);
+
+    const jg::Vec3f v3{ 5.0f, -1.0f, 4.0f };
+    const auto n3 = jg::fast::NormalizeFast(v3);
+    const auto p3 = jg::Normalize(v3);
+    for (auto i = 0; i < 3; ++i)
+        EXPECT_NEAR(n3[i], p3[i], 5e-6f);
+
+    const jg::Vec4f v4{ 5.0f, -1.0f, 4.0f, -3.0f };
+    const auto n4 = jg::fast::NormalizeFast(v4);
+    const auto p4 = jg::Normalize(v4);
+    for (auto i = 0; i < 4; ++i)
+        EXPECT_NEAR(n4[i], p4[i], 5e-6f);
+}
+
+TEST(FastMath, SinCos)
+{
+    auto maxError = 0.0;
+    for (auto x = -8192.0; x <= 8192.0; x += 0.0137)
+    {
+        const auto f = static_cast<float>(x);
+        const auto sc = jg::fast::SinCos(f);
+        maxError = std::max(maxError, std::abs(sc.sin - std::sin(static_cast<double>(f))));
+        maxError = std::max(maxError, std::abs(sc.cos - std::cos(static_cast<double>(f))));
+    }
+    EXPECT_LE(maxError, 2e-7);
+
+    const auto rot = jg::fast::Rotation2D(0.5f * jg::HALF_PI);
+    const auto precise = jg::Mat3f::Rotation2D(0.5f * jg::HALF_PI);
+    for (auto i = 0; i < 9; ++i)
+        EXPECT_NEAR(rot.data[i], precise.data[i], 2e-7f);
+}
+
+TEST(FastMath, Atan2)
+{
+    auto maxError = 0.0;
+    for (auto a = -3.14; a <= 3.14; a += 0.0003)
+    {
+        for (const auto radius : { 1e-3, 1.0, 1e4 })
+        {
+            const auto y = static_cast<float>(radius * std::sin(a));
+            const auto x = static_cast<float>(radius * std::cos(a));
+            maxError = std::max(maxError,
+                std::abs(jg::fast::Atan2(y, x) - std::atan2(static_cast<double>(y), static_cast<double>(x))));
+        }
+    }
+    EXPECT_LE(maxError, 5e-7);
+
+    EXPECT_FLOAT_EQ(jg::fast::Atan2(0.0f, 0.0f), 0.0f);
+    EXPECT_NEAR(jg::fast::Atan2(1.0f, 0.0f), jg::HALF_PI, 5e-7f);
+    EXPECT_NEAR(jg::fast::Atan2(0.0f, -1.0f), jg::PI, 5e-7f);
+    EXPECT_NEAR(jg::fast::Atan2(-1.0f, -1.0f), -0.75f * jg::PI, 5e-7f);
+}
+
+TEST(FastMath, Exp)
+{
+    auto maxRelError = 0.0;
+    for (auto x = -87.0; x <= 88.0; x += 0.0011)
+    {
+        const auto f = static_cast<float>(x);
+        const auto expected = std::exp(static_cast<double>(f));
+        maxRelError = std::max(maxRelError, std::abs(jg::fast::Exp(f) - expected) / expected);
+    }
+    EXPECT_LE(maxRelError, 3e-7);
+
+    EXPECT_FLOAT_EQ(jg::fast::Exp(0.0f), 1.0f);
+    EXPECT_FLOAT_EQ(jg::fast::Exp(-100.0f), 0.0f);
+    EXPECT_TRUE(std::isinf(jg::fast::Exp(100.0f)));
+}
@@ -0,0 +1,239 @@
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "jangine.h"
+
+TEST(Fixed, Conversions)
+{
+    EXPECT_EQ(jg::fixed{ 1 }.raw, 65536);
+    EXPECT_EQ(jg::fixed{ -3 }.raw, -3 * 65536);
+    EXPECT_EQ(jg::fixed{ 0.5f }.raw, 32768);
+    EXPECT_EQ(jg::fixed{ -0.25 }.raw, -16384);
+    // Half a unit rounds away from zero
+    EXPECT_EQ(jg::fixed{ 1.5 / 65536.0 }.raw, 2);
+    EXPECT_EQ(jg::fixed{ -1.5 / 65536.0 }.raw, -2);
+
+    EXPECT_EQ(static_cast<double>(jg::fixed::FromRaw(98304)), 1.5);
+    EXPECT_EQ(static_cast<int>(jg::fixed{ 2.75 }), 2);
+    EXPECT_EQ(static_cast<int>(jg::fixed{ -2.25 }), -3);
+}
+
+TEST(Fixed, Arithmetic)
+{
+    constexpr jg::fixed a{ 2.5 };
+    constexpr jg::fixed b{ -1.25 };
+    static_assert((a + b).raw == jg::fixed{ 1.25 }.raw);
+    static_assert((a * b).raw == jg::fixed{ -3.125 }.raw);
+    static_assert((a / b).raw == jg::fixed{ -2 }.raw);
+    static_assert((-a).raw == -a.raw);
+    static_assert(b < a && a >= a && a != b);
+
+    // Products round to nearest, quotients truncate
+    EXPECT_EQ((jg::fixed::FromRaw(1) * jg::fixed{ 0.5 }).raw, 1);
+    EXPECT_EQ((jg::fixed::FromRaw(1) * jg::fixed{ 0.25 }).raw, 0);
+    EXPECT_EQ((jg::fixed{ 1 } / jg::fixed{ 3 }).raw, 21845);
+
+    // Addition wraps instead of being undefined
+    EXPECT_EQ((jg::fixed::FromRaw(0x7FFFFFFF) + jg::fixed::FromRaw(1)).raw, static_cast<jg::i32>(0x80000000u));
+}
+
+TEST(Fixed, Sqrt)
+{
+    static_assert(jg::Sqrt(jg::fixed{ 4 }).raw == jg::fixed{ 2 }.raw);
+    EXPECT_EQ(jg::Sqrt(jg::fixed{ 0 }).raw, 0);
+    // The runtime path starts from an f64 estimate; check it against the exact one
+    for (jg::i32 raw : { 1, 2, 3, 65535, 65536, 0x7FFFFFFF, 0x7FFFFFFE, 0x40000000, 0x3FFFFFFF })
+    {
+        const auto x = jg::fixed::FromRaw(raw);
+        const auto root = jg::Sqrt(x).raw;
+        EXPECT_LE(static_cast<jg::u64>(root) * static_cast<jg::u64>(root), static_cast<jg::u64>(raw) << 16) << raw;
+        EXPECT_GT(static_cast<jg::u64>(root + 1) * static_cast<jg::u64>(root + 1), static_cast<jg::u64>(raw) << 16) << raw;
+    }
+    EXPECT_EQ(jg::Sqrt(jg::fixed{ -1 }).raw, 0);
+    // Against the exact root of the quantized input, rounded down
+    for (const auto v : { 0.001, 0.5, 2.0, 3.0, 100.0, 30000.0 })
+    {
+        const auto root = std::sqrt(static_cast<double>(jg::fixed{ v }));
+        const auto actual = static_cast<double>(jg::Sqrt(jg::fixed{ v }));
+        EXPECT_LE(actual, root) << v;
+        EXPECT_GT(actual, root - 1.0 / 65536.0) << v;
+    }
+}
+
+TEST(Fixed, VecOperators)
+{
+    const jg::Vec3fx a{ jg::fixed{ 1 }, jg::fixed{ 2 }, jg::fixed{ 2 } };
+    EXPECT_EQ(jg::Length(a).raw, jg::fixed{ 3 }.raw);
+    EXPECT_EQ(jg::Dot(a, a).raw, jg::fixed{ 9 }.raw);
+    EXPECT_EQ((a - a * jg::fixed{ 0.5 }).z.raw, jg::fixed{ 1 }.raw);
+    const auto n = jg::Normalize(a);
+    EXPECT_NEAR(static_cast<double>(n.x), 1.0 / 3.0, 1e-4);
+    EXPECT_EQ(jg::Max(a, -a).y.raw, a.y.raw);
+}
+
+TEST(Fixed, PackUnpack)
+{
+    std::vector<jg::Vec3f> in;
+    for (int i = 0; i < 29; ++i)
+    {
+        const auto f = static_cast<float>(i);
+        // Includes exact half-unit ties and large magnitudes
+        in.push_back(jg::Vec3f{ (f + 0.5f) / 65536.0f - 7.0f, -1000.25f * f, 12345.678f - (f + 0.5f) / 65536.0f });
+    }
+
+    std::vector<jg::Vec3fx> packed(in.size());
+    std::vector<jg::Vec3f> out(in.size());
+    jg::PackFixed(jg::Span<const jg::Vec3f>{ in }, jg::Span<jg::Vec3fx>{ packed });
+    jg::UnpackFixed(jg::Span<const jg::Vec3fx>{ packed }, jg::Span<jg::Vec3f>{ out });
+
+    for (size_t i = 0; i < in.size(); ++i)
+    {
+        for (size_t k = 0; k < 3; ++k)
+        {
+            EXPECT_EQ(packed[i][k].raw, jg::fixed{ in[i][k] }.raw) << i << " " << k;
+            EXPECT_EQ(out[i][k], static_cast<float>(packed[i][k])) << i << " " << k;
+            EXPECT_NEAR(out[i][k], in[i][k], 1.0f / 65536.0f + 1e-3f * std::abs(in[i][k]) * 1e-3f);
+        }
+    }
+}
+
+TEST(Fixed, Trig)
+{
+    static_assert(jg::Sin(jg::fixed{ 0 }).raw == 0);
+    static_assert(jg::Cos(jg::fixed{ 0 }).raw == jg::fixed::ONE);
+    EXPECT_EQ(jg::Sin(jg::fixed{ jg::cx::PI_F64 / 2 }).raw, jg::fixed::ONE);
+    EXPECT_EQ(jg::Sin(jg::fixed{ -jg::cx::PI_F64 / 2 }).raw, -jg::fixed::ONE);
+
+    // Within two raw units of libm, across several turns in both directions
+    for (int i = -4000; i <= 4000; ++i)
+    {
+        const auto rad = jg::fixed::FromRaw(i * 97 + (i & 7));
+        const auto exact = static_cast<double>(rad);
+        ASSERT_NEAR(static_cast<double>(jg::Sin(rad)), std::sin(exact), 2.0 / 65536.0) << exact;
+        ASSERT_NEAR(static_cast<double>(jg::Cos(rad)), std::cos(exact), 2.0 / 65536.0) << exact;
+    }
+
+    const auto rotation = jg::Mat3fx::Rotation2D(jg::fixed{ jg::cx::PI_F64 / 2 });
+    const auto rotated = rotation * jg::Vec3fx{ jg::fixed{ 1 }, jg::fixed{ 0 }, jg::fixed{ 1 } };
+    EXPECT_EQ(rotated.x.raw, 0);
+    EXPECT_EQ(rotated.y.raw, jg::fixed::ONE);
+}
+
+TEST(Fixed, WideVecOperations)
+{
+    // Rounded once instead of per term: 3 * (1 * 0.5 raw units) is 1.5, not 3 * 0
+    const jg::Vec3fx tiny{ jg::fixed::FromRaw(1) };
+    EXPECT_EQ(jg::Dot(tiny, jg::Vec3fx{ jg::fixed{ 0.5 } }).raw, 2);
+
+    // The sum of squares would overflow 16.16 long before the length does
+    const jg::Vec2fx far{ jg::fixed{ 18000 }, jg::fixed{ -24000 } };
+    EXPECT_EQ(jg::Length(far).raw, jg::fixed{ 30000 }.raw);
+    // -0.8 is -52428.8 raw units; the division truncates
+    EXPECT_EQ(jg::Normalize(far).y.raw, -52428);
+
+    // Four components fit the 64-bit sums too
+    const jg::Vec4fx q{ jg::fixed{ 5000 }, jg::fixed{ -10000 }, jg::fixed{ 10000 }, jg::fixed{ 20000 } };
+    EXPECT_EQ(jg::Length(q).raw, jg::fixed{ 25000 }.raw);
+    EXPECT_EQ(jg::Normalize(q).w.raw, 52428);
+    EXPECT_EQ(jg::Dot(q, jg::Vec4fx{ jg::fixed{ 0.25 } }).raw, jg::fixed{ 6250 }.raw);
+
+    // Out-of-range sums wrap instead of overflowing a signed integer, so this is a constant expression
+    constexpr jg::Vec4fx minimum{ jg::fixed::FromRaw(INT32_MIN) };
+    static_assert(jg::Dot(minimum, minimum).raw == 0);
+    static_assert(jg::Length(minimum).raw == 0);
+}
+
+namespace
+{
+    // Bodies that thrust along a spinning heading under gravity, capped in speed and
+    // bouncing inside a box: exercises every fixed operation and Sin, Cos and Length
+    struct LockstepWorld
+    {
+        std::vector<jg::Vec2fx> position;
+        std::vector<jg::Vec2fx> velocity;
+        std::vector<jg::fixed> angle;
+        std::vector<jg::fixed> spin;
+
+        explicit LockstepWorld(size_t count)
+        {
+            jg::u32 seed = 12345;
+            const auto next = [&seed](int range) {
+                seed = seed * 1664525u + 1013904223u;
+                return jg::fixed::FromRaw(static_cast<jg::i32>(seed >> 8) % (range * jg::fixed::ONE));
+            };
+            for (size_t i = 0; i < count; ++i)
+            {
+                position.push_back(jg::Vec2fx{ next(500), next(500) });
+                velocity.push_back(jg::Vec2fx{ next(20), next(20) });
+                angle.push_back(next(6));
+                spin.push_back(next(4));
+            }
+        }
+
+        void Step()
+        {
+            constexpr jg::fixed dt{ 1.0 / 60.0 };
+            constexpr jg::fixed gravity{ -9.81 };
+            constexpr jg::fixed thrust{ 12 };
+            constexpr jg::fixed maxSpeed{ 80 };
+            constexpr jg::fixed bounds{ 500 };
+            constexpr jg::fixed restitution{ 0.75 };
+
+            for (size_t i = 0; i < position.size(); ++i)
+            {
+                angle[i] += spin[i] * dt;
+                const jg::Vec2fx heading{ jg::Cos(angle[i]), jg::Sin(angle[i]) };
+                auto v = velocity[i] + heading * (thrust * dt);
+                v.y += gravity * dt;
+
+                const auto speed = jg::Length(v);
+                if (speed > maxSpeed)
+                    v = v * (maxSpeed / speed);
+
+                auto p = position[i] + v * dt;
+                for (size_t k = 0; k < 2; ++k)
+                {
+                    if (p[k] > bounds || p[k] < -bounds)
+                    {
+                        p[k] = p[k] > bounds ? bounds : -bounds;
+                        v[k] = -v[k] * restitution;
+                    }
+                }
+                position[i] = p;
+                velocity[i] = v;
+            }
+        }
+
+        // FNV-1a over every raw value
+        jg::u64 Hash() const
+        {
+            jg::u64 hash = 14695981039346656037ull;
+            const auto mix = [&hash](jg::fixed f) {
+                for (int shift = 0; shift < 32; shift += 8)
+                    hash = (hash ^ ((static_cast<jg::u32>(f.raw) >> shift) & 0xFFu)) * 1099511628211ull;
+            };
+            for (size_t i = 0; i < position.size(); ++i)
+            {
+                mix(position[i].x);
+                mix(position[i].y);
+                mix(velocity[i].x);
+                mix(velocity[i].y);
+                mix(angle[i]);
+            }
+            return hash;
+        }
+    };
+}
+
+TEST(Fixed, LockstepGoldenHash)
+{
+    // Two simulated minutes. Any change to fixed rounding, the trig table or the
+    // Vec overloads moves this hash, as would any platform dependence
+    LockstepWorld world{ 256 };
+    for (int step = 0; step < 7200; ++step)
+        world.Step();
+    EXPECT_EQ(world.Hash(), 14527583492121400405ull);
+}
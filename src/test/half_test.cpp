@@ -0,0 +1,106 @@
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "jangine.h"
+
+namespace
+{
+    float Round(float v) { return static_cast<float>(jg::f16{ v }); }
+
+    // Reference conversion through exact arithmetic: every half is representable in f32
+    float HalfToFloatReference(jg::u16 bits)
+    {
+        const auto sign = (bits & 0x8000) ? -1.0f : 1.0f;
+        const auto exponent = (bits >> 10) & 0x1F;
+        const auto mantissa = bits & 0x3FF;
+        if (exponent == 0)
+            return sign * std::ldexp(static_cast<float>(mantissa), -24);
+        if (exponent == 31)
+            return mantissa ? std::numeric_limits<float>::quiet_NaN() : sign * std::numeric_limits<float>::infinity();
+        return sign * std::ldexp(static_cast<float>(mantissa | 0x400), exponent - 25);
+    }
+}
+
+TEST(Half, Layout)
+{
+    EXPECT_EQ(sizeof(jg::f16), 2u);
+    EXPECT_EQ(sizeof(jg::Vec3h), 6u);
+    EXPECT_EQ(jg::f16{}.bits, 0u);
+    EXPECT_EQ(jg::f16{ 1.0f }.bits, 0x3C00u);
+    EXPECT_EQ(jg::f16{ -2.0f }.bits, 0xC000u);
+    EXPECT_EQ(jg::f16{ 65504.0f }.bits, 0x7BFFu);
+}
+
+TEST(Half, EveryHalfRoundTrips)
+{
+    for (jg::u32 b = 0; b <= 0xFFFF; ++b)
+    {
+        const auto h = jg::f16::FromBits(static_cast<jg::u16>(b));
+        const auto f = static_cast<float>(h);
+        const auto expected = HalfToFloatReference(static_cast<jg::u16>(b));
+        if (std::isnan(expected))
+        {
+            ASSERT_TRUE(std::isnan(f)) << b;
+            continue;
+        }
+        ASSERT_EQ(f, expected) << b;
+        ASSERT_EQ(jg::f16{ f }.bits, b) << b;
+    }
+}
+
+TEST(Half, RoundsToNearestEven)
+{
+    // 1 + 2^-11 is halfway between 1 and the next half; ties go to the even mantissa
+    EXPECT_EQ(Round(1.0f + std::ldexp(1.0f, -11)), 1.0f);
+    EXPECT_EQ(Round(1.0f + 3.0f * std::ldexp(1.0f, -11)), 1.0f + std::ldexp(1.0f, -9));
+    EXPECT_EQ(Round(1.0f + std::ldexp(1.0f, -11) + std::ldexp(1.0f, -20)), 1.0f + std::ldexp(1.0f, -10));
+
+    // Subnormals, overflow, infinities and NaN
+    EXPECT_EQ(jg::f16{ std::ldexp(1.0f, -24) }.bits, 0x0001u);
+    EXPECT_EQ(jg::f16{ std::ldexp(1.0f, -26) }.bits, 0x0000u);
+    EXPECT_EQ(jg::f16{ 65520.0f }.bits, 0x7C00u);
+    EXPECT_EQ(jg::f16{ -1e10f }.bits, 0xFC00u);
+    EXPECT_EQ(jg::f16{ std::numeric_limits<float>::infinity() }.bits, 0x7C00u);
+    EXPECT_TRUE(std::isnan(static_cast<float>(jg::f16{ std::numeric_limits<float>::quiet_NaN() })));
+    EXPECT_EQ(jg::f16{ -0.0f }.bits, 0x8000u);
+}
+
+TEST(Half, VecOperators)
+{
+    const jg::Vec3h a{ jg::f16{ 1.0f }, jg::f16{ 2.0f }, jg::f16{ 3.0f } };
+    const jg::Vec3h b{ jg::f16{ 0.5f } };
+    const auto sum = a + b;
+    EXPECT_EQ(static_cast<float>(sum.z), 3.5f);
+    EXPECT_EQ(static_cast<float>((a * jg::f16{ 2.0f }).y), 4.0f);
+    EXPECT_EQ(static_cast<float>(jg::Dot(a, b)), 3.0f);
+    EXPECT_EQ(static_cast<float>((-a).x), -1.0f);
+    EXPECT_NEAR(static_cast<float>(jg::Length(a)), std::sqrt(14.0f), 4e-3f);
+    EXPECT_TRUE(jg::f16{ 1.0f } < jg::f16{ 1.5f });
+    EXPECT_TRUE(jg::f16{ 0.0f } == -jg::f16{ 0.0f });
+}
+
+TEST(Half, PackUnpack)
+{
+    // Odd count so the scalar tail runs after the SIMD loops
+    std::vector<jg::Vec3f> in;
+    for (int i = 0; i < 37; ++i)
+        in.push_back(jg::Vec3f{ 0.37f * static_cast<float>(i) - 5.0f, 1000.0f / static_cast<float>(i + 1), -1e-6f * static_cast<float>(i) });
+
+    std::vector<jg::Vec3h> packed(in.size());
+    std::vector<jg::Vec3f> out(in.size());
+    jg::PackHalf(jg::Span<const jg::Vec3f>{ in }, jg::Span<jg::Vec3h>{ packed });
+    jg::UnpackHalf(jg::Span<const jg::Vec3h>{ packed }, jg::Span<jg::Vec3f>{ out });
+
+    for (size_t i = 0; i < in.size(); ++i)
+    {
+        for (size_t k = 0; k < 3; ++k)
+        {
+            EXPECT_EQ(packed[i][k].bits, jg::f16{ in[i][k] }.bits) << i << " " << k;
+            EXPECT_EQ(out[i][k], Round(in[i][k])) << i << " " << k;
+        }
+    }
+}
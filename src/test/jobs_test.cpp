@@ -0,0 +1,165 @@
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "jangine.h"
+
+namespace
+{
+    jg::Mat3f MakeTransform(size_t i)
+    {
+        const auto f = static_cast<float>(i);
+        return jg::Mat3f::Translation2D(f, -f) * jg::Mat3f::Rotation2D(0.01f * f);
+    }
+
+    // Same arithmetic on every path, so results must match bit for bit
+    void ExpectSame(const jg::Mat3f& a, const jg::Mat3f& b)
+    {
+        for (size_t k = 0; k < 9; ++k)
+            EXPECT_EQ(a.data[k], b.data[k]);
+    }
+
+    // Sums [begin, end) by forking halves until ranges are small
+    long long ForkJoinSum(jg::jobs::ThreadPool& pool, long long begin, long long end)
+    {
+        if (end - begin <= 64)
+        {
+            long long sum = 0;
+            for (auto i = begin; i < end; ++i)
+                sum += i;
+            return sum;
+        }
+        const auto mid = begin + (end - begin) / 2;
+        long long left = 0;
+        jg::jobs::TaskGroup group;
+        pool.Run(group, [&] { left = ForkJoinSum(pool, begin, mid); });
+        const auto right = ForkJoinSum(pool, mid, end);
+        pool.Wait(group);
+        return left + right;
+    }
+}
+
+TEST(ThreadPool, RunsEveryTask)
+{
+    for (const size_t threads : { 1u, 2u, 4u })
+    {
+        jg::jobs::ThreadPool pool{ threads };
+        EXPECT_EQ(pool.ThreadCount(), threads);
+
+        std::atomic<int> counter{ 0 };
+        jg::jobs::TaskGroup group;
+        for (int i = 0; i < 1000; ++i)
+            pool.Run(group, [&] { counter.fetch_add(1, std::memory_order_relaxed); });
+        pool.Wait(group);
+        EXPECT_TRUE(group.Done());
+        EXPECT_EQ(counter.load(), 1000);
+    }
+}
+
+TEST(ThreadPool, NestedForkJoin)
+{
+    jg::jobs::ThreadPool pool{ 4 };
+    EXPECT_EQ(ForkJoinSum(pool, 0, 100000), 100000ll * 99999ll / 2);
+}
+
+TEST(ThreadPool, WaitOnEmptyGroup)
+{
+    jg::jobs::ThreadPool pool{ 2 };
+    jg::jobs::TaskGroup group;
+    pool.Wait(group);
+    EXPECT_TRUE(group.Done());
+}
+
+TEST(ThreadPool, RethrowsFirstException)
+{
+    for (const size_t threads : { 1u, 4u })
+    {
+        jg::jobs::ThreadPool pool{ threads };
+        std::atomic<int> counter{ 0 };
+        jg::jobs::TaskGroup group;
+        for (int i = 0; i < 100; ++i)
+        {
+            pool.Run(group, [&, i] {
+                counter.fetch_add(1, std::memory_order_relaxed);
+                if (i % 10 == 3)
+                    throw std::runtime_error{ "task failed" };
+            });
+        }
+        EXPECT_THROW(pool.Wait(group), std::runtime_error);
+        // The failing tasks do not cancel the others
+        EXPECT_TRUE(group.Done());
+        EXPECT_EQ(counter.load(), 100);
+
+        // The exception is consumed, so the group can be reused
+        pool.Run(group, [&] { counter.fetch_add(1, std::memory_order_relaxed); });
+        pool.Wait(group);
+        EXPECT_EQ(counter.load(), 101);
+    }
+}
+
+TEST(ThreadPool, NestedExceptionReachesOuterWait)
+{
+    jg::jobs::ThreadPool pool{ 4 };
+    jg::jobs::TaskGroup outer;
+    pool.Run(outer, [&] {
+        jg::jobs::TaskGroup inner;
+        pool.Run(inner, [] { throw std::logic_error{ "inner" }; });
+        pool.Wait(inner);
+    });
+    EXPECT_THROW(pool.Wait(outer), std::logic_error);
+
+    EXPECT_THROW(jg::jobs::ParallelFor(pool, 0, 1000, 10, [](size_t first, size_t) {
+        if (first == 500)
+            throw std::runtime_error{ "chunk failed" };
+    }), std::runtime_error);
+}
+
+TEST(ParallelFor, CoversRangeOnce)
+{
+    jg::jobs::ThreadPool pool{ 4 };
+    for (const size_t grain : { 0u, 1u, 7u, 1000u, 5000u })
+    {
+        std::vector<int> hits(3000, 0);
+        jg::jobs::ParallelFor(pool, 10, hits.size(), grain, [&](size_t first, size_t last) {
+            EXPECT_LT(first, last);
+            for (auto i = first; i < last; ++i)
+                ++hits[i];
+        });
+        for (size_t i = 0; i < hits.size(); ++i)
+            ASSERT_EQ(hits[i], i < 10 ? 0 : 1) << "grain " << grain << " index " << i;
+    }
+}
+
+TEST(ParallelFor, EmptyRange)
+{
+    jg::jobs::ThreadPool pool{ 2 };
+    auto calls = 0;
+    jg::jobs::ParallelFor(pool, 5, 5, 1, [&](size_t, size_t) { ++calls; });
+    EXPECT_EQ(calls, 0);
+}
+
+TEST(ParallelFor, ComposeTransformsMatchesSerial)
+{
+    constexpr size_t COUNT = 10000;
+    std::vector<jg::Mat3f> parents, locals;
+    for (size_t i = 0; i < COUNT; ++i)
+    {
+        parents.push_back(MakeTransform(i));
+        locals.push_back(MakeTransform(COUNT - i));
+    }
+
+    std::vector<jg::Mat3f> serial(COUNT), parallel(COUNT);
+    jg::ComposeTransforms(jg::Span<const jg::Mat3f>{ parents }, jg::Span<const jg::Mat3f>{ locals }, jg::Span<jg::Mat3f>{ serial });
+
+    jg::jobs::ThreadPool pool{ 3 };
+    jg::jobs::ComposeTransforms(pool, jg::Span<const jg::Mat3f>{ parents }, jg::Span<const jg::Mat3f>{ locals },
+                                jg::Span<jg::Mat3f>{ parallel }, 333);
+
+    for (size_t i = 0; i < COUNT; ++i)
+    {
+        ExpectSame(serial[i], parents[i] * locals[i]);
+        ExpectSame(parallel[i], serial[i]);
+    }
+}
@@ -0,0 +1,196 @@
+#include "gtest/gtest.h"
+
+#include "jangine.h"
+
+namespace
+{
+    // Diagonally dominant, so well conditioned and invertible
+    template <typename T, size_t N>
+    jg::Mat<T, N, N> MakeGeneral(size_t seed)
+    {
+        jg::Mat<T, N, N> m;
+        for (size_t j = 0; j < N; ++j)
+            for (size_t i = 0; i < N; ++i)
+                m.data[j * N + i] = static_cast<T>(static_cast<int>((seed + i * 7 + j * 13) % 17) - 8) / static_cast<T>(4)
+                                  + (i == j ? static_cast<T>(N) : T{});
+        return m;
+    }
+
+    // A^T * A + I is symmetric positive definite
+    template <typename T, size_t N>
+    jg::Mat<T, N, N> MakeSpd(size_t seed)
+    {
+        const auto a = MakeGeneral<T, N>(seed);
+        auto m = jg::Transpose(a) * a;
+        for (size_t i = 0; i < N; ++i)
+            m.data[i * N + i] += static_cast<T>(1);
+        return m;
+    }
+
+    template <typename T, size_t N>
+    jg::Vec<T, N> MakeVec(size_t seed)
+    {
+        jg::Vec<T, N> v{ T{} };
+        for (size_t i = 0; i < N; ++i)
+            v[i] = static_cast<T>(static_cast<int>((seed + i * 5) % 9) - 4);
+        return v;
+    }
+
+    template <typename T, size_t M, size_t N>
+    void ExpectNear(const jg::Vec<T, M>& a, const jg::Vec<T, M>& b, T tolerance)
+    {
+        for (size_t i = 0; i < M; ++i)
+            EXPECT_NEAR(a[i], b[i], tolerance) << "index " << i;
+    }
+
+    template <typename T, size_t N>
+    void CheckSolvers(T tolerance)
+    {
+        const auto a = MakeGeneral<T, N>(3);
+        const auto x = MakeVec<T, N>(1);
+        const auto b = a * x;
+
+        const auto lu = jg::DecomposeLU(a);
+        ASSERT_TRUE(lu.has_value());
+        ExpectNear<T, N, N>(jg::Solve(*lu, b), x, tolerance);
+
+        const auto direct = jg::Solve(a, b);
+        ASSERT_TRUE(direct.has_value());
+        ExpectNear<T, N, N>(*direct, x, tolerance);
+
+        const auto qr = jg::DecomposeQR(a);
+        ASSERT_TRUE(qr.has_value());
+        ExpectNear<T, N, N>(jg::Solve(*qr, b), x, tolerance);
+
+        const auto spd = MakeSpd<T, N>(5);
+        const auto chol = jg::DecomposeCholesky(spd);
+        ASSERT_TRUE(chol.has_value());
+        ExpectNear<T, N, N>(jg::Solve(*chol, spd * x), x, tolerance * static_cast<T>(N));
+
+        // L * L^T reproduces the input
+        const auto llt = chol->l * jg::Transpose(chol->l);
+        for (size_t i = 0; i < N * N; ++i)
+            EXPECT_NEAR(llt.data[i], spd.data[i], tolerance * static_cast<T>(N * N));
+    }
+}
+
+TEST(LinAlg, SolveSmallAndLarge)
+{
+    CheckSolvers<float, 2>(1e-4f);
+    CheckSolvers<float, 6>(1e-4f);
+    CheckSolvers<float, 12>(1e-3f);
+    CheckSolvers<double, 6>(1e-10);
+    CheckSolvers<double, 12>(1e-10);
+}
+
+TEST(LinAlg, PivotingHandlesZeroDiagonal)
+{
+    // Needs a row swap on the first step
+    const jg::Mat<double, 3, 3> a{
+        0.0, 1.0, 2.0,
+        1.0, 0.0, 3.0,
+        4.0, -3.0, 8.0
+    };
+    const jg::Vec<double, 3> x{ 1.0, -2.0, 0.5 };
+    const auto solved = jg::Solve(a, a * x);
+    ASSERT_TRUE(solved.has_value());
+    ExpectNear<double, 3, 3>(*solved, x, 1e-12);
+}
+
+TEST(LinAlg, Determinant)
+{
+    // Generic path agrees with the closed-form 3x3 and 4x4 overloads
+    const auto m3 = MakeGeneral<double, 3>(2);
+    const auto m4 = MakeGeneral<double, 4>(4);
+    EXPECT_NEAR(jg::Determinant(*jg::DecomposeLU(m3)), jg::Determinant(m3), 1e-9);
+    EXPECT_NEAR(jg::Determinant(*jg::DecomposeLU(m4)), jg::Determinant(m4), 1e-9);
+
+    jg::Mat<double, 5, 5> diag;
+    for (size_t i = 0; i < 5; ++i)
+        diag.data[i * 5 + i] = static_cast<double>(i + 1);
+    EXPECT_NEAR(jg::Determinant(diag), 120.0, 1e-9);
+
+    // Swapping two rows flips the sign
+    auto swapped = diag;
+    swapped.data[0] = 0.0;
+    swapped.data[1] = 1.0;
+    swapped.data[6] = 0.0;
+    swapped.data[5] = 2.0;
+    EXPECT_NEAR(jg::Determinant(swapped), -120.0, 1e-9);
+
+    jg::Mat<double, 5, 5> zero;
+    EXPECT_EQ(jg::Determinant(zero), 0.0);
+}
+
+TEST(LinAlg, Inverse)
+{
+    const auto a = MakeGeneral<float, 6>(7);
+    const auto inv = jg::TryInverse(a);
+    ASSERT_TRUE(inv.has_value());
+    const auto identity = a * *inv;
+    for (size_t j = 0; j < 6; ++j)
+        for (size_t i = 0; i < 6; ++i)
+            EXPECT_NEAR(identity.data[j * 6 + i], i == j ? 1.0f : 0.0f, 1e-5f);
+
+    const auto inv2 = jg::Inverse(a);
+    for (size_t i = 0; i < 36; ++i)
+        EXPECT_FLOAT_EQ(inv2.data[i], inv->data[i]);
+}
+
+TEST(LinAlg, ReportsFailure)
+{
+    // Rank 1
+    jg::Mat<float, 6, 6> singular;
+    for (size_t j = 0; j < 6; ++j)
+        for (size_t i = 0; i < 6; ++i)
+            singular.data[j * 6 + i] = static_cast<float>((i + 1) * (j + 1));
+    EXPECT_FALSE(jg::DecomposeLU(singular).has_value());
+    EXPECT_FALSE(jg::TryInverse(singular).has_value());
+    EXPECT_FALSE(jg::Solve(singular, MakeVec<float, 6>(0)).has_value());
+    EXPECT_FALSE(jg::DecomposeQR(singular).has_value());
+
+    // Symmetric but indefinite
+    jg::Mat<double, 2, 2> indefinite{ 1.0, 2.0, 2.0, 1.0 };
+    EXPECT_FALSE(jg::DecomposeCholesky(indefinite).has_value());
+    EXPECT_TRUE(jg::DecomposeLU(indefinite).has_value());
+}
+
+TEST(LinAlg, LeastSquares)
+{
+    // Fit y = 2 + 3x through points that lie exactly on the line
+    jg::Mat<double, 5, 2> a;
+    jg::Vec<double, 5> y{ 0.0 };
+    for (size_t i = 0; i < 5; ++i)
+    {
+        a.data[i] = 1.0;
+        a.data[5 + i] = static_cast<double>(i);
+        y[i] = 2.0 + 3.0 * static_cast<double>(i);
+    }
+    const auto qr = jg::DecomposeQR(a);
+    ASSERT_TRUE(qr.has_value());
+    const auto coeffs = jg::Solve(*qr, y);
+    EXPECT_NEAR(coeffs[0], 2.0, 1e-12);
+    EXPECT_NEAR(coeffs[1], 3.0, 1e-12);
+
+    // Off-line points: residual is orthogonal to the columns of A
+    y[2] += 1.0;
+    const auto fit = jg::Solve(*qr, y);
+    auto r0 = 0.0, r1 = 0.0;
+    for (size_t i = 0; i < 5; ++i)
+    {
+        const auto residual = y[i] - (fit[0] + fit[1] * static_cast<double>(i));
+        r0 += residual;
+        r1 += residual * static_cast<double>(i);
+    }
+    EXPECT_NEAR(r0, 0.0, 1e-12);
+    EXPECT_NEAR(r1, 0.0, 1e-12);
+}
+
+TEST(LinAlg, Constexpr)
+{
+    constexpr jg::Mat<double, 2, 2> a{ 4.0, 2.0, 2.0, 3.0 };
+    constexpr auto det = jg::Determinant(*jg::DecomposeLU(a));
+    static_assert(det > 7.999 && det < 8.001);
+    constexpr auto x = jg::Solve(*jg::DecomposeCholesky(a), jg::Vec<double, 2>{ 8.0, 7.0 });
+    static_assert(x.x > 1.249 && x.x < 1.251 && x.y > 1.499 && x.y < 1.501);
+}
@@ -17,6 +17,15 @@ TEST(Matrix, General)
     EXPECT_FLOAT_EQ(a[0][1], 3.0f);
     EXPECT_FLOAT_EQ(a[1][0], 0.0f);
 
+    // Const operator[] refers into the matrix; Column() copies
+    const auto& ca = a;
+    EXPECT_EQ(&ca[1], &a.col[1]);
+    EXPECT_FLOAT_EQ(ca.Column(0).y, 3.0f);
+    const auto t = jg::Mat4f::Translation3D(1.0f, 2.0f, 3.0f);
+    EXPECT_EQ(&t[3].z, &t.m23);
+    EXPECT_FLOAT_EQ(t.Column(3).y, 2.0f);
+    EXPECT_FLOAT_EQ(jg::Mat3f::Scale2D(4.0f, 5.0f).Column(1)[1], 5.0f);
+
     constexpr jg::Mat<float, 2, 3> b;
     for (auto i = 0; i < 6; ++i)
         EXPECT_FLOAT_EQ(b.data[i], 0.0f);
@@ -75,6 +84,54 @@ TEST(Matrix, General)
     EXPECT_FLOAT_EQ(out3[0][1], 1.0f);
 }
 
+namespace
+{
+    // The plain triple loop the blocked kernel replaced
+    template <typename T, size_t M, size_t N, size_t K>
+    jg::Mat<T, M, K> ReferenceMultiply(const jg::Mat<T, M, N>& lhs, const jg::Mat<T, N, K>& rhs)
+    {
+        jg::Mat<T, M, K> ret;
+        for (size_t i = 0; i < K; ++i)
+            for (size_t j = 0; j < M; ++j)
+                for (size_t k = 0; k < N; ++k)
+                    ret.data[i * M + j] += lhs.data[k * M + j] * rhs.data[i * N + k];
+        return ret;
+    }
+
+    template <typename T, size_t M, size_t N, size_t K>
+    void CheckBlockedMultiply()
+    {
+        jg::Mat<T, M, N> lhs;
+        jg::Mat<T, N, K> rhs;
+        for (size_t i = 0; i < M * N; ++i)
+            lhs.data[i] = static_cast<T>(static_cast<int>(i * 7 % 11) - 5);
+        for (size_t i = 0; i < N * K; ++i)
+            rhs.data[i] = static_cast<T>(static_cast<int>(i * 5 % 13) - 6);
+
+        // Small integers, so every path must be exact
+        const auto expected = ReferenceMultiply(lhs, rhs);
+        const auto actual = lhs * rhs;
+        for (size_t i = 0; i < M * K; ++i)
+            EXPECT_EQ(actual.data[i], expected.data[i]) << M << "x" << N << " * " << N << "x" << K << " element " << i;
+    }
+}
+
+TEST(Matrix, BlockedMultiply)
+{
+    CheckBlockedMultiply<float, 2, 3, 2>();
+    CheckBlockedMultiply<float, 5, 5, 5>();
+    CheckBlockedMultiply<float, 7, 3, 9>();
+    CheckBlockedMultiply<float, 8, 8, 8>();
+    CheckBlockedMultiply<float, 13, 6, 11>();
+    CheckBlockedMultiply<float, 16, 16, 16>();
+    CheckBlockedMultiply<float, 16, 4, 1>();
+    CheckBlockedMultiply<double, 3, 5, 7>();
+    CheckBlockedMultiply<double, 9, 9, 9>();
+    CheckBlockedMultiply<double, 16, 16, 16>();
+    CheckBlockedMultiply<int, 6, 6, 6>();
+    CheckBlockedMultiply<int, 12, 7, 3>();
+}
+
 TEST(Matrix, Transpose)
 {
     jg::Mat<float, 5, 5> m1{
@@ -113,6 +170,34 @@ TEST(Matrix, Transpose)
     EXPECT_FLOAT_EQ(transposed[4][4], 25.0f);
 }
 
+TEST(Matrix, Mat4Multiply)
+{
+    // Compare the f32 4x4 path against the generic f64 implementation
+    jg::Mat<float, 4, 4> a;
+    jg::Mat<double, 4, 4> ad;
+    jg::Mat<float, 4, 4> b;
+    jg::Mat<double, 4, 4> bd;
+    for (auto i = 0; i < 16; ++i)
+    {
+        a.data[i] = static_cast<float>(i) - 7.0f;
+        ad.data[i] = static_cast<double>(i) - 7.0;
+        b.data[i] = 0.5f * static_cast<float>(i % 5) + 1.0f;
+        bd.data[i] = 0.5 * static_cast<double>(i % 5) + 1.0;
+    }
+
+    const auto out = a * b;
+    const auto outd = ad * bd;
+    for (auto i = 0; i < 16; ++i)
+        EXPECT_FLOAT_EQ(out.data[i], static_cast<float>(outd.data[i]));
+
+    const jg::Vec4f v{ 1.0f, -2.0f, 3.0f, 0.5f };
+    const jg::Vec<double, 4> vd{ 1.0, -2.0, 3.0, 0.5 };
+    const auto vOut = a * v;
+    const auto vOutd = ad * vd;
+    for (auto i = 0; i < 4; ++i)
+        EXPECT_FLOAT_EQ(vOut[i], static_cast<float>(vOutd[i]));
+}
+
 class Mat3 : public ::testing::Test
 {
 protected:
@@ -312,3 +397,164 @@ TEST_F(Mat3, Inverse)
         0.0f, 1.0f, 0.0f,
         -3.0f, -1.0f, 1.0f);
 }
+
+
+
+class Mat4 : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m1 = jg::Mat4f{
+            2.0f, 0.0f, 1.0f, 0.0f,
+            1.0f, 3.0f, 0.0f, 0.0f,
+            0.0f, 1.0f, 4.0f, 0.0f,
+            5.0f, -2.0f, 3.0f, 1.0f
+        };
+        m2 = jg::Mat4f{
+            1.0f, 2.0f, 0.0f, 1.0f,
+            0.0f, 1.0f, 3.0f, 2.0f,
+            4.0f, 0.0f, 1.0f, 0.0f,
+            2.0f, 1.0f, 0.0f, 3.0f
+        };
+    }
+
+    jg::Mat4f m1, m2;
+
+    void CheckMatNear(const jg::Mat4f& a, const jg::Mat4f& b, float tolerance = 1e-5f)
+    {
+        for (auto i = 0; i < 4; ++i)
+            for (auto j = 0; j < 4; ++j)
+                EXPECT_NEAR(a[i][j], b[i][j], tolerance) << "column " << i << ", row " << j;
+    }
+};
+
+TEST_F(Mat4, Constructors)
+{
+    constexpr jg::Mat4f a;
+    for (auto i = 0; i < 16; ++i)
+        EXPECT_FLOAT_EQ(a.data[i], 0.0f);
+
+    EXPECT_FLOAT_EQ(m1.m00, 2.0f);
+    EXPECT_FLOAT_EQ(m1.m20, 1.0f);
+    EXPECT_FLOAT_EQ(m1.m01, 1.0f);
+    EXPECT_FLOAT_EQ(m1.m13, -2.0f);
+    EXPECT_FLOAT_EQ(m1[3][2], 3.0f);
+    EXPECT_FLOAT_EQ(m1.data[12], 5.0f);
+
+    const jg::Mat4f c{ m1[3], m1[2], m1[1], m1[0] };
+    EXPECT_FLOAT_EQ(c.m00, 5.0f);
+    EXPECT_FLOAT_EQ(c.m33, 0.0f);
+    EXPECT_FLOAT_EQ(c.m03, 2.0f);
+}
+
+TEST_F(Mat4, HomogenousMatrix)
+{
+    constexpr auto iden = jg::Mat4f::Identity();
+    for (auto i = 0; i < 4; ++i)
+        for (auto j = 0; j < 4; ++j)
+            EXPECT_FLOAT_EQ(iden[i][j], i == j ? 1.0f : 0.0f);
+
+    constexpr auto tran = jg::Mat4f::Translation3D(1.0f, 2.0f, 3.0f);
+    const auto p = tran * jg::Vec4f{ 1.0f, 1.0f, 1.0f, 1.0f };
+    EXPECT_FLOAT_EQ(p.x, 2.0f);
+    EXPECT_FLOAT_EQ(p.y, 3.0f);
+    EXPECT_FLOAT_EQ(p.z, 4.0f);
+    EXPECT_FLOAT_EQ(p.w, 1.0f);
+
+    constexpr auto scale = jg::Mat4f::Scale3D(2.0f, -1.0f, 0.5f);
+    const auto s = scale * jg::Vec4f{ 1.0f, 1.0f, 1.0f, 1.0f };
+    EXPECT_FLOAT_EQ(s.x, 2.0f);
+    EXPECT_FLOAT_EQ(s.y, -1.0f);
+    EXPECT_FLOAT_EQ(s.z, 0.5f);
+    EXPECT_FLOAT_EQ(s.w, 1.0f);
+
+    // Quarter turns
+    const auto rx = jg::Mat4f::RotationX(jg::HALF_PI) * jg::Vec4f{ 0.0f, 1.0f, 0.0f, 0.0f };
+    EXPECT_NEAR(rx.y, 0.0f, 1e-6f);
+    EXPECT_NEAR(rx.z, 1.0f, 1e-6f);
+    const auto ry = jg::Mat4f::RotationY(jg::HALF_PI) * jg::Vec4f{ 0.0f, 0.0f, 1.0f, 0.0f };
+    EXPECT_NEAR(ry.z, 0.0f, 1e-6f);
+    EXPECT_NEAR(ry.x, 1.0f, 1e-6f);
+    const auto rz = jg::Mat4f::RotationZ(jg::HALF_PI) * jg::Vec4f{ 1.0f, 0.0f, 0.0f, 0.0f };
+    EXPECT_NEAR(rz.x, 0.0f, 1e-6f);
+    EXPECT_NEAR(rz.y, 1.0f, 1e-6f);
+
+    constexpr auto ortho = jg::Mat4f::Orthographic(0.0f, 800.0f, 0.0f, 600.0f, -1.0f, 1.0f);
+    const auto corner = ortho * jg::Vec4f{ 800.0f, 600.0f, 0.0f, 1.0f };
+    EXPECT_FLOAT_EQ(corner.x, 1.0f);
+    EXPECT_FLOAT_EQ(corner.y, 1.0f);
+    const auto origin = ortho * jg::Vec4f{ 0.0f, 0.0f, 0.0f, 1.0f };
+    EXPECT_FLOAT_EQ(origin.x, -1.0f);
+    EXPECT_FLOAT_EQ(origin.y, -1.0f);
+}
+
+TEST_F(Mat4, BasicOperations)
+{
+    const auto neg = -m1;
+    for (auto i = 0; i < 16; ++i)
+        EXPECT_FLOAT_EQ(neg.data[i], -m1.data[i]);
+
+    const auto sum = m1 + m2;
+    const auto diff = m1 - m2;
+    for (auto i = 0; i < 16; ++i)
+    {
+        EXPECT_FLOAT_EQ(sum.data[i], m1.data[i] + m2.data[i]);
+        EXPECT_FLOAT_EQ(diff.data[i], m1.data[i] - m2.data[i]);
+    }
+
+    const auto prod = m1 * m2;
+    EXPECT_FLOAT_EQ(prod[0][0], 9.0f);
+    EXPECT_FLOAT_EQ(prod[0][1], 4.0f);
+    EXPECT_FLOAT_EQ(prod[0][2], 4.0f);
+    EXPECT_FLOAT_EQ(prod[0][3], 1.0f);
+    EXPECT_FLOAT_EQ(prod[3][0], 20.0f);
+    EXPECT_FLOAT_EQ(prod[3][1], -3.0f);
+    EXPECT_FLOAT_EQ(prod[3][2], 11.0f);
+    EXPECT_FLOAT_EQ(prod[3][3], 3.0f);
+
+    // Same product through the generic template
+    constexpr jg::Mat<double, 4, 4> iden = jg::Mat<double, 4, 4>::Identity();
+    const auto dprod = iden * jg::Mat<double, 4, 4>::Translation3D(1.0, 2.0, 3.0);
+    EXPECT_DOUBLE_EQ(dprod.m13, 2.0);
+}
+
+TEST_F(Mat4, Transpose)
+{
+    const auto transposed = jg::Transpose(m2);
+    for (auto i = 0; i < 4; ++i)
+        for (auto j = 0; j < 4; ++j)
+            EXPECT_FLOAT_EQ(transposed[i][j], m2[j][i]);
+}
+
+TEST_F(Mat4, Determinant)
+{
+    EXPECT_FLOAT_EQ(jg::Determinant(jg::Mat4f::Identity()), 1.0f);
+    EXPECT_FLOAT_EQ(jg::Determinant(jg::Mat4f::Scale3D(2.0f, 3.0f, 4.0f)), 24.0f);
+    EXPECT_FLOAT_EQ(jg::Determinant(m1), 25.0f);
+    EXPECT_FLOAT_EQ(jg::Determinant(m2), 67.0f);
+}
+
+TEST_F(Mat4, Inverse)
+{
+    CheckMatNear(jg::Inverse(m1) * m1, jg::Mat4f::Identity());
+    CheckMatNear(m2 * jg::Inverse(m2), jg::Mat4f::Identity());
+
+    const auto ti = jg::Inverse(jg::Mat4f::Translation3D(3.0f, 1.0f, -2.0f));
+    CheckMatNear(ti, jg::Mat4f::Translation3D(-3.0f, -1.0f, 2.0f));
+}
+
+TEST_F(Mat4, AffineInverse)
+{
+    const auto affine = jg::Mat4f::Translation3D(3.0f, -4.0f, 2.0f)
+                      * jg::Mat4f::RotationZ(0.7f)
+                      * jg::Mat4f::RotationX(-0.3f)
+                      * jg::Mat4f::Scale3D(2.0f, 0.5f, 3.0f);
+
+    const auto inv = jg::AffineInverse(affine);
+    CheckMatNear(inv, jg::Inverse(affine));
+    CheckMatNear(inv * affine, jg::Mat4f::Identity());
+
+    // m1 has a shear in its 3x3 block
+    CheckMatNear(jg::AffineInverse(m1), jg::Inverse(m1));
+}
@@ -0,0 +1,117 @@
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <list>
+#include <vector>
+
+#include "jangine.h"
+
+namespace
+{
+    bool IsAligned(const void* p, size_t align) { return reinterpret_cast<std::uintptr_t>(p) % align == 0; }
+}
+
+TEST(Arena, AllocateAndRewind)
+{
+    jg::memory::Arena arena{ 256 };
+    auto* a = arena.Allocate(10, 1);
+    auto* b = arena.Allocate(16, 16);
+    ASSERT_NE(a, nullptr);
+    ASSERT_NE(b, nullptr);
+    EXPECT_TRUE(IsAligned(b, 16));
+    EXPECT_EQ(arena.Used(), 32u);
+
+    const auto marker = arena.GetMarker();
+    const auto floats = arena.AllocateArray<float>(8, 32);
+    EXPECT_EQ(floats.size(), 8u);
+    EXPECT_TRUE(IsAligned(floats.data(), 32));
+    arena.Rewind(marker);
+    EXPECT_EQ(arena.Used(), 32u);
+
+    // Exhaustion fails without disturbing the arena
+    EXPECT_EQ(arena.Allocate(1000), nullptr);
+    EXPECT_TRUE(arena.AllocateArray<double>(100).empty());
+    EXPECT_EQ(arena.Used(), 32u);
+
+    const auto& stats = arena.Stats();
+    EXPECT_EQ(stats.allocations, 3u);
+    EXPECT_EQ(stats.failures, 2u);
+    EXPECT_EQ(stats.peak, 64u);
+    EXPECT_EQ(stats.capacity, 256u);
+
+    arena.Reset();
+    EXPECT_EQ(arena.Used(), 0u);
+    EXPECT_EQ(arena.Stats().peak, 64u);
+}
+
+TEST(FrameArena, ResetsEveryFrame)
+{
+    jg::memory::FrameArena frame{ 1024 };
+    for (size_t f = 1; f <= 4; ++f)
+    {
+        frame.BeginFrame();
+        EXPECT_EQ(frame.Used(), 0u);
+        const auto scratch = frame.AllocateArray<jg::Vec2f>(f * 16);
+        ASSERT_EQ(scratch.size(), f * 16);
+        for (auto& v : scratch)
+            v = jg::Vec2f{ 1.0f, 2.0f };
+    }
+    frame.BeginFrame();
+    EXPECT_EQ(frame.FrameCount(), 5u);
+    EXPECT_EQ(frame.LastFrameUsed(), 64u * sizeof(jg::Vec2f));
+    EXPECT_EQ(frame.PeakFrameUsed(), 64u * sizeof(jg::Vec2f));
+
+    // Containers can draw from the current frame
+    std::vector<int, jg::memory::FrameAllocator<int>> culled{ jg::memory::FrameAllocator<int>{ frame.GetArena() } };
+    for (auto i = 0; i < 50; ++i)
+        culled.push_back(i);
+    EXPECT_EQ(culled[49], 49);
+    EXPECT_GT(frame.Used(), 50u * sizeof(int));
+}
+
+TEST(Pool, AllocateAndFree)
+{
+    jg::memory::Pool pool{ 24, 4, 16 };
+    EXPECT_EQ(pool.BlockSize(), 32u);
+
+    void* blocks[4];
+    for (auto& b : blocks)
+    {
+        b = pool.Allocate();
+        ASSERT_NE(b, nullptr);
+        EXPECT_TRUE(IsAligned(b, 16));
+        EXPECT_TRUE(pool.Owns(b));
+    }
+    EXPECT_EQ(pool.Allocate(), nullptr);
+    EXPECT_EQ(pool.BlocksInUse(), 4u);
+
+    pool.Free(blocks[2]);
+    pool.Free(blocks[0]);
+    EXPECT_EQ(pool.BlocksInUse(), 2u);
+    // Most recently freed block is reused first
+    EXPECT_EQ(pool.Allocate(), blocks[0]);
+
+    const auto& stats = pool.Stats();
+    EXPECT_EQ(stats.allocations, 5u);
+    EXPECT_EQ(stats.failures, 1u);
+    EXPECT_EQ(stats.peak, 4u * 32u);
+    EXPECT_EQ(stats.used, 3u * 32u);
+
+    int local = 0;
+    EXPECT_FALSE(pool.Owns(&local));
+}
+
+TEST(Pool, StdAllocator)
+{
+    jg::memory::Pool pool{ 64, 8 };
+    {
+        std::list<jg::Vec3f, jg::memory::PoolAllocator<jg::Vec3f>> nodes{ jg::memory::PoolAllocator<jg::Vec3f>{ pool } };
+        for (auto i = 0; i < 12; ++i)
+            nodes.push_back(jg::Vec3f{ static_cast<float>(i) });
+        // The first 8 nodes come from the pool, the rest overflow to the heap
+        EXPECT_EQ(pool.BlocksInUse(), 8u);
+        EXPECT_EQ(nodes.back().z, 11.0f);
+    }
+    EXPECT_EQ(pool.BlocksInUse(), 0u);
+    EXPECT_EQ(pool.Stats().peak, 8u * pool.BlockSize());
+}
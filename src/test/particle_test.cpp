@@ -0,0 +1,178 @@
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "jangine.h"
+
+namespace
+{
+    constexpr float DT = 1.0f / 60.0f;
+
+    // 7 particles, so both the 4-wide loop and the scalar tail run
+    void EmitRow(jg::ParticleSystem& particles, size_t count, const jg::Vec2f& velocity, float lifetime = 100.0f)
+    {
+        for (size_t i = 0; i < count; ++i)
+            ASSERT_TRUE(particles.Emit(jg::Vec2f{ static_cast<float>(i), 0.0f }, velocity, lifetime));
+    }
+}
+
+TEST(ParticleSystem, EulerMatchesClosedForm)
+{
+    jg::ParticleSystem particles{ 16 };
+    particles.SetGravity(jg::Vec2f{ 0.0f, -10.0f });
+    EmitRow(particles, 7, jg::Vec2f{ 2.0f, 5.0f });
+
+    constexpr int STEPS = 60;
+    for (int n = 0; n < STEPS; ++n)
+        particles.Update(DT);
+
+    // Semi-implicit Euler: x_n = x_0 + n * v_0 * dt + g * dt^2 * n * (n + 1) / 2
+    const auto n = static_cast<float>(STEPS);
+    for (size_t i = 0; i < 7; ++i)
+    {
+        EXPECT_NEAR(particles.PositionsX()[i], static_cast<float>(i) + n * 2.0f * DT, 1e-4f);
+        EXPECT_NEAR(particles.PositionsY()[i], n * 5.0f * DT - 10.0f * DT * DT * n * (n + 1.0f) / 2.0f, 1e-4f);
+        EXPECT_NEAR(particles.VelocitiesY()[i], 5.0f - 10.0f * n * DT, 1e-4f);
+    }
+}
+
+TEST(ParticleSystem, VerletIsExactUnderConstantAcceleration)
+{
+    jg::ParticleSystem particles{ 16 };
+    particles.SetIntegrator(jg::Integrator::Verlet);
+    particles.SetGravity(jg::Vec2f{ 0.0f, -10.0f });
+    EmitRow(particles, 7, jg::Vec2f{ 2.0f, 5.0f });
+
+    constexpr int STEPS = 60;
+    for (int n = 0; n < STEPS; ++n)
+        particles.Update(DT);
+
+    const auto t = static_cast<float>(STEPS) * DT;
+    for (size_t i = 0; i < 7; ++i)
+    {
+        EXPECT_NEAR(particles.PositionsX()[i], static_cast<float>(i) + 2.0f * t, 1e-4f);
+        EXPECT_NEAR(particles.PositionsY()[i], 5.0f * t - 5.0f * t * t, 1e-4f);
+        EXPECT_NEAR(particles.VelocitiesY()[i], 5.0f - 10.0f * t, 1e-4f);
+    }
+}
+
+TEST(ParticleSystem, DragDampsVelocity)
+{
+    jg::ParticleSystem particles{ 16 };
+    particles.SetDrag(0.5f);
+    EmitRow(particles, 7, jg::Vec2f{ 4.0f, -2.0f });
+
+    constexpr int STEPS = 120;
+    for (int n = 0; n < STEPS; ++n)
+        particles.Update(DT);
+
+    const auto decay = std::pow(1.0f - 0.5f * DT, static_cast<float>(STEPS));
+    for (size_t i = 0; i < 7; ++i)
+    {
+        EXPECT_NEAR(particles.VelocitiesX()[i], 4.0f * decay, 1e-4f);
+        EXPECT_NEAR(particles.VelocitiesY()[i], -2.0f * decay, 1e-4f);
+    }
+}
+
+TEST(ParticleSystem, ForceFieldsPullWithinTheirRadius)
+{
+    jg::ParticleSystem particles{ 16 };
+    particles.AddForceField(jg::ForceField{ jg::Vec2f{ 0.0f, 0.0f }, 8.0f, 4.0f });
+    particles.AddForceField(jg::ForceField{ jg::Vec2f{ 100.0f, 0.0f }, -8.0f, 4.0f });
+    ASSERT_EQ(particles.ForceFields().size(), 2u);
+
+    ASSERT_TRUE(particles.Emit(jg::Vec2f{ 2.0f, 0.0f }, jg::Vec2f{ 0.0f }, 10.0f)); // Halfway out: 4 toward the centre
+    ASSERT_TRUE(particles.Emit(jg::Vec2f{ 0.0f, -1.0f }, jg::Vec2f{ 0.0f }, 10.0f)); // 6 up
+    ASSERT_TRUE(particles.Emit(jg::Vec2f{ 50.0f, 0.0f }, jg::Vec2f{ 0.0f }, 10.0f)); // Out of reach
+    ASSERT_TRUE(particles.Emit(jg::Vec2f{ 97.0f, 0.0f }, jg::Vec2f{ 0.0f }, 10.0f)); // Pushed away: 2 left
+    ASSERT_TRUE(particles.Emit(jg::Vec2f{ 0.0f, 0.0f }, jg::Vec2f{ 0.0f }, 10.0f)); // At the centre: no direction, no force
+    particles.Update(DT);
+
+    const float expectedVx[] = { -4.0f, 0.0f, 0.0f, -2.0f, 0.0f };
+    const float expectedVy[] = { 0.0f, 6.0f, 0.0f, 0.0f, 0.0f };
+    for (size_t i = 0; i < 5; ++i)
+    {
+        EXPECT_NEAR(particles.VelocitiesX()[i], expectedVx[i] * DT, 1e-6f) << i;
+        EXPECT_NEAR(particles.VelocitiesY()[i], expectedVy[i] * DT, 1e-6f) << i;
+    }
+}
+
+TEST(ParticleSystem, ExpiredParticlesAreSwapRemoved)
+{
+    jg::ParticleSystem particles{ 64 };
+    EXPECT_EQ(particles.Capacity(), 64u);
+    // Lifetime in frames is i % 5, so a fifth of them go each frame
+    for (size_t i = 0; i < 50; ++i)
+        ASSERT_TRUE(particles.Emit(jg::Vec2f{ static_cast<float>(i), 0.0f }, jg::Vec2f{ 0.0f }, (static_cast<float>(i % 5) + 0.5f) * DT));
+
+    particles.Update(DT);
+    EXPECT_EQ(particles.size(), 40u);
+    particles.Update(DT);
+    particles.Update(DT);
+    EXPECT_EQ(particles.size(), 20u);
+
+    // The survivors are exactly the ones with i % 5 >= 3, packed at the front
+    std::vector<int> survivors;
+    for (size_t k = 0; k < particles.size(); ++k)
+    {
+        EXPECT_FLOAT_EQ(particles.Ages()[k], 3.0f * DT);
+        survivors.push_back(static_cast<int>(particles.PositionsX()[k]));
+    }
+    std::sort(survivors.begin(), survivors.end());
+    for (size_t k = 0; k < survivors.size(); ++k)
+        EXPECT_EQ(survivors[k], static_cast<int>(k / 2 * 5 + 3 + k % 2));
+
+    particles.Update(DT);
+    particles.Update(DT);
+    EXPECT_TRUE(particles.empty());
+}
+
+TEST(ParticleSystem, EmitFailsWhenFull)
+{
+    jg::ParticleSystem particles{ 3 };
+    EmitRow(particles, 3, jg::Vec2f{ 0.0f });
+    EXPECT_FALSE(particles.Emit(jg::Vec2f{ 0.0f }, jg::Vec2f{ 0.0f }, 1.0f));
+    EXPECT_EQ(particles.size(), 3u);
+    particles.Clear();
+    EXPECT_TRUE(particles.empty());
+    EXPECT_TRUE(particles.Emit(jg::Vec2f{ 0.0f }, jg::Vec2f{ 0.0f }, 1.0f));
+}
+
+TEST(ParticleSystem, ThreadedUpdateMatchesSerial)
+{
+    constexpr size_t COUNT = 5 * jg::ParticleSystem::UPDATE_GRAIN + 123;
+    jg::ParticleSystem serial{ COUNT };
+    jg::ParticleSystem threaded{ COUNT };
+    for (auto* particles : { &serial, &threaded })
+    {
+        particles->SetIntegrator(jg::Integrator::Verlet);
+        particles->SetGravity(jg::Vec2f{ 0.0f, -9.8f });
+        particles->SetDrag(0.1f);
+        particles->AddForceField(jg::ForceField{ jg::Vec2f{ 50.0f, 50.0f }, 20.0f, 40.0f });
+        for (size_t i = 0; i < COUNT; ++i)
+        {
+            const auto h = static_cast<jg::u32>(i * 2654435761u);
+            particles->Emit(jg::Vec2f{ static_cast<float>(h % 100), static_cast<float>((h >> 8) % 100) },
+                            jg::Vec2f{ static_cast<float>((h >> 16) % 7) - 3.0f, 1.0f }, static_cast<float>(h % 97) * 0.01f);
+        }
+    }
+
+    jg::jobs::ThreadPool pool{ 4 };
+    for (int frame = 0; frame < 30; ++frame)
+    {
+        serial.Update(DT);
+        threaded.Update(pool, DT);
+    }
+
+    ASSERT_EQ(serial.size(), threaded.size());
+    EXPECT_LT(serial.size(), COUNT);
+    for (size_t i = 0; i < serial.size(); ++i)
+    {
+        ASSERT_EQ(serial.PositionsX()[i], threaded.PositionsX()[i]) << i;
+        ASSERT_EQ(serial.PositionsY()[i], threaded.PositionsY()[i]) << i;
+        ASSERT_EQ(serial.VelocitiesX()[i], threaded.VelocitiesX()[i]) << i;
+        ASSERT_EQ(serial.Lifetimes()[i], threaded.Lifetimes()[i]) << i;
+    }
+}
@@ -0,0 +1,265 @@
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <vector>
+
+#include "jangine.h"
+
+namespace
+{
+    using jg::physics::BodyDef;
+    using jg::physics::BodyId;
+    using jg::physics::Pose;
+    using jg::physics::World;
+
+    constexpr float DT = 1.0f / 60.0f;
+
+    Pose At(float x, float y, float angle = 0.0f) { return Pose{ jg::Vec2f{ x, y }, jg::Rotor2f::FromAngle(angle) }; }
+
+    BodyDef Box(float x, float y, float halfWidth, float halfHeight, float density = 1.0f)
+    {
+        BodyDef def;
+        def.shape = jg::physics::MakeBox(halfWidth, halfHeight);
+        def.position = jg::Vec2f{ x, y };
+        def.density = density;
+        return def;
+    }
+
+    BodyId AddGround(World& world) { return world.CreateBody(Box(0.0f, -1.0f, 50.0f, 1.0f, 0.0f)); }
+}
+
+TEST(Physics, ShapeMassProperties)
+{
+    const auto box = jg::physics::ComputeMass(jg::physics::MakeBox(1.0f, 0.5f), 2.0f);
+    EXPECT_NEAR(box.mass, 4.0f, 1e-5f);
+    EXPECT_NEAR(box.inertia, box.mass * (4.0f + 1.0f) / 12.0f, 1e-5f);
+
+    const auto circle = jg::physics::ComputeMass(jg::physics::MakeCircle(2.0f), 1.0f);
+    EXPECT_NEAR(circle.mass, jg::PI * 4.0f, 1e-4f);
+    EXPECT_NEAR(circle.inertia, circle.mass * 2.0f, 1e-4f);
+
+    // Interior and collinear points are dropped
+    const jg::Vec2f points[] = { jg::Vec2f{ 3.0f, 1.0f }, jg::Vec2f{ 4.0f, 2.0f }, jg::Vec2f{ 1.0f, 1.0f },
+                                 jg::Vec2f{ 2.0f, 1.0f }, jg::Vec2f{ 2.0f, 2.0f }, jg::Vec2f{ 1.0f, 3.0f } };
+    const auto hull = jg::physics::MakePolygon(jg::Span<const jg::Vec2f>{ points, 6 });
+    ASSERT_EQ(hull.count, 4u);
+    for (jg::u32 i = 0; i < hull.count; ++i)
+    {
+        const auto& next = hull.vertices[(i + 1) % hull.count];
+        EXPECT_GT(jg::Cross(hull.vertices[i], next), 0.0f); // Counter-clockwise around the origin
+        EXPECT_NEAR(jg::Dot(hull.normals[i], next - hull.vertices[i]), 0.0f, 1e-5f);
+        EXPECT_NEAR(jg::Length(hull.normals[i]), 1.0f, 1e-5f);
+    }
+    const auto poly = jg::physics::ComputeMass(hull, 1.0f);
+    EXPECT_NEAR(poly.mass, 4.0f, 1e-5f);
+}
+
+TEST(Physics, CircleContacts)
+{
+    const auto a = jg::physics::MakeCircle(1.0f);
+    const auto b = jg::physics::MakeCircle(0.5f);
+    auto m = jg::physics::Collide(a, At(0.0f, 0.0f), b, At(1.25f, 0.0f));
+    ASSERT_EQ(m.count, 1u);
+    EXPECT_NEAR(m.normal.x, 1.0f, 1e-6f);
+    EXPECT_NEAR(m.points[0].separation, -0.25f, 1e-6f);
+    EXPECT_NEAR(m.points[0].point.x, 0.875f, 1e-6f);
+    EXPECT_EQ(jg::physics::Collide(a, At(0.0f, 0.0f), b, At(2.0f, 0.0f)).count, 0u);
+
+    // Circle resting on a box face, then beyond its corner
+    const auto box = jg::physics::MakeBox(1.0f, 1.0f);
+    m = jg::physics::Collide(box, At(0.0f, 0.0f), b, At(0.3f, 1.4f));
+    ASSERT_EQ(m.count, 1u);
+    EXPECT_NEAR(m.normal.y, 1.0f, 1e-6f);
+    EXPECT_NEAR(m.points[0].separation, -0.1f, 1e-6f);
+
+    m = jg::physics::Collide(b, At(1.3f, 1.3f), box, At(0.0f, 0.0f));
+    ASSERT_EQ(m.count, 1u);
+    EXPECT_NEAR(m.normal.x, -std::sqrt(0.5f), 1e-5f); // From the circle to the box
+    EXPECT_NEAR(m.normal.y, -std::sqrt(0.5f), 1e-5f);
+    EXPECT_NEAR(m.points[0].separation, std::sqrt(0.18f) - 0.5f, 1e-5f);
+}
+
+TEST(Physics, PolygonContactsClipToTheReferenceFace)
+{
+    const auto ground = jg::physics::MakeBox(5.0f, 1.0f);
+    const auto box = jg::physics::MakeBox(0.5f, 0.5f);
+    const auto m = jg::physics::Collide(ground, At(0.0f, 0.0f), box, At(1.0f, 1.45f));
+    ASSERT_EQ(m.count, 2u);
+    EXPECT_NEAR(m.normal.x, 0.0f, 1e-6f);
+    EXPECT_NEAR(m.normal.y, 1.0f, 1e-6f);
+    EXPECT_NE(m.points[0].id, m.points[1].id);
+    for (jg::u32 i = 0; i < 2; ++i)
+    {
+        EXPECT_NEAR(m.points[i].separation, -0.05f, 1e-5f);
+        EXPECT_NEAR(std::abs(m.points[i].point.x - 1.0f), 0.5f, 1e-5f);
+    }
+
+    // A box balanced on its corner touches at one point
+    const auto corner = jg::physics::Collide(ground, At(0.0f, 0.0f), box, At(0.0f, 1.0f + std::sqrt(0.5f) - 0.01f, 0.25f * jg::PI));
+    ASSERT_EQ(corner.count, 1u);
+    EXPECT_NEAR(corner.points[0].separation, -0.01f, 1e-4f);
+    EXPECT_NEAR(corner.points[0].point.x, 0.0f, 1e-4f);
+
+    // Separated by more than the speculative distance
+    EXPECT_EQ(jg::physics::Collide(ground, At(0.0f, 0.0f), box, At(0.0f, 1.6f)).count, 0u);
+    EXPECT_EQ(jg::physics::Collide(ground, At(0.0f, 0.0f), box, At(6.0f, 1.0f)).count, 0u);
+}
+
+TEST(Physics, FreeFallMatchesSemiImplicitEuler)
+{
+    World world;
+    BodyDef def;
+    def.velocity = jg::Vec2f{ 3.0f, 4.0f };
+    def.angularVelocity = 2.0f;
+    const auto id = world.CreateBody(def);
+
+    constexpr int STEPS = 60;
+    for (int n = 0; n < STEPS; ++n)
+        world.Step(DT);
+
+    const auto n = static_cast<float>(STEPS);
+    EXPECT_NEAR(world.GetPosition(id).x, 3.0f * n * DT, 1e-4f);
+    EXPECT_NEAR(world.GetPosition(id).y, 4.0f * n * DT - 9.8f * DT * DT * n * (n + 1.0f) / 2.0f, 1e-4f);
+    EXPECT_NEAR(world.GetAngle(id), 2.0f, 1e-4f);
+    EXPECT_TRUE(world.Contacts().empty());
+}
+
+TEST(Physics, StackComesToRest)
+{
+    World world;
+    AddGround(world);
+    std::vector<BodyId> boxes;
+    for (int i = 0; i < 10; ++i)
+        boxes.push_back(world.CreateBody(Box(0.0f, 0.5f + static_cast<float>(i) * 1.0f, 0.5f, 0.5f)));
+    auto ball = Box(0.0f, 0.0f, 0.5f, 0.5f);
+    ball.shape = jg::physics::MakeCircle(0.5f);
+    ball.position = jg::Vec2f{ 5.0f, 3.0f };
+    const auto circle = world.CreateBody(ball);
+
+    for (int n = 0; n < 5 * 60; ++n)
+        world.Step(DT);
+
+    for (size_t i = 0; i < boxes.size(); ++i)
+    {
+        EXPECT_NEAR(world.GetPosition(boxes[i]).x, 0.0f, 0.02f) << i;
+        EXPECT_NEAR(world.GetPosition(boxes[i]).y, 0.5f + static_cast<float>(i), 0.05f) << i;
+        EXPECT_NEAR(world.GetAngle(boxes[i]), 0.0f, 0.01f) << i;
+        EXPECT_LT(jg::Length(world.GetVelocity(boxes[i])), 0.05f) << i;
+    }
+    EXPECT_NEAR(world.GetPosition(circle).y, 0.5f, 0.02f);
+    EXPECT_EQ(world.IslandCount(), 2u); // The ball only touches the ground, so it is on its own
+    EXPECT_EQ(world.Contacts().size(), 11u);
+}
+
+TEST(Physics, FrictionStopsASlidingBox)
+{
+    World world;
+    AddGround(world);
+    auto def = Box(0.0f, 0.5f, 0.5f, 0.5f);
+    def.velocity = jg::Vec2f{ 4.0f, 0.0f };
+    def.friction = 0.5f;
+    const auto id = world.CreateBody(def);
+
+    // Ground friction 0.6 mixes to sqrt(0.3): decelerates at mu * g until stopped
+    const auto mu = std::sqrt(0.5f * 0.6f);
+    for (int n = 0; n < 30; ++n)
+        world.Step(DT);
+    EXPECT_NEAR(world.GetVelocity(id).x, 4.0f - mu * 9.8f * 30.0f * DT, 0.05f);
+    for (int n = 0; n < 60; ++n)
+        world.Step(DT);
+    EXPECT_NEAR(world.GetVelocity(id).x, 0.0f, 1e-3f);
+    const auto stop = 4.0f * 4.0f / (2.0f * mu * 9.8f);
+    EXPECT_NEAR(world.GetPosition(id).x, stop, 0.1f);
+    EXPECT_NEAR(world.GetAngle(id), 0.0f, 0.01f);
+}
+
+TEST(Physics, WarmStartingReusesImpulsesByFeature)
+{
+    World world;
+    AddGround(world);
+    const auto id = world.CreateBody(Box(0.0f, 0.5f, 0.5f, 0.5f));
+    for (int n = 0; n < 30; ++n)
+        world.Step(DT);
+
+    // Resting: each of the two points carries half the weight per step
+    ASSERT_EQ(world.Contacts().size(), 1u);
+    const auto& contact = world.Contacts()[0];
+    EXPECT_EQ(contact.bodyA, id);
+    ASSERT_EQ(contact.manifold.count, 2u);
+    const auto weight = 9.8f * DT; // Unit mass
+    EXPECT_NEAR(contact.normalImpulses[0] + contact.normalImpulses[1], weight, 0.01f * weight);
+    EXPECT_NEAR(contact.normalImpulses[0], contact.normalImpulses[1], 0.05f * weight);
+
+    // A single iteration is enough once the impulses carry over
+    world.SetVelocityIterations(1);
+    for (int n = 0; n < 60; ++n)
+        world.Step(DT);
+    EXPECT_NEAR(world.GetPosition(id).y, 0.5f, 0.01f);
+    EXPECT_LT(jg::Length(world.GetVelocity(id)), 1e-3f);
+}
+
+TEST(Physics, DestroyedBodiesLeaveNoContacts)
+{
+    World world;
+    const auto ground = AddGround(world);
+    const auto a = world.CreateBody(Box(0.0f, 0.5f, 0.5f, 0.5f));
+    const auto b = world.CreateBody(Box(3.0f, 0.5f, 0.5f, 0.5f));
+    world.Step(DT);
+    EXPECT_EQ(world.Contacts().size(), 2u);
+    EXPECT_EQ(world.IslandCount(), 2u);
+
+    world.DestroyBody(a);
+    EXPECT_FALSE(world.IsAlive(a));
+    EXPECT_EQ(world.size(), 2u);
+    ASSERT_EQ(world.Contacts().size(), 1u);
+    EXPECT_EQ(world.Contacts()[0].bodyA, b);
+    EXPECT_EQ(world.Contacts()[0].bodyB, ground);
+
+    // The slot is reused
+    const auto c = world.CreateBody(Box(3.0f, 1.5f, 0.5f, 0.5f));
+    EXPECT_EQ(c, a);
+    world.Step(DT);
+    EXPECT_EQ(world.Contacts().size(), 2u);
+    EXPECT_EQ(world.IslandCount(), 1u);
+}
+
+TEST(Physics, ThreadedStepMatchesSerial)
+{
+    World serial;
+    World threaded;
+    for (auto* world : { &serial, &threaded })
+    {
+        AddGround(*world);
+        // Separate piles, so there are many islands
+        for (int pile = 0; pile < 12; ++pile)
+        {
+            for (int i = 0; i < 40; ++i)
+            {
+                const auto h = static_cast<jg::u32>((pile * 40 + i) * 2654435761u);
+                auto def = Box(static_cast<float>(pile) * 8.0f - 45.0f + static_cast<float>(h % 300) * 0.01f,
+                               0.6f + static_cast<float>(i) * 1.1f, 0.3f + static_cast<float>(h % 5) * 0.05f, 0.4f);
+                if (h % 3 == 0)
+                    def.shape = jg::physics::MakeCircle(0.4f);
+                def.angle = static_cast<float>(h % 7) * 0.1f;
+                world->CreateBody(def);
+            }
+        }
+    }
+
+    jg::jobs::ThreadPool pool{ 4 };
+    for (int n = 0; n < 120; ++n)
+    {
+        serial.Step(DT);
+        threaded.Step(pool, DT);
+    }
+
+    EXPECT_GT(serial.IslandCount(), 1u);
+    EXPECT_EQ(serial.IslandCount(), threaded.IslandCount());
+    ASSERT_EQ(serial.Contacts().size(), threaded.Contacts().size());
+    for (BodyId id = 0; id < serial.size(); ++id)
+    {
+        ASSERT_EQ(serial.GetPosition(id).x, threaded.GetPosition(id).x) << id;
+        ASSERT_EQ(serial.GetPosition(id).y, threaded.GetPosition(id).y) << id;
+        ASSERT_EQ(serial.GetAngle(id), threaded.GetAngle(id)) << id;
+    }
+}
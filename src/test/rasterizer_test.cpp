@@ -0,0 +1,238 @@
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <vector>
+
+#include "jangine.h"
+
+namespace
+{
+    constexpr jg::u32 WHITE = 0xFFFFFFFFu;
+    constexpr jg::u32 CLEAR = 0xFF000000u;
+
+    void DrawTriangle(jg::TileRasterizer& r, const jg::Vec2f& a, const jg::Vec2f& b, const jg::Vec2f& c, const jg::Vec4f& color)
+    {
+        const jg::Vec2f positions[] = { a, b, c };
+        const jg::Vec4f colors[] = { color, color, color };
+        const jg::u32 indices[] = { 0, 1, 2 };
+        r.Draw(jg::Mat3f::Identity(), jg::Span<const jg::Vec2f>{ positions }, jg::Span<const jg::Vec4f>{ colors }, jg::Span<const jg::u32>{ indices });
+    }
+
+    // Pixel centre coverage straight from the definition: 1/16 pixel snapping, top-left rule
+    bool ReferenceCovers(const jg::Vec2f (&v)[3], int px, int py)
+    {
+        long long x[3], y[3];
+        for (int k = 0; k < 3; ++k)
+        {
+            x[k] = static_cast<long long>(std::floor(v[k].x * 16.0f + 0.5f));
+            y[k] = static_cast<long long>(std::floor(v[k].y * 16.0f + 0.5f));
+        }
+        const auto area = (x[1] - x[0]) * (y[2] - y[0]) - (y[1] - y[0]) * (x[2] - x[0]);
+        if (area == 0)
+            return false;
+        const auto sign = area > 0 ? 1 : -1;
+        const long long sx = px * 16 + 8, sy = py * 16 + 8;
+        for (int k = 0; k < 3; ++k)
+        {
+            const auto j = (k + 1) % 3;
+            const auto a = sign * (y[k] - y[j]);
+            const auto b = sign * (x[j] - x[k]);
+            const auto e = sign * ((x[j] - x[k]) * (sy - y[k]) - (y[j] - y[k]) * (sx - x[k]));
+            const auto topLeft = a > 0 || (a == 0 && b > 0);
+            if (e < 0 || (e == 0 && !topLeft))
+                return false;
+        }
+        return true;
+    }
+
+    struct Rng
+    {
+        jg::u32 state = 2463534242u;
+        float Next(float lo, float hi)
+        {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return lo + (hi - lo) * static_cast<float>(state >> 8) / 16777216.0f;
+        }
+    };
+}
+
+TEST(Rasterizer, AxisAlignedSquare)
+{
+    jg::Framebuffer fb{ 8, 8 };
+    fb.Clear(CLEAR);
+    jg::TileRasterizer r;
+    const jg::Vec4f white{ 1.0f };
+    DrawTriangle(r, jg::Vec2f{ 1.0f, 1.0f }, jg::Vec2f{ 5.0f, 1.0f }, jg::Vec2f{ 5.0f, 5.0f }, white);
+    DrawTriangle(r, jg::Vec2f{ 5.0f, 5.0f }, jg::Vec2f{ 1.0f, 5.0f }, jg::Vec2f{ 1.0f, 1.0f }, white);
+    EXPECT_EQ(r.TriangleCount(), 2u);
+    r.Render(fb);
+    EXPECT_EQ(r.TriangleCount(), 0u);
+
+    for (jg::u32 y = 0; y < 8; ++y)
+        for (jg::u32 x = 0; x < 8; ++x)
+            EXPECT_EQ(fb.At(x, y), (x >= 1 && x < 5 && y >= 1 && y < 5) ? WHITE : CLEAR) << x << ", " << y;
+}
+
+TEST(Rasterizer, MatchesReferenceCoverage)
+{
+    // Not a multiple of the block or tile size, to exercise the clipped edges
+    jg::Framebuffer fb{ 131, 75 };
+    jg::TileRasterizer r;
+    Rng rng;
+    for (int t = 0; t < 300; ++t)
+    {
+        // Mostly small and thin, some huge and partly off screen
+        const auto spread = t % 10 == 0 ? 400.0f : 12.0f;
+        const jg::Vec2f centre{ rng.Next(-10.0f, 140.0f), rng.Next(-10.0f, 85.0f) };
+        const jg::Vec2f v[3] = {
+            centre + jg::Vec2f{ rng.Next(-spread, spread), rng.Next(-spread, spread) },
+            centre + jg::Vec2f{ rng.Next(-spread, spread), rng.Next(-spread, spread) },
+            t % 7 == 0 ? centre : centre + jg::Vec2f{ rng.Next(-spread, spread), rng.Next(-spread, spread) },
+        };
+
+        fb.Clear(CLEAR);
+        DrawTriangle(r, v[0], v[1], v[2], jg::Vec4f{ 1.0f });
+        r.Render(fb);
+        for (jg::u32 y = 0; y < fb.height; ++y)
+            for (jg::u32 x = 0; x < fb.width; ++x)
+                ASSERT_EQ(fb.At(x, y) == WHITE, ReferenceCovers(v, static_cast<int>(x), static_cast<int>(y))) << "triangle " << t << " pixel " << x << ", " << y;
+    }
+}
+
+TEST(Rasterizer, SharedEdgesCoverEveryPixelOnce)
+{
+    // A jittered grid spanning the whole target, drawn half transparent over black:
+    // a pixel covered twice would come out brighter, one missed would stay black
+    jg::Framebuffer fb{ 150, 100 };
+    fb.Clear(0u);
+    constexpr int CELLS_X = 13, CELLS_Y = 9;
+    Rng rng;
+    std::vector<jg::Vec2f> positions;
+    for (int y = 0; y <= CELLS_Y; ++y)
+    {
+        for (int x = 0; x <= CELLS_X; ++x)
+        {
+            const auto inner = x > 0 && x < CELLS_X && y > 0 && y < CELLS_Y;
+            positions.push_back(jg::Vec2f{ 150.0f * x / CELLS_X + (inner ? rng.Next(-4.0f, 4.0f) : 0.0f),
+                                           100.0f * y / CELLS_Y + (inner ? rng.Next(-4.0f, 4.0f) : 0.0f) });
+        }
+    }
+    std::vector<jg::u32> indices;
+    for (jg::u32 y = 0; y < CELLS_Y; ++y)
+    {
+        for (jg::u32 x = 0; x < CELLS_X; ++x)
+        {
+            const auto i = y * (CELLS_X + 1) + x;
+            // Alternate the diagonal and the winding
+            if ((x + y) % 2 == 0)
+                indices.insert(indices.end(), { i, i + 1, i + CELLS_X + 2, i, i + CELLS_X + 2, i + CELLS_X + 1 });
+            else
+                indices.insert(indices.end(), { i + 1, i, i + CELLS_X + 1, i + 1, i + CELLS_X + 1, i + CELLS_X + 2 });
+        }
+    }
+    const std::vector<jg::Vec4f> colors(positions.size(), jg::Vec4f{ 1.0f, 1.0f, 1.0f, 0.5f });
+
+    jg::TileRasterizer r;
+    r.Draw(jg::Mat3f::Identity(), jg::Span<const jg::Vec2f>{ positions }, jg::Span<const jg::Vec4f>{ colors }, jg::Span<const jg::u32>{ indices });
+    r.Render(fb);
+    for (jg::u32 y = 0; y < fb.height; ++y)
+        for (jg::u32 x = 0; x < fb.width; ++x)
+            ASSERT_EQ(fb.At(x, y), 0x80808080u) << x << ", " << y;
+}
+
+TEST(Rasterizer, InterpolatesColors)
+{
+    jg::Framebuffer fb{ 64, 64 };
+    fb.Clear(CLEAR);
+    const jg::Vec2f positions[] = { jg::Vec2f{ 0.0f, 0.0f }, jg::Vec2f{ 60.0f, 0.0f }, jg::Vec2f{ 0.0f, 60.0f } };
+    const jg::Vec4f colors[] = { jg::Vec4f{ 1.0f, 0.0f, 0.0f, 1.0f }, jg::Vec4f{ 0.0f, 1.0f, 0.0f, 1.0f }, jg::Vec4f{ 0.0f, 0.0f, 1.0f, 1.0f } };
+    const jg::u32 indices[] = { 0, 1, 2 };
+
+    jg::TileRasterizer r;
+    r.Draw(jg::Mat3f::Identity(), jg::Span<const jg::Vec2f>{ positions }, jg::Span<const jg::Vec4f>{ colors }, jg::Span<const jg::u32>{ indices });
+    r.Render(fb);
+
+    // At pixel centre (x + 0.5, y + 0.5) the weights are x / 60 for green and y / 60 for blue
+    for (const auto& p : { jg::Vec2f{ 0.0f, 0.0f }, jg::Vec2f{ 20.0f, 20.0f }, jg::Vec2f{ 50.0f, 3.0f }, jg::Vec2f{ 7.0f, 41.0f } })
+    {
+        const auto pixel = jg::SpriteBatcher::UnpackColor(fb.At(static_cast<jg::u32>(p.x), static_cast<jg::u32>(p.y)));
+        const auto g = (p.x + 0.5f) / 60.0f;
+        const auto b = (p.y + 0.5f) / 60.0f;
+        EXPECT_NEAR(pixel.x, 1.0f - g - b, 1.0f / 255.0f);
+        EXPECT_NEAR(pixel.y, g, 1.0f / 255.0f);
+        EXPECT_NEAR(pixel.z, b, 1.0f / 255.0f);
+        EXPECT_EQ(pixel.w, 1.0f);
+    }
+}
+
+TEST(Rasterizer, ThreadCountDoesNotChangeTheImage)
+{
+    std::vector<jg::Vec2f> positions;
+    std::vector<jg::Vec4f> colors;
+    std::vector<jg::u32> indices;
+    Rng rng;
+    for (jg::u32 i = 0; i < 3000; ++i)
+    {
+        positions.push_back(jg::Vec2f{ rng.Next(-20.0f, 280.0f), rng.Next(-20.0f, 210.0f) });
+        colors.push_back(jg::Vec4f{ rng.Next(0.0f, 1.0f), rng.Next(0.0f, 1.0f), rng.Next(0.0f, 1.0f), i % 2 ? 1.0f : rng.Next(0.0f, 1.0f) });
+        if (i % 3 == 2)
+        {
+            // Small triangles with the odd huge one, overlapping across tiles
+            const auto big = i % 99 == 2;
+            positions[i] = positions[i - 2] + jg::Vec2f{ rng.Next(-30.0f, 30.0f) * (big ? 8.0f : 1.0f), rng.Next(-30.0f, 30.0f) };
+            indices.insert(indices.end(), { i - 2, i - 1, i });
+        }
+    }
+
+    const auto render = [&](jg::Framebuffer& fb, jg::jobs::ThreadPool* pool) {
+        jg::TileRasterizer r;
+        fb.Clear(0xFF202020u);
+        r.Draw(jg::Mat3f::Translation2D(3.25f, -1.5f), jg::Span<const jg::Vec2f>{ positions }, jg::Span<const jg::Vec4f>{ colors }, jg::Span<const jg::u32>{ indices });
+        if (pool)
+            r.Render(*pool, fb);
+        else
+            r.Render(fb);
+    };
+
+    jg::Framebuffer serial{ 256, 192 };
+    jg::Framebuffer parallel{ 256, 192 };
+    render(serial, nullptr);
+    jg::jobs::ThreadPool pool{ 4 };
+    render(parallel, &pool);
+    EXPECT_EQ(serial.pixels, parallel.pixels);
+}
+
+TEST(Rasterizer, DrawsBatchedSprites)
+{
+    std::vector<jg::Sprite> sprites(2);
+    sprites[0].transform = jg::Mat3f::Scale2D(4.0f, 4.0f);
+    sprites[0].position = jg::Vec2f{ 10.0f, 10.0f };
+    sprites[0].color = jg::Vec4f{ 0.0f, 0.0f, 1.0f, 1.0f };
+    sprites[1] = sprites[0];
+    sprites[1].position = jg::Vec2f{ 12.0f, 10.0f };
+    sprites[1].color = jg::Vec4f{ 1.0f, 0.0f, 0.0f, 1.0f };
+    sprites[1].layer = 1;
+
+    std::vector<jg::SpriteVertex> vertices(8);
+    jg::SpriteBatcher batcher;
+    batcher.Build(jg::Span<const jg::Sprite>{ sprites }, jg::Span<jg::SpriteVertex>{ vertices });
+
+    jg::Framebuffer fb{ 32, 32 };
+    fb.Clear(CLEAR);
+    jg::TileRasterizer r;
+    r.DrawQuads(jg::Mat3f::Translation2D(0.0f, 2.0f), jg::Span<const jg::SpriteVertex>{ vertices });
+    r.Render(fb);
+
+    // Quads [8, 12) and [10, 14) wide, [10, 14) tall after the transform; layer 1 on top
+    for (jg::u32 y = 8; y < 16; ++y)
+    {
+        for (jg::u32 x = 6; x < 16; ++x)
+        {
+            const auto inY = y >= 10 && y < 14;
+            const auto expected = !inY ? CLEAR : (x >= 10 && x < 14) ? 0xFF0000FFu : (x >= 8 && x < 10) ? 0xFFFF0000u : CLEAR;
+            EXPECT_EQ(fb.At(x, y), expected) << x << ", " << y;
+        }
+    }
+}
@@ -0,0 +1,210 @@
+#include "gtest/gtest.h"
+
+#include <array>
+#include <vector>
+
+#include "jangine.h"
+
+namespace
+{
+    // Hexagon around (1, 1), counter-clockwise
+    const std::array<jg::Vec2f, 6> HEXAGON{
+        jg::Vec2f{ 0.0f, 0.5f }, jg::Vec2f{ 0.5f, 0.0f }, jg::Vec2f{ 1.5f, 0.0f },
+        jg::Vec2f{ 2.0f, 0.5f }, jg::Vec2f{ 1.5f, 2.0f }, jg::Vec2f{ 0.5f, 2.0f }
+    };
+
+    // Rays from a ring around (1, 1) aimed near the center, some wide, some axis-aligned, some inside
+    jg::Ray2f MakeRay(size_t i)
+    {
+        const auto angle = static_cast<float>(i) * 0.61f;
+        const auto radius = i % 9 == 0 ? 0.3f : 4.0f;
+        const auto origin = jg::Vec2f{ 1.0f + radius * jg::Cos(angle), 1.0f + radius * jg::Sin(angle) };
+        auto target = jg::Vec2f{ 1.0f + 2.5f * jg::Sin(static_cast<float>(i) * 1.7f), 1.0f };
+        if (i % 5 == 0)
+            target = jg::Vec2f{ origin.x, 1.0f };
+        if (i % 7 == 0)
+            target = jg::Vec2f{ 1.0f, origin.y };
+        return jg::Ray2f{ origin, (target - origin) * 0.5f };
+    }
+
+    float MakeMaxT(size_t i) { return i % 11 == 0 ? 0.5f : 10.0f; }
+
+    // Runs packet and scalar over the same rays, lanes of the packet past count left inactive
+    template <size_t W, typename PacketFn, typename ScalarFn>
+    void ExpectPacketMatchesScalar(PacketFn packetFn, ScalarFn scalarFn)
+    {
+        size_t hits = 0;
+        for (size_t first = 0; first < 200; first += W)
+        {
+            jg::RayPacket<W> packet;
+            const auto count = first % 3 == 0 ? W - 1 : W;
+            for (size_t lane = 0; lane < count; ++lane)
+                packet.Set(lane, MakeRay(first + lane), MakeMaxT(first + lane));
+
+            std::array<float, W> t{};
+            const auto mask = packetFn(packet, t);
+            for (size_t lane = 0; lane < W; ++lane)
+            {
+                float expectedT = -1.0f;
+                const auto expected = lane < count && scalarFn(MakeRay(first + lane), MakeMaxT(first + lane), expectedT);
+                ASSERT_EQ(((mask >> lane) & 1) != 0, expected) << "ray " << first + lane;
+                if (expected)
+                {
+                    EXPECT_NEAR(t[lane], expectedT, 1e-4f) << "ray " << first + lane;
+                    ++hits;
+                }
+            }
+        }
+        EXPECT_GT(hits, 20u);
+    }
+}
+
+TEST(Ray, IntersectCircle)
+{
+    const jg::Vec2f center{ 2.0f, 0.0f };
+    float t = -1.0f;
+    EXPECT_TRUE(jg::IntersectCircle(jg::Ray2f{ jg::Vec2f{ 0.0f, 0.0f }, jg::Vec2f{ 2.0f, 0.0f } }, center, 1.0f, 10.0f, t));
+    EXPECT_FLOAT_EQ(t, 0.5f);
+    EXPECT_FALSE(jg::IntersectCircle(jg::Ray2f{ jg::Vec2f{ 0.0f, 0.0f }, jg::Vec2f{ 2.0f, 0.0f } }, center, 1.0f, 0.4f, t));
+    // Pointing away, and passing wide
+    EXPECT_FALSE(jg::IntersectCircle(jg::Ray2f{ jg::Vec2f{ 0.0f, 0.0f }, jg::Vec2f{ -1.0f, 0.0f } }, center, 1.0f, 10.0f, t));
+    EXPECT_FALSE(jg::IntersectCircle(jg::Ray2f{ jg::Vec2f{ 0.0f, 1.5f }, jg::Vec2f{ 1.0f, 0.0f } }, center, 1.0f, 10.0f, t));
+    // Origin inside
+    EXPECT_TRUE(jg::IntersectCircle(jg::Ray2f{ jg::Vec2f{ 2.5f, 0.0f }, jg::Vec2f{ 1.0f, 0.0f } }, center, 1.0f, 10.0f, t));
+    EXPECT_EQ(t, 0.0f);
+
+    // Sweep: a circle of radius 0.5 moving along the ray touches the other at the summed radius
+    EXPECT_TRUE(jg::IntersectCircle(jg::Ray2f{ jg::Vec2f{ -3.0f, 1.2f }, jg::Vec2f{ 1.0f, 0.0f } }, center, 1.5f, 10.0f, t));
+    EXPECT_NEAR(t, 5.0f - jg::Sqrt(1.5f * 1.5f - 1.2f * 1.2f), 1e-5f);
+}
+
+TEST(Ray, IntersectSegment)
+{
+    const jg::Vec2f a{ 1.0f, -1.0f };
+    const jg::Vec2f b{ 1.0f, 1.0f };
+    float t = -1.0f;
+    EXPECT_TRUE(jg::IntersectSegment(jg::Ray2f{ jg::Vec2f{ 0.0f, 0.5f }, jg::Vec2f{ 4.0f, 0.0f } }, a, b, 10.0f, t));
+    EXPECT_FLOAT_EQ(t, 0.25f);
+    // Either way along the ray direction, hitting the back of the segment too
+    EXPECT_TRUE(jg::IntersectSegment(jg::Ray2f{ jg::Vec2f{ 3.0f, 0.0f }, jg::Vec2f{ -1.0f, 0.0f } }, a, b, 10.0f, t));
+    EXPECT_FLOAT_EQ(t, 2.0f);
+    EXPECT_FALSE(jg::IntersectSegment(jg::Ray2f{ jg::Vec2f{ 0.0f, 0.5f }, jg::Vec2f{ 4.0f, 0.0f } }, a, b, 0.2f, t));
+    EXPECT_FALSE(jg::IntersectSegment(jg::Ray2f{ jg::Vec2f{ 0.0f, 1.5f }, jg::Vec2f{ 1.0f, 0.0f } }, a, b, 10.0f, t));
+    EXPECT_FALSE(jg::IntersectSegment(jg::Ray2f{ jg::Vec2f{ 2.0f, 0.0f }, jg::Vec2f{ 1.0f, 0.0f } }, a, b, 10.0f, t));
+    // Parallel, even collinear
+    EXPECT_FALSE(jg::IntersectSegment(jg::Ray2f{ jg::Vec2f{ 1.0f, -3.0f }, jg::Vec2f{ 0.0f, 1.0f } }, a, b, 10.0f, t));
+}
+
+TEST(Ray, IntersectConvexPolygon)
+{
+    const jg::Span<const jg::Vec2f> hexagon{ HEXAGON.data(), HEXAGON.size() };
+    float t = -1.0f;
+    EXPECT_TRUE(jg::IntersectConvexPolygon(jg::Ray2f{ jg::Vec2f{ -2.0f, 1.0f }, jg::Vec2f{ 1.0f, 0.0f } }, hexagon, 10.0f, t));
+    EXPECT_FLOAT_EQ(t, 2.0f + 1.0f / 6.0f);
+    // Through a slanted edge
+    EXPECT_TRUE(jg::IntersectConvexPolygon(jg::Ray2f{ jg::Vec2f{ 1.75f, 3.0f }, jg::Vec2f{ 0.0f, -1.0f } }, hexagon, 10.0f, t));
+    EXPECT_FLOAT_EQ(t, 1.75f);
+    EXPECT_FALSE(jg::IntersectConvexPolygon(jg::Ray2f{ jg::Vec2f{ -2.0f, 1.0f }, jg::Vec2f{ 1.0f, 0.0f } }, hexagon, 1.5f, t));
+    EXPECT_FALSE(jg::IntersectConvexPolygon(jg::Ray2f{ jg::Vec2f{ -2.0f, 1.0f }, jg::Vec2f{ -1.0f, 0.0f } }, hexagon, 10.0f, t));
+    // Clips the corner region a box test would accept
+    EXPECT_FALSE(jg::IntersectConvexPolygon(jg::Ray2f{ jg::Vec2f{ -0.25f, 1.4f }, jg::Vec2f{ 0.25f, -1.0f } }, hexagon, 10.0f, t));
+    // Parallel to an edge: outside it misses, inside it goes through
+    EXPECT_FALSE(jg::IntersectConvexPolygon(jg::Ray2f{ jg::Vec2f{ -1.0f, -0.5f }, jg::Vec2f{ 1.0f, 0.0f } }, hexagon, 10.0f, t));
+    EXPECT_TRUE(jg::IntersectConvexPolygon(jg::Ray2f{ jg::Vec2f{ -1.0f, 1.9f }, jg::Vec2f{ 1.0f, 0.0f } }, hexagon, 10.0f, t));
+    // Origin inside
+    EXPECT_TRUE(jg::IntersectConvexPolygon(jg::Ray2f{ jg::Vec2f{ 1.0f, 1.0f }, jg::Vec2f{ 0.0f, 1.0f } }, hexagon, 10.0f, t));
+    EXPECT_EQ(t, 0.0f);
+}
+
+TEST(RayPacket, Lanes)
+{
+    jg::RayPacket4 packet;
+    EXPECT_EQ(packet.ActiveMask(), 0u);
+    for (size_t lane = 0; lane < 4; ++lane)
+        packet.Set(lane, MakeRay(lane), 10.0f);
+    EXPECT_EQ(packet.ActiveMask(), jg::RayPacket4::ALL_LANES);
+    EXPECT_EQ(packet.Get(2).origin.x, MakeRay(2).origin.x);
+    EXPECT_EQ(packet.Get(2).direction.y, MakeRay(2).direction.y);
+
+    packet.Deactivate(0x5u);
+    EXPECT_EQ(packet.ActiveMask(), 0xAu);
+
+    const std::array<float, 4> t{ 1.0f, 2.0f, 3.0f, 4.0f };
+    packet.ClipTo(0x8u, t);
+    EXPECT_EQ(packet.maxT[3], 4.0f);
+    EXPECT_EQ(packet.maxT[1], 10.0f);
+
+    // Axis-aligned rays get 0 for the unused inverse, like the scalar slab test
+    packet.Set(0, jg::Ray2f{ jg::Vec2f{ 0.0f }, jg::Vec2f{ 0.0f, 2.0f } }, 1.0f);
+    EXPECT_EQ(packet.invDirectionX[0], 0.0f);
+    EXPECT_EQ(packet.invDirectionY[0], 0.5f);
+}
+
+TEST(RayPacket, MatchesScalar)
+{
+    const jg::AABB2f box{ jg::Vec2f{ 0.5f, 0.25f }, jg::Vec2f{ 1.5f, 2.0f } };
+    const jg::Vec2f center{ 1.0f, 1.0f };
+    const jg::Vec2f a{ 0.0f, 2.0f };
+    const jg::Vec2f b{ 2.0f, 0.5f };
+    const jg::Span<const jg::Vec2f> hexagon{ HEXAGON.data(), HEXAGON.size() };
+
+    const auto boxPacket = [&](const auto& packet, auto& t) { return jg::Intersect(packet, box, t); };
+    const auto boxScalar = [&](const jg::Ray2f& ray, float maxT, float& t) { return jg::Intersect(ray, box, maxT, t); };
+    ExpectPacketMatchesScalar<4>(boxPacket, boxScalar);
+    ExpectPacketMatchesScalar<8>(boxPacket, boxScalar);
+
+    const auto circlePacket = [&](const auto& packet, auto& t) { return jg::IntersectCircle(packet, center, 0.75f, t); };
+    const auto circleScalar = [&](const jg::Ray2f& ray, float maxT, float& t) { return jg::IntersectCircle(ray, center, 0.75f, maxT, t); };
+    ExpectPacketMatchesScalar<4>(circlePacket, circleScalar);
+    ExpectPacketMatchesScalar<8>(circlePacket, circleScalar);
+
+    const auto segmentPacket = [&](const auto& packet, auto& t) { return jg::IntersectSegment(packet, a, b, t); };
+    const auto segmentScalar = [&](const jg::Ray2f& ray, float maxT, float& t) { return jg::IntersectSegment(ray, a, b, maxT, t); };
+    ExpectPacketMatchesScalar<4>(segmentPacket, segmentScalar);
+    ExpectPacketMatchesScalar<8>(segmentPacket, segmentScalar);
+
+    const auto polygonPacket = [&](const auto& packet, auto& t) { return jg::IntersectConvexPolygon(packet, hexagon, t); };
+    const auto polygonScalar = [&](const jg::Ray2f& ray, float maxT, float& t) { return jg::IntersectConvexPolygon(ray, hexagon, maxT, t); };
+    ExpectPacketMatchesScalar<4>(polygonPacket, polygonScalar);
+    ExpectPacketMatchesScalar<8>(polygonPacket, polygonScalar);
+}
+
+TEST(RayPacket, EarlyOut)
+{
+    // Every lane misses on the first edge, and an all-inactive packet never hits
+    const jg::Span<const jg::Vec2f> hexagon{ HEXAGON.data(), HEXAGON.size() };
+    jg::RayPacket8 packet;
+    std::array<float, 8> t{};
+    EXPECT_EQ(jg::IntersectConvexPolygon(packet, hexagon, t), 0u);
+    EXPECT_EQ(jg::Intersect(packet, jg::AABB2f{ jg::Vec2f{ -100.0f }, jg::Vec2f{ 100.0f } }, t), 0u);
+    EXPECT_EQ(jg::IntersectCircle(packet, jg::Vec2f{ 0.0f }, 100.0f, t), 0u);
+    for (size_t lane = 0; lane < 8; ++lane)
+        packet.Set(lane, jg::Ray2f{ jg::Vec2f{ static_cast<float>(lane), -5.0f }, jg::Vec2f{ 0.0f, -1.0f } }, 10.0f);
+    EXPECT_EQ(jg::IntersectConvexPolygon(packet, hexagon, t), 0u);
+
+    // Line of sight: lanes drop out as walls block them
+    std::vector<std::array<jg::Vec2f, 2>> walls;
+    for (size_t i = 0; i < 8; ++i)
+    {
+        const auto x = 1.0f + static_cast<float>(i);
+        walls.push_back({ jg::Vec2f{ x, -100.0f }, jg::Vec2f{ x, static_cast<float>(i) + 0.5f } });
+    }
+    for (size_t lane = 0; lane < 8; ++lane)
+        packet.Set(lane, jg::Ray2f{ jg::Vec2f{ 0.0f, static_cast<float>(lane) }, jg::Vec2f{ 1.0f, 0.0f } }, 20.0f);
+    jg::u32 blockedAt[8] = {};
+    size_t wall = 0;
+    for (; wall < walls.size() && packet.ActiveMask() != 0; ++wall)
+    {
+        const auto hits = jg::IntersectSegment(packet, walls[wall][0], walls[wall][1], t);
+        for (size_t lane = 0; lane < 8; ++lane)
+        {
+            if (hits & (1u << lane))
+                blockedAt[lane] = static_cast<jg::u32>(wall);
+        }
+        packet.Deactivate(hits);
+    }
+    EXPECT_EQ(packet.ActiveMask(), 0u);
+    EXPECT_EQ(wall, walls.size());
+    for (jg::u32 lane = 0; lane < 8; ++lane)
+        EXPECT_EQ(blockedAt[lane], lane);
+}
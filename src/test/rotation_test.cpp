@@ -0,0 +1,147 @@
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <vector>
+
+#include "jangine.h"
+
+namespace
+{
+    constexpr float PI = 3.14159265358979f;
+
+    void ExpectQuatNear(const jg::Quatf& a, const jg::Quatf& b, float eps)
+    {
+        // q and -q are the same rotation
+        const auto sign = jg::Dot(a, b) < 0.0f ? -1.0f : 1.0f;
+        for (auto i = 0; i < 4; ++i)
+            EXPECT_NEAR(a.data[i], b.data[i] * sign, eps) << "i = " << i;
+    }
+}
+
+TEST(Rotor2, Rotate)
+{
+    const auto r = jg::Rotor2f::FromAngle(PI / 2.0f);
+    const auto v = jg::Rotate(r, jg::Vec2f{ 1.0f, 0.0f });
+    EXPECT_NEAR(v.x, 0.0f, 1e-6f);
+    EXPECT_NEAR(v.y, 1.0f, 1e-6f);
+
+    const auto m = jg::Mat3f::Rotation2D(0.7f);
+    const auto p = jg::Vec2f{ 3.0f, -2.0f };
+    const auto expected = m * jg::Vec3f{ p.x, p.y, 1.0f };
+    const auto actual = jg::Rotate(jg::Rotor2f::FromAngle(0.7f), p);
+    EXPECT_NEAR(actual.x, expected.x, 1e-5f);
+    EXPECT_NEAR(actual.y, expected.y, 1e-5f);
+}
+
+TEST(Rotor2, ComposeAndConvert)
+{
+    const auto a = jg::Rotor2f::FromAngle(0.3f);
+    const auto b = jg::Rotor2f::FromAngle(1.1f);
+    EXPECT_NEAR(jg::Angle(a * b), 1.4f, 1e-6f);
+    EXPECT_NEAR(jg::Angle(a * jg::Conjugate(a)), 0.0f, 1e-6f);
+
+    const auto m = jg::ToMat3(a * b);
+    const auto expected = jg::Mat3f::Rotation2D(1.4f);
+    for (auto i = 0; i < 9; ++i)
+        EXPECT_NEAR(m.data[i], expected.data[i], 1e-6f);
+}
+
+TEST(Rotor2, Interpolate)
+{
+    const auto a = jg::Rotor2f::FromAngle(0.2f);
+    const auto b = jg::Rotor2f::FromAngle(1.8f);
+    for (auto t = 0.0f; t <= 1.0f; t += 0.125f)
+        EXPECT_NEAR(jg::Angle(jg::Slerp(a, b, t)), 0.2f + 1.6f * t, 1e-5f);
+
+    // Shorter arc across +-pi
+    const auto c = jg::Rotor2f::FromAngle(PI - 0.1f);
+    const auto d = jg::Rotor2f::FromAngle(-PI + 0.1f);
+    EXPECT_NEAR(std::abs(jg::Angle(jg::Slerp(c, d, 0.5f))), PI, 1e-5f);
+
+    const auto n = jg::Nlerp(a, b, 0.5f);
+    EXPECT_NEAR(jg::Dot(n, n), 1.0f, 1e-6f);
+    EXPECT_NEAR(jg::Angle(n), 1.0f, 1e-6f);
+}
+
+TEST(Quat, RotateMatchesMatrix)
+{
+    const auto axis = jg::Normalize(jg::Vec3f{ 1.0f, 2.0f, -0.5f });
+    const auto q = jg::Quatf::FromAxisAngle(axis, 0.9f);
+    const auto m = jg::ToMat3(q);
+    const jg::Vec3f v{ 0.3f, -1.5f, 2.0f };
+
+    const auto byQuat = jg::Rotate(q, v);
+    const auto byMat = m * v;
+    for (auto i = 0; i < 3; ++i)
+        EXPECT_NEAR(byQuat[i], byMat[i], 1e-5f);
+
+    // Rotating about z matches the Mat4 factory
+    const auto qz = jg::Quatf::FromAxisAngle(jg::Vec3f{ 0.0f, 0.0f, 1.0f }, 0.6f);
+    const auto m4 = jg::ToMat4(qz);
+    const auto rz = jg::Mat4f::RotationZ(0.6f);
+    for (auto i = 0; i < 16; ++i)
+        EXPECT_NEAR(m4.data[i], rz.data[i], 1e-6f);
+}
+
+TEST(Quat, Compose)
+{
+    const auto qx = jg::Quatf::FromAxisAngle(jg::Vec3f{ 1.0f, 0.0f, 0.0f }, 0.4f);
+    const auto qy = jg::Quatf::FromAxisAngle(jg::Vec3f{ 0.0f, 1.0f, 0.0f }, -1.2f);
+    const jg::Vec3f v{ 1.0f, 2.0f, 3.0f };
+
+    const auto composed = jg::Rotate(qy * qx, v);
+    const auto sequential = jg::Rotate(qy, jg::Rotate(qx, v));
+    for (auto i = 0; i < 3; ++i)
+        EXPECT_NEAR(composed[i], sequential[i], 1e-5f);
+
+    const auto m = jg::ToMat3(qy) * jg::ToMat3(qx);
+    const auto mq = jg::ToMat3(qy * qx);
+    for (auto i = 0; i < 9; ++i)
+        EXPECT_NEAR(m.data[i], mq.data[i], 1e-5f);
+
+    ExpectQuatNear(qx * jg::Conjugate(qx), jg::Quatf::Identity(), 1e-6f);
+}
+
+TEST(Quat, Slerp)
+{
+    const jg::Vec3f axis{ 0.0f, 1.0f, 0.0f };
+    const auto a = jg::Quatf::FromAxisAngle(axis, 0.2f);
+    const auto b = jg::Quatf::FromAxisAngle(axis, 2.2f);
+    for (auto t = 0.0f; t <= 1.0f; t += 0.125f)
+        ExpectQuatNear(jg::Slerp(a, b, t), jg::Quatf::FromAxisAngle(axis, 0.2f + 2.0f * t), 1e-5f);
+
+    // Takes the shorter path when the inputs are in opposite hemispheres
+    ExpectQuatNear(jg::Slerp(a, -b, 0.5f), jg::Quatf::FromAxisAngle(axis, 1.2f), 1e-5f);
+
+    // Nearly identical inputs fall back to nlerp
+    const auto c = jg::Quatf::FromAxisAngle(axis, 0.2001f);
+    const auto s = jg::Slerp(a, c, 0.5f);
+    EXPECT_NEAR(jg::Dot(s, s), 1.0f, 1e-6f);
+    ExpectQuatNear(s, jg::Quatf::FromAxisAngle(axis, 0.20005f), 1e-6f);
+}
+
+TEST(Quat, SlerpBatch)
+{
+    std::vector<jg::Quatf> from, to, out;
+    std::vector<float> t;
+    for (auto i = 0; i < 67; ++i)
+    {
+        const auto axisA = jg::Normalize(jg::Vec3f{ 1.0f + i * 0.1f, -0.5f, 0.25f * i });
+        const auto axisB = jg::Normalize(jg::Vec3f{ -0.3f, 1.0f, 0.1f * i });
+        from.push_back(jg::Quatf::FromAxisAngle(axisA, 0.05f * i));
+        // Every third pair in opposite hemispheres, plus a few nearly equal pairs
+        auto b = i % 7 == 0 ? from.back() : jg::Quatf::FromAxisAngle(axisB, 3.0f - 0.04f * i);
+        to.push_back(i % 3 == 0 ? -b : b);
+        t.push_back((i % 9) / 8.0f);
+    }
+    out.resize(from.size());
+
+    jg::SlerpBatch(from, to, t, out);
+    for (size_t i = 0; i < from.size(); ++i)
+        ExpectQuatNear(out[i], jg::Slerp(from[i], to[i], t[i]), 2e-6f);
+
+    // In place
+    jg::SlerpBatch(from, to, t, from);
+    for (size_t i = 0; i < from.size(); ++i)
+        ExpectQuatNear(from[i], out[i], 0.0f);
+}
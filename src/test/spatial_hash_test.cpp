@@ -0,0 +1,160 @@
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "jangine.h"
+
+namespace
+{
+    using ProxyId = jg::SpatialHashGrid::ProxyId;
+
+    // Deterministic boxes in [-200, 200)^2, mostly smaller than a cell, some spanning several
+    jg::AABB2f MakeBox(size_t i, float offset = 0.0f)
+    {
+        const auto x = static_cast<float>((i * 7919) % 400) - 200.0f + offset;
+        const auto y = static_cast<float>((i * 104729) % 400) - 200.0f;
+        const auto size = i % 10 == 0 ? 45.0f : 1.0f + static_cast<float>(i % 7);
+        return jg::AABB2f{ jg::Vec2f{ x, y }, jg::Vec2f{ x + size, y + size * 0.5f } };
+    }
+
+    std::vector<ProxyId> QueryGrid(const jg::SpatialHashGrid& grid, const jg::AABB2f& region)
+    {
+        std::vector<ProxyId> ids;
+        grid.Query(region, [&](ProxyId id) { ids.push_back(id); });
+        std::sort(ids.begin(), ids.end());
+        return ids;
+    }
+
+    std::vector<ProxyId> QueryBrute(const std::vector<jg::AABB2f>& boxes, const std::vector<bool>& alive, const jg::AABB2f& region)
+    {
+        std::vector<ProxyId> ids;
+        for (size_t i = 0; i < boxes.size(); ++i)
+        {
+            if (alive[i] && jg::Intersects(boxes[i], region))
+                ids.push_back(static_cast<ProxyId>(i));
+        }
+        return ids;
+    }
+}
+
+TEST(SpatialHashGrid, QueryMatchesBruteForce)
+{
+    jg::SpatialHashGrid grid{ 16.0f, 256 };
+    std::vector<jg::AABB2f> boxes;
+    std::vector<bool> alive;
+    for (size_t i = 0; i < 500; ++i)
+    {
+        boxes.push_back(MakeBox(i));
+        alive.push_back(true);
+        EXPECT_EQ(grid.Insert(boxes.back()), i);
+    }
+    EXPECT_EQ(grid.size(), 500u);
+
+    const jg::AABB2f regions[] = {
+        jg::AABB2f{ jg::Vec2f{ -30.0f, -30.0f }, jg::Vec2f{ 30.0f, 30.0f } },
+        jg::AABB2f{ jg::Vec2f{ 100.0f, -200.0f }, jg::Vec2f{ 101.0f, 200.0f } },
+        jg::AABB2f{ jg::Vec2f{ 5.0f, 5.0f }, jg::Vec2f{ 5.0f, 5.0f } },
+        // Covers more cells than there are buckets
+        jg::AABB2f{ jg::Vec2f{ -500.0f, -500.0f }, jg::Vec2f{ 500.0f, 500.0f } },
+    };
+    for (const auto& region : regions)
+        EXPECT_EQ(QueryGrid(grid, region), QueryBrute(boxes, alive, region));
+
+    // Move everything, some within their cells and some across, then remove a few
+    for (size_t i = 0; i < boxes.size(); ++i)
+    {
+        boxes[i] = MakeBox(i, i % 2 == 0 ? 0.5f : 37.0f);
+        grid.Move(static_cast<ProxyId>(i), boxes[i]);
+    }
+    for (size_t i = 0; i < boxes.size(); i += 3)
+    {
+        grid.Remove(static_cast<ProxyId>(i));
+        alive[i] = false;
+    }
+    EXPECT_FALSE(grid.Contains(0));
+    EXPECT_TRUE(grid.Contains(1));
+    for (const auto& region : regions)
+        EXPECT_EQ(QueryGrid(grid, region), QueryBrute(boxes, alive, region));
+
+    // Removed ids are reused
+    const auto reused = grid.Insert(MakeBox(7));
+    EXPECT_FALSE(alive[reused]);
+}
+
+TEST(SpatialHashGrid, Raycast)
+{
+    jg::SpatialHashGrid grid{ 16.0f, 256 };
+    std::vector<jg::AABB2f> boxes;
+    for (size_t i = 0; i < 500; ++i)
+    {
+        boxes.push_back(MakeBox(i));
+        grid.Insert(boxes.back());
+    }
+
+    const jg::Ray2f rays[] = {
+        jg::Ray2f{ jg::Vec2f{ -210.0f, -190.0f }, jg::Vec2f{ 1.0f, 0.9f } },
+        jg::Ray2f{ jg::Vec2f{ 150.0f, 20.0f }, jg::Vec2f{ -1.0f, 0.0f } },
+        jg::Ray2f{ jg::Vec2f{ 3.0f, 200.0f }, jg::Vec2f{ 0.0f, -2.0f } },
+        jg::Ray2f{ jg::Vec2f{ 0.0f, 0.0f }, jg::Vec2f{ -0.3f, 0.7f } },
+    };
+    for (const auto& ray : rays)
+    {
+        const auto maxT = 350.0f;
+        std::vector<ProxyId> hits;
+        grid.Raycast(ray, maxT, [&](ProxyId id, float t) {
+            float expectedT = 0.0f;
+            EXPECT_TRUE(jg::Intersect(ray, boxes[id], maxT, expectedT));
+            EXPECT_FLOAT_EQ(t, expectedT);
+            hits.push_back(id);
+            return true;
+        });
+        std::sort(hits.begin(), hits.end());
+        EXPECT_TRUE(std::adjacent_find(hits.begin(), hits.end()) == hits.end()) << "reported twice";
+
+        std::vector<ProxyId> expected;
+        auto closest = jg::SpatialHashGrid::INVALID_PROXY;
+        auto closestT = maxT;
+        for (size_t i = 0; i < boxes.size(); ++i)
+        {
+            float t = 0.0f;
+            if (jg::Intersect(ray, boxes[i], maxT, t))
+            {
+                expected.push_back(static_cast<ProxyId>(i));
+                if (t < closestT || closest == jg::SpatialHashGrid::INVALID_PROXY)
+                {
+                    closest = static_cast<ProxyId>(i);
+                    closestT = t;
+                }
+            }
+        }
+        EXPECT_EQ(hits, expected);
+        EXPECT_FALSE(expected.empty());
+
+        float t = 0.0f;
+        const auto id = grid.RaycastClosest(ray, maxT, t);
+        EXPECT_EQ(t, closestT);
+        EXPECT_TRUE(id == closest || jg::Intersect(ray, boxes[id], closestT, t));
+    }
+
+    // Early out
+    size_t visits = 0;
+    grid.Raycast(rays[0], 350.0f, [&](ProxyId, float) { return ++visits < 2; });
+    EXPECT_EQ(visits, 2u);
+}
+
+TEST(Ray, IntersectAABB)
+{
+    const jg::AABB2f box{ jg::Vec2f{ 1.0f, 1.0f }, jg::Vec2f{ 3.0f, 2.0f } };
+    float t = -1.0f;
+    EXPECT_TRUE(jg::Intersect(jg::Ray2f{ jg::Vec2f{ 0.0f, 1.5f }, jg::Vec2f{ 2.0f, 0.0f } }, box, 10.0f, t));
+    EXPECT_FLOAT_EQ(t, 0.5f);
+    EXPECT_FALSE(jg::Intersect(jg::Ray2f{ jg::Vec2f{ 0.0f, 1.5f }, jg::Vec2f{ 2.0f, 0.0f } }, box, 0.4f, t));
+    EXPECT_FALSE(jg::Intersect(jg::Ray2f{ jg::Vec2f{ 0.0f, 2.5f }, jg::Vec2f{ 1.0f, 0.0f } }, box, 10.0f, t));
+    EXPECT_FALSE(jg::Intersect(jg::Ray2f{ jg::Vec2f{ 4.0f, 1.5f }, jg::Vec2f{ 1.0f, 0.0f } }, box, 10.0f, t));
+    // Origin inside
+    EXPECT_TRUE(jg::Intersect(jg::Ray2f{ jg::Vec2f{ 2.0f, 1.5f }, jg::Vec2f{ 0.0f, -1.0f } }, box, 10.0f, t));
+    EXPECT_EQ(t, 0.0f);
+    const auto p = jg::PointAt(jg::Ray2f{ jg::Vec2f{ 1.0f, 1.0f }, jg::Vec2f{ 0.5f, 2.0f } }, 2.0f);
+    EXPECT_EQ(p.y, 5.0f);
+}
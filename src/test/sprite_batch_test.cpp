@@ -0,0 +1,125 @@
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include "jangine.h"
+
+namespace
+{
+    jg::Sprite MakeSprite(jg::u32 texture, jg::u32 layer, float x)
+    {
+        jg::Sprite s;
+        s.texture = texture;
+        s.layer = layer;
+        s.position = jg::Vec2f{ x, 0.0f };
+        return s;
+    }
+}
+
+TEST(RadixSort, MatchesStableSort)
+{
+    std::vector<jg::u64> keys;
+    jg::u64 seed = 88172645463325252ull;
+    for (size_t i = 0; i < 5000; ++i)
+    {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        // Mix of keys differing only in a few bytes and keys differing everywhere
+        keys.push_back(i % 3 == 0 ? seed : (seed & 0xFF0000000000000Full));
+    }
+
+    std::vector<jg::u32> values(keys.size());
+    std::iota(values.begin(), values.end(), 0u);
+    auto expected = values;
+    std::stable_sort(expected.begin(), expected.end(), [&keys](jg::u32 a, jg::u32 b) { return keys[a] < keys[b]; });
+
+    auto sortedKeys = keys;
+    std::vector<jg::u64> keyScratch(keys.size());
+    std::vector<jg::u32> valueScratch(keys.size());
+    jg::RadixSort(jg::Span<jg::u64>{ sortedKeys }, jg::Span<jg::u32>{ values }, jg::Span<jg::u64>{ keyScratch }, jg::Span<jg::u32>{ valueScratch });
+
+    EXPECT_EQ(values, expected);
+    EXPECT_TRUE(std::is_sorted(sortedKeys.begin(), sortedKeys.end()));
+}
+
+TEST(RadixSort, ConstantAndTinyInputs)
+{
+    std::vector<jg::u64> keys(10, 42);
+    std::vector<jg::u32> values{ 9, 8, 7, 6, 5, 4, 3, 2, 1, 0 };
+    std::vector<jg::u64> keyScratch(10);
+    std::vector<jg::u32> valueScratch(10);
+    jg::RadixSort(jg::Span<jg::u64>{ keys }, jg::Span<jg::u32>{ values }, jg::Span<jg::u64>{ keyScratch }, jg::Span<jg::u32>{ valueScratch });
+    EXPECT_EQ(values, (std::vector<jg::u32>{ 9, 8, 7, 6, 5, 4, 3, 2, 1, 0 }));
+
+    jg::RadixSort(jg::Span<jg::u64>{}, jg::Span<jg::u32>{}, jg::Span<jg::u64>{}, jg::Span<jg::u32>{});
+}
+
+TEST(SpriteBatch, SortsIntoBatches)
+{
+    const std::vector<jg::Sprite> sprites{
+        MakeSprite(2, 1, 0.0f),
+        MakeSprite(1, 0, 1.0f),
+        MakeSprite(2, 0, 2.0f),
+        MakeSprite(1, 0, 3.0f),
+        MakeSprite(2, 1, 4.0f),
+        MakeSprite(1, 1, 5.0f),
+    };
+    std::vector<jg::SpriteVertex> vertices(sprites.size() * jg::SpriteBatcher::VERTICES_PER_SPRITE);
+
+    jg::SpriteBatcher batcher;
+    const auto batches = batcher.Build(jg::Span<const jg::Sprite>{ sprites }, jg::Span<jg::SpriteVertex>{ vertices });
+
+    // Layer first, then texture; submission order within a batch
+    ASSERT_EQ(batches.size(), 4u);
+    const jg::u32 expected[4][4] = { { 1, 0, 0, 2 }, { 2, 0, 2, 1 }, { 1, 1, 3, 1 }, { 2, 1, 4, 2 } };
+    for (size_t b = 0; b < 4; ++b)
+    {
+        EXPECT_EQ(batches[b].texture, expected[b][0]);
+        EXPECT_EQ(batches[b].layer, expected[b][1]);
+        EXPECT_EQ(batches[b].firstSprite, expected[b][2]);
+        EXPECT_EQ(batches[b].spriteCount, expected[b][3]);
+    }
+
+    // Quads were written in draw order; the x offset identifies each sprite
+    const float drawOrder[] = { 1.0f, 3.0f, 2.0f, 5.0f, 0.0f, 4.0f };
+    for (size_t i = 0; i < sprites.size(); ++i)
+        EXPECT_FLOAT_EQ(vertices[i * 4].position.x, drawOrder[i] - 0.5f) << i;
+
+    EXPECT_EQ(batcher.Batches().size(), 4u);
+}
+
+TEST(SpriteBatch, WritesTransformedQuads)
+{
+    jg::Sprite sprite;
+    sprite.transform = jg::Mat3f::Translation2D(10.0f, 20.0f) * jg::Mat3f::Rotation2D(0.5f) * jg::Mat3f::Scale2D(4.0f, 2.0f);
+    sprite.position = jg::Vec2f{ 1.0f, -1.0f };
+    sprite.uvRect = jg::Vec4f{ 0.25f, 0.5f, 0.75f, 1.0f };
+    sprite.color = jg::Vec4f{ 1.0f, 0.5f, -1.0f, 2.0f };
+
+    std::vector<jg::SpriteVertex> vertices(4);
+    jg::SpriteBatcher batcher;
+    batcher.Build(jg::Span<const jg::Sprite>{ &sprite, 1 }, jg::Span<jg::SpriteVertex>{ vertices });
+
+    const jg::Vec3f corners[4] = { jg::Vec3f{ -0.5f, -0.5f, 1.0f }, jg::Vec3f{ 0.5f, -0.5f, 1.0f }, jg::Vec3f{ 0.5f, 0.5f, 1.0f }, jg::Vec3f{ -0.5f, 0.5f, 1.0f } };
+    const jg::Vec2f uvs[4] = { jg::Vec2f{ 0.25f, 0.5f }, jg::Vec2f{ 0.75f, 0.5f }, jg::Vec2f{ 0.75f, 1.0f }, jg::Vec2f{ 0.25f, 1.0f } };
+    for (size_t k = 0; k < 4; ++k)
+    {
+        const auto expected = sprite.transform * corners[k];
+        EXPECT_NEAR(vertices[k].position.x, expected.x + 1.0f, 1e-4f) << k;
+        EXPECT_NEAR(vertices[k].position.y, expected.y - 1.0f, 1e-4f) << k;
+        EXPECT_EQ(vertices[k].uv.x, uvs[k].x) << k;
+        EXPECT_EQ(vertices[k].uv.y, uvs[k].y) << k;
+        // Clamped, rounded, red in the low byte
+        EXPECT_EQ(vertices[k].color, 0xFF0080FFu) << k;
+    }
+}
+
+TEST(SpriteBatch, QuadIndices)
+{
+    std::vector<jg::u32> indices(12);
+    jg::WriteQuadIndices(jg::Span<jg::u32>{ indices }, 2);
+    EXPECT_EQ(indices, (std::vector<jg::u32>{ 0, 1, 2, 2, 3, 0, 4, 5, 6, 6, 7, 4 }));
+}
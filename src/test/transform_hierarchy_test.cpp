@@ -0,0 +1,144 @@
+#include "gtest/gtest.h"
+
+#include <vector>
+
+#include "jangine.h"
+
+namespace
+{
+    using Node = jg::TransformHierarchy::NodeId;
+
+    jg::Mat3f Local(const jg::Vec2f& t, float rad, const jg::Vec2f& s)
+    {
+        return jg::Mat3f::Translation2D(t.x, t.y) * jg::Mat3f::Rotation2D(rad) * jg::Mat3f::Scale2D(s.x, s.y);
+    }
+
+    void ExpectNear(const jg::Mat3f& a, const jg::Mat3f& b)
+    {
+        for (size_t k = 0; k < 9; ++k)
+            EXPECT_NEAR(a.data[k], b.data[k], 1e-4f) << "element " << k;
+    }
+
+    // World matrix the slow way, walking up the parents
+    jg::Mat3f ReferenceWorld(const jg::TransformHierarchy& h, Node id)
+    {
+        auto world = h.GetLocal(id);
+        for (auto p = h.GetParent(id); p != jg::TransformHierarchy::INVALID_NODE; p = h.GetParent(p))
+            world = h.GetLocal(p) * world;
+        return world;
+    }
+}
+
+TEST(TransformHierarchy, LocalIsTranslateRotateScale)
+{
+    jg::TransformHierarchy h;
+    const auto node = h.Create();
+    h.SetLocal(node, jg::Vec2f{ 3.0f, -1.0f }, 0.7f, jg::Vec2f{ 2.0f, 0.5f });
+    EXPECT_EQ(h.Update(), 1u);
+    ExpectNear(h.GetWorld(node), Local(jg::Vec2f{ 3.0f, -1.0f }, 0.7f, jg::Vec2f{ 2.0f, 0.5f }));
+    EXPECT_EQ(h.GetTranslation(node).x, 3.0f);
+    EXPECT_EQ(h.GetRotation(node), 0.7f);
+    EXPECT_EQ(h.GetScale(node).y, 0.5f);
+}
+
+TEST(TransformHierarchy, ChildrenFollowParents)
+{
+    jg::TransformHierarchy h;
+    const auto root = h.Create();
+    const auto child = h.Create(root);
+    const auto grandChild = h.Create(child);
+    h.SetTranslation(root, jg::Vec2f{ 10.0f, 0.0f });
+    h.SetRotation(child, 1.5707964f);
+    h.SetTranslation(grandChild, jg::Vec2f{ 1.0f, 0.0f });
+    EXPECT_EQ(h.Update(), 3u);
+
+    const auto p = h.GetWorld(grandChild) * jg::Vec3f{ 0.0f, 0.0f, 1.0f };
+    EXPECT_NEAR(p.x, 10.0f, 1e-5f);
+    EXPECT_NEAR(p.y, 1.0f, 1e-5f);
+    EXPECT_EQ(h.GetParent(grandChild), child);
+    EXPECT_EQ(h.GetParent(root), jg::TransformHierarchy::INVALID_NODE);
+}
+
+TEST(TransformHierarchy, UpdatesOnlyDirtySubtrees)
+{
+    // Two independent chains of 4 nodes
+    jg::TransformHierarchy h;
+    std::vector<Node> a, b;
+    for (int i = 0; i < 4; ++i)
+    {
+        a.push_back(h.Create(a.empty() ? jg::TransformHierarchy::INVALID_NODE : a.back()));
+        b.push_back(h.Create(b.empty() ? jg::TransformHierarchy::INVALID_NODE : b.back()));
+    }
+    EXPECT_EQ(h.Update(), 8u);
+    EXPECT_EQ(h.Update(), 0u);
+
+    h.SetTranslation(a[2], jg::Vec2f{ 1.0f, 2.0f });
+    EXPECT_EQ(h.Update(), 2u);
+    ExpectNear(h.GetWorld(a[3]), ReferenceWorld(h, a[3]));
+
+    h.SetRotation(a[0], 0.3f);
+    h.SetScale(a[1], jg::Vec2f{ 2.0f, 2.0f });
+    h.SetScale(b[3], jg::Vec2f{ 3.0f, 1.0f });
+    EXPECT_EQ(h.Update(), 5u);
+    for (const auto node : a)
+        ExpectNear(h.GetWorld(node), ReferenceWorld(h, node));
+    ExpectNear(h.GetWorld(b[3]), ReferenceWorld(h, b[3]));
+}
+
+TEST(TransformHierarchy, ReparentAndDestroy)
+{
+    jg::TransformHierarchy h;
+    const auto root = h.Create();
+    const auto other = h.Create();
+    const auto child = h.Create(root);
+    const auto leaf = h.Create(child);
+    h.SetTranslation(root, jg::Vec2f{ 1.0f, 0.0f });
+    h.SetTranslation(other, jg::Vec2f{ 0.0f, 5.0f });
+    h.SetTranslation(leaf, jg::Vec2f{ 0.5f, 0.5f });
+    h.Update();
+
+    // A root moved under a deeper node must still be updated before its new children
+    h.SetParent(root, other);
+    h.SetParent(other, h.Create());
+    h.Update();
+    for (const auto node : { root, other, child, leaf })
+        ExpectNear(h.GetWorld(node), ReferenceWorld(h, node));
+    ExpectNear(h.GetWorld(leaf), jg::Mat3f::Translation2D(1.5f, 5.5f));
+
+    h.Destroy(child);
+    EXPECT_FALSE(h.Contains(child));
+    EXPECT_FALSE(h.Contains(leaf));
+    EXPECT_TRUE(h.Contains(root));
+    EXPECT_EQ(h.size(), 3u);
+
+    // Ids are reused, and survivors keep their world matrices
+    const auto reused = h.Create(root);
+    EXPECT_TRUE(reused == leaf || reused == child);
+    EXPECT_EQ(h.Update(), 1u);
+    ExpectNear(h.GetWorld(reused), h.GetWorld(root));
+    ExpectNear(h.GetWorld(root), ReferenceWorld(h, root));
+}
+
+TEST(TransformHierarchy, MatchesReferenceOnRandomTree)
+{
+    jg::TransformHierarchy h;
+    std::vector<Node> nodes;
+    unsigned state = 12345;
+    const auto next = [&] { state = state * 1664525u + 1013904223u; return state >> 8; };
+    for (int i = 0; i < 500; ++i)
+    {
+        const auto parent = nodes.empty() || next() % 8 == 0 ? jg::TransformHierarchy::INVALID_NODE : nodes[next() % nodes.size()];
+        const auto node = h.Create(parent);
+        h.SetLocal(node, jg::Vec2f{ static_cast<float>(next() % 7) - 3.0f, 1.0f }, 0.01f * static_cast<float>(next() % 100), jg::Vec2f{ 1.0f });
+        nodes.push_back(node);
+    }
+    h.Update();
+    for (int frame = 0; frame < 5; ++frame)
+    {
+        for (int k = 0; k < 20; ++k)
+            h.SetRotation(nodes[next() % nodes.size()], 0.01f * static_cast<float>(next() % 100));
+        h.Update();
+        for (const auto node : nodes)
+            ExpectNear(h.GetWorld(node), ReferenceWorld(h, node));
+    }
+}
@@ -272,6 +272,19 @@ TEST_F(Vec4, Constructors)
     EXPECT_FLOAT_EQ(c[3], -5.0f);
 }
 
+TEST_F(Vec4, Layout)
+{
+    EXPECT_EQ(sizeof(jg::Vec4f), 4 * sizeof(float));
+#if defined(JG_SIMD_SSE)
+    EXPECT_EQ(alignof(jg::Vec4f), 16u);
+#endif
+
+    const jg::Vec4f v{ 1.0f, 2.0f, 3.0f, 4.0f };
+    EXPECT_FLOAT_EQ(v.xyz.z, 3.0f);
+    EXPECT_FLOAT_EQ(v.rgb.r, 1.0f);
+    EXPECT_FLOAT_EQ(v.a, 4.0f);
+}
+
 TEST_F(Vec4, BasicOperations)
 {
     // Negate